@@ -37,8 +37,9 @@ HLSEnableNSManagedObjectValidation();
     // Use optional preloading provided by CoconutKit
     [application preload];
     
-    // Instead of using the UIAppFonts key in the plist to load the Beon font, do it in code
-    [UIFont loadFontWithFileName:@"Beon-Regular.otf" inBundle:nil];
+    // Instead of using the UIAppFonts key in the plist to load the Beon font, do it in code. The font is only
+    // registered when first used
+    [UIFont declareFontWithName:@"Beon-Regular" fileName:@"Beon-Regular.otf" inBundle:nil];
     
     self.application = [[CoconutKit_demoApplication alloc] init];
     self.window.rootViewController = [self.application rootViewController];
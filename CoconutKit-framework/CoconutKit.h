@@ -20,6 +20,7 @@
 #import <CoconutKit/HLSCoreError.h>
 #import <CoconutKit/HLSCursor.h>
 #import <CoconutKit/HLSFakeConnection.h>
+#import <CoconutKit/HLSFetchResultCache.h>
 #import <CoconutKit/HLSFileManager.h>
 #import <CoconutKit/HLSFileURLConnection.h>
 #import <CoconutKit/HLSGeometry.h>
@@ -36,12 +37,15 @@
 #import <CoconutKit/HLSNotifications.h>
 #import <CoconutKit/HLSObjectAnimation.h>
 #import <CoconutKit/HLSOptionalFeatures.h>
+#import <CoconutKit/HLSPersistentArray.h>
+#import <CoconutKit/HLSPersistentDictionary.h>
 #import <CoconutKit/HLSPlaceholderInsetSegue.h>
 #import <CoconutKit/HLSPlaceholderViewController.h>
 #import <CoconutKit/HLSPreviewItem.h>
 #import <CoconutKit/HLSRestrictedInterfaceProxy.h>
 #import <CoconutKit/HLSRuntime.h>
 #import <CoconutKit/HLSSafariActivity.h>
+#import <CoconutKit/HLSSearchEngine.h>
 #import <CoconutKit/HLSSlideshow.h>
 #import <CoconutKit/HLSStackController.h>
 #import <CoconutKit/HLSStackPushSegue.h>
@@ -55,6 +59,7 @@
 #import <CoconutKit/HLSTaskManager.h>
 #import <CoconutKit/HLSTaskOperation.h>
 #import <CoconutKit/HLSTaskOperation+Protected.h>
+#import <CoconutKit/HLSTextMeasurementCache.h>
 #import <CoconutKit/HLSTransformer.h>
 #import <CoconutKit/HLSTransition.h>
 #import <CoconutKit/HLSURLConnection.h>
@@ -69,7 +74,9 @@
 #import <CoconutKit/HLSViewBindingDelegate.h>
 #import <CoconutKit/HLSViewBindingError.h>
 #import <CoconutKit/HLSViewController.h>
+#import <CoconutKit/HLSViewControllerLifeCycleProfiler.h>
 #import <CoconutKit/HLSWebViewController.h>
+#import <CoconutKit/HLSWebViewPool.h>
 #import <CoconutKit/HLSWizardViewController.h>
 #import <CoconutKit/NSArray+HLSExtensions.h>
 #import <CoconutKit/NSBundle+HLSExtensions.h>
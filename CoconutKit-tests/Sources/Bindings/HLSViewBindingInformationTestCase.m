@@ -0,0 +1,136 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import "HLSViewBindingInformationTestCase.h"
+
+#import "HLSViewBindingInformation.h"
+#import "UIView+HLSViewBindingFriend.h"
+
+@interface ProfiledModel : NSObject
+
+@property (nonatomic, strong) NSString *name;
+
+@end
+
+@implementation ProfiledModel
+
+@end
+
+@interface ProfiledView : UIView
+
+@property (nonatomic, strong) ProfiledModel *model;
+@property (nonatomic, strong) UILabel *label;
+
+@end
+
+@implementation ProfiledView
+
+- (instancetype)initWithFrame:(CGRect)frame
+{
+    if (self = [super initWithFrame:frame]) {
+        self.model = [[ProfiledModel alloc] init];
+        self.model.name = @"Name";
+        
+        self.label = [[UILabel alloc] initWithFrame:CGRectMake(0.f, 0.f, 200.f, 20.f)];
+        [self.label bindToKeyPath:@"model.name" withTransformer:nil];
+        [self addSubview:self.label];
+    }
+    return self;
+}
+
+@end
+
+@interface HLSViewBindingInformationTestCase ()
+
+@property (nonatomic, strong) UIWindow *window;
+@property (nonatomic, strong) ProfiledView *profiledView;
+
+@end
+
+@implementation HLSViewBindingInformationTestCase
+
+#pragma mark Setup and teardown
+
+- (void)setUp
+{
+    [super setUp];
+    
+    self.window = [[UIWindow alloc] initWithFrame:CGRectMake(0.f, 0.f, 320.f, 20.f)];
+    
+    self.profiledView = [[ProfiledView alloc] initWithFrame:CGRectMake(0.f, 0.f, 320.f, 20.f)];
+    [self.window addSubview:self.profiledView];
+    
+    [self.profiledView.label.bindingInformation resetProfilingInformation];
+}
+
+- (void)tearDown
+{
+    [super tearDown];
+    
+    self.profiledView = nil;
+    self.window = nil;
+}
+
+#pragma mark Tests
+
+- (void)testProfilingCounters
+{
+    HLSViewBindingInformation *bindingInformation = self.profiledView.label.bindingInformation;
+    XCTAssertEqual(bindingInformation.updateCount, 0);
+    XCTAssertEqual(bindingInformation.totalUpdateDuration, 0.);
+    
+    for (NSUInteger i = 0; i < 10; ++i) {
+        [self.profiledView updateBoundViewHierarchy];
+    }
+    
+    XCTAssertEqual(bindingInformation.updateCount, 10);
+    XCTAssertTrue(bindingInformation.keyPathResolutionDuration >= 0.);
+    XCTAssertTrue(bindingInformation.transformationDuration >= 0.);
+    XCTAssertTrue(bindingInformation.viewUpdateDuration >= 0.);
+    XCTAssertTrue(bindingInformation.totalUpdateDuration > 0.);
+    XCTAssertEqualWithAccuracy(bindingInformation.totalUpdateDuration,
+                               bindingInformation.keyPathResolutionDuration + bindingInformation.transformationDuration + bindingInformation.viewUpdateDuration,
+                               1e-9);
+    XCTAssertTrue(bindingInformation.updatesPerSecond >= 0.f);
+    
+    [bindingInformation resetProfilingInformation];
+    XCTAssertEqual(bindingInformation.updateCount, 0);
+    XCTAssertEqual(bindingInformation.keyPathResolutionDuration, 0.);
+    XCTAssertEqual(bindingInformation.transformationDuration, 0.);
+    XCTAssertEqual(bindingInformation.viewUpdateDuration, 0.);
+    XCTAssertEqual(bindingInformation.updatesPerSecond, 0.f);
+}
+
+- (void)testProfilingInformationExport
+{
+    for (NSUInteger i = 0; i < 3; ++i) {
+        [self.profiledView updateBoundViewHierarchy];
+    }
+    
+    HLSViewBindingInformation *bindingInformation = self.profiledView.label.bindingInformation;
+    NSDictionary *profilingInformationDictionary = [bindingInformation profilingInformationDictionary];
+    XCTAssertEqualObjects([profilingInformationDictionary objectForKey:@"viewClass"], @"UILabel");
+    XCTAssertEqualObjects([profilingInformationDictionary objectForKey:@"keyPath"], @"model.name");
+    XCTAssertEqualObjects([profilingInformationDictionary objectForKey:@"transformerName"], @"");
+    XCTAssertEqualObjects([profilingInformationDictionary objectForKey:@"updateCount"], @3);
+    
+    // Durations are exported in milliseconds
+    XCTAssertEqualWithAccuracy([[profilingInformationDictionary objectForKey:@"totalUpdateDuration"] doubleValue],
+                               bindingInformation.totalUpdateDuration * 1000., 1e-6);
+    
+    // Same format as the file exported by the debug overlay
+    NSError *error = nil;
+    NSData *data = [NSJSONSerialization dataWithJSONObject:@[profilingInformationDictionary] options:NSJSONWritingPrettyPrinted error:&error];
+    XCTAssertNotNil(data);
+    XCTAssertNil(error);
+    
+    NSArray *profilingInformationDictionaries = [NSJSONSerialization JSONObjectWithData:data options:0 error:NULL];
+    XCTAssertEqual([profilingInformationDictionaries count], 1);
+    XCTAssertEqualObjects([[profilingInformationDictionaries firstObject] objectForKey:@"keyPath"], @"model.name");
+    XCTAssertEqualObjects([[profilingInformationDictionaries firstObject] objectForKey:@"updateCount"], @3);
+}
+
+@end
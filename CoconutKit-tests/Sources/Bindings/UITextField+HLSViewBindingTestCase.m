@@ -0,0 +1,233 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import "UITextField+HLSViewBindingTestCase.h"
+
+static const NSUInteger kFieldCount = 30;
+
+@interface TextInputModel : NSObject
+
+@property (nonatomic, strong) NSNumber *amount;
+@property (nonatomic, assign) NSUInteger validationCount;
+
+@end
+
+@implementation TextInputModel
+
+- (BOOL)validateAmount:(NSNumber **)pAmount error:(NSError *__autoreleasing *)pError
+{
+    ++self.validationCount;
+    return [*pAmount floatValue] >= 0.f;
+}
+
+@end
+
+@interface TextInputView : UIView
+
+@property (nonatomic, strong) TextInputModel *model;
+@property (nonatomic, strong) UITextField *textField;
+
+@end
+
+@implementation TextInputView
+
++ (NSNumberFormatter *)decimalNumberFormatter
+{
+    static NSNumberFormatter *s_numberFormatter = nil;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        s_numberFormatter = [[NSNumberFormatter alloc] init];
+        s_numberFormatter.numberStyle = NSNumberFormatterDecimalStyle;
+        s_numberFormatter.locale = [NSLocale localeWithLocaleIdentifier:@"en_US"];
+    });
+    return s_numberFormatter;
+}
+
+- (instancetype)initWithFrame:(CGRect)frame
+{
+    if (self = [super initWithFrame:frame]) {
+        self.model = [[TextInputModel alloc] init];
+        
+        self.textField = [[UITextField alloc] initWithFrame:CGRectMake(0.f, 0.f, 200.f, 20.f)];
+        [self.textField bindToKeyPath:@"model.amount" withTransformer:@"decimalNumberFormatter"];
+        [self addSubview:self.textField];
+        
+        // Other view displaying the same value, refreshed each time the model changes
+        UILabel *label = [[UILabel alloc] initWithFrame:CGRectMake(200.f, 0.f, 100.f, 20.f)];
+        [label bindToKeyPath:@"model.amount" withTransformer:@"decimalNumberFormatter"];
+        [self addSubview:label];
+    }
+    return self;
+}
+
+@end
+
+@interface UITextField_HLSViewBindingTestCase ()
+
+@property (nonatomic, strong) UIWindow *window;
+@property (nonatomic, strong) NSArray *inputViews;
+
+@end
+
+@implementation UITextField_HLSViewBindingTestCase
+
+#pragma mark Setup and teardown
+
+- (void)setUp
+{
+    [super setUp];
+    
+    self.window = [[UIWindow alloc] initWithFrame:CGRectMake(0.f, 0.f, 320.f, 20.f * kFieldCount)];
+    
+    NSMutableArray *inputViews = [NSMutableArray array];
+    for (NSUInteger i = 0; i < kFieldCount; ++i) {
+        TextInputView *inputView = [[TextInputView alloc] initWithFrame:CGRectMake(0.f, 20.f * i, 320.f, 20.f)];
+        [self.window addSubview:inputView];
+        [inputViews addObject:inputView];
+    }
+    self.inputViews = [NSArray arrayWithArray:inputViews];
+}
+
+- (void)tearDown
+{
+    [super tearDown];
+    
+    self.inputViews = nil;
+    self.window = nil;
+}
+
+#pragma mark Tests
+
+- (void)testWriteBackOnChange
+{
+    TextInputView *inputView = [self.inputViews firstObject];
+    inputView.textField.text = @"1,234";
+    XCTAssertEqualObjects(inputView.model.amount, @1234);
+}
+
+- (void)testDelayedWriteBack
+{
+    TextInputView *inputView = [self.inputViews firstObject];
+    inputView.textField.bindWriteBackDelay = 0.1;
+    
+    inputView.textField.text = @"1";
+    inputView.textField.text = @"12";
+    XCTAssertNil(inputView.model.amount);
+    
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.3]];
+    XCTAssertEqualObjects(inputView.model.amount, @12);
+}
+
+- (void)testExplicitWriteBack
+{
+    TextInputView *inputView = [self.inputViews firstObject];
+    inputView.textField.bindWriteBackPolicy = HLSViewBindingWriteBackPolicyExplicit;
+    
+    inputView.textField.text = @"42";
+    XCTAssertNil(inputView.model.amount);
+    
+    XCTAssertTrue([self.window commitBoundViewHierarchyWithError:NULL]);
+    XCTAssertEqualObjects(inputView.model.amount, @42);
+    
+    // Model changes discard input which has not been written back
+    inputView.textField.text = @"43";
+    inputView.model.amount = @7;
+    XCTAssertEqualObjects(inputView.textField.text, @"7");
+    XCTAssertTrue([self.window commitBoundViewHierarchyWithError:NULL]);
+    XCTAssertEqualObjects(inputView.model.amount, @7);
+}
+
+- (void)testWriteBackOnEndEditing
+{
+    // Programmatic changes made outside an editing session are written back immediately
+    TextInputView *inputView = [self.inputViews firstObject];
+    inputView.textField.bindWriteBackPolicy = HLSViewBindingWriteBackPolicyOnEndEditing;
+    inputView.textField.text = @"5";
+    XCTAssertEqualObjects(inputView.model.amount, @5);
+}
+
+- (void)testCachedValidation
+{
+    TextInputView *inputView = [self.inputViews firstObject];
+    inputView.textField.bindInputChecked = YES;
+    
+    inputView.textField.text = @"3";
+    XCTAssertEqual(inputView.model.validationCount, 1);
+    
+    // Same input, unchanged model
+    inputView.textField.text = @"3";
+    XCTAssertEqual(inputView.model.validationCount, 1);
+    
+    // Explicit checks are always performed
+    XCTAssertTrue([self.window checkBoundViewHierarchyWithError:NULL]);
+    XCTAssertEqual(inputView.model.validationCount, 2);
+    
+    // The model changed
+    inputView.model.amount = @4;
+    inputView.textField.text = @"3";
+    XCTAssertEqual(inputView.model.validationCount, 3);
+}
+
+- (void)testCacheInvalidationByOtherBindings
+{
+    TextInputView *inputView = [self.inputViews firstObject];
+    inputView.textField.bindInputChecked = YES;
+    
+    inputView.textField.text = @"3";
+    XCTAssertEqual(inputView.model.validationCount, 1);
+    
+    // Validation might depend on other model values. Any model update made through a binding discards cached results
+    TextInputView *otherInputView = [self.inputViews objectAtIndex:1];
+    otherInputView.textField.text = @"5";
+    
+    inputView.textField.text = @"3";
+    XCTAssertEqual(inputView.model.validationCount, 2);
+}
+
+- (void)testUncachedNonTextInput
+{
+    // Input received through the generic update method is never cached
+    TextInputView *inputView = [self.inputViews firstObject];
+    inputView.textField.bindInputChecked = YES;
+    
+    XCTAssertTrue([inputView.textField check:YES update:YES withInputValue:@"3" error:NULL]);
+    XCTAssertTrue([inputView.textField check:YES update:YES withInputValue:@"3" error:NULL]);
+    XCTAssertEqual(inputView.model.validationCount, 2);
+}
+
+- (void)testTypingPerformanceWithWriteBackOnChange
+{
+    // 10 keystrokes in each field, each one transformed, checked and written back
+    [self measureBlock:^{
+        for (TextInputView *inputView in self.inputViews) {
+            inputView.textField.bindInputChecked = YES;
+            NSMutableString *text = [NSMutableString string];
+            for (NSUInteger i = 0; i < 10; ++i) {
+                [text appendFormat:@"%@", @(i)];
+                inputView.textField.text = text;
+            }
+        }
+    }];
+}
+
+- (void)testTypingPerformanceWithExplicitWriteBack
+{
+    // Same as above, but values are written back once at the end
+    [self measureBlock:^{
+        for (TextInputView *inputView in self.inputViews) {
+            inputView.textField.bindInputChecked = YES;
+            inputView.textField.bindWriteBackPolicy = HLSViewBindingWriteBackPolicyExplicit;
+            NSMutableString *text = [NSMutableString string];
+            for (NSUInteger i = 0; i < 10; ++i) {
+                [text appendFormat:@"%@", @(i)];
+                inputView.textField.text = text;
+            }
+        }
+        [self.window commitBoundViewHierarchyWithError:NULL];
+    }];
+}
+
+@end
@@ -0,0 +1,180 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import "CALayer+HLSExtensionsTestCase.h"
+
+#import "HLSLayerSnapshotter.h"
+
+static const NSUInteger kLargeLayerTreeSublayerCount = 2000;
+
+@interface CALayer_HLSExtensionsTestCase ()
+
+@property (nonatomic, strong) CALayer *displayedLayer;
+
+@end
+
+@implementation CALayer_HLSExtensionsTestCase
+
+#pragma mark Setup and teardown
+
+- (void)tearDown
+{
+    [super tearDown];
+    
+    [self.displayedLayer removeFromSuperlayer];
+    self.displayedLayer = nil;
+}
+
+#pragma mark Helpers
+
+// Layers are only rendered in the background once they have a presentation layer, i.e. once they have been
+// committed to a layer tree which is displayed
+- (CALayer *)displayedLargeLayerTree
+{
+    CALayer *layer = [self largeLayerTree];
+    [[UIApplication sharedApplication].keyWindow.layer addSublayer:layer];
+    [CATransaction flush];
+    
+    self.displayedLayer = layer;
+    return layer;
+}
+
+- (CALayer *)largeLayerTree
+{
+    CALayer *layer = [CALayer layer];
+    layer.frame = CGRectMake(0.f, 0.f, 1024.f, 768.f);
+    layer.backgroundColor = [UIColor whiteColor].CGColor;
+    
+    for (NSUInteger i = 0; i < kLargeLayerTreeSublayerCount; ++i) {
+        CALayer *sublayer = [CALayer layer];
+        sublayer.frame = CGRectMake((i * 37) % 1000, (i * 53) % 740, 24.f, 24.f);
+        sublayer.backgroundColor = [UIColor colorWithHue:(i % 100) / 100.f saturation:1.f brightness:1.f alpha:0.5f].CGColor;
+        sublayer.cornerRadius = 6.f;
+        sublayer.borderWidth = 1.f;
+        [layer addSublayer:sublayer];
+    }
+    return layer;
+}
+
+#pragma mark Tests
+
+- (void)testFlattenedImageInRect
+{
+    CALayer *layer = [CALayer layer];
+    layer.frame = CGRectMake(0.f, 0.f, 200.f, 100.f);
+    
+    UIImage *image = [layer flattenedImageInRect:CGRectNull scale:1.f];
+    XCTAssertTrue(CGSizeEqualToSize(image.size, CGSizeMake(200.f, 100.f)));
+    XCTAssertEqualWithAccuracy(image.scale, 1.f, 0.0001f);
+    
+    UIImage *croppedImage = [layer flattenedImageInRect:CGRectMake(150.f, 50.f, 100.f, 100.f) scale:0.5f];
+    XCTAssertTrue(CGSizeEqualToSize(croppedImage.size, CGSizeMake(50.f, 50.f)));
+    XCTAssertEqual(CGImageGetWidth(croppedImage.CGImage), (size_t)25);
+    
+    XCTAssertNil([layer flattenedImageInRect:CGRectMake(300.f, 0.f, 100.f, 100.f) scale:1.f]);
+}
+
+- (void)testFlattenImageAsynchronously
+{
+    CALayer *layer = [self displayedLargeLayerTree];
+    XCTAssertNotNil([layer presentationLayer]);
+    
+    HLSLayerSnapshotter *layerSnapshotter = [HLSLayerSnapshotter sharedLayerSnapshotter];
+    NSTimeInterval renderingDuration1 = layerSnapshotter.renderingDuration;
+    
+    XCTestExpectation *expectation1 = [self expectationWithDescription:@"Image flattened"];
+    __block UIImage *image1 = nil;
+    [layer flattenImageInRect:CGRectNull scale:1.f contentVersion:@1 completionBlock:^(UIImage *image) {
+        XCTAssertTrue([NSThread isMainThread]);
+        XCTAssertNotNil(image);
+        image1 = image;
+        [expectation1 fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10. handler:nil];
+    
+    // Rendered in the background
+    NSTimeInterval renderingDuration2 = layerSnapshotter.renderingDuration;
+    XCTAssertTrue(renderingDuration2 > renderingDuration1);
+    
+    // Same content version: Served from the cache, immediately
+    NSUInteger hitCount = layerSnapshotter.hitCount;
+    __block UIImage *image2 = nil;
+    [layer flattenImageInRect:CGRectNull scale:1.f contentVersion:@1 completionBlock:^(UIImage *image) {
+        image2 = image;
+    }];
+    XCTAssertEqual(image1, image2);
+    XCTAssertEqual(layerSnapshotter.hitCount, hitCount + 1);
+    XCTAssertEqual(layerSnapshotter.renderingDuration, renderingDuration2);
+    
+    // New content version: Rendered again
+    XCTestExpectation *expectation3 = [self expectationWithDescription:@"Image flattened again"];
+    __block UIImage *image3 = nil;
+    [layer flattenImageInRect:CGRectNull scale:1.f contentVersion:@2 completionBlock:^(UIImage *image) {
+        image3 = image;
+        [expectation3 fulfill];
+    }];
+    XCTAssertNil(image3);
+    [self waitForExpectationsWithTimeout:10. handler:nil];
+    XCTAssertNotEqual(image1, image3);
+    XCTAssertTrue(layerSnapshotter.renderingDuration > renderingDuration2);
+    
+    // Discarded images are rendered again
+    [layer discardFlattenedImages];
+    XCTestExpectation *expectation4 = [self expectationWithDescription:@"Image flattened after being discarded"];
+    __block UIImage *image4 = nil;
+    [layer flattenImageInRect:CGRectNull scale:1.f contentVersion:@2 completionBlock:^(UIImage *image) {
+        image4 = image;
+        [expectation4 fulfill];
+    }];
+    XCTAssertNil(image4);
+    [self waitForExpectationsWithTimeout:10. handler:nil];
+}
+
+- (void)testFlatteningPerformance
+{
+    // Reference: Full render at device scale
+    CALayer *layer = [self largeLayerTree];
+    [self measureBlock:^{
+        [layer flattenedImage];
+    }];
+}
+
+- (void)testReducedScaleFlatteningPerformance
+{
+    CALayer *layer = [self largeLayerTree];
+    [self measureBlock:^{
+        [layer flattenedImageInRect:CGRectNull scale:0.25f];
+    }];
+}
+
+- (void)testRegionOfInterestFlatteningPerformance
+{
+    CALayer *layer = [self largeLayerTree];
+    [self measureBlock:^{
+        [layer flattenedImageInRect:CGRectMake(0.f, 0.f, 256.f, 192.f) scale:0.f];
+    }];
+}
+
+- (void)testCachedFlatteningPerformance
+{
+    CALayer *layer = [self displayedLargeLayerTree];
+    
+    HLSLayerSnapshotter *layerSnapshotter = [HLSLayerSnapshotter sharedLayerSnapshotter];
+    NSTimeInterval renderingDuration = layerSnapshotter.renderingDuration;
+    
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Image flattened"];
+    [layer flattenImageInRect:CGRectNull scale:0.f contentVersion:@"version" completionBlock:^(UIImage *image) {
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10. handler:nil];
+    XCTAssertTrue(layerSnapshotter.renderingDuration > renderingDuration);
+    
+    [self measureBlock:^{
+        [layer flattenImageInRect:CGRectNull scale:0.f contentVersion:@"version" completionBlock:nil];
+    }];
+}
+
+@end
@@ -0,0 +1,9 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+@interface HLSAnimationTestCase : XCTestCase
+
+@end
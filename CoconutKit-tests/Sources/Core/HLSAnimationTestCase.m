@@ -0,0 +1,240 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import "HLSAnimationTestCase.h"
+
+static const NSUInteger kLongAnimationStepCount = 500;
+
+@implementation HLSAnimationTestCase
+
+#pragma mark Helpers
+
+- (void)assertRect:(CGRect)rect1 isEqualToRect:(CGRect)rect2
+{
+    XCTAssertEqualWithAccuracy(CGRectGetMinX(rect1), CGRectGetMinX(rect2), 0.0001f);
+    XCTAssertEqualWithAccuracy(CGRectGetMinY(rect1), CGRectGetMinY(rect2), 0.0001f);
+    XCTAssertEqualWithAccuracy(CGRectGetWidth(rect1), CGRectGetWidth(rect2), 0.0001f);
+    XCTAssertEqualWithAccuracy(CGRectGetHeight(rect1), CGRectGetHeight(rect2), 0.0001f);
+}
+
+- (void)assertTransform:(CATransform3D)transform1 isEqualToTransform:(CATransform3D)transform2
+{
+    XCTAssertEqualWithAccuracy(transform1.m11, transform2.m11, 0.0001f);
+    XCTAssertEqualWithAccuracy(transform1.m12, transform2.m12, 0.0001f);
+    XCTAssertEqualWithAccuracy(transform1.m21, transform2.m21, 0.0001f);
+    XCTAssertEqualWithAccuracy(transform1.m22, transform2.m22, 0.0001f);
+    XCTAssertEqualWithAccuracy(transform1.m34, transform2.m34, 0.0001f);
+    XCTAssertEqualWithAccuracy(transform1.m41, transform2.m41, 0.0001f);
+    XCTAssertEqualWithAccuracy(transform1.m42, transform2.m42, 0.0001f);
+}
+
+- (HLSLayerAnimationState)identityLayerAnimationState
+{
+    HLSLayerAnimationState state;
+    state.opacity = 1.f;
+    state.transform = CATransform3DIdentity;
+    state.anchorPoint = CGPointMake(0.5f, 0.5f);
+    state.anchorPointZ = 0.f;
+    state.shouldRasterize = NO;
+    state.rasterizationScale = 1.f;
+    state.nonProjectedSublayerTransform = CATransform3DIdentity;
+    state.sublayerCameraZPosition = 0.f;
+    return state;
+}
+
+// An animation mixing view and layer animation steps, applied to two views (layer animation steps are applied
+// to the second one only). Durations are exactly representable so that start times fall exactly on step boundaries
+- (HLSAnimation *)animationForView1:(UIView *)view1 view2:(UIView *)view2
+{
+    NSMutableArray *animationSteps = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 4; ++i) {
+        HLSViewAnimationStep *viewAnimationStep = [HLSViewAnimationStep animationStep];
+        HLSViewAnimation *viewAnimation = [HLSViewAnimation animation];
+        [viewAnimation translateByVectorWithX:10.f y:-5.f];
+        [viewAnimation scaleWithXFactor:1.5f yFactor:0.5f];
+        [viewAnimation addToAlpha:-0.2f];
+        [viewAnimationStep addViewAnimation:viewAnimation forView:view1];
+        viewAnimationStep.duration = 0.125;
+        [animationSteps addObject:viewAnimationStep];
+        
+        HLSLayerAnimationStep *layerAnimationStep = [HLSLayerAnimationStep animationStep];
+        HLSLayerAnimation *layerAnimation = [HLSLayerAnimation animation];
+        [layerAnimation rotateByAngle:M_PI_4];
+        [layerAnimation translateByVectorWithX:20.f y:10.f];
+        [layerAnimation translateSublayerCameraByVectorWithZ:100.f];
+        [layerAnimation addToOpacity:-0.1f];
+        [layerAnimationStep addLayerAnimation:layerAnimation forView:view2];
+        layerAnimationStep.duration = 0.25;
+        [animationSteps addObject:layerAnimationStep];
+    }
+    return [HLSAnimation animationWithAnimationSteps:[NSArray arrayWithArray:animationSteps]];
+}
+
+- (HLSAnimation *)longAnimationForView:(UIView *)view
+{
+    NSMutableArray *animationSteps = [NSMutableArray array];
+    for (NSUInteger i = 0; i < kLongAnimationStepCount; ++i) {
+        HLSLayerAnimationStep *animationStep = [HLSLayerAnimationStep animationStep];
+        HLSLayerAnimation *layerAnimation = [HLSLayerAnimation animation];
+        [layerAnimation translateByVectorWithX:(i % 2 == 0) ? 1.f : -1.f y:0.f];
+        [animationStep addLayerAnimation:layerAnimation forView:view];
+        animationStep.duration = 0.125;
+        [animationSteps addObject:animationStep];
+    }
+    return [HLSAnimation animationWithAnimationSteps:[NSArray arrayWithArray:animationSteps]];
+}
+
+#pragma mark Tests
+
+- (void)testLayerAnimationState
+{
+    HLSLayerAnimation *layerAnimation = [HLSLayerAnimation animation];
+    [layerAnimation translateByVectorWithX:10.f y:20.f];
+    [layerAnimation translateAnchorPointByVectorWithX:0.1f y:-0.1f];
+    [layerAnimation addToOpacity:-0.25f];
+    [layerAnimation addToRasterizationScale:0.5f];
+    [layerAnimation translateSublayerCameraByVectorWithZ:200.f];
+    layerAnimation.togglingShouldRasterize = YES;
+    
+    HLSLayerAnimationState state = [self identityLayerAnimationState];
+    state = [layerAnimation stateByApplyingToState:state];
+    state = [layerAnimation stateByApplyingToState:state];
+    
+    XCTAssertEqualWithAccuracy(state.opacity, 0.5f, 0.0001f);
+    XCTAssertEqualWithAccuracy(state.transform.m41, 20.f, 0.0001f);
+    XCTAssertEqualWithAccuracy(state.transform.m42, 40.f, 0.0001f);
+    XCTAssertEqualWithAccuracy(state.anchorPoint.x, 0.7f, 0.0001f);
+    XCTAssertEqualWithAccuracy(state.anchorPoint.y, 0.3f, 0.0001f);
+    XCTAssertFalse(state.shouldRasterize);
+    XCTAssertEqualWithAccuracy(state.rasterizationScale, 2.f, 0.0001f);
+    XCTAssertEqualWithAccuracy(state.sublayerCameraZPosition, 400.f, 0.0001f);
+    XCTAssertEqualWithAccuracy(HLSLayerAnimationStateSublayerTransform(state).m34, -1.f / 400.f, 0.0001f);
+    
+    // The reverse animation restores the initial state
+    state = [[layerAnimation reverseObjectAnimation] stateByApplyingToState:state];
+    state = [[layerAnimation reverseObjectAnimation] stateByApplyingToState:state];
+    XCTAssertTrue(CATransform3DIsIdentity(state.transform));
+    XCTAssertEqualWithAccuracy(state.opacity, 1.f, 0.0001f);
+    XCTAssertEqualWithAccuracy(state.sublayerCameraZPosition, 0.f, 0.0001f);
+}
+
+- (void)testViewAnimationState
+{
+    HLSViewAnimation *viewAnimation = [HLSViewAnimation animation];
+    [viewAnimation scaleWithXFactor:2.f yFactor:0.5f];
+    [viewAnimation translateByVectorWithX:10.f y:-10.f];
+    [viewAnimation addToAlpha:-0.5f];
+    
+    HLSViewAnimationState state;
+    state.alpha = 1.f;
+    state.frame = CGRectMake(0.f, 0.f, 100.f, 100.f);
+    state.anchorPoint = CGPointMake(0.5f, 0.5f);
+    
+    // Scaling is applied about the view center
+    state = [viewAnimation stateByApplyingToState:state];
+    XCTAssertEqualWithAccuracy(state.alpha, 0.5f, 0.0001f);
+    [self assertRect:state.frame isEqualToRect:CGRectMake(-40.f, 15.f, 200.f, 50.f)];
+    
+    state = [[viewAnimation reverseObjectAnimation] stateByApplyingToState:state];
+    XCTAssertEqualWithAccuracy(state.alpha, 1.f, 0.0001f);
+    [self assertRect:state.frame isEqualToRect:CGRectMake(0.f, 0.f, 100.f, 100.f)];
+}
+
+- (void)testSeeking
+{
+    UIView *seekedView1 = [[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 100.f, 100.f)];
+    UIView *seekedView2 = [[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 100.f, 100.f)];
+    HLSAnimation *seekedAnimation = [self animationForView1:seekedView1 view2:seekedView2];
+    
+    UIView *playedView1 = [[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 100.f, 100.f)];
+    UIView *playedView2 = [[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 100.f, 100.f)];
+    HLSAnimation *playedAnimation = [self animationForView1:playedView1 view2:playedView2];
+    
+    // Starting at the end: All steps are skipped, the result must be the same as when playing all steps
+    [seekedAnimation playWithStartTime:[seekedAnimation duration]];
+    XCTAssertFalse(seekedAnimation.running);
+    [playedAnimation playAnimated:NO];
+    
+    [self assertRect:seekedView1.frame isEqualToRect:playedView1.frame];
+    XCTAssertEqualWithAccuracy(seekedView1.alpha, playedView1.alpha, 0.0001f);
+    [self assertTransform:seekedView2.layer.transform isEqualToTransform:playedView2.layer.transform];
+    [self assertTransform:seekedView2.layer.sublayerTransform isEqualToTransform:playedView2.layer.sublayerTransform];
+    XCTAssertEqualWithAccuracy(seekedView2.layer.opacity, playedView2.layer.opacity, 0.0001f);
+    
+    // Playing the reverse animation from the end restores the initial state
+    HLSAnimation *reverseAnimation = [seekedAnimation reverseAnimation];
+    [reverseAnimation playWithStartTime:[reverseAnimation duration]];
+    [self assertRect:seekedView1.frame isEqualToRect:CGRectMake(0.f, 0.f, 100.f, 100.f)];
+    [self assertTransform:seekedView2.layer.transform isEqualToTransform:CATransform3DIdentity];
+}
+
+- (void)testSuspension
+{
+    UIView *view = [[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 100.f, 100.f)];
+    [[UIApplication sharedApplication].keyWindow addSubview:view];
+    
+    HLSLayerAnimationStep *animationStep1 = [HLSLayerAnimationStep animationStep];
+    HLSLayerAnimation *layerAnimation1 = [HLSLayerAnimation animation];
+    [layerAnimation1 translateByVectorWithX:100.f y:0.f];
+    [animationStep1 addLayerAnimation:layerAnimation1 forView:view];
+    animationStep1.duration = 0.25;
+    
+    HLSLayerAnimationStep *animationStep2 = [HLSLayerAnimationStep animationStep];
+    HLSLayerAnimation *layerAnimation2 = [HLSLayerAnimation animation];
+    [layerAnimation2 translateByVectorWithX:0.f y:50.f];
+    [animationStep2 addLayerAnimation:layerAnimation2 forView:view];
+    animationStep2.duration = 0.25;
+    
+    HLSAnimation *animation = [HLSAnimation animationWithAnimationSteps:@[animationStep1, animationStep2]];
+    
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Animation completed"];
+    animation.completionBlock = ^(BOOL animated) {
+        XCTAssertTrue(animated);
+        [expectation fulfill];
+    };
+    [animation playAnimated:YES];
+    [animation pause];
+    
+    // The animation is suspended, not cancelled
+    [[NSNotificationCenter defaultCenter] postNotificationName:UIApplicationDidEnterBackgroundNotification object:nil];
+    XCTAssertTrue(animation.running);
+    XCTAssertTrue(animation.paused);
+    
+    // Resumed in the paused state it was suspended in
+    [[NSNotificationCenter defaultCenter] postNotificationName:UIApplicationWillEnterForegroundNotification object:nil];
+    XCTAssertTrue(animation.running);
+    XCTAssertTrue(animation.paused);
+    
+    [animation resume];
+    [self waitForExpectationsWithTimeout:5. handler:nil];
+    
+    XCTAssertFalse(animation.running);
+    XCTAssertEqualWithAccuracy(view.layer.transform.m41, 100.f, 0.0001f);
+    XCTAssertEqualWithAccuracy(view.layer.transform.m42, 50.f, 0.0001f);
+    
+    [view removeFromSuperview];
+}
+
+- (void)testNonAnimatedPlaybackPerformance
+{
+    // Reference: All steps are played one after the other
+    UIView *view = [[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 100.f, 100.f)];
+    HLSAnimation *animation = [self longAnimationForView:view];
+    [self measureBlock:^{
+        [animation playAnimated:NO];
+    }];
+}
+
+- (void)testSeekingPerformance
+{
+    UIView *view = [[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 100.f, 100.f)];
+    HLSAnimation *animation = [self longAnimationForView:view];
+    [self measureBlock:^{
+        [animation playWithStartTime:[animation duration]];
+    }];
+}
+
+@end
@@ -0,0 +1,181 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import "HLSImageLoaderTestCase.h"
+
+#import "HLSImageLoader.h"
+
+@implementation HLSImageLoaderTestCase
+
+#pragma mark Class methods
+
++ (NSString *)imageFilePath
+{
+    return [NSTemporaryDirectory() stringByAppendingPathComponent:@"HLSImageLoaderTestCase.png"];
+}
+
+#pragma mark Setup and teardown
+
+- (void)setUp
+{
+    [super setUp];
+    
+    // 1000 x 800 pixel image
+    UIGraphicsBeginImageContextWithOptions(CGSizeMake(1000.f, 800.f), YES, 1.f);
+    [[UIColor redColor] setFill];
+    UIRectFill(CGRectMake(0.f, 0.f, 1000.f, 800.f));
+    UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    
+    [UIImagePNGRepresentation(image) writeToFile:[HLSImageLoaderTestCase imageFilePath] atomically:YES];
+}
+
+- (void)tearDown
+{
+    [super tearDown];
+    
+    [[NSFileManager defaultManager] removeItemAtPath:[HLSImageLoaderTestCase imageFilePath] error:NULL];
+}
+
+#pragma mark Tests
+
+- (void)testLoading
+{
+    NSString *imageFilePath = [HLSImageLoaderTestCase imageFilePath];
+    CGSize targetSize = CGSizeMake(100.f, 100.f);
+    
+    HLSImageLoader *imageLoader = [HLSImageLoader sharedImageLoader];
+    XCTAssertNil([imageLoader cachedImageWithContentsOfFile:imageFilePath targetSize:targetSize]);
+    
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Image loaded"];
+    [imageLoader loadImageWithContentsOfFile:imageFilePath targetSize:targetSize completionBlock:^(UIImage *image) {
+        // Downsampled to cover the target size, same size in points
+        XCTAssertEqual(CGImageGetWidth(image.CGImage), 125);
+        XCTAssertEqual(CGImageGetHeight(image.CGImage), 100);
+        XCTAssertEqualWithAccuracy(image.size.width, 1000.f, 0.5f);
+        XCTAssertEqualWithAccuracy(image.size.height, 800.f, 0.5f);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10. handler:nil];
+    
+    XCTAssertNotNil([imageLoader cachedImageWithContentsOfFile:imageFilePath targetSize:targetSize]);
+    XCTAssertNil([imageLoader cachedImageWithContentsOfFile:imageFilePath targetSize:CGSizeMake(200.f, 200.f)]);
+}
+
+- (void)testCancellation
+{
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Later image loaded"];
+    
+    HLSImageLoader *imageLoader = [HLSImageLoader sharedImageLoader];
+    NSOperation *operation = [imageLoader loadImageWithContentsOfFile:[HLSImageLoaderTestCase imageFilePath] targetSize:CGSizeMake(10.f, 10.f) completionBlock:^(UIImage *image) {
+        XCTFail(@"Completion block must not be called for cancelled operations");
+    }];
+    [operation cancel];
+    
+    [imageLoader loadImageWithContentsOfFile:[HLSImageLoaderTestCase imageFilePath] targetSize:CGSizeMake(20.f, 20.f) completionBlock:^(UIImage *image) {
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10. handler:nil];
+}
+
+- (void)testPathForImageNamed
+{
+    NSString *bundlePath = [NSTemporaryDirectory() stringByAppendingPathComponent:@"HLSImageLoaderTestCase.bundle"];
+    [[NSFileManager defaultManager] removeItemAtPath:bundlePath error:NULL];
+    [[NSFileManager defaultManager] createDirectoryAtPath:bundlePath withIntermediateDirectories:YES attributes:nil error:NULL];
+    for (NSString *fileName in @[@"icon.png", @"icon@2x.png", @"icon~ipad.png", @"photo.jpg", @"photo@2x~ipad.jpg"]) {
+        [[NSFileManager defaultManager] createFileAtPath:[bundlePath stringByAppendingPathComponent:fileName] contents:[NSData data] attributes:nil];
+    }
+    NSBundle *bundle = [NSBundle bundleWithPath:bundlePath];
+    
+    // Lower scales are used when no variant exists for the screen scale
+    XCTAssertEqualObjects([[HLSImageLoader pathForImageNamed:@"icon" inBundle:bundle scale:3.f userInterfaceIdiom:UIUserInterfaceIdiomPhone] lastPathComponent], @"icon@2x.png");
+    XCTAssertEqualObjects([[HLSImageLoader pathForImageNamed:@"icon" inBundle:bundle scale:2.f userInterfaceIdiom:UIUserInterfaceIdiomPhone] lastPathComponent], @"icon@2x.png");
+    XCTAssertEqualObjects([[HLSImageLoader pathForImageNamed:@"icon" inBundle:bundle scale:1.f userInterfaceIdiom:UIUserInterfaceIdiomPhone] lastPathComponent], @"icon.png");
+    XCTAssertEqualObjects([[HLSImageLoader pathForImageNamed:@"icon.png" inBundle:bundle scale:3.f userInterfaceIdiom:UIUserInterfaceIdiomPhone] lastPathComponent], @"icon@2x.png");
+    
+    // Scale has precedence over the device modifier
+    XCTAssertEqualObjects([[HLSImageLoader pathForImageNamed:@"icon" inBundle:bundle scale:2.f userInterfaceIdiom:UIUserInterfaceIdiomPad] lastPathComponent], @"icon@2x.png");
+    XCTAssertEqualObjects([[HLSImageLoader pathForImageNamed:@"icon" inBundle:bundle scale:1.f userInterfaceIdiom:UIUserInterfaceIdiomPad] lastPathComponent], @"icon~ipad.png");
+    
+    XCTAssertEqualObjects([[HLSImageLoader pathForImageNamed:@"photo" inBundle:bundle scale:3.f userInterfaceIdiom:UIUserInterfaceIdiomPad] lastPathComponent], @"photo@2x~ipad.jpg");
+    XCTAssertEqualObjects([[HLSImageLoader pathForImageNamed:@"photo" inBundle:bundle scale:2.f userInterfaceIdiom:UIUserInterfaceIdiomPhone] lastPathComponent], @"photo.jpg");
+    
+    XCTAssertNil([HLSImageLoader pathForImageNamed:@"missing" inBundle:bundle scale:2.f userInterfaceIdiom:UIUserInterfaceIdiomPhone]);
+    XCTAssertNil([HLSImageLoader pathForImageNamed:@"icon.jpg" inBundle:bundle scale:2.f userInterfaceIdiom:UIUserInterfaceIdiomPhone]);
+    
+    [[NSFileManager defaultManager] removeItemAtPath:bundlePath error:NULL];
+}
+
+- (void)testJoiningLoads
+{
+    NSString *imageFilePath = [HLSImageLoaderTestCase imageFilePath];
+    CGSize targetSize = CGSizeMake(30.f, 30.f);
+    
+    HLSImageLoader *imageLoader = [HLSImageLoader sharedImageLoader];
+    XCTAssertNil([imageLoader cachedImageWithContentsOfFile:imageFilePath targetSize:targetSize]);
+    
+    XCTestExpectation *expectation1 = [self expectationWithDescription:@"First request fulfilled"];
+    [imageLoader loadImageWithContentsOfFile:imageFilePath targetSize:targetSize completionBlock:^(UIImage *image) {
+        XCTAssertNotNil(image);
+        [expectation1 fulfill];
+    }];
+    
+    // Requests for the image being loaded are not counted as misses, and join the load in progress
+    NSUInteger missCount = imageLoader.missCount;
+    [imageLoader cachedImageWithContentsOfFile:imageFilePath targetSize:targetSize];
+    XCTAssertEqual(imageLoader.missCount, missCount);
+    
+    NSOperation *cancelledRequest = [imageLoader loadImageWithContentsOfFile:imageFilePath targetSize:targetSize completionBlock:^(UIImage *image) {
+        XCTFail(@"Completion block must not be called for cancelled requests");
+    }];
+    [cancelledRequest cancel];
+    
+    XCTestExpectation *expectation2 = [self expectationWithDescription:@"Second request fulfilled"];
+    [imageLoader loadImageWithContentsOfFile:imageFilePath targetSize:targetSize completionBlock:^(UIImage *image) {
+        XCTAssertNotNil(image);
+        [expectation2 fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10. handler:nil];
+}
+
+- (void)testSynchronousLoadingPerformance
+{
+    // Reference: What image view bindings used to do on the main thread for each cell displayed
+    NSString *imageFilePath = [HLSImageLoaderTestCase imageFilePath];
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 50; ++i) {
+            UIImage *image = [UIImage imageWithContentsOfFile:imageFilePath];
+            UIGraphicsBeginImageContextWithOptions(CGSizeMake(1.f, 1.f), NO, 1.f);
+            [image drawAtPoint:CGPointZero];
+            UIGraphicsEndImageContext();
+        }
+    }];
+}
+
+- (void)testCachedLoadingPerformance
+{
+    NSString *imageFilePath = [HLSImageLoaderTestCase imageFilePath];
+    CGSize targetSize = CGSizeMake(80.f, 80.f);
+    
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Image loaded"];
+    HLSImageLoader *imageLoader = [HLSImageLoader sharedImageLoader];
+    [imageLoader loadImageWithContentsOfFile:imageFilePath targetSize:targetSize completionBlock:^(UIImage *image) {
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10. handler:nil];
+    
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 50; ++i) {
+            UIImage *image = [imageLoader cachedImageWithContentsOfFile:imageFilePath targetSize:targetSize];
+            UIGraphicsBeginImageContextWithOptions(CGSizeMake(1.f, 1.f), NO, 1.f);
+            [image drawAtPoint:CGPointZero];
+            UIGraphicsEndImageContext();
+        }
+    }];
+}
+
+@end
@@ -0,0 +1,152 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import "HLSPersistentArrayTestCase.h"
+
+@implementation HLSPersistentArrayTestCase
+
+#pragma mark Helpers
+
+// Grow an array one object at a time
+- (NSArray *)arrayByGrowingArray:(NSArray *)array toNumberOfObjects:(NSUInteger)numberOfObjects
+{
+    for (NSUInteger i = [array count]; i < numberOfObjects; ++i) {
+        array = [array arrayByAddingObject:@(i)];
+    }
+    return array;
+}
+
+#pragma mark Tests
+
+- (void)testCreation
+{
+    NSMutableArray *objects = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 2000; ++i) {
+        [objects addObject:@(i)];
+    }
+    
+    HLSPersistentArray *array = [HLSPersistentArray arrayWithArray:objects];
+    XCTAssertEqual([array count], (NSUInteger)2000);
+    XCTAssertEqualObjects(array, objects);
+    XCTAssertEqualObjects([array objectAtIndex:1234], @1234);
+    XCTAssertThrows([array objectAtIndex:2000]);
+    XCTAssertEqual([array copy], array);
+    
+    NSUInteger index = 0;
+    for (NSNumber *number in array) {
+        XCTAssertEqualObjects(number, @(index));
+        ++index;
+    }
+    XCTAssertEqual(index, (NSUInteger)2000);
+    
+    XCTAssertEqual([[HLSPersistentArray array] count], (NSUInteger)0);
+}
+
+- (void)testEnumerationWithReferences
+{
+    NSMutableArray *objects = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 100; ++i) {
+        [objects addObject:@(i)];
+    }
+    HLSPersistentArray *array = [HLSPersistentArray arrayWithArray:objects];
+    
+    // Retaining or weakly referencing the array while enumerating it is not a mutation
+    NSMutableArray *retainedArrays = [NSMutableArray array];
+    NSUInteger index = 0;
+    for (NSNumber *number in array) {
+        [retainedArrays addObject:array];
+        __weak HLSPersistentArray *weakArray = array;
+        XCTAssertEqual(weakArray, array);
+        XCTAssertEqualObjects(number, @(index));
+        ++index;
+    }
+    XCTAssertEqual(index, (NSUInteger)100);
+    XCTAssertEqual([retainedArrays count], (NSUInteger)100);
+}
+
+- (void)testModification
+{
+    NSArray *array1 = [HLSPersistentArray arrayWithArray:@[@1, @2, @3]];
+    NSArray *array2 = [array1 arrayByAddingObject:@4];
+    NSArray *array3 = [array2 arrayByRemovingLastObject];
+    NSArray *array4 = [(HLSPersistentArray *)array3 arrayByReplacingObjectAtIndex:0 withObject:@0];
+    NSArray *array5 = [array4 arrayByAddingObjectsFromArray:@[@5, @6]];
+    
+    // Earlier versions are left untouched
+    XCTAssertEqualObjects(array1, (@[@1, @2, @3]));
+    XCTAssertEqualObjects(array2, (@[@1, @2, @3, @4]));
+    XCTAssertEqualObjects(array3, (@[@1, @2, @3]));
+    XCTAssertEqualObjects(array4, (@[@0, @2, @3]));
+    XCTAssertEqualObjects(array5, (@[@0, @2, @3, @5, @6]));
+    
+    XCTAssertTrue([array5 isKindOfClass:[HLSPersistentArray class]]);
+    XCTAssertThrows([[HLSPersistentArray array] arrayByRemovingLastObject]);
+}
+
+- (void)testConsistency
+{
+    // Grow and shrink across several trie levels (32 objects per chunk, 32 children per node), comparing with a
+    // mutable array
+    NSMutableArray *referenceArray = [NSMutableArray array];
+    NSArray *array = [HLSPersistentArray array];
+    for (NSUInteger i = 0; i < 40000; ++i) {
+        [referenceArray addObject:@(i)];
+        array = [array arrayByAddingObject:@(i)];
+    }
+    XCTAssertEqualObjects(array, referenceArray);
+    
+    for (NSUInteger i = 0; i < 1000; ++i) {
+        NSUInteger index = arc4random_uniform((u_int32_t)[referenceArray count]);
+        [referenceArray replaceObjectAtIndex:index withObject:@(-(NSInteger)i)];
+        array = [(HLSPersistentArray *)array arrayByReplacingObjectAtIndex:index withObject:@(-(NSInteger)i)];
+    }
+    XCTAssertEqualObjects(array, referenceArray);
+    
+    while ([referenceArray count] != 0) {
+        [referenceArray removeLastObject];
+        array = [array arrayByRemovingLastObject];
+        XCTAssertEqual([array count], [referenceArray count]);
+        if ([referenceArray count] % 997 == 0) {
+            XCTAssertEqualObjects(array, referenceArray);
+        }
+    }
+}
+
+- (void)testGrowth
+{
+    NSArray *array = [self arrayByGrowingArray:[HLSPersistentArray array] toNumberOfObjects:100000];
+    XCTAssertTrue([array isKindOfClass:[HLSPersistentArray class]]);
+    XCTAssertEqual([array count], (NSUInteger)100000);
+    XCTAssertEqualObjects([array firstObject], @0);
+    XCTAssertEqualObjects([array objectAtIndex:54321], @54321);
+    XCTAssertEqualObjects([array lastObject], @99999);
+}
+
+- (void)testStandardGrowthPerformance
+{
+    // Reference: Standard arrays are copied for each addition (quadratic growth)
+    [self measureBlock:^{
+        [self arrayByGrowingArray:@[] toNumberOfObjects:5000];
+    }];
+}
+
+- (void)testPersistentGrowthPerformance
+{
+    [self measureBlock:^{
+        [self arrayByGrowingArray:[HLSPersistentArray array] toNumberOfObjects:5000];
+    }];
+}
+
+- (void)testLargePersistentGrowthPerformance
+{
+    // Persistent arrays grow in logarithmic time per addition. Standard arrays are not measured at this size, since
+    // this would take minutes
+    [self measureBlock:^{
+        [self arrayByGrowingArray:[HLSPersistentArray array] toNumberOfObjects:100000];
+    }];
+}
+
+@end
@@ -0,0 +1,161 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import "HLSPersistentDictionaryTestCase.h"
+
+// Keys with colliding hashes
+@interface CollidingKey : NSObject <NSCopying>
+
+- (instancetype)initWithIdentifier:(NSUInteger)identifier;
+
+@property (nonatomic, readonly, assign) NSUInteger identifier;
+
+@end
+
+@implementation CollidingKey
+
+- (instancetype)initWithIdentifier:(NSUInteger)identifier
+{
+    if (self = [super init]) {
+        _identifier = identifier;
+    }
+    return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    return self;
+}
+
+- (BOOL)isEqual:(id)object
+{
+    return [object isKindOfClass:[CollidingKey class]] && ((CollidingKey *)object).identifier == self.identifier;
+}
+
+- (NSUInteger)hash
+{
+    return self.identifier % 3;
+}
+
+@end
+
+@implementation HLSPersistentDictionaryTestCase
+
+#pragma mark Helpers
+
+// Grow a dictionary one key at a time
+- (NSDictionary *)dictionaryByGrowingDictionary:(NSDictionary *)dictionary toNumberOfKeys:(NSUInteger)numberOfKeys
+{
+    for (NSUInteger i = [dictionary count]; i < numberOfKeys; ++i) {
+        dictionary = [dictionary dictionaryBySettingObject:@(i) forKey:@(i)];
+    }
+    return dictionary;
+}
+
+#pragma mark Tests
+
+- (void)testCreation
+{
+    NSDictionary *dictionary = @{ @"key1" : @"obj1", @"key2" : @"obj2", @"key3" : @"obj3" };
+    HLSPersistentDictionary *persistentDictionary = [HLSPersistentDictionary dictionaryWithDictionary:dictionary];
+    XCTAssertEqual([persistentDictionary count], (NSUInteger)3);
+    XCTAssertEqualObjects([persistentDictionary objectForKey:@"key2"], @"obj2");
+    XCTAssertNil([persistentDictionary objectForKey:@"key4"]);
+    XCTAssertEqualObjects(persistentDictionary, dictionary);
+    XCTAssertEqualObjects([NSSet setWithArray:[persistentDictionary allKeys]], [NSSet setWithArray:[dictionary allKeys]]);
+    XCTAssertEqual([persistentDictionary copy], persistentDictionary);
+    
+    NSMutableDictionary *mutableDictionary = [persistentDictionary mutableCopy];
+    [mutableDictionary removeObjectForKey:@"key1"];
+    XCTAssertEqual([mutableDictionary count], (NSUInteger)2);
+    XCTAssertEqual([persistentDictionary count], (NSUInteger)3);
+    
+    XCTAssertEqual([[HLSPersistentDictionary dictionary] count], (NSUInteger)0);
+}
+
+- (void)testModification
+{
+    NSDictionary *dictionary1 = [HLSPersistentDictionary dictionary];
+    NSDictionary *dictionary2 = [dictionary1 dictionaryBySettingObject:@"obj1" forKey:@"key1"];
+    NSDictionary *dictionary3 = [dictionary2 dictionaryBySettingObject:@"obj2" forKey:@"key2"];
+    NSDictionary *dictionary4 = [dictionary3 dictionaryBySettingObject:@"obj1'" forKey:@"key1"];
+    NSDictionary *dictionary5 = [dictionary4 dictionaryByRemovingObjectForKey:@"key2"];
+    
+    // Earlier versions are left untouched
+    XCTAssertEqualObjects(dictionary1, @{});
+    XCTAssertEqualObjects(dictionary2, @{ @"key1" : @"obj1" });
+    XCTAssertEqualObjects(dictionary3, (@{ @"key1" : @"obj1", @"key2" : @"obj2" }));
+    XCTAssertEqualObjects(dictionary4, (@{ @"key1" : @"obj1'", @"key2" : @"obj2" }));
+    XCTAssertEqualObjects(dictionary5, @{ @"key1" : @"obj1'" });
+    
+    XCTAssertTrue([dictionary5 isKindOfClass:[HLSPersistentDictionary class]]);
+    XCTAssertEqual([dictionary5 dictionaryByRemovingObjectForKey:@"key3"], dictionary5);
+    XCTAssertEqual([[dictionary3 dictionaryByRemovingObjectsForKeys:@[@"key1", @"key2", @"key3"]] count], (NSUInteger)0);
+}
+
+- (void)testConsistency
+{
+    // Compare with a mutable dictionary, including keys with colliding hashes
+    NSMutableDictionary *referenceDictionary = [NSMutableDictionary dictionary];
+    NSDictionary *dictionary = [HLSPersistentDictionary dictionary];
+    for (NSUInteger i = 0; i < 5000; ++i) {
+        id key = (i % 10 == 0) ? [[CollidingKey alloc] initWithIdentifier:arc4random_uniform(100)] : @(arc4random_uniform(2000));
+        if (arc4random_uniform(3) == 0) {
+            [referenceDictionary removeObjectForKey:key];
+            dictionary = [dictionary dictionaryByRemovingObjectForKey:key];
+        }
+        else {
+            [referenceDictionary setObject:@(i) forKey:key];
+            dictionary = [dictionary dictionaryBySettingObject:@(i) forKey:key];
+        }
+        XCTAssertEqual([dictionary count], [referenceDictionary count]);
+    }
+    XCTAssertEqualObjects(dictionary, referenceDictionary);
+    
+    __block NSUInteger count = 0;
+    [dictionary enumerateKeysAndObjectsUsingBlock:^(id key, id object, BOOL *stop) {
+        XCTAssertEqualObjects([referenceDictionary objectForKey:key], object);
+        ++count;
+    }];
+    XCTAssertEqual(count, [referenceDictionary count]);
+}
+
+- (void)testGrowth
+{
+    NSDictionary *dictionary = [self dictionaryByGrowingDictionary:[HLSPersistentDictionary dictionary] toNumberOfKeys:100000];
+    XCTAssertTrue([dictionary isKindOfClass:[HLSPersistentDictionary class]]);
+    XCTAssertEqual([dictionary count], (NSUInteger)100000);
+    XCTAssertEqualObjects([dictionary objectForKey:@0], @0);
+    XCTAssertEqualObjects([dictionary objectForKey:@54321], @54321);
+    XCTAssertEqualObjects([dictionary objectForKey:@99999], @99999);
+    XCTAssertNil([dictionary objectForKey:@100000]);
+}
+
+- (void)testStandardGrowthPerformance
+{
+    // Reference: Standard dictionaries are copied for each addition (quadratic growth)
+    [self measureBlock:^{
+        [self dictionaryByGrowingDictionary:@{} toNumberOfKeys:5000];
+    }];
+}
+
+- (void)testPersistentGrowthPerformance
+{
+    [self measureBlock:^{
+        [self dictionaryByGrowingDictionary:[HLSPersistentDictionary dictionary] toNumberOfKeys:5000];
+    }];
+}
+
+- (void)testLargePersistentGrowthPerformance
+{
+    // Persistent dictionaries grow in logarithmic time per addition. Standard dictionaries are not measured at this
+    // size, since this would take minutes
+    [self measureBlock:^{
+        [self dictionaryByGrowingDictionary:[HLSPersistentDictionary dictionary] toNumberOfKeys:100000];
+    }];
+}
+
+@end
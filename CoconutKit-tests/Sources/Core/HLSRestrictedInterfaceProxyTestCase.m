@@ -100,6 +100,33 @@
 
 @end
 
+// Class to which methods are added at runtime
+@interface PartialInterfaceTestClass : NSObject
+
+- (NSInteger)method2;
+- (NSInteger)method3;
+
+@end
+
+@implementation PartialInterfaceTestClass
+
+- (NSInteger)method2
+{
+    return 2;
+}
+
+- (NSInteger)method3
+{
+    return 3;
+}
+
+@end
+
+static NSInteger method5(id self, SEL _cmd)
+{
+    return 5;
+}
+
 @implementation HLSRestrictedInterfaceProxyTestCase
 
 #pragma mark Tests
@@ -176,4 +203,57 @@
     XCTAssertThrows([hackerCastProxyB method1]);
 }
 
+- (void)testMethodAddedAtRuntime
+{
+    PartialInterfaceTestClass *target = [[PartialInterfaceTestClass alloc] init];
+    
+    id<CompatibleRestrictedInterfaceC> proxyC = [target proxyWithRestrictedInterface:@protocol(CompatibleRestrictedInterfaceC)];
+    XCTAssertFalse([proxyC respondsToSelector:@selector(method5)]);
+    XCTAssertThrows([proxyC method5]);
+    
+    const char *types = method_getTypeEncoding(class_getInstanceMethod([PartialInterfaceTestClass class], @selector(method2)));
+    hls_class_addMethod([PartialInterfaceTestClass class], @selector(method5), (IMP)method5, types);
+    XCTAssertTrue([proxyC respondsToSelector:@selector(method5)]);
+    XCTAssertEqual([proxyC method5], (NSInteger)5);
+}
+
+- (void)testDirectCallPerformance
+{
+    // Reference for the proxy benchmarks below
+    FullInterfaceTestClass *target = [[FullInterfaceTestClass alloc] init];
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 100000; ++i) {
+            [target method3];
+        }
+    }];
+}
+
+- (void)testProxyCallPerformance
+{
+    FullInterfaceTestClass *target = [[FullInterfaceTestClass alloc] init];
+    id<CompatibleRestrictedInterfaceB> proxyB = [target proxyWithRestrictedInterface:@protocol(CompatibleRestrictedInterfaceB)];
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 100000; ++i) {
+            [proxyB method3];
+        }
+    }];
+}
+
+- (void)testProxyRespondsToSelectorPerformance
+{
+    // Typical optional delegate method check followed by a call
+    FullInterfaceTestClass *target = [[FullInterfaceTestClass alloc] init];
+    id<CompatibleRestrictedInterfaceC> proxyC = [target proxyWithRestrictedInterface:@protocol(CompatibleRestrictedInterfaceC)];
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 100000; ++i) {
+            if ([proxyC respondsToSelector:@selector(method5)]) {
+                [proxyC method5];
+            }
+            if ([proxyC respondsToSelector:@selector(method6)]) {
+                [proxyC method6];
+            }
+        }
+    }];
+}
+
 @end
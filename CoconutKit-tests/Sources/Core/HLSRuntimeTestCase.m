@@ -1049,6 +1049,36 @@ typedef union LargeUnion_ {
 
 @end
 
+@interface RuntimeTestClass13 : NSObject
+
+- (NSInteger)value;
+- (NSInteger)otherValue;
+
+@end
+
+@implementation RuntimeTestClass13
+
+- (NSInteger)value
+{
+    return 1;
+}
+
+- (NSInteger)otherValue
+{
+    return 1;
+}
+
+@end
+
+static NSInteger (*s_RuntimeTestClass13_value)(id, SEL) = NULL;
+
+static NSInteger swizzle_RuntimeTestClass13_value(RuntimeTestClass13 *self, SEL _cmd)
+{
+    HLSSwizzleCountCall(&s_RuntimeTestClass13_value);
+    
+    return s_RuntimeTestClass13_value(self, _cmd) + 1;
+}
+
 #pragma mark Test case implementation
 
 @implementation HLSRuntimeTestCase
@@ -1367,6 +1397,55 @@ typedef union LargeUnion_ {
     XCTAssertTrue(hls_class_swizzleSelector([RuntimeTestClass11 class], NSSelectorFromString(@"unknownSelector"), nil) == NULL);
 }
 
+- (void)testSwizzleRegistry
+{
+    // CoconutKit swizzles are recorded, and +load durations as well
+    NSArray *entries = hls_swizzleRegistryEntries();
+    NSPredicate *scrollViewPredicate = [NSPredicate predicateWithFormat:@"%K == %@ AND %K == %@", HLSSwizzleGroupKey, @"UIScrollView+HLSExtensions",
+                                        HLSSwizzleSelectorNameKey, @"-setContentOffset:"];
+    NSDictionary *scrollViewEntry = [[entries filteredArrayUsingPredicate:scrollViewPredicate] firstObject];
+    XCTAssertEqualObjects([scrollViewEntry objectForKey:HLSSwizzleClassNameKey], @"UIScrollView");
+    XCTAssertNotNil([hls_swizzleGroupLoadDurations() objectForKey:@"UIScrollView+HLSExtensions"]);
+    
+    // Block swizzles made in this file are recorded as well
+    NSPredicate *classMethodPredicate = [NSPredicate predicateWithFormat:@"%K == %@ AND %K == %@", HLSSwizzleClassNameKey, @"RuntimeTestClass10",
+                                         HLSSwizzleSelectorNameKey, @"+classString"];
+    NSDictionary *classMethodEntry = [[entries filteredArrayUsingPredicate:classMethodPredicate] firstObject];
+    XCTAssertEqualObjects([classMethodEntry objectForKey:HLSSwizzleGroupKey], @"HLSRuntimeTestCase");
+    
+    // Disabled groups
+    hls_setSwizzleGroupEnabled("RuntimeTestGroup", NO);
+    XCTAssertFalse(hls_isSwizzleGroupEnabled("RuntimeTestGroup"));
+    XCTAssertFalse(hls_isSwizzleGroupEnabled("/path/to/RuntimeTestGroup.m"));
+    XCTAssertTrue(hls_class_swizzleSelectorInGroup([RuntimeTestClass13 class], @selector(otherValue), (IMP)swizzle_RuntimeTestClass13_value, "RuntimeTestGroup", NULL) == NULL);
+    XCTAssertEqual([[RuntimeTestClass13 new] otherValue], 1);
+    hls_setSwizzleGroupEnabled("RuntimeTestGroup", YES);
+    XCTAssertTrue(hls_isSwizzleGroupEnabled("RuntimeTestGroup"));
+}
+
+- (void)testSwizzleCallCounting
+{
+    HLSSwizzleSelector([RuntimeTestClass13 class], @selector(value), swizzle_RuntimeTestClass13_value, &s_RuntimeTestClass13_value);
+    
+    NSPredicate *predicate = [NSPredicate predicateWithFormat:@"%K == %@", HLSSwizzleClassNameKey, @"RuntimeTestClass13"];
+    
+    // Not counted
+    RuntimeTestClass13 *object = [[RuntimeTestClass13 alloc] init];
+    XCTAssertEqual([object value], 2);
+    XCTAssertEqualObjects([[[hls_swizzleRegistryEntries() filteredArrayUsingPredicate:predicate] firstObject] objectForKey:HLSSwizzleCallCountKey], @0);
+    
+    hls_setSwizzleCallCountingEnabled(YES);
+    for (NSUInteger i = 0; i < 10; ++i) {
+        [object value];
+    }
+    hls_setSwizzleCallCountingEnabled(NO);
+    
+    NSDictionary *entry = [[hls_swizzleRegistryEntries() filteredArrayUsingPredicate:predicate] firstObject];
+    XCTAssertEqualObjects([entry objectForKey:HLSSwizzleSelectorNameKey], @"-value");
+    XCTAssertEqualObjects([entry objectForKey:HLSSwizzleGroupKey], @"HLSRuntimeTestCase");
+    XCTAssertEqualObjects([entry objectForKey:HLSSwizzleCallCountKey], @10);
+}
+
 - (void)testClassIsSubclassOfClass
 {
     XCTAssertTrue(hls_class_isSubclassOfClass([UIView class], [NSObject class]));
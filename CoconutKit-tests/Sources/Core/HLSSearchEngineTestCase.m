@@ -0,0 +1,155 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import "HLSSearchEngineTestCase.h"
+
+static const NSUInteger kBenchmarkItemCount = 100000;
+
+@implementation HLSSearchEngineTestCase
+
+#pragma mark Class methods
+
++ (NSArray *)items
+{
+    NSMutableArray *items = [NSMutableArray arrayWithCapacity:kBenchmarkItemCount];
+    for (NSUInteger i = 0; i < kBenchmarkItemCount; ++i) {
+        [items addObject:[NSString stringWithFormat:@"Item %@", @(i)]];
+    }
+    return [NSArray arrayWithArray:items];
+}
+
++ (HLSSearchEngineFilterBlock)containsFilterBlock
+{
+    return ^(NSString *item, NSString *searchString, NSInteger scope) {
+        return (BOOL)([searchString length] == 0 || [item rangeOfString:searchString options:NSCaseInsensitiveSearch].location != NSNotFound);
+    };
+}
+
+#pragma mark Tests
+
+- (void)testSearch
+{
+    HLSSearchEngine *searchEngine = [[HLSSearchEngine alloc] initWithObjects:@[@"apple", @"banana", @"apricot", @"cherry"]
+                                                                 filterBlock:[HLSSearchEngineTestCase containsFilterBlock]];
+    searchEngine.delay = 0.;
+    XCTAssertEqualObjects(searchEngine.results, (@[@"apple", @"banana", @"apricot", @"cherry"]));
+    
+    XCTestExpectation *expectation1 = [self expectationWithDescription:@"Search finished"];
+    [searchEngine searchForString:@"ap" scope:0 completionBlock:^(NSArray *results, NSIndexSet *deletedIndexes, NSIndexSet *insertedIndexes) {
+        XCTAssertTrue([NSThread isMainThread]);
+        XCTAssertEqualObjects(results, (@[@"apple", @"apricot"]));
+        XCTAssertEqualObjects(deletedIndexes, ([NSIndexSet indexSetWithIndexesInRange:NSMakeRange(1, 1)]));
+        XCTAssertEqual([insertedIndexes count], (NSUInteger)0);
+        [expectation1 fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10. handler:nil];
+    XCTAssertEqualObjects(searchEngine.searchString, @"ap");
+    XCTAssertFalse(searchEngine.searching);
+    
+    // Indexes are positions within the previous, respectively new results
+    XCTestExpectation *expectation2 = [self expectationWithDescription:@"Search finished"];
+    [searchEngine searchForString:@"an" scope:0 completionBlock:^(NSArray *results, NSIndexSet *deletedIndexes, NSIndexSet *insertedIndexes) {
+        XCTAssertEqualObjects(results, (@[@"banana"]));
+        XCTAssertEqualObjects(deletedIndexes, ([NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 2)]));
+        XCTAssertEqualObjects(insertedIndexes, [NSIndexSet indexSetWithIndex:0]);
+        [expectation2 fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10. handler:nil];
+}
+
+- (void)testDebouncing
+{
+    HLSSearchEngine *searchEngine = [[HLSSearchEngine alloc] initWithObjects:[HLSSearchEngineTestCase items]
+                                                                 filterBlock:[HLSSearchEngineTestCase containsFilterBlock]];
+    searchEngine.delay = 0.1;
+    
+    // Only the last query completes
+    __block NSUInteger completionCount = 0;
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Search finished"];
+    for (NSString *searchString in @[@"1", @"12", @"123"]) {
+        [searchEngine searchForString:searchString scope:0 completionBlock:^(NSArray *results, NSIndexSet *deletedIndexes, NSIndexSet *insertedIndexes) {
+            ++completionCount;
+            XCTAssertEqualObjects(searchString, @"123");
+            [expectation fulfill];
+        }];
+        XCTAssertTrue(searchEngine.searching);
+    }
+    [self waitForExpectationsWithTimeout:10. handler:nil];
+    XCTAssertEqual(completionCount, (NSUInteger)1);
+}
+
+- (void)testRefinementAndScope
+{
+    // Scope 1 only matches even items
+    HLSSearchEngine *searchEngine = [[HLSSearchEngine alloc] initWithObjects:@[@"a1", @"a2", @"a3", @"a4", @"b1"] filterBlock:^(NSString *item, NSString *searchString, NSInteger scope) {
+        if (scope == 1 && [[item substringFromIndex:1] integerValue] % 2 != 0) {
+            return NO;
+        }
+        return [item hasPrefix:searchString];
+    }];
+    searchEngine.delay = 0.;
+    
+    NSArray *queries = @[@[@"a", @0], @[@"a", @1], @[@"a4", @1], @[@"b", @1], @[@"b", @0]];
+    NSArray *expectedResults = @[@[@"a1", @"a2", @"a3", @"a4"], @[@"a2", @"a4"], @[@"a4"], @[], @[@"b1"]];
+    [queries enumerateObjectsUsingBlock:^(NSArray *query, NSUInteger idx, BOOL *stop) {
+        XCTestExpectation *expectation = [self expectationWithDescription:@"Search finished"];
+        [searchEngine searchForString:[query firstObject] scope:[[query lastObject] integerValue] completionBlock:^(NSArray *results, NSIndexSet *deletedIndexes, NSIndexSet *insertedIndexes) {
+            XCTAssertEqualObjects(results, [expectedResults objectAtIndex:idx]);
+            [expectation fulfill];
+        }];
+        [self waitForExpectationsWithTimeout:10. handler:nil];
+    }];
+}
+
+- (void)testCancel
+{
+    HLSSearchEngine *searchEngine = [[HLSSearchEngine alloc] initWithObjects:[HLSSearchEngineTestCase items]
+                                                                 filterBlock:[HLSSearchEngineTestCase containsFilterBlock]];
+    searchEngine.delay = 0.;
+    [searchEngine searchForString:@"1" scope:0 completionBlock:^(NSArray *results, NSIndexSet *deletedIndexes, NSIndexSet *insertedIndexes) {
+        XCTFail(@"Cancelled searches must not complete");
+    }];
+    [searchEngine cancel];
+    XCTAssertFalse(searchEngine.searching);
+    
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.5]];
+    XCTAssertEqual([searchEngine.results count], kBenchmarkItemCount);
+    XCTAssertNil(searchEngine.searchString);
+}
+
+- (void)testSynchronousFilteringPerformance
+{
+    // Reference: Filter all items for each keystroke, as subclasses of HLSTableSearchDisplayViewController usually do
+    NSArray *items = [HLSSearchEngineTestCase items];
+    HLSSearchEngineFilterBlock filterBlock = [HLSSearchEngineTestCase containsFilterBlock];
+    [self measureBlock:^{
+        for (NSString *searchString in @[@"1", @"12", @"123", @"1234"]) {
+            NSIndexSet *indexes = [items indexesOfObjectsPassingTest:^BOOL(NSString *item, NSUInteger idx, BOOL *stop) {
+                return filterBlock(item, searchString, 0);
+            }];
+            XCTAssertTrue([indexes count] > 0);
+        }
+    }];
+}
+
+- (void)testSearchEnginePerformance
+{
+    // Incremental refinement: Only the previous results are filtered again for each keystroke
+    NSArray *items = [HLSSearchEngineTestCase items];
+    [self measureBlock:^{
+        HLSSearchEngine *searchEngine = [[HLSSearchEngine alloc] initWithObjects:items filterBlock:[HLSSearchEngineTestCase containsFilterBlock]];
+        searchEngine.delay = 0.;
+        for (NSString *searchString in @[@"1", @"12", @"123", @"1234"]) {
+            XCTestExpectation *expectation = [self expectationWithDescription:@"Search finished"];
+            [searchEngine searchForString:searchString scope:0 completionBlock:^(NSArray *results, NSIndexSet *deletedIndexes, NSIndexSet *insertedIndexes) {
+                [expectation fulfill];
+            }];
+            [self waitForExpectationsWithTimeout:10. handler:nil];
+        }
+    }];
+}
+
+@end
@@ -0,0 +1,85 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import "NSBundle+HLSExtensionsTestCase.h"
+
+@implementation NSBundle_HLSExtensionsTestCase
+
+#pragma mark Class methods
+
++ (NSString *)rootFolderPath
+{
+    return [HLSApplicationDocumentDirectoryPath() stringByAppendingPathComponent:@"bundleTests"];
+}
+
+#pragma mark Setup and teardown
+
+- (void)setUp
+{
+    [super setUp];
+    
+    NSString *rootFolderPath = [NSBundle_HLSExtensionsTestCase rootFolderPath];
+    if ([[NSFileManager defaultManager] fileExistsAtPath:rootFolderPath]) {
+        [[NSFileManager defaultManager] removeItemAtPath:rootFolderPath error:NULL];
+    }
+    [[NSFileManager defaultManager] createDirectoryAtPath:rootFolderPath withIntermediateDirectories:YES attributes:nil error:NULL];
+    [NSBundle invalidateBundleCache];
+}
+
+- (void)tearDown
+{
+    [super tearDown];
+    
+    [[NSFileManager defaultManager] removeItemAtPath:[NSBundle_HLSExtensionsTestCase rootFolderPath] error:NULL];
+    [NSBundle invalidateBundleCache];
+}
+
+#pragma mark Tests
+
+- (void)testBundleWithName
+{
+    XCTAssertEqualObjects([NSBundle bundleWithName:nil], [NSBundle mainBundle]);
+    XCTAssertNil([NSBundle bundleWithName:@"DownloadedBundle"]);
+    
+    // Misses are cached. The cache must be invalidated for bundles added at runtime to be found
+    NSString *bundlePath = [[NSBundle_HLSExtensionsTestCase rootFolderPath] stringByAppendingPathComponent:@"Nested/DownloadedBundle.bundle"];
+    [[NSFileManager defaultManager] createDirectoryAtPath:bundlePath withIntermediateDirectories:YES attributes:nil error:NULL];
+    XCTAssertNil([NSBundle bundleWithName:@"DownloadedBundle"]);
+    
+    [self expectationForNotification:HLSBundleCacheDidInvalidateNotification object:nil handler:nil];
+    [NSBundle invalidateBundleCache];
+    [self waitForExpectationsWithTimeout:1. handler:nil];
+    
+    NSBundle *bundle = [NSBundle bundleWithName:@"DownloadedBundle"];
+    XCTAssertNotNil(bundle);
+    XCTAssertEqualObjects([[bundle bundlePath] lastPathComponent], @"DownloadedBundle.bundle");
+    XCTAssertEqualObjects([NSBundle bundleWithName:@"DownloadedBundle.bundle"], bundle);
+}
+
+- (void)testBundleWithNameInLargeDirectoryPerformance
+{
+    // Synthetic Documents tree containing 50'000 files
+    NSString *rootFolderPath = [NSBundle_HLSExtensionsTestCase rootFolderPath];
+    for (NSUInteger i = 0; i < 500; ++i) {
+        NSString *folderPath = [rootFolderPath stringByAppendingPathComponent:[NSString stringWithFormat:@"Folder%@", @(i)]];
+        [[NSFileManager defaultManager] createDirectoryAtPath:folderPath withIntermediateDirectories:YES attributes:nil error:NULL];
+        for (NSUInteger j = 0; j < 100; ++j) {
+            NSString *filePath = [folderPath stringByAppendingPathComponent:[NSString stringWithFormat:@"File%@.txt", @(j)]];
+            [[NSFileManager defaultManager] createFileAtPath:filePath contents:nil attributes:nil];
+        }
+    }
+    
+    // Repeated lookups of missing bundles, as made when relocalizing labels referencing them. Each miss used to
+    // trigger six recursive directory enumerations
+    [self measureBlock:^{
+        [NSBundle invalidateBundleCache];
+        for (NSUInteger i = 0; i < 100; ++i) {
+            XCTAssertNil([NSBundle bundleWithName:[NSString stringWithFormat:@"MissingBundle%@", @(i % 10)]]);
+        }
+    }];
+}
+
+@end
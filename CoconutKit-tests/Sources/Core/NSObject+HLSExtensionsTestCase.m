@@ -6,6 +6,51 @@
 
 #import "NSObject+HLSExtensionsTestCase.h"
 
+@protocol OptionalMethodsTestProtocolA <NSObject>
+
+@optional
+
+- (void)methodA1;
+- (void)methodA2;
+
+@end
+
+@protocol OptionalMethodsTestProtocolB <NSObject>
+
+@optional
+
+- (void)methodB;
+
+@end
+
+@interface OptionalMethodsTestClass : NSObject <OptionalMethodsTestProtocolA, OptionalMethodsTestProtocolB>
+
+@end
+
+@implementation OptionalMethodsTestClass
+
+- (void)methodA1
+{
+}
+
+- (void)methodA2
+{
+}
+
+@end
+
+@interface OptionalMethodsTestSubclass : OptionalMethodsTestClass
+
+@end
+
+@implementation OptionalMethodsTestSubclass
+
+@end
+
+static void methodB(id self, SEL _cmd)
+{
+}
+
 @implementation NSObject_HLSExtensionsTestCase
 
 #pragma mark Tests
@@ -18,4 +63,92 @@
     XCTAssertEqualObjects([self className], @"NSObject_HLSExtensionsTestCase");
 }
 
+- (void)testImplementsProtocol
+{
+    OptionalMethodsTestClass *object = [[OptionalMethodsTestClass alloc] init];
+    
+    // Check twice, the second time from the cache
+    for (NSUInteger i = 0; i < 2; ++i) {
+        XCTAssertTrue([object implementsProtocol:@protocol(OptionalMethodsTestProtocolA)]);
+        XCTAssertFalse([object implementsProtocol:@protocol(OptionalMethodsTestProtocolB)]);
+        XCTAssertTrue([object implementsProtocol:@protocol(NSObject)]);
+        XCTAssertFalse([[NSObject new] implementsProtocol:@protocol(OptionalMethodsTestProtocolA)]);
+    }
+}
+
+- (void)testImplementsProtocols
+{
+    OptionalMethodsTestClass *object = [[OptionalMethodsTestClass alloc] init];
+    XCTAssertTrue([object implementsProtocols:@[]]);
+    XCTAssertTrue([object implementsProtocols:@[@protocol(OptionalMethodsTestProtocolA), @protocol(NSObject)]]);
+    XCTAssertFalse([object implementsProtocols:@[@protocol(OptionalMethodsTestProtocolA), @protocol(OptionalMethodsTestProtocolB)]]);
+}
+
+- (void)testImplementsProtocolAfterMethodAddition
+{
+    // Use the subclass so that other tests are not affected
+    OptionalMethodsTestSubclass *object = [[OptionalMethodsTestSubclass alloc] init];
+    XCTAssertFalse([object implementsProtocol:@protocol(OptionalMethodsTestProtocolB)]);
+    
+    int32_t generation = hls_methodListsGeneration();
+    XCTAssertTrue(hls_class_addMethod([OptionalMethodsTestSubclass class], @selector(methodB), (IMP)methodB, "v@:"));
+    XCTAssertNotEqual(hls_methodListsGeneration(), generation);
+    
+    XCTAssertTrue([object implementsProtocol:@protocol(OptionalMethodsTestProtocolB)]);
+    XCTAssertTrue([object implementsProtocols:@[@protocol(OptionalMethodsTestProtocolA), @protocol(OptionalMethodsTestProtocolB)]]);
+}
+
+- (void)testImplementsProtocolAfterClassDisposal
+{
+    static const char *kClassName = "NSObject_HLSExtensionsTestCase_RuntimeClass";
+    
+    // Runtime class implementing all methods of protocol B
+    Class class1 = objc_allocateClassPair([OptionalMethodsTestClass class], kClassName, 0);
+    class_addMethod(class1, @selector(methodB), (IMP)methodB, "v@:");
+    objc_registerClassPair(class1);
+    
+    @autoreleasepool {
+        id object1 = [[class1 alloc] init];
+        XCTAssertTrue([object1 implementsProtocol:@protocol(OptionalMethodsTestProtocolB)]);
+    }
+    
+    int32_t generation = hls_methodListsGeneration();
+    hls_objc_disposeClassPair(class1);
+    XCTAssertNotEqual(hls_methodListsGeneration(), generation);
+    
+    // A class created afterwards (possibly at the same address) must not be served the result cached for the disposed class
+    Class class2 = objc_allocateClassPair([OptionalMethodsTestClass class], kClassName, 0);
+    objc_registerClassPair(class2);
+    
+    @autoreleasepool {
+        id object2 = [[class2 alloc] init];
+        XCTAssertFalse([object2 implementsProtocol:@protocol(OptionalMethodsTestProtocolB)]);
+    }
+    
+    hls_objc_disposeClassPair(class2);
+}
+
+- (void)testImplementsProtocolPerformance
+{
+    // Typical delegate check made for each displayed cell
+    OptionalMethodsTestClass *object = [[OptionalMethodsTestClass alloc] init];
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 100000; ++i) {
+            [object implementsProtocol:@protocol(UITableViewDataSource)];
+            [object implementsProtocol:@protocol(OptionalMethodsTestProtocolA)];
+        }
+    }];
+}
+
+- (void)testImplementsProtocolsPerformance
+{
+    OptionalMethodsTestClass *object = [[OptionalMethodsTestClass alloc] init];
+    NSArray *protocols = @[@protocol(OptionalMethodsTestProtocolA), @protocol(NSObject), @protocol(OptionalMethodsTestProtocolB)];
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 100000; ++i) {
+            [object implementsProtocols:protocols];
+        }
+    }];
+}
+
 @end
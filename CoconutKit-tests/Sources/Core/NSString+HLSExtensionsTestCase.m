@@ -6,8 +6,40 @@
 
 #import "NSString+HLSExtensionsTestCase.h"
 
+#import <MobileCoreServices/MobileCoreServices.h>
+
+static const NSUInteger kBenchmarkIterationCount = 100000;
+
 @implementation NSString_HLSExtensionsTestCase
 
+#pragma mark Helpers
+
+// Former -isFilled implementation, for benchmarks
+- (BOOL)isStringFilledByTrimming:(NSString *)string
+{
+    return [[string stringByTrimmingWhitespaces] length] != 0;
+}
+
+// Former -MIMEType implementation, for benchmarks
+- (NSString *)uncachedMIMETypeForPath:(NSString *)path
+{
+    CFStringRef identifier = UTTypeCreatePreferredIdentifierForTag(kUTTagClassFilenameExtension, (__bridge CFStringRef)[path pathExtension], NULL);
+    if (! identifier) {
+        return nil;
+    }
+    
+    NSString *MIMEType = (NSString *)CFBridgingRelease(UTTypeCopyPreferredTagWithClass(identifier, kUTTagClassMIMEType));
+    CFRelease(identifier);
+    return MIMEType;
+}
+
+- (NSArray *)benchmarkStrings
+{
+    NSString *longWhitespaceString = [@"" stringByPaddingToLength:200 withString:@" \t" startingAtIndex:0];
+    return @[@"", @"   ", @"abc", @"   Hello, World!   ", longWhitespaceString,
+             [longWhitespaceString stringByAppendingString:@"x"], [NSMutableString stringWithString:@"  \u00e9t\u00e9  "]];
+}
+
 #pragma mark Tests
 
 - (void)testTrim
@@ -18,6 +50,19 @@
     XCTAssertFalse([@"" isFilled]);
     XCTAssertFalse([@"     \t  " isFilled]);
     XCTAssertTrue([@"  abc  " isFilled]);
+    
+    // Strings whose characters cannot be accessed directly, longer than the scan buffer
+    NSString *longWhitespaceString = [@"" stringByPaddingToLength:1000 withString:@"\u00a0 \t" startingAtIndex:0];
+    XCTAssertFalse([longWhitespaceString isFilled]);
+    XCTAssertTrue([[longWhitespaceString stringByAppendingString:@"\u00e9"] isFilled]);
+    XCTAssertTrue([[longWhitespaceString stringByAppendingString:@"\U0001F600"] isFilled]);
+    XCTAssertFalse([[NSMutableString stringWithString:longWhitespaceString] isFilled]);
+    XCTAssertTrue([[NSMutableString stringWithFormat:@"%@%@", longWhitespaceString, @"a"] isFilled]);
+    
+    // Same results as when trimming
+    for (NSString *string in [self benchmarkStrings]) {
+        XCTAssertEqual([string isFilled], [self isStringFilledByTrimming:string]);
+    }
 }
 
 - (void)testHashMethods
@@ -69,6 +114,17 @@
     
     NSString *encodedStringReference = @"%01%02%03%04%05%06%07%08%09%0A%0B%0C%0D%0E%0F%10%11%12%13%14%15%16%17%18%19%1A%1B%1C%1D%1E%1F%20%21%22%23%24%25%26%27%28%29%2A%2B%2C-.%2F0123456789%3A%3B%3C%3D%3E%3F%40ABCDEFGHIJKLMNOPQRSTUVWXYZ%5B%5C%5D%5E_%60abcdefghijklmnopqrstuvwxyz%7B%7C%7D~%7F%C4%A8%C4%A9%C4%B0%C4%B1%C4%B2%C4%B3%C4%B4%C4%B5%C4%B6%C4%B7%C4%B8%C4%B9%C5%80%C5%81%C5%82%C5%83%C5%84%C5%85%C5%86%C5%87%C5%88%C5%89%C5%90%C5%91%C5%92%C5%93%C5%94%C5%95%C5%96%C5%97%C5%98%C5%99%C5%A0%C5%A1%C5%A2%C5%A3%C5%A4%C5%A5%C5%A6%C5%A7%C5%A8%C5%A9%C5%B0%C5%B1%C5%B2%C5%B3%C5%B4%C5%B5%C5%B6%C5%B7%C5%B8%C5%B9%C6%80%C6%81%C6%82%C6%83%C6%84%C6%85%C6%86%C6%87%C6%88%C6%89%C6%90%C6%91%C6%92%C6%93%C6%94%C6%95%C6%96%C6%97%C6%98%C6%99%C8%80%C8%81%C8%82%C8%83%C8%84%C8%85%C8%86%C8%87%C8%88%C8%89%C8%90%C8%91%C8%92%C8%93%C8%94%C8%95%C8%96%C8%97%C8%98%C8%99%C8%A0%C8%A1%C8%A2%C8%A3%C8%A4%C8%A5%C8%A6%C8%A7%C8%A8%C8%A9%C8%B0%C8%B1%C8%B2%C8%B3%C8%B4%C8%B5%C8%B6%C8%B7%C8%B8%C8%B9%C9%80%C9%81%C9%82%C9%83%C9%84%C9%85%C9%86%C9%87%C9%88%C9%89%C9%90%C9%91%C9%92%C9%93%C9%94%C9%95";
     XCTAssertEqualObjects([string urlEncodedStringUsingEncoding:NSUTF8StringEncoding], encodedStringReference);
+    
+    // Batch encoding yields the same results
+    NSArray *strings = @[string, @"", @"Hello, World!", @"\u00e9t\u00e9", string];
+    NSArray *urlEncodedStrings = [NSString urlEncodedStringsWithStrings:strings usingEncoding:NSUTF8StringEncoding];
+    XCTAssertEqual([urlEncodedStrings count], [strings count]);
+    for (NSUInteger i = 0; i < [strings count]; ++i) {
+        XCTAssertEqualObjects([urlEncodedStrings objectAtIndex:i], [[strings objectAtIndex:i] urlEncodedStringUsingEncoding:NSUTF8StringEncoding]);
+    }
+    
+    // Strings which cannot be encoded
+    XCTAssertEqualObjects([NSString urlEncodedStringsWithStrings:@[@"\u00e9t\u00e9"] usingEncoding:NSASCIIStringEncoding], @[[NSNull null]]);
 }
 
 - (void)testMIMEType
@@ -81,6 +137,80 @@
     XCTAssertEqualObjects([@"/path/to/file.TXT" MIMEType], @"text/plain");
     XCTAssertEqualObjects([@"/path/to/file.pdf" MIMEType], @"application/pdf");
     XCTAssertEqualObjects([@"/path/to/file.PDF" MIMEType], @"application/pdf");
+    
+    // Cached results
+    XCTAssertEqualObjects([@"/path/to/other_file.png" MIMEType], @"image/png");
+    XCTAssertNil([@"/path/to/file" MIMEType]);
+    XCTAssertNil([@"/path/to/file" MIMEType]);
+}
+
+- (void)testIsFilledByTrimmingPerformance
+{
+    // Reference: Former implementation
+    NSArray *strings = [self benchmarkStrings];
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < kBenchmarkIterationCount; ++i) {
+            [self isStringFilledByTrimming:[strings objectAtIndex:i % [strings count]]];
+        }
+    }];
+}
+
+- (void)testIsFilledPerformance
+{
+    NSArray *strings = [self benchmarkStrings];
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < kBenchmarkIterationCount; ++i) {
+            [[strings objectAtIndex:i % [strings count]] isFilled];
+        }
+    }];
+}
+
+- (void)testUncachedMIMETypePerformance
+{
+    // Reference: Former implementation
+    NSArray *paths = @[@"file.png", @"file.jpg", @"file.pdf", @"file.txt", @"file.html"];
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < kBenchmarkIterationCount / 10; ++i) {
+            [self uncachedMIMETypeForPath:[paths objectAtIndex:i % [paths count]]];
+        }
+    }];
+}
+
+- (void)testMIMETypePerformance
+{
+    NSArray *paths = @[@"file.png", @"file.jpg", @"file.pdf", @"file.txt", @"file.html"];
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < kBenchmarkIterationCount / 10; ++i) {
+            [[paths objectAtIndex:i % [paths count]] MIMEType];
+        }
+    }];
+}
+
+- (void)testURLEncodingPerformance
+{
+    // Reference: Strings encoded one by one
+    NSMutableArray *strings = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 1000; ++i) {
+        [strings addObject:[NSString stringWithFormat:@"name=value %@ & \u00e9t\u00e9/%@", @(i), @(i * i)]];
+    }
+    
+    [self measureBlock:^{
+        for (NSString *string in strings) {
+            [string urlEncodedStringUsingEncoding:NSUTF8StringEncoding];
+        }
+    }];
+}
+
+- (void)testBatchURLEncodingPerformance
+{
+    NSMutableArray *strings = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 1000; ++i) {
+        [strings addObject:[NSString stringWithFormat:@"name=value %@ & \u00e9t\u00e9/%@", @(i), @(i * i)]];
+    }
+    
+    [self measureBlock:^{
+        [NSString urlEncodedStringsWithStrings:strings usingEncoding:NSUTF8StringEncoding];
+    }];
 }
 
 @end
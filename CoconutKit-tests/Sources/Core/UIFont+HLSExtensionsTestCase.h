@@ -0,0 +1,8 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+@interface UIFont_HLSExtensionsTestCase : XCTestCase
+@end
@@ -0,0 +1,118 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import "UIFont+HLSExtensionsTestCase.h"
+
+#import "NSBundle+Tests.h"
+
+// Fonts are registered for the whole process. Each test therefore uses its own font file
+
+@implementation UIFont_HLSExtensionsTestCase
+
+#pragma mark Helpers
+
++ (NSDictionary *)fontRegistryEntryForFileName:(NSString *)fileName
+{
+    for (NSDictionary *fontRegistryEntry in [UIFont fontRegistryEntries]) {
+        if ([[[fontRegistryEntry objectForKey:HLSFontFilePathKey] lastPathComponent] isEqualToString:fileName]) {
+            return fontRegistryEntry;
+        }
+    }
+    return nil;
+}
+
+#pragma mark Tests
+
+- (void)testLazyRegistration
+{
+    [UIFont declareFontWithName:@"Lato-Regular" fileName:@"Lato-Regular.ttf" inBundle:[NSBundle testBundle]];
+    XCTAssertEqual([UIFont registrationStatusForFontWithName:@"Lato-Regular"], HLSFontRegistrationStatusDeclared);
+    
+    // Other fonts do not trigger registration
+    XCTAssertNotNil([UIFont fontWithName:@"Helvetica" size:12.f]);
+    XCTAssertEqual([UIFont registrationStatusForFontWithName:@"Lato-Regular"], HLSFontRegistrationStatusDeclared);
+    
+    UIFont *font = [UIFont fontWithName:@"Lato-Regular" size:12.f];
+    XCTAssertNotNil(font);
+    XCTAssertEqualObjects(font.fontName, @"Lato-Regular");
+    XCTAssertEqual([UIFont registrationStatusForFontWithName:@"Lato-Regular"], HLSFontRegistrationStatusRegistered);
+    
+    NSDictionary *fontRegistryEntry = [UIFont_HLSExtensionsTestCase fontRegistryEntryForFileName:@"Lato-Regular.ttf"];
+    XCTAssertEqualObjects([fontRegistryEntry objectForKey:HLSFontNameKey], @"Lato-Regular");
+    XCTAssertEqualObjects([fontRegistryEntry objectForKey:HLSFontRegistrationStatusKey], @(HLSFontRegistrationStatusRegistered));
+    XCTAssertTrue([[fontRegistryEntry objectForKey:HLSFontRegistrationDurationKey] doubleValue] > 0.);
+}
+
+- (void)testBackgroundRegistration
+{
+    [UIFont declareFontWithName:@"Lato-LightItalic" fileName:@"Lato-LightItalic.ttf" inBundle:[NSBundle testBundle]];
+    XCTAssertEqual([UIFont registrationStatusForFontWithName:@"Lato-LightItalic"], HLSFontRegistrationStatusDeclared);
+    
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Fonts registered"];
+    [UIFont registerDeclaredFontsInBackgroundWithCompletionBlock:^{
+        XCTAssertTrue([NSThread isMainThread]);
+        [expectation fulfill];
+    }];
+    
+    // Lookups of fonts which are not pending do not wait for the registration to complete
+    XCTAssertNotNil([UIFont fontWithName:@"Helvetica" size:12.f]);
+    
+    [self waitForExpectationsWithTimeout:10. handler:nil];
+    
+    XCTAssertEqual([UIFont registrationStatusForFontWithName:@"Lato-LightItalic"], HLSFontRegistrationStatusRegistered);
+    XCTAssertNotNil([UIFont fontWithName:@"Lato-LightItalic" size:12.f]);
+}
+
+- (void)testFailedRegistration
+{
+    [UIFont declareFontWithName:@"HLSNotAFont" fileName:@"Sample.txt" inBundle:[NSBundle testBundle]];
+    XCTAssertEqual([UIFont registrationStatusForFontWithName:@"HLSNotAFont"], HLSFontRegistrationStatusDeclared);
+    
+    XCTAssertNil([UIFont fontWithName:@"HLSNotAFont" size:12.f]);
+    XCTAssertEqual([UIFont registrationStatusForFontWithName:@"HLSNotAFont"], HLSFontRegistrationStatusFailed);
+    
+    // Not retried
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Fonts registered"];
+    [UIFont registerDeclaredFontsInBackgroundWithCompletionBlock:^{
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10. handler:nil];
+    XCTAssertEqual([UIFont registrationStatusForFontWithName:@"HLSNotAFont"], HLSFontRegistrationStatusFailed);
+}
+
+- (void)testDeclaredNameMismatch
+{
+    // Declared with a name which is not the PostScript name of the font
+    [UIFont declareFontWithName:@"Lato-Thin" fileName:@"Lato-Light.ttf" inBundle:[NSBundle testBundle]];
+    XCTAssertEqual([UIFont registrationStatusForFontWithName:@"Lato-Thin"], HLSFontRegistrationStatusDeclared);
+    XCTAssertEqual([UIFont registrationStatusForFontWithName:@"Lato-Light"], HLSFontRegistrationStatusEnumEnd);
+    
+    // The declared name triggers registration, but no font bears this name
+    XCTAssertNil([UIFont fontWithName:@"Lato-Thin" size:12.f]);
+    XCTAssertEqual([UIFont registrationStatusForFontWithName:@"Lato-Thin"], HLSFontRegistrationStatusRegistered);
+    
+    // The font is available under its PostScript name
+    XCTAssertEqual([UIFont registrationStatusForFontWithName:@"Lato-Light"], HLSFontRegistrationStatusRegistered);
+    XCTAssertNotNil([UIFont fontWithName:@"Lato-Light" size:12.f]);
+}
+
+- (void)testDeduplication
+{
+    // Fonts are identified by their PostScript name, and registered once
+    XCTAssertTrue([UIFont loadFontWithFileName:@"SourceCodePro-Regular.ttf" inBundle:[NSBundle testBundle]]);
+    XCTAssertTrue([UIFont loadFontWithFileName:@"SourceCodePro-Regular.ttf" inBundle:[NSBundle testBundle]]);
+    
+    NSString *filePath = [[NSBundle testBundle] pathForResource:@"SourceCodePro-Regular" ofType:@"ttf"];
+    XCTAssertTrue([UIFont loadFontWithData:[NSData dataWithContentsOfFile:filePath]]);
+    XCTAssertEqual([UIFont registrationStatusForFontWithName:@"SourceCodePro-Regular"], HLSFontRegistrationStatusRegistered);
+    
+    // A font registered by other means is immediately considered registered when declared
+    [UIFont declareFontWithName:@"SourceCodePro-Regular" fileName:@"SourceCodePro-Regular.ttf" inBundle:[NSBundle testBundle]];
+    XCTAssertEqual([UIFont registrationStatusForFontWithName:@"SourceCodePro-Regular"], HLSFontRegistrationStatusRegistered);
+    XCTAssertNotNil([UIFont fontWithName:@"SourceCodePro-Regular" size:12.f]);
+}
+
+@end
@@ -0,0 +1,211 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import "HLSFetchResultCacheTestCase.h"
+
+#import "BankAccount.h"
+#import "House.h"
+#import "NSBundle+Tests.h"
+#import "Person.h"
+
+static const NSUInteger kPersonCount = 1000;
+static const NSUInteger kFetchCount = 1000;
+static const NSUInteger kFetchesPerEdit = 20;
+
+@interface HLSFetchResultCacheTestCase ()
+
+@property (nonatomic, strong) HLSModelManager *modelManager;
+
+@end
+
+@implementation HLSFetchResultCacheTestCase
+
+#pragma mark Test setup and tear down
+
+- (void)setUp
+{
+    [super setUp];
+    
+    NSString *storeDirectory = [NSTemporaryDirectory() stringByAppendingPathComponent:@"FetchResultCache"];
+    [[NSFileManager defaultManager] removeItemAtPath:storeDirectory error:NULL];
+    [[NSFileManager defaultManager] createDirectoryAtPath:storeDirectory withIntermediateDirectories:YES attributes:nil error:NULL];
+    
+    self.modelManager = [HLSModelManager SQLiteManagerWithModelFileName:@"CoconutKitTestData"
+                                                               inBundle:[NSBundle testBundle]
+                                                          configuration:nil
+                                                         storeDirectory:storeDirectory
+                                                            fileManager:nil
+                                                                options:nil];
+    [HLSModelManager pushModelManager:self.modelManager];
+    
+    for (NSUInteger i = 0; i < kPersonCount; ++i) {
+        Person *person = [Person insert];
+        person.firstName = [NSString stringWithFormat:@"Person %@", @(i)];
+        person.lastName = @"Soprano";
+        
+        BankAccount *bankAccount = [BankAccount insert];
+        bankAccount.name = @"Account";
+        bankAccount.balanceValue = i;
+        bankAccount.owner = person;
+    }
+    
+    House *house = [House insert];
+    house.name = @"Mafia blues";
+    
+    NSAssert([HLSModelManager saveCurrentModelContext:NULL], @"Failed to insert test data");
+}
+
+- (void)tearDown
+{
+    [super tearDown];
+    
+    [HLSFetchResultCache disableFetchResultCacheForManagedObjectContext:self.modelManager.managedObjectContext];
+    [HLSModelManager popModelManager];
+}
+
+#pragma mark Tests
+
+- (void)testEnableAndDisable
+{
+    NSManagedObjectContext *managedObjectContext = self.modelManager.managedObjectContext;
+    XCTAssertNil([HLSFetchResultCache fetchResultCacheForManagedObjectContext:managedObjectContext]);
+    
+    HLSFetchResultCache *fetchResultCache = [HLSFetchResultCache enableFetchResultCacheForManagedObjectContext:managedObjectContext];
+    XCTAssertNotNil(fetchResultCache);
+    XCTAssertEqual(fetchResultCache.managedObjectContext, managedObjectContext);
+    XCTAssertEqual([HLSFetchResultCache enableFetchResultCacheForManagedObjectContext:managedObjectContext], fetchResultCache);
+    XCTAssertEqual([HLSFetchResultCache fetchResultCacheForManagedObjectContext:managedObjectContext], fetchResultCache);
+    
+    [HLSFetchResultCache disableFetchResultCacheForManagedObjectContext:managedObjectContext];
+    XCTAssertNil([HLSFetchResultCache fetchResultCacheForManagedObjectContext:managedObjectContext]);
+}
+
+- (void)testHitsAndMisses
+{
+    HLSFetchResultCache *fetchResultCache = [HLSFetchResultCache enableFetchResultCacheForManagedObjectContext:self.modelManager.managedObjectContext];
+    
+    NSPredicate *predicate = [NSPredicate predicateWithFormat:@"lastName == %@", @"Soprano"];
+    NSArray *sortDescriptors = @[[NSSortDescriptor sortDescriptorWithKey:@"firstName" ascending:YES]];
+    NSArray *persons1 = [Person filteredObjectsUsingPredicate:predicate sortedUsingDescriptors:sortDescriptors];
+    XCTAssertEqual([persons1 count], kPersonCount);
+    XCTAssertEqual(fetchResultCache.missCount, (NSUInteger)1);
+    XCTAssertEqual(fetchResultCache.hitCount, (NSUInteger)0);
+    
+    // Equal, but not identical, predicate and sort descriptors
+    NSArray *persons2 = [Person filteredObjectsUsingPredicate:[NSPredicate predicateWithFormat:@"lastName == %@", @"Soprano"]
+                                       sortedUsingDescriptors:@[[NSSortDescriptor sortDescriptorWithKey:@"firstName" ascending:YES]]];
+    XCTAssertEqual(persons2, persons1);
+    XCTAssertEqual(fetchResultCache.missCount, (NSUInteger)1);
+    XCTAssertEqual(fetchResultCache.hitCount, (NSUInteger)1);
+    
+    // Different sort order
+    NSArray *persons3 = [Person filteredObjectsUsingPredicate:predicate
+                                       sortedUsingDescriptors:@[[NSSortDescriptor sortDescriptorWithKey:@"firstName" ascending:NO]]];
+    XCTAssertEqualObjects([persons3 firstObject], [persons1 lastObject]);
+    XCTAssertEqual(fetchResultCache.missCount, (NSUInteger)2);
+    XCTAssertEqual(fetchResultCache.count, (NSUInteger)2);
+    
+    [fetchResultCache removeAllFetchResults];
+    XCTAssertEqual(fetchResultCache.count, (NSUInteger)0);
+    XCTAssertEqual(fetchResultCache.hitCount, (NSUInteger)0);
+    XCTAssertEqual(fetchResultCache.missCount, (NSUInteger)0);
+}
+
+- (void)testInvalidation
+{
+    HLSFetchResultCache *fetchResultCache = [HLSFetchResultCache enableFetchResultCacheForManagedObjectContext:self.modelManager.managedObjectContext];
+    
+    NSPredicate *richPredicate = [NSPredicate predicateWithFormat:@"ANY accounts.balance >= %@", @(kPersonCount - 10)];
+    XCTAssertEqual([[Person filteredObjectsUsingPredicate:richPredicate sortedUsingDescriptors:nil] count], (NSUInteger)10);
+    XCTAssertEqual([[House allObjects] count], (NSUInteger)1);
+    XCTAssertEqual(fetchResultCache.count, (NSUInteger)2);
+    
+    // Changing an account must discard the person result (whose predicate depends on accounts), but not the house result
+    BankAccount *bankAccount = [[BankAccount filteredObjectsUsingPredicate:[NSPredicate predicateWithFormat:@"balance == 0"]
+                                                      sortedUsingDescriptors:nil] firstObject];
+    XCTAssertEqual(fetchResultCache.count, (NSUInteger)3);
+    bankAccount.balanceValue = kPersonCount;
+    XCTAssertEqual([[Person filteredObjectsUsingPredicate:richPredicate sortedUsingDescriptors:nil] count], (NSUInteger)11);
+    XCTAssertEqual(fetchResultCache.invalidationCount, (NSUInteger)2);
+    
+    NSUInteger hitCount = fetchResultCache.hitCount;
+    XCTAssertEqual([[House allObjects] count], (NSUInteger)1);
+    XCTAssertEqual(fetchResultCache.hitCount, hitCount + 1);
+    
+    // Inserted objects are seen
+    Person *person = [Person insert];
+    person.firstName = @"Christopher";
+    person.lastName = @"Moltisanti";
+    XCTAssertEqual([[Person allObjects] count], kPersonCount + 1);
+    
+    // Rolling back is seen as well
+    [HLSModelManager rollbackCurrentModelContext];
+    XCTAssertEqual([[Person allObjects] count], kPersonCount);
+    XCTAssertEqual([[Person filteredObjectsUsingPredicate:richPredicate sortedUsingDescriptors:nil] count], (NSUInteger)10);
+}
+
+- (void)testCountLimit
+{
+    HLSFetchResultCache *fetchResultCache = [HLSFetchResultCache enableFetchResultCacheForManagedObjectContext:self.modelManager.managedObjectContext];
+    fetchResultCache.countLimit = 2;
+    
+    NSPredicate *predicate1 = [NSPredicate predicateWithFormat:@"firstName == %@", @"Person 1"];
+    NSPredicate *predicate2 = [NSPredicate predicateWithFormat:@"firstName == %@", @"Person 2"];
+    NSPredicate *predicate3 = [NSPredicate predicateWithFormat:@"firstName == %@", @"Person 3"];
+    [Person filteredObjectsUsingPredicate:predicate1 sortedUsingDescriptors:nil];
+    [Person filteredObjectsUsingPredicate:predicate2 sortedUsingDescriptors:nil];
+    
+    // Least recently used result is discarded first
+    [Person filteredObjectsUsingPredicate:predicate1 sortedUsingDescriptors:nil];
+    [Person filteredObjectsUsingPredicate:predicate3 sortedUsingDescriptors:nil];
+    XCTAssertEqual(fetchResultCache.count, (NSUInteger)2);
+    
+    [Person filteredObjectsUsingPredicate:predicate1 sortedUsingDescriptors:nil];
+    XCTAssertEqual(fetchResultCache.hitCount, (NSUInteger)2);
+    [Person filteredObjectsUsingPredicate:predicate2 sortedUsingDescriptors:nil];
+    XCTAssertEqual(fetchResultCache.missCount, (NSUInteger)4);
+    
+    fetchResultCache.countLimit = 0;
+    XCTAssertEqual(fetchResultCache.count, (NSUInteger)0);
+}
+
+- (void)testUncachedFetchesWithEditsPerformance
+{
+    // Reference: Each fetch hits the store
+    [self measureBlock:^{
+        [self performFetchesWithEdits];
+    }];
+}
+
+- (void)testCachedFetchesWithEditsPerformance
+{
+    HLSFetchResultCache *fetchResultCache = [HLSFetchResultCache enableFetchResultCacheForManagedObjectContext:self.modelManager.managedObjectContext];
+    [self measureBlock:^{
+        [fetchResultCache removeAllFetchResults];
+        [self performFetchesWithEdits];
+    }];
+}
+
+#pragma mark Helpers
+
+// The same person and house fetches repeated, e.g. as when reloading a screen, with occasional house edits which
+// only invalidate the house fetch
+- (void)performFetchesWithEdits
+{
+    NSPredicate *predicate = [NSPredicate predicateWithFormat:@"lastName == %@", @"Soprano"];
+    NSArray *sortDescriptors = @[[NSSortDescriptor sortDescriptorWithKey:@"firstName" ascending:YES]];
+    House *house = [[House allObjects] firstObject];
+    for (NSUInteger i = 0; i < kFetchCount; ++i) {
+        if (i % kFetchesPerEdit == 0) {
+            house.name = [NSString stringWithFormat:@"House %@", @(i)];
+        }
+        
+        XCTAssertEqual([[Person filteredObjectsUsingPredicate:predicate sortedUsingDescriptors:sortDescriptors] count], kPersonCount);
+        XCTAssertEqual([[House allObjects] count], (NSUInteger)1);
+    }
+}
+
+@end
@@ -0,0 +1,269 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import "HLSModelManagerTestCase.h"
+
+#import "NSBundle+Tests.h"
+#import "Person.h"
+
+static const NSUInteger kInsertionCount = 10000;
+static const NSUInteger kSavedObjectCount = 10000;
+
+@implementation HLSModelManagerTestCase
+
+#pragma mark Class methods
+
++ (HLSModelManager *)inMemoryModelManager
+{
+    return [HLSModelManager inMemoryModelManagerWithModelFileName:@"CoconutKitTestData"
+                                                         inBundle:[NSBundle testBundle]
+                                                    configuration:nil
+                                                          options:nil];
+}
+
++ (NSString *)emptyStoreDirectoryWithName:(NSString *)name
+{
+    NSString *storeDirectory = [NSTemporaryDirectory() stringByAppendingPathComponent:name];
+    [[NSFileManager defaultManager] removeItemAtPath:storeDirectory error:NULL];
+    [[NSFileManager defaultManager] createDirectoryAtPath:storeDirectory withIntermediateDirectories:YES attributes:nil error:NULL];
+    return storeDirectory;
+}
+
++ (HLSModelManager *)SQLiteModelManagerInStoreDirectory:(NSString *)storeDirectory asynchronousSaving:(BOOL)asynchronousSaving
+{
+    return [[HLSModelManager alloc] initWithModelFileName:@"CoconutKitTestData"
+                                                 inBundle:[NSBundle testBundle]
+                                                storeType:NSSQLiteStoreType
+                                            configuration:nil
+                                           storeDirectory:storeDirectory
+                                              fileManager:nil
+                                                  options:nil
+                                       asynchronousSaving:asynchronousSaving];
+}
+
+#pragma mark Tests
+
+- (void)testModelManagerStacks
+{
+    HLSModelManager *rootModelManager = [HLSModelManagerTestCase inMemoryModelManager];
+    HLSModelManager *modelManager = [rootModelManager duplicate];
+    
+    HLSModelManager *initialModelManager = [HLSModelManager currentModelManager];
+    [HLSModelManager pushModelManager:rootModelManager];
+    [HLSModelManager pushModelManager:modelManager];
+    XCTAssertEqual([HLSModelManager currentModelManager], modelManager);
+    XCTAssertEqual([HLSModelManager currentModelManagerForMainThread], modelManager);
+    XCTAssertEqual([HLSModelManager currentModelContext], modelManager.managedObjectContext);
+    
+    // Each thread has its own stack
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Background work finished"];
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        XCTAssertNil([HLSModelManager currentModelManager]);
+        XCTAssertEqual([HLSModelManager currentModelManagerForMainThread], modelManager);
+        
+        HLSModelManager *backgroundModelManager = [rootModelManager duplicate];
+        [HLSModelManager performWithModelManager:backgroundModelManager block:^(NSManagedObjectContext *managedObjectContext) {
+            XCTAssertEqual([HLSModelManager currentModelManager], backgroundModelManager);
+            XCTAssertEqual(managedObjectContext, backgroundModelManager.managedObjectContext);
+        }];
+        XCTAssertNil([HLSModelManager currentModelManager]);
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [expectation fulfill];
+        });
+    });
+    [self waitForExpectationsWithTimeout:10. handler:nil];
+    
+    [HLSModelManager popModelManager];
+    XCTAssertEqual([HLSModelManager currentModelManager], rootModelManager);
+    [HLSModelManager popModelManager];
+    XCTAssertEqual([HLSModelManager currentModelManager], initialModelManager);
+}
+
+- (void)testPerformWithModelManager
+{
+    HLSModelManager *modelManager = [HLSModelManagerTestCase inMemoryModelManager];
+    HLSModelManager *initialModelManager = [HLSModelManager currentModelManager];
+    
+    [HLSModelManager performWithModelManager:modelManager block:^(NSManagedObjectContext *managedObjectContext) {
+        XCTAssertEqual([HLSModelManager currentModelManager], modelManager);
+        
+        Person *person = [Person insertIntoManagedObjectContext:managedObjectContext];
+        person.firstName = @"Tony";
+        person.lastName = @"Soprano";
+        XCTAssertEqual([[Person allObjects] count], (NSUInteger)1);
+    }];
+    
+    XCTAssertEqual([HLSModelManager currentModelManager], initialModelManager);
+    XCTAssertEqual([[Person allObjectsInManagedObjectContext:modelManager.managedObjectContext] count], (NSUInteger)1);
+}
+
+- (void)testAsynchronousSaving
+{
+    NSString *storeDirectory = [HLSModelManagerTestCase emptyStoreDirectoryWithName:@"AsynchronousSaving"];
+    HLSModelManager *modelManager = [HLSModelManagerTestCase SQLiteModelManagerInStoreDirectory:storeDirectory asynchronousSaving:YES];
+    XCTAssertTrue(modelManager.savingAsynchronously);
+    
+    // Changes made in a duplicate are propagated to the main queue context, then written to disk
+    HLSModelManager *duplicateModelManager = [modelManager duplicate];
+    XCTAssertTrue(duplicateModelManager.savingAsynchronously);
+    Person *person = [Person insertIntoManagedObjectContext:duplicateModelManager.managedObjectContext];
+    person.firstName = @"Tony";
+    person.lastName = @"Soprano";
+    
+    // Coalesced saves
+    __block NSUInteger completionCount = 0;
+    XCTestExpectation *expectation1 = [self expectationWithDescription:@"Changes written"];
+    XCTestExpectation *expectation2 = [self expectationWithDescription:@"Changes written"];
+    [duplicateModelManager saveWithCompletionBlock:^(NSError *error) {
+        XCTAssertTrue([NSThread isMainThread]);
+        XCTAssertNil(error);
+        ++completionCount;
+        [expectation1 fulfill];
+    }];
+    [modelManager saveWithCompletionBlock:^(NSError *error) {
+        XCTAssertNil(error);
+        ++completionCount;
+        [expectation2 fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10. handler:nil];
+    XCTAssertEqual(completionCount, (NSUInteger)2);
+    XCTAssertEqual([[Person allObjectsInManagedObjectContext:modelManager.managedObjectContext] count], (NSUInteger)1);
+    
+    HLSModelManager *otherModelManager = [HLSModelManagerTestCase SQLiteModelManagerInStoreDirectory:storeDirectory asynchronousSaving:NO];
+    XCTAssertEqual([[Person allObjectsInManagedObjectContext:otherModelManager.managedObjectContext] count], (NSUInteger)1);
+}
+
+- (void)testAsynchronousSavingFromDuplicate
+{
+    NSString *storeDirectory = [HLSModelManagerTestCase emptyStoreDirectoryWithName:@"AsynchronousSavingFromDuplicate"];
+    HLSModelManager *modelManager = [HLSModelManagerTestCase SQLiteModelManagerInStoreDirectory:storeDirectory asynchronousSaving:YES];
+    
+    // Unsaved changes of the main queue context
+    Person *unsavedPerson = [Person insertIntoManagedObjectContext:modelManager.managedObjectContext];
+    unsavedPerson.firstName = @"Paulie";
+    unsavedPerson.lastName = @"Gualtieri";
+    
+    HLSModelManager *duplicateModelManager = [modelManager duplicate];
+    XCTAssertEqual(duplicateModelManager.managedObjectContext.parentContext, modelManager.managedObjectContext.parentContext);
+    Person *person = [Person insertIntoManagedObjectContext:duplicateModelManager.managedObjectContext];
+    person.firstName = @"Tony";
+    person.lastName = @"Soprano";
+    
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Changes written"];
+    [duplicateModelManager saveWithCompletionBlock:^(NSError *error) {
+        XCTAssertNil(error);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10. handler:nil];
+    
+    // Saved objects have received permanent IDs, and are available from the main queue context
+    XCTAssertFalse([person.objectID isTemporaryID]);
+    XCTAssertNotNil([modelManager.managedObjectContext existingObjectWithID:person.objectID error:NULL]);
+    
+    // Only the changes saved by the duplicate have been written to disk
+    HLSModelManager *otherModelManager = [HLSModelManagerTestCase SQLiteModelManagerInStoreDirectory:storeDirectory asynchronousSaving:NO];
+    NSArray *writtenPersons = [Person allObjectsInManagedObjectContext:otherModelManager.managedObjectContext];
+    XCTAssertEqual([writtenPersons count], (NSUInteger)1);
+    XCTAssertEqualObjects([[writtenPersons firstObject] firstName], @"Tony");
+    
+    // Unsaved changes of the main queue context can still be rolled back
+    XCTAssertTrue([modelManager.managedObjectContext hasChanges]);
+    [HLSModelManager performWithModelManager:modelManager block:^(NSManagedObjectContext *managedObjectContext) {
+        [HLSModelManager rollbackCurrentModelContext];
+    }];
+    XCTAssertFalse([modelManager.managedObjectContext hasChanges]);
+    XCTAssertEqual([[Person allObjectsInManagedObjectContext:modelManager.managedObjectContext] count], (NSUInteger)1);
+}
+
+- (void)testFlush
+{
+    NSString *storeDirectory = [HLSModelManagerTestCase emptyStoreDirectoryWithName:@"Flush"];
+    HLSModelManager *modelManager = [HLSModelManagerTestCase SQLiteModelManagerInStoreDirectory:storeDirectory asynchronousSaving:YES];
+    [HLSModelManager performWithModelManager:modelManager block:^(NSManagedObjectContext *managedObjectContext) {
+        Person *person = [Person insert];
+        person.firstName = @"Tony";
+        person.lastName = @"Soprano";
+        XCTAssertTrue([HLSModelManager saveCurrentModelContext:NULL]);
+    }];
+    
+    NSError *error = nil;
+    XCTAssertTrue([modelManager flush:&error]);
+    XCTAssertNil(error);
+    
+    HLSModelManager *otherModelManager = [HLSModelManagerTestCase SQLiteModelManagerInStoreDirectory:storeDirectory asynchronousSaving:NO];
+    XCTAssertEqual([[Person allObjectsInManagedObjectContext:otherModelManager.managedObjectContext] count], (NSUInteger)1);
+}
+
+- (void)testSynchronousSaveLatencyPerformance
+{
+    // Reference: Changes are written to disk on the main thread
+    NSString *storeDirectory = [HLSModelManagerTestCase emptyStoreDirectoryWithName:@"SynchronousSaveLatency"];
+    HLSModelManager *modelManager = [HLSModelManagerTestCase SQLiteModelManagerInStoreDirectory:storeDirectory asynchronousSaving:NO];
+    [self measureMetrics:[[self class] defaultPerformanceMetrics] automaticallyStartMeasuring:NO forBlock:^{
+        for (NSUInteger i = 0; i < kSavedObjectCount; ++i) {
+            Person *person = [Person insertIntoManagedObjectContext:modelManager.managedObjectContext];
+            person.firstName = @"Tony";
+            person.lastName = @"Soprano";
+        }
+        
+        [self startMeasuring];
+        [modelManager saveWithCompletionBlock:nil];
+        [self stopMeasuring];
+    }];
+}
+
+- (void)testAsynchronousSaveLatencyPerformance
+{
+    // Only the time during which the main thread is blocked is measured
+    NSString *storeDirectory = [HLSModelManagerTestCase emptyStoreDirectoryWithName:@"AsynchronousSaveLatency"];
+    HLSModelManager *modelManager = [HLSModelManagerTestCase SQLiteModelManagerInStoreDirectory:storeDirectory asynchronousSaving:YES];
+    [self measureMetrics:[[self class] defaultPerformanceMetrics] automaticallyStartMeasuring:NO forBlock:^{
+        for (NSUInteger i = 0; i < kSavedObjectCount; ++i) {
+            Person *person = [Person insertIntoManagedObjectContext:modelManager.managedObjectContext];
+            person.firstName = @"Tony";
+            person.lastName = @"Soprano";
+        }
+        
+        XCTestExpectation *expectation = [self expectationWithDescription:@"Changes written"];
+        [self startMeasuring];
+        [modelManager saveWithCompletionBlock:^(NSError *error) {
+            [expectation fulfill];
+        }];
+        [self stopMeasuring];
+        [self waitForExpectationsWithTimeout:60. handler:nil];
+    }];
+}
+
+- (void)testContextFreeInsertionPerformance
+{
+    // Reference: The current context is resolved for each insertion
+    HLSModelManager *modelManager = [HLSModelManagerTestCase inMemoryModelManager];
+    [HLSModelManager pushModelManager:modelManager];
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < kInsertionCount; ++i) {
+            [Person insert];
+        }
+        [HLSModelManager rollbackCurrentModelContext];
+    }];
+    [HLSModelManager popModelManager];
+}
+
+- (void)testScopedInsertionPerformance
+{
+    // The context is resolved once for the whole batch
+    HLSModelManager *modelManager = [HLSModelManagerTestCase inMemoryModelManager];
+    [self measureBlock:^{
+        [HLSModelManager performWithModelManager:modelManager block:^(NSManagedObjectContext *managedObjectContext) {
+            for (NSUInteger i = 0; i < kInsertionCount; ++i) {
+                [Person insertIntoManagedObjectContext:managedObjectContext];
+            }
+            [managedObjectContext rollback];
+        }];
+    }];
+}
+
+@end
@@ -0,0 +1,83 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import "HLSLabelLocalizationInfoTestCase.h"
+
+#import "HLSLabelLocalizationInfo.h"
+
+@implementation HLSLabelLocalizationInfoTestCase
+
+#pragma mark Tests
+
+- (void)testLocalizedText
+{
+    HLSLabelLocalizationInfo *plainInfo = [[HLSLabelLocalizationInfo alloc] initWithText:@"Not localized" tableName:nil bundleName:nil];
+    XCTAssertFalse([plainInfo isLocalized]);
+    XCTAssertNil([plainInfo localizedText]);
+    
+    HLSLabelLocalizationInfo *uppercaseInfo = [[HLSLabelLocalizationInfo alloc] initWithText:@"ULS/missing_key" tableName:nil bundleName:nil];
+    XCTAssertTrue([uppercaseInfo isLocalized]);
+    XCTAssertTrue([uppercaseInfo isIncomplete]);
+    XCTAssertEqualObjects([uppercaseInfo localizedText], @"MISSING_KEY");
+    
+    // Same key, different representation
+    HLSLabelLocalizationInfo *normalInfo = [[HLSLabelLocalizationInfo alloc] initWithText:@"LS/missing_key" tableName:nil bundleName:nil];
+    XCTAssertEqualObjects([normalInfo localizedText], @"missing_key");
+    XCTAssertEqualObjects([uppercaseInfo localizedText], @"MISSING_KEY");
+    
+    HLSLabelLocalizationInfo *emptyKeyInfo = [[HLSLabelLocalizationInfo alloc] initWithText:@"LS/" tableName:nil bundleName:nil];
+    XCTAssertTrue([emptyKeyInfo isIncomplete]);
+    XCTAssertEqualObjects([emptyKeyInfo localizedText], @"(no key)");
+}
+
+- (void)testBundleCacheInvalidation
+{
+    NSString *rootFolderPath = [HLSApplicationDocumentDirectoryPath() stringByAppendingPathComponent:@"labelLocalizationTests"];
+    [[NSFileManager defaultManager] removeItemAtPath:rootFolderPath error:NULL];
+    [NSBundle invalidateBundleCache];
+    
+    HLSLabelLocalizationInfo *info = [[HLSLabelLocalizationInfo alloc] initWithText:@"LS/downloaded_key" tableName:nil bundleName:@"DownloadedLabelBundle"];
+    XCTAssertTrue([info isIncomplete]);
+    XCTAssertEqualObjects([info localizedText], @"downloaded_key");
+    
+    // Strings files can be stored in property list format
+    NSString *bundlePath = [rootFolderPath stringByAppendingPathComponent:@"DownloadedLabelBundle.bundle"];
+    NSString *localizationFolderPath = [bundlePath stringByAppendingPathComponent:[NSString stringWithFormat:@"%@.lproj", [NSBundle localization]]];
+    [[NSFileManager defaultManager] createDirectoryAtPath:localizationFolderPath withIntermediateDirectories:YES attributes:nil error:NULL];
+    [@{ @"downloaded_key" : @"Downloaded text" } writeToFile:[localizationFolderPath stringByAppendingPathComponent:@"Localizable.strings"] atomically:YES];
+    
+    // The bundle is not visible before the bundle cache is invalidated, which must also discard memoized texts
+    XCTAssertTrue([info isIncomplete]);
+    XCTAssertEqualObjects([info localizedText], @"downloaded_key");
+    
+    [NSBundle invalidateBundleCache];
+    XCTAssertFalse([info isIncomplete]);
+    XCTAssertEqualObjects([info localizedText], @"Downloaded text");
+    
+    [[NSFileManager defaultManager] removeItemAtPath:rootFolderPath error:NULL];
+    [NSBundle invalidateBundleCache];
+}
+
+- (void)testCellReusePerformance
+{
+    // 20 cells, each with 5 localized labels, reused while scrolling through 500 rows
+    NSMutableArray *labels = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 20 * 5; ++i) {
+        [labels addObject:[[UILabel alloc] initWithFrame:CGRectMake(0.f, 0.f, 100.f, 20.f)]];
+    }
+    
+    [self measureBlock:^{
+        for (NSUInteger row = 0; row < 500; ++row) {
+            NSUInteger cellIndex = row % 20;
+            for (NSUInteger j = 0; j < 5; ++j) {
+                UILabel *label = [labels objectAtIndex:cellIndex * 5 + j];
+                label.text = [NSString stringWithFormat:@"CLS/cell_label_%@", @(j)];
+            }
+        }
+    }];
+}
+
+@end
@@ -0,0 +1,143 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import "HLSTextMeasurementCacheTestCase.h"
+
+static const NSStringDrawingOptions kDrawingOptions = NSStringDrawingUsesLineFragmentOrigin | NSStringDrawingUsesFontLeading;
+
+@implementation HLSTextMeasurementCacheTestCase
+
+#pragma mark Class methods
+
++ (NSArray *)texts
+{
+    NSMutableArray *texts = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 100; ++i) {
+        [texts addObject:[NSString stringWithFormat:@"Lorem ipsum dolor sit amet %@, consectetur adipiscing elit, sed do eiusmod tempor "
+                          "incididunt ut labore et dolore magna aliqua", @(i)]];
+    }
+    return [NSArray arrayWithArray:texts];
+}
+
+#pragma mark Setup and teardown
+
+- (void)setUp
+{
+    [super setUp];
+    
+    [[HLSTextMeasurementCache sharedTextMeasurementCache] removeAllMeasurements];
+}
+
+#pragma mark Tests
+
+- (void)testMeasurements
+{
+    HLSTextMeasurementCache *textMeasurementCache = [HLSTextMeasurementCache sharedTextMeasurementCache];
+    NSDictionary *attributes = @{ NSFontAttributeName : [UIFont systemFontOfSize:15.f] };
+    NSString *text = [[HLSTextMeasurementCacheTestCase texts] firstObject];
+    
+    CGRect expectedRect = [text boundingRectWithSize:CGSizeMake(200.f, CGFLOAT_MAX) options:kDrawingOptions attributes:attributes context:nil];
+    CGRect rect1 = [textMeasurementCache boundingRectForString:text withSize:CGSizeMake(200.f, CGFLOAT_MAX) options:kDrawingOptions attributes:attributes];
+    XCTAssertTrue(CGRectEqualToRect(rect1, expectedRect));
+    XCTAssertEqual(textMeasurementCache.hitCount, 0);
+    XCTAssertEqual(textMeasurementCache.missCount, 1);
+    
+    // Equal but not identical parameters
+    NSDictionary *otherAttributes = @{ NSFontAttributeName : [UIFont systemFontOfSize:15.f] };
+    CGRect rect2 = [textMeasurementCache boundingRectForString:[text mutableCopy] withSize:CGSizeMake(200.f, CGFLOAT_MAX) options:kDrawingOptions attributes:otherAttributes];
+    XCTAssertTrue(CGRectEqualToRect(rect2, expectedRect));
+    XCTAssertEqual(textMeasurementCache.hitCount, 1);
+    XCTAssertEqual(textMeasurementCache.missCount, 1);
+    
+    // Different width
+    [textMeasurementCache boundingRectForString:text withSize:CGSizeMake(100.f, CGFLOAT_MAX) options:kDrawingOptions attributes:attributes];
+    XCTAssertEqual(textMeasurementCache.missCount, 2);
+    
+    // Different font
+    [textMeasurementCache boundingRectForString:text withSize:CGSizeMake(200.f, CGFLOAT_MAX) options:kDrawingOptions attributes:@{ NSFontAttributeName : [UIFont boldSystemFontOfSize:15.f] }];
+    XCTAssertEqual(textMeasurementCache.missCount, 3);
+    
+    // Sizes are not bounding rectangles
+    CGSize size = [textMeasurementCache sizeForString:text withAttributes:attributes];
+    XCTAssertTrue(CGSizeEqualToSize(size, [text sizeWithAttributes:attributes]));
+    XCTAssertEqual(textMeasurementCache.missCount, 4);
+    [textMeasurementCache sizeForString:text withAttributes:attributes];
+    XCTAssertEqual(textMeasurementCache.hitCount, 2);
+}
+
+- (void)testPrecomputation
+{
+    HLSTextMeasurementCache *textMeasurementCache = [HLSTextMeasurementCache sharedTextMeasurementCache];
+    UIFont *font = [UIFont systemFontOfSize:15.f];
+    NSArray *texts = [HLSTextMeasurementCacheTestCase texts];
+    
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Precomputation finished"];
+    [textMeasurementCache precomputeBoundingRectsForStrings:texts withSize:CGSizeMake(200.f, 100.f) options:kDrawingOptions attributes:@{ NSFontAttributeName : font } completionBlock:^{
+        XCTAssertTrue([NSThread isMainThread]);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10. handler:nil];
+    
+    // HLSLabel finds precomputed measurements when drawing
+    HLSLabel *label = [[HLSLabel alloc] initWithFrame:CGRectMake(0.f, 0.f, 200.f, 100.f)];
+    label.font = font;
+    label.numberOfLines = 0;
+    
+    UIGraphicsBeginImageContextWithOptions(label.bounds.size, NO, 0.f);
+    for (NSString *text in texts) {
+        label.text = text;
+        [label drawTextInRect:label.bounds];
+    }
+    UIGraphicsEndImageContext();
+    
+    XCTAssertEqual(textMeasurementCache.hitCount, [texts count]);
+    XCTAssertEqual(textMeasurementCache.missCount, 0);
+}
+
+- (void)testConcurrentAccess
+{
+    HLSTextMeasurementCache *textMeasurementCache = [HLSTextMeasurementCache sharedTextMeasurementCache];
+    NSDictionary *attributes = @{ NSFontAttributeName : [UIFont systemFontOfSize:15.f] };
+    NSArray *texts = [HLSTextMeasurementCacheTestCase texts];
+    
+    dispatch_apply(1000, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
+        NSString *text = [texts objectAtIndex:i % [texts count]];
+        [textMeasurementCache boundingRectForString:text withSize:CGSizeMake(200.f, CGFLOAT_MAX) options:kDrawingOptions attributes:attributes];
+    });
+    
+    XCTAssertEqual(textMeasurementCache.hitCount + textMeasurementCache.missCount, 1000);
+    XCTAssertTrue(textMeasurementCache.missCount >= [texts count]);
+}
+
+- (void)testUncachedMeasurementPerformance
+{
+    // Reference: What HLSLabel used to do each time it was drawn
+    NSDictionary *attributes = @{ NSFontAttributeName : [UIFont systemFontOfSize:15.f] };
+    NSArray *texts = [HLSTextMeasurementCacheTestCase texts];
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 10; ++i) {
+            for (NSString *text in texts) {
+                [text boundingRectWithSize:CGSizeMake(200.f, 100.f) options:kDrawingOptions attributes:attributes context:nil];
+            }
+        }
+    }];
+}
+
+- (void)testCachedMeasurementPerformance
+{
+    HLSTextMeasurementCache *textMeasurementCache = [HLSTextMeasurementCache sharedTextMeasurementCache];
+    NSDictionary *attributes = @{ NSFontAttributeName : [UIFont systemFontOfSize:15.f] };
+    NSArray *texts = [HLSTextMeasurementCacheTestCase texts];
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 10; ++i) {
+            for (NSString *text in texts) {
+                [textMeasurementCache boundingRectForString:text withSize:CGSizeMake(200.f, 100.f) options:kDrawingOptions attributes:attributes];
+            }
+        }
+    }];
+}
+
+@end
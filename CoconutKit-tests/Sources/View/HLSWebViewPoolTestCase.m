@@ -0,0 +1,244 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import "HLSWebViewPoolTestCase.h"
+
+#import <WebKit/WebKit.h>
+
+@interface WebViewLoadObserver : NSObject <UIWebViewDelegate, WKNavigationDelegate>
+
+- (instancetype)initWithWebView:(UIView *)webView completionBlock:(void (^)(void))completionBlock;
+
+- (void)loadRequest:(NSURLRequest *)request;
+
+@end
+
+@implementation WebViewLoadObserver {
+@private
+    UIView *_webView;
+    void (^_completionBlock)(void);
+}
+
+- (instancetype)initWithWebView:(UIView *)webView completionBlock:(void (^)(void))completionBlock
+{
+    if (self = [super init]) {
+        _webView = webView;
+        _completionBlock = [completionBlock copy];
+        
+        if ([WKWebView class]) {
+            ((WKWebView *)webView).navigationDelegate = self;
+        }
+        else {
+            ((UIWebView *)webView).delegate = self;
+        }
+    }
+    return self;
+}
+
+- (void)loadRequest:(NSURLRequest *)request
+{
+    if ([WKWebView class]) {
+        [(WKWebView *)_webView loadRequest:request];
+    }
+    else {
+        [(UIWebView *)_webView loadRequest:request];
+    }
+}
+
+- (void)webView:(WKWebView *)webView didFinishNavigation:(WKNavigation *)navigation
+{
+    _completionBlock();
+}
+
+- (void)webViewDidFinishLoad:(UIWebView *)webView
+{
+    if (! webView.loading) {
+        _completionBlock();
+    }
+}
+
+@end
+
+@implementation HLSWebViewPoolTestCase
+
+#pragma mark Class methods
+
++ (NSURL *)pageFileURL
+{
+    return [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:@"HLSWebViewPoolTestCase.html"]];
+}
+
+#pragma mark Setup and teardown
+
+- (void)setUp
+{
+    [super setUp];
+    
+    NSString *page = @"<html><head><title>Pool</title></head><body><h1>Hello, world!</h1></body></html>";
+    [page writeToURL:[HLSWebViewPoolTestCase pageFileURL] atomically:YES encoding:NSUTF8StringEncoding error:NULL];
+    
+    [[HLSWebViewPool sharedWebViewPool] prewarm];
+    [self waitForPoolFilling];
+}
+
+- (void)tearDown
+{
+    [super tearDown];
+    
+    [HLSWebViewPool sharedWebViewPool].capacity = 2;
+    [[NSFileManager defaultManager] removeItemAtURL:[HLSWebViewPoolTestCase pageFileURL] error:NULL];
+}
+
+#pragma mark Helpers
+
+- (void)waitForPoolFilling
+{
+    // The pool is filled when the main run loop is idle
+    HLSWebViewPool *webViewPool = [HLSWebViewPool sharedWebViewPool];
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:10.];
+    while (webViewPool.availableWebViewCount < webViewPool.capacity && [timeoutDate timeIntervalSinceNow] > 0.) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+    }
+}
+
+- (void)measureFirstPaintWithWebViewBlock:(UIView * (^)(void))webViewBlock
+{
+    NSURLRequest *request = [NSURLRequest requestWithURL:[HLSWebViewPoolTestCase pageFileURL]];
+    [self measureMetrics:[[self class] defaultPerformanceMetrics] automaticallyStartMeasuring:NO forBlock:^{
+        [self waitForPoolFilling];
+        
+        XCTestExpectation *expectation = [self expectationWithDescription:@"Page loaded"];
+        
+        [self startMeasuring];
+        UIView *webView = webViewBlock();
+        WebViewLoadObserver *loadObserver = [[WebViewLoadObserver alloc] initWithWebView:webView completionBlock:^{
+            // Stop measuring as soon as possible. The pool might be refilled while waiting for the expectation
+            [self stopMeasuring];
+            [expectation fulfill];
+        }];
+        [loadObserver loadRequest:request];
+        
+        [self waitForExpectationsWithTimeout:10. handler:nil];
+        
+        [[HLSWebViewPool sharedWebViewPool] enqueueWebView:webView];
+    }];
+}
+
+#pragma mark Tests
+
+- (void)testFilling
+{
+    HLSWebViewPool *webViewPool = [HLSWebViewPool sharedWebViewPool];
+    XCTAssertEqual(webViewPool.availableWebViewCount, 2);
+    
+    webViewPool.capacity = 4;
+    XCTAssertEqual(webViewPool.availableWebViewCount, 2);
+    [self waitForPoolFilling];
+    XCTAssertEqual(webViewPool.availableWebViewCount, 4);
+    
+    webViewPool.capacity = 1;
+    XCTAssertEqual(webViewPool.availableWebViewCount, 1);
+}
+
+- (void)testDequeueAndEnqueue
+{
+    HLSWebViewPool *webViewPool = [HLSWebViewPool sharedWebViewPool];
+    
+    UIView *webView1 = [webViewPool dequeueWebViewWithFrame:CGRectMake(0.f, 0.f, 320.f, 480.f)];
+    XCTAssertNotNil(webView1);
+    XCTAssertTrue(CGRectEqualToRect(webView1.frame, CGRectMake(0.f, 0.f, 320.f, 480.f)));
+    XCTAssertEqual(webViewPool.availableWebViewCount, 1);
+    
+    // Unused web views are reused
+    UIView *superview = [[UIView alloc] init];
+    [superview addSubview:webView1];
+    [webViewPool enqueueWebView:webView1];
+    XCTAssertNil(webView1.superview);
+    XCTAssertEqual(webViewPool.availableWebViewCount, 2);
+    
+    // Web views which have loaded content are discarded
+    UIView *webView2 = [webViewPool dequeueWebViewWithFrame:CGRectMake(0.f, 0.f, 320.f, 480.f)];
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Page loaded"];
+    WebViewLoadObserver *loadObserver = [[WebViewLoadObserver alloc] initWithWebView:webView2 completionBlock:^{
+        [expectation fulfill];
+    }];
+    [loadObserver loadRequest:[NSURLRequest requestWithURL:[HLSWebViewPoolTestCase pageFileURL]]];
+    [self waitForExpectationsWithTimeout:10. handler:nil];
+    
+    [self waitForPoolFilling];
+    webViewPool.capacity = 3;
+    [webViewPool enqueueWebView:webView2];
+    XCTAssertEqual(webViewPool.availableWebViewCount, 2);
+}
+
+- (void)testReuse
+{
+    HLSWebViewPool *webViewPool = [HLSWebViewPool sharedWebViewPool];
+    
+    // A returned web view is handed out again by the next request
+    UIView *webView1 = [webViewPool dequeueWebViewWithFrame:CGRectMake(0.f, 0.f, 320.f, 480.f)];
+    [webViewPool enqueueWebView:webView1];
+    
+    UIView *webView2 = [webViewPool dequeueWebViewWithFrame:CGRectMake(0.f, 0.f, 200.f, 300.f)];
+    XCTAssertEqual(webView2, webView1);
+    XCTAssertTrue(CGRectEqualToRect(webView2.frame, CGRectMake(0.f, 0.f, 200.f, 300.f)));
+    
+    [webViewPool enqueueWebView:webView2];
+}
+
+- (void)testLazyFilling
+{
+    // Instantiating or configuring a pool does not create any web view
+    HLSWebViewPool *webViewPool = [[HLSWebViewPool alloc] init];
+    webViewPool.capacity = 3;
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.5]];
+    XCTAssertEqual(webViewPool.availableWebViewCount, 0);
+    
+    // The pool is filled after the first request
+    UIView *webView = [webViewPool dequeueWebViewWithFrame:CGRectMake(0.f, 0.f, 320.f, 480.f)];
+    XCTAssertNotNil(webView);
+    
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:10.];
+    while (webViewPool.availableWebViewCount < webViewPool.capacity && [timeoutDate timeIntervalSinceNow] > 0.) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+    }
+    XCTAssertEqual(webViewPool.availableWebViewCount, 3);
+}
+
+- (void)testWebViewController
+{
+    HLSWebViewPool *webViewPool = [HLSWebViewPool sharedWebViewPool];
+    
+    // The error web view is only drawn from the pool when an error must be displayed
+    @autoreleasepool {
+        HLSWebViewController *webViewController = [[HLSWebViewController alloc] initWithRequest:[NSURLRequest requestWithURL:[HLSWebViewPoolTestCase pageFileURL]]];
+        [webViewController view];
+        XCTAssertEqual(webViewPool.availableWebViewCount, 1);
+    }
+    
+    // The web view which has loaded content has been discarded and is replaced during idle time
+    XCTAssertEqual(webViewPool.availableWebViewCount, 1);
+    [self waitForPoolFilling];
+    XCTAssertEqual(webViewPool.availableWebViewCount, 2);
+}
+
+- (void)testFirstPaintWithNewWebViewPerformance
+{
+    // Reference: What HLSWebViewController used to do
+    Class webViewClass = [WKWebView class] ?: [UIWebView class];
+    [self measureFirstPaintWithWebViewBlock:^UIView *{
+        return [[webViewClass alloc] initWithFrame:[UIScreen mainScreen].bounds];
+    }];
+}
+
+- (void)testFirstPaintWithPooledWebViewPerformance
+{
+    [self measureFirstPaintWithWebViewBlock:^UIView *{
+        return [[HLSWebViewPool sharedWebViewPool] dequeueWebViewWithFrame:[UIScreen mainScreen].bounds];
+    }];
+}
+
+@end
@@ -0,0 +1,54 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import "UITextField+HLSExtensionsTestCase.h"
+
+@implementation UITextField_HLSExtensionsTestCase
+
+#pragma mark Tests
+
+- (void)testResigningFirstResponderOnTap
+{
+    UITextField *textField = [[UITextField alloc] initWithFrame:CGRectMake(0.f, 0.f, 200.f, 30.f)];
+    XCTAssertFalse(textField.resigningFirstResponderOnTap);
+    
+    textField.resigningFirstResponderOnTap = YES;
+    XCTAssertTrue(textField.resigningFirstResponderOnTap);
+    
+    textField.resigningFirstResponderOnTap = NO;
+    XCTAssertFalse(textField.resigningFirstResponderOnTap);
+}
+
+- (void)testCreationAndTeardownPerformance
+{
+    // Most text fields never opt in, and must therefore be as cheap as plain UIKit text fields
+    [self measureBlock:^{
+        @autoreleasepool {
+            NSMutableArray *textFields = [NSMutableArray array];
+            for (NSUInteger i = 0; i < 1000; ++i) {
+                [textFields addObject:[[UITextField alloc] initWithFrame:CGRectMake(0.f, 0.f, 200.f, 30.f)]];
+            }
+            [textFields removeAllObjects];
+        }
+    }];
+}
+
+- (void)testOptedInCreationAndTeardownPerformance
+{
+    [self measureBlock:^{
+        @autoreleasepool {
+            NSMutableArray *textFields = [NSMutableArray array];
+            for (NSUInteger i = 0; i < 1000; ++i) {
+                UITextField *textField = [[UITextField alloc] initWithFrame:CGRectMake(0.f, 0.f, 200.f, 30.f)];
+                textField.resigningFirstResponderOnTap = YES;
+                [textFields addObject:textField];
+            }
+            [textFields removeAllObjects];
+        }
+    }];
+}
+
+@end
@@ -0,0 +1,222 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import "HLSContainerStackViewTestCase.h"
+
+#import "HLSContainerStackView.h"
+
+static const NSUInteger kBenchmarkDepth = 50;
+
+@implementation HLSContainerStackViewTestCase
+
+#pragma mark Helpers
+
++ (NSArray *)contentViewsWithCount:(NSUInteger)count
+{
+    NSMutableArray *contentViews = [NSMutableArray array];
+    for (NSUInteger i = 0; i < count; ++i) {
+        [contentViews addObject:[[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 320.f, 480.f)]];
+    }
+    return [NSArray arrayWithArray:contentViews];
+}
+
++ (NSUInteger)depthOfView:(UIView *)view inView:(UIView *)ancestorView
+{
+    NSUInteger depth = 0;
+    while (view && view != ancestorView) {
+        view = view.superview;
+        ++depth;
+    }
+    return depth;
+}
+
+- (void)pushPopWithFlatStackView:(BOOL)flat
+{
+    NSArray *contentViews = [HLSContainerStackViewTestCase contentViewsWithCount:kBenchmarkDepth];
+    
+    [self measureBlock:^{
+        HLSContainerStackView *stackView = [[HLSContainerStackView alloc] initWithFrame:CGRectMake(0.f, 0.f, 320.f, 480.f)];
+        stackView.flat = flat;
+        
+        for (UIView *contentView in contentViews) {
+            [stackView insertContentView:contentView atIndex:[stackView.contentViews count]];
+            [stackView transitionGroupViewForContentView:contentView];
+        }
+        
+        for (UIView *contentView in [contentViews reverseObjectEnumerator]) {
+            [stackView transitionGroupViewForContentView:contentView];
+            [stackView removeContentView:contentView];
+        }
+    }];
+}
+
+/**
+ * Return a displayed stack controller with kBenchmarkDepth children, all with their view loaded
+ */
++ (HLSStackController *)displayedStackControllerWithFlatViewHierarchy:(BOOL)flat
+{
+    HLSStackController *stackController = [[HLSStackController alloc] initWithRootViewController:[[UIViewController alloc] init]
+                                                                                        capacity:HLSContainerStackUnlimitedCapacity];
+    stackController.flatViewHierarchy = flat;
+    for (NSUInteger i = 1; i < kBenchmarkDepth; ++i) {
+        [stackController pushViewController:[[UIViewController alloc] init]
+                        withTransitionClass:[HLSTransitionCoverFromBottom class]
+                                   animated:NO];
+    }
+    
+    UIWindow *keyWindow = [UIApplication sharedApplication].keyWindow;
+    stackController.view.frame = keyWindow.bounds;
+    [stackController beginAppearanceTransition:YES animated:NO];
+    [keyWindow addSubview:stackController.view];
+    [stackController endAppearanceTransition];
+    return stackController;
+}
+
++ (void)dismissStackController:(HLSStackController *)stackController
+{
+    [stackController beginAppearanceTransition:NO animated:NO];
+    [stackController.view removeFromSuperview];
+    [stackController endAppearanceTransition];
+}
+
+/**
+ * Rotate a stack controller back and forth, going through the same rotation methods as UIKit
+ */
++ (void)rotateStackController:(HLSStackController *)stackController
+{
+    CGRect portraitFrame = stackController.view.frame;
+    CGRect landscapeFrame = CGRectMake(CGRectGetMinX(portraitFrame), CGRectGetMinY(portraitFrame),
+                                       CGRectGetHeight(portraitFrame), CGRectGetWidth(portraitFrame));
+    
+    [stackController willRotateToInterfaceOrientation:UIInterfaceOrientationLandscapeLeft duration:0.];
+    stackController.view.frame = landscapeFrame;
+    [stackController.view layoutIfNeeded];
+    [stackController willAnimateRotationToInterfaceOrientation:UIInterfaceOrientationLandscapeLeft duration:0.];
+    [stackController didRotateFromInterfaceOrientation:UIInterfaceOrientationPortrait];
+    
+    [stackController willRotateToInterfaceOrientation:UIInterfaceOrientationPortrait duration:0.];
+    stackController.view.frame = portraitFrame;
+    [stackController.view layoutIfNeeded];
+    [stackController willAnimateRotationToInterfaceOrientation:UIInterfaceOrientationPortrait duration:0.];
+    [stackController didRotateFromInterfaceOrientation:UIInterfaceOrientationLandscapeLeft];
+}
+
+- (void)rotateWithFlatViewHierarchy:(BOOL)flat
+{
+    HLSStackController *stackController = [HLSContainerStackViewTestCase displayedStackControllerWithFlatViewHierarchy:flat];
+    [self measureBlock:^{
+        [HLSContainerStackViewTestCase rotateStackController:stackController];
+    }];
+    [HLSContainerStackViewTestCase dismissStackController:stackController];
+}
+
+#pragma mark Tests
+
+- (void)testFlatHierarchy
+{
+    HLSContainerStackView *stackView = [[HLSContainerStackView alloc] initWithFrame:CGRectMake(0.f, 0.f, 320.f, 480.f)];
+    stackView.flat = YES;
+    
+    NSArray *contentViews = [HLSContainerStackViewTestCase contentViewsWithCount:4];
+    [stackView insertContentView:[contentViews objectAtIndex:0] atIndex:0];
+    [stackView insertContentView:[contentViews objectAtIndex:3] atIndex:1];
+    [stackView insertContentView:[contentViews objectAtIndex:1] atIndex:1];
+    [stackView insertContentView:[contentViews objectAtIndex:2] atIndex:2];
+    XCTAssertEqualObjects(stackView.contentViews, contentViews);
+    
+    for (NSUInteger i = 0; i < [contentViews count]; ++i) {
+        UIView *contentView = [contentViews objectAtIndex:i];
+        XCTAssertEqual([stackView indexOfContentView:contentView], i);
+        XCTAssertEqual([stackView groupViewForContentView:contentView].frontContentView, contentView);
+    }
+    
+    // Group views are kept side by side, in the correct order
+    XCTAssertEqual([stackView.subviews count], [contentViews count]);
+    for (NSUInteger i = 0; i < [contentViews count] - 1; ++i) {
+        HLSContainerGroupView *groupView = [stackView groupViewForContentView:[contentViews objectAtIndex:i]];
+        XCTAssertEqual(groupView.superview, [stackView.subviews objectAtIndex:i]);
+    }
+    XCTAssertEqual([stackView groupViewForContentView:[contentViews lastObject]], [stackView.subviews lastObject]);
+    
+    // Pairing for transitions
+    HLSContainerGroupView *groupView2 = [stackView transitionGroupViewForContentView:[contentViews objectAtIndex:2]];
+    XCTAssertTrue(groupView2.backViewAttached);
+    XCTAssertEqual(groupView2.backContentView, [stackView groupViewForContentView:[contentViews objectAtIndex:1]]);
+    
+    HLSContainerGroupView *groupView3 = [stackView transitionGroupViewForContentView:[contentViews objectAtIndex:3]];
+    XCTAssertTrue(groupView3.backViewAttached);
+    XCTAssertFalse(groupView2.backViewAttached);
+    
+    [stackView removeContentView:[contentViews objectAtIndex:1]];
+    XCTAssertFalse(groupView3.backViewAttached);
+    XCTAssertEqual([stackView indexOfContentView:[contentViews objectAtIndex:1]], (NSUInteger)NSNotFound);
+    XCTAssertEqual([stackView indexOfContentView:[contentViews objectAtIndex:2]], (NSUInteger)1);
+    XCTAssertEqual(groupView2.backContentView, [stackView groupViewForContentView:[contentViews objectAtIndex:0]]);
+    XCTAssertEqual([stackView.subviews count], (NSUInteger)3);
+    
+    [stackView removeContentView:[contentViews objectAtIndex:3]];
+    XCTAssertEqual([stackView.subviews lastObject], groupView2);
+    XCTAssertEqual([HLSContainerStackViewTestCase depthOfView:[contentViews objectAtIndex:0] inView:stackView], (NSUInteger)4);
+}
+
+- (void)testHierarchyDepth
+{
+    NSArray *contentViews = [HLSContainerStackViewTestCase contentViewsWithCount:kBenchmarkDepth];
+    
+    HLSContainerStackView *nestedStackView = [[HLSContainerStackView alloc] initWithFrame:CGRectMake(0.f, 0.f, 320.f, 480.f)];
+    HLSContainerStackView *flatStackView = [[HLSContainerStackView alloc] initWithFrame:CGRectMake(0.f, 0.f, 320.f, 480.f)];
+    flatStackView.flat = YES;
+    
+    for (UIView *contentView in contentViews) {
+        [nestedStackView insertContentView:contentView atIndex:[nestedStackView.contentViews count]];
+    }
+    XCTAssertEqual([HLSContainerStackViewTestCase depthOfView:[contentViews firstObject] inView:nestedStackView], 2 * kBenchmarkDepth + 1);
+    
+    for (UIView *contentView in contentViews) {
+        [flatStackView insertContentView:contentView atIndex:[flatStackView.contentViews count]];
+    }
+    XCTAssertEqual([HLSContainerStackViewTestCase depthOfView:[contentViews firstObject] inView:flatStackView], (NSUInteger)4);
+}
+
+- (void)testFlatHierarchyRotation
+{
+    HLSStackController *stackController = [HLSContainerStackViewTestCase displayedStackControllerWithFlatViewHierarchy:YES];
+    UIView *rootView = [stackController.rootViewController viewIfLoaded];
+    UIView *topView = [stackController.topViewController viewIfLoaded];
+    XCTAssertNotNil(rootView);
+    
+    // Rotation does not move views around, and leaves the hierarchy flat
+    NSUInteger rootViewDepth = [HLSContainerStackViewTestCase depthOfView:rootView inView:stackController.view];
+    NSUInteger topViewDepth = [HLSContainerStackViewTestCase depthOfView:topView inView:stackController.view];
+    [HLSContainerStackViewTestCase rotateStackController:stackController];
+    XCTAssertEqual([HLSContainerStackViewTestCase depthOfView:rootView inView:stackController.view], rootViewDepth);
+    XCTAssertEqual([HLSContainerStackViewTestCase depthOfView:topView inView:stackController.view], topViewDepth);
+    XCTAssertEqualWithAccuracy(CGRectGetWidth(topView.frame), CGRectGetWidth(stackController.view.bounds), 0.001f);
+    
+    [HLSContainerStackViewTestCase dismissStackController:stackController];
+}
+
+- (void)testNestedPushPopPerformance
+{
+    [self pushPopWithFlatStackView:NO];
+}
+
+- (void)testFlatPushPopPerformance
+{
+    [self pushPopWithFlatStackView:YES];
+}
+
+- (void)testNestedRotationPerformance
+{
+    [self rotateWithFlatViewHierarchy:NO];
+}
+
+- (void)testFlatRotationPerformance
+{
+    [self rotateWithFlatViewHierarchy:YES];
+}
+
+@end
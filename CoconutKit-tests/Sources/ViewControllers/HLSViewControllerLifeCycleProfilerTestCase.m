@@ -0,0 +1,166 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import "HLSViewControllerLifeCycleProfilerTestCase.h"
+
+@interface ProfiledViewController : UIViewController
+
+@end
+
+@implementation ProfiledViewController
+
+@end
+
+@implementation HLSViewControllerLifeCycleProfilerTestCase
+
+#pragma mark Setup and teardown
+
+- (void)setUp
+{
+    [super setUp];
+    
+    [[HLSViewControllerLifeCycleProfiler sharedProfiler] reset];
+    [HLSViewControllerLifeCycleProfiler sharedProfiler].enabled = YES;
+}
+
+- (void)tearDown
+{
+    [super tearDown];
+    
+    [HLSViewControllerLifeCycleProfiler sharedProfiler].enabled = NO;
+    [[HLSViewControllerLifeCycleProfiler sharedProfiler] reset];
+}
+
+#pragma mark Tests
+
+- (void)testInitAndViewLoading
+{
+    HLSViewControllerLifeCycleProfiler *profiler = [HLSViewControllerLifeCycleProfiler sharedProfiler];
+    
+    ProfiledViewController *viewController1 = [[ProfiledViewController alloc] init];
+    ProfiledViewController *viewController2 = [[ProfiledViewController alloc] init];
+    XCTAssertEqual([profiler countForMetric:HLSViewControllerLifeCycleMetricInit viewControllerClass:[ProfiledViewController class]], (NSUInteger)2);
+    XCTAssertEqual([profiler countForMetric:HLSViewControllerLifeCycleMetricViewLoading viewControllerClass:[ProfiledViewController class]], (NSUInteger)0);
+    
+    // Only the first access loads the view
+    XCTAssertNotNil(viewController1.view);
+    XCTAssertNotNil(viewController1.view);
+    XCTAssertNotNil(viewController2.view);
+    XCTAssertEqual([profiler countForMetric:HLSViewControllerLifeCycleMetricViewLoading viewControllerClass:[ProfiledViewController class]], (NSUInteger)2);
+    
+    NSTimeInterval totalDuration = [profiler totalDurationForMetric:HLSViewControllerLifeCycleMetricViewLoading viewControllerClass:[ProfiledViewController class]];
+    NSTimeInterval maximumDuration = [profiler maximumDurationForMetric:HLSViewControllerLifeCycleMetricViewLoading viewControllerClass:[ProfiledViewController class]];
+    XCTAssertTrue(maximumDuration <= totalDuration);
+    
+    // Classes are profiled separately
+    XCTAssertEqual([profiler countForMetric:HLSViewControllerLifeCycleMetricInit viewControllerClass:[UIViewController class]], (NSUInteger)0);
+}
+
+- (void)testAppearanceAndDisappearance
+{
+    HLSViewControllerLifeCycleProfiler *profiler = [HLSViewControllerLifeCycleProfiler sharedProfiler];
+    
+    ProfiledViewController *viewController = [[ProfiledViewController alloc] init];
+    [viewController beginAppearanceTransition:YES animated:NO];
+    XCTAssertEqual([profiler countForMetric:HLSViewControllerLifeCycleMetricAppearance viewControllerClass:[ProfiledViewController class]], (NSUInteger)0);
+    [viewController endAppearanceTransition];
+    XCTAssertEqual([profiler countForMetric:HLSViewControllerLifeCycleMetricAppearance viewControllerClass:[ProfiledViewController class]], (NSUInteger)1);
+    XCTAssertEqual([profiler countForMetric:HLSViewControllerLifeCycleMetricDisappearance viewControllerClass:[ProfiledViewController class]], (NSUInteger)0);
+    
+    [viewController beginAppearanceTransition:NO animated:NO];
+    [viewController endAppearanceTransition];
+    XCTAssertEqual([profiler countForMetric:HLSViewControllerLifeCycleMetricDisappearance viewControllerClass:[ProfiledViewController class]], (NSUInteger)1);
+    XCTAssertEqual([profiler countForMetric:HLSViewControllerLifeCycleMetricAppearance viewControllerClass:[ProfiledViewController class]], (NSUInteger)1);
+    
+    // Not pushed into a container
+    XCTAssertEqual([profiler countForMetric:HLSViewControllerLifeCycleMetricPushToAppearance viewControllerClass:[ProfiledViewController class]], (NSUInteger)0);
+    
+    NSDictionary *classProfileDictionary = [[profiler profileDictionary] objectForKey:NSStringFromClass([ProfiledViewController class])];
+    XCTAssertEqualObjects([[classProfileDictionary objectForKey:@"appearance"] objectForKey:@"count"], @1);
+    XCTAssertEqualObjects([[classProfileDictionary objectForKey:@"disappearance"] objectForKey:@"count"], @1);
+}
+
+- (void)testPushToAppearance
+{
+    HLSViewControllerLifeCycleProfiler *profiler = [HLSViewControllerLifeCycleProfiler sharedProfiler];
+    
+    HLSStackController *stackController = [[HLSStackController alloc] initWithRootViewController:[[UIViewController alloc] init]];
+    UIWindow *keyWindow = [UIApplication sharedApplication].keyWindow;
+    stackController.view.frame = keyWindow.bounds;
+    [stackController beginAppearanceTransition:YES animated:NO];
+    [keyWindow addSubview:stackController.view];
+    [stackController endAppearanceTransition];
+    
+    [stackController pushViewController:[[ProfiledViewController alloc] init] withTransitionClass:[HLSTransitionCoverFromBottom class] animated:NO];
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.3]];
+    XCTAssertEqual([profiler countForMetric:HLSViewControllerLifeCycleMetricPushToAppearance viewControllerClass:[ProfiledViewController class]], (NSUInteger)1);
+    XCTAssertEqual([profiler countForMetric:HLSViewControllerLifeCycleMetricAppearance viewControllerClass:[ProfiledViewController class]], (NSUInteger)1);
+    
+    // The push delay includes the appearance transition
+    NSTimeInterval pushToAppearanceDuration = [profiler totalDurationForMetric:HLSViewControllerLifeCycleMetricPushToAppearance viewControllerClass:[ProfiledViewController class]];
+    NSTimeInterval appearanceDuration = [profiler totalDurationForMetric:HLSViewControllerLifeCycleMetricAppearance viewControllerClass:[ProfiledViewController class]];
+    XCTAssertTrue(appearanceDuration <= pushToAppearanceDuration);
+    
+    // Only measured once per push
+    [stackController popViewControllerAnimated:NO];
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.3]];
+    XCTAssertEqual([profiler countForMetric:HLSViewControllerLifeCycleMetricDisappearance viewControllerClass:[ProfiledViewController class]], (NSUInteger)1);
+    XCTAssertEqual([profiler countForMetric:HLSViewControllerLifeCycleMetricPushToAppearance viewControllerClass:[ProfiledViewController class]], (NSUInteger)1);
+    
+    [stackController beginAppearanceTransition:NO animated:NO];
+    [stackController.view removeFromSuperview];
+    [stackController endAppearanceTransition];
+}
+
+- (void)testDisabled
+{
+    HLSViewControllerLifeCycleProfiler *profiler = [HLSViewControllerLifeCycleProfiler sharedProfiler];
+    profiler.enabled = NO;
+    
+    ProfiledViewController *viewController = [[ProfiledViewController alloc] init];
+    XCTAssertNotNil(viewController.view);
+    XCTAssertEqual([profiler countForMetric:HLSViewControllerLifeCycleMetricInit viewControllerClass:[ProfiledViewController class]], (NSUInteger)0);
+    XCTAssertEqual([profiler countForMetric:HLSViewControllerLifeCycleMetricViewLoading viewControllerClass:[ProfiledViewController class]], (NSUInteger)0);
+    XCTAssertEqual([[profiler profileDictionary] count], (NSUInteger)0);
+}
+
+- (void)testReset
+{
+    HLSViewControllerLifeCycleProfiler *profiler = [HLSViewControllerLifeCycleProfiler sharedProfiler];
+    
+    ProfiledViewController *viewController = [[ProfiledViewController alloc] init];
+    XCTAssertNotNil(viewController);
+    XCTAssertEqual([profiler countForMetric:HLSViewControllerLifeCycleMetricInit viewControllerClass:[ProfiledViewController class]], (NSUInteger)1);
+    
+    [profiler reset];
+    XCTAssertEqual([profiler countForMetric:HLSViewControllerLifeCycleMetricInit viewControllerClass:[ProfiledViewController class]], (NSUInteger)0);
+}
+
+- (void)testProfileDump
+{
+    HLSViewControllerLifeCycleProfiler *profiler = [HLSViewControllerLifeCycleProfiler sharedProfiler];
+    
+    ProfiledViewController *viewController = [[ProfiledViewController alloc] init];
+    XCTAssertNotNil(viewController.view);
+    
+    NSDictionary *classProfileDictionary = [[profiler profileDictionary] objectForKey:NSStringFromClass([ProfiledViewController class])];
+    XCTAssertEqualObjects([[classProfileDictionary objectForKey:@"init"] objectForKey:@"count"], @1);
+    XCTAssertEqualObjects([[classProfileDictionary objectForKey:@"viewLoading"] objectForKey:@"count"], @1);
+    XCTAssertNil([classProfileDictionary objectForKey:@"appearance"]);
+    
+    NSString *filePath = [NSTemporaryDirectory() stringByAppendingPathComponent:@"LifeCycleProfile.json"];
+    NSError *error = nil;
+    XCTAssertTrue([profiler writeProfileToFile:filePath error:&error]);
+    XCTAssertNil(error);
+    
+    NSData *data = [NSData dataWithContentsOfFile:filePath];
+    NSDictionary *readProfileDictionary = [NSJSONSerialization JSONObjectWithData:data options:0 error:NULL];
+    XCTAssertNotNil([readProfileDictionary objectForKey:NSStringFromClass([ProfiledViewController class])]);
+    
+    [[NSFileManager defaultManager] removeItemAtPath:filePath error:NULL];
+}
+
+@end
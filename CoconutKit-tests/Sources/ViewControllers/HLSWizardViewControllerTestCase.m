@@ -0,0 +1,121 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import "HLSWizardViewControllerTestCase.h"
+
+static const NSInteger kPageCount = 25;
+
+@interface WizardPageViewController : UIViewController <HLSValidable>
+
+@property (nonatomic, assign) NSUInteger validationCount;
+
+@end
+
+@implementation WizardPageViewController
+
+- (BOOL)validate
+{
+    ++self.validationCount;
+    return YES;
+}
+
+@end
+
+@interface HLSWizardViewControllerTestCase () <HLSWizardViewControllerDataSource>
+
+@property (nonatomic, strong) NSMutableDictionary *pageToViewControllerMap;         // All pages ever instantiated
+@property (nonatomic, assign) NSUInteger instantiationCount;
+
+@end
+
+@implementation HLSWizardViewControllerTestCase
+
+#pragma mark Setup and teardown
+
+- (void)setUp
+{
+    [super setUp];
+    
+    self.pageToViewControllerMap = [NSMutableDictionary dictionary];
+    self.instantiationCount = 0;
+}
+
+#pragma mark HLSWizardViewControllerDataSource protocol implementation
+
+- (NSInteger)numberOfPagesInWizardViewController:(HLSWizardViewController *)wizardViewController
+{
+    return kPageCount;
+}
+
+- (UIViewController *)wizardViewController:(HLSWizardViewController *)wizardViewController viewControllerForPage:(NSInteger)page
+{
+    ++self.instantiationCount;
+    
+    WizardPageViewController *viewController = [[WizardPageViewController alloc] init];
+    [self.pageToViewControllerMap setObject:viewController forKey:@(page)];
+    return viewController;
+}
+
+#pragma mark Helpers
+
+- (NSUInteger)validationCountForPage:(NSInteger)page
+{
+    WizardPageViewController *viewController = [self.pageToViewControllerMap objectForKey:@(page)];
+    return viewController.validationCount;
+}
+
+#pragma mark Tests
+
+- (void)testLazyPages
+{
+    HLSWizardViewController *wizardViewController = [[HLSWizardViewController alloc] init];
+    wizardViewController.dataSource = self;
+    
+    // Current page and next one only
+    XCTAssertEqual(self.instantiationCount, 2);
+    
+    [wizardViewController moveToPage:1];
+    XCTAssertEqual(self.instantiationCount, 3);
+    
+    // Pages outside the preloading window are released, and requested again when needed
+    [wizardViewController moveToPage:0];
+    [wizardViewController didReceiveMemoryWarning];
+    [wizardViewController moveToPage:1];
+    XCTAssertEqual(self.instantiationCount, 4);
+}
+
+- (void)testValidationOfDirtyPagesOnly
+{
+    HLSWizardViewController *wizardViewController = [[HLSWizardViewController alloc] init];
+    wizardViewController.dataSource = self;
+    
+    [wizardViewController moveToPage:20];
+    for (NSInteger i = 0; i < 20; ++i) {
+        XCTAssertEqual([self validationCountForPage:i], 1);
+    }
+    
+    // Jumping again only validates the current page and those marked as dirty
+    [wizardViewController moveToPage:0];
+    [wizardViewController setNeedsValidationForPage:5];
+    [wizardViewController moveToPage:20];
+    for (NSInteger i = 0; i < 20; ++i) {
+        XCTAssertEqual([self validationCountForPage:i], (i == 0 || i == 5) ? 2 : 1);
+    }
+}
+
+- (void)testLongJumpPerformance
+{
+    [self measureBlock:^{
+        HLSWizardViewController *wizardViewController = [[HLSWizardViewController alloc] init];
+        wizardViewController.dataSource = self;
+        for (NSUInteger i = 0; i < 10; ++i) {
+            [wizardViewController moveToPage:kPageCount - 1];
+            [wizardViewController moveToPage:0];
+        }
+    }];
+}
+
+@end
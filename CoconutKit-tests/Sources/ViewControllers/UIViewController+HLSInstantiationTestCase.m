@@ -0,0 +1,164 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import "UIViewController+HLSInstantiationTestCase.h"
+
+#import "NSBundle+Tests.h"
+#import "UIViewController+HLSInstantiation.h"
+
+// Five-level view controller class hierarchy, without any associated storyboard or nib
+@interface InstantiationLevel1ViewController : HLSViewController
+@end
+
+@implementation InstantiationLevel1ViewController
+@end
+
+@interface InstantiationLevel2ViewController : InstantiationLevel1ViewController
+@end
+
+@implementation InstantiationLevel2ViewController
+@end
+
+@interface InstantiationLevel3ViewController : InstantiationLevel2ViewController
+@end
+
+@implementation InstantiationLevel3ViewController
+@end
+
+@interface InstantiationLevel4ViewController : InstantiationLevel3ViewController
+@end
+
+@implementation InstantiationLevel4ViewController
+@end
+
+@interface InstantiationLevel5ViewController : InstantiationLevel4ViewController
+@end
+
+@implementation InstantiationLevel5ViewController
+@end
+
+// View controllers from InstantiationTests.storyboard, respectively as initial view controller and with an identifier
+@interface InstantiationInitialViewController : HLSViewController
+@end
+
+@implementation InstantiationInitialViewController
+@end
+
+@interface InstantiationIdentifierViewController : HLSViewController
+@end
+
+@implementation InstantiationIdentifierViewController
+@end
+
+@implementation UIViewController_HLSInstantiationTestCase
+
+#pragma mark Helpers
+
+/**
+ * Return a bundle containing a copy of InstantiationTests.storyboard, whose compiled Info.plist has been altered
+ * using the given block
+ */
+- (NSBundle *)bundleWithName:(NSString *)name storyboardInfoAlteredUsingBlock:(void (^)(NSMutableDictionary *info))block
+{
+    NSString *bundlePath = [NSTemporaryDirectory() stringByAppendingPathComponent:[name stringByAppendingPathExtension:@"bundle"]];
+    [[NSFileManager defaultManager] removeItemAtPath:bundlePath error:NULL];
+    [[NSFileManager defaultManager] createDirectoryAtPath:bundlePath withIntermediateDirectories:YES attributes:nil error:NULL];
+    
+    NSString *storyboardPath = [[NSBundle testBundle] pathForResource:@"InstantiationTests" ofType:@"storyboardc"];
+    NSString *copiedStoryboardPath = [bundlePath stringByAppendingPathComponent:[storyboardPath lastPathComponent]];
+    [[NSFileManager defaultManager] copyItemAtPath:storyboardPath toPath:copiedStoryboardPath error:NULL];
+    
+    NSString *infoPath = [copiedStoryboardPath stringByAppendingPathComponent:@"Info.plist"];
+    NSMutableDictionary *info = [NSMutableDictionary dictionaryWithContentsOfFile:infoPath];
+    block(info);
+    [info writeToFile:infoPath atomically:YES];
+    
+    return [NSBundle bundleWithPath:bundlePath];
+}
+
+#pragma mark Tests
+
+- (void)testStoryboardIdentifierInstantiation
+{
+    NSBundle *bundle = [NSBundle testBundle];
+    XCTAssertTrue([UIStoryboard storyboardWithName:@"InstantiationTests" bundle:bundle containsViewControllerWithIdentifier:@"InstantiationIdentifierViewController"]);
+    XCTAssertFalse([UIStoryboard storyboardWithName:@"InstantiationTests" bundle:bundle containsViewControllerWithIdentifier:@"MissingIdentifier"]);
+    
+    InstantiationIdentifierViewController *viewController = [[InstantiationIdentifierViewController alloc] initWithStoryboardName:@"InstantiationTests" bundle:bundle];
+    XCTAssertTrue([viewController isMemberOfClass:[InstantiationIdentifierViewController class]]);
+    
+    // Cached resolution
+    XCTAssertTrue([[[InstantiationIdentifierViewController alloc] initWithStoryboardName:@"InstantiationTests" bundle:bundle] isMemberOfClass:[InstantiationIdentifierViewController class]]);
+}
+
+- (void)testStoryboardInitialInstantiation
+{
+    NSBundle *bundle = [NSBundle testBundle];
+    
+    InstantiationInitialViewController *viewController = [[InstantiationInitialViewController alloc] initWithStoryboardName:@"InstantiationTests" bundle:bundle];
+    XCTAssertTrue([viewController isMemberOfClass:[InstantiationInitialViewController class]]);
+    
+    // Cached resolution
+    XCTAssertTrue([[[InstantiationInitialViewController alloc] initWithStoryboardName:@"InstantiationTests" bundle:bundle] isMemberOfClass:[InstantiationInitialViewController class]]);
+}
+
+- (void)testStoryboardLookupWithoutIdentifierInformation
+{
+    // Private information missing or with an unexpected format: Public API must be used instead
+    NSBundle *missingInfoBundle = [self bundleWithName:@"InstantiationMissingInfo" storyboardInfoAlteredUsingBlock:^(NSMutableDictionary *info) {
+        [info removeObjectForKey:@"UIViewControllerIdentifiersToNibNames"];
+    }];
+    NSBundle *changedInfoBundle = [self bundleWithName:@"InstantiationChangedInfo" storyboardInfoAlteredUsingBlock:^(NSMutableDictionary *info) {
+        [info setObject:[[info objectForKey:@"UIViewControllerIdentifiersToNibNames"] allKeys] ?: @[] forKey:@"UIViewControllerIdentifiersToNibNames"];
+    }];
+    
+    for (NSBundle *bundle in @[missingInfoBundle, changedInfoBundle]) {
+        XCTAssertTrue([UIStoryboard storyboardWithName:@"InstantiationTests" bundle:bundle containsViewControllerWithIdentifier:@"InstantiationIdentifierViewController"]);
+        XCTAssertFalse([UIStoryboard storyboardWithName:@"InstantiationTests" bundle:bundle containsViewControllerWithIdentifier:@"MissingIdentifier"]);
+        XCTAssertTrue([[[InstantiationIdentifierViewController alloc] initWithStoryboardName:@"InstantiationTests" bundle:bundle] isMemberOfClass:[InstantiationIdentifierViewController class]]);
+        
+        [[NSFileManager defaultManager] removeItemAtPath:[bundle bundlePath] error:NULL];
+    }
+}
+
+- (void)testInstantiationWithoutResources
+{
+    NSBundle *bundle = [NSBundle bundleForClass:[self class]];
+    
+    InstantiationLevel5ViewController *viewController = [[InstantiationLevel5ViewController alloc] initWithBundle:bundle];
+    XCTAssertNotNil(viewController);
+    XCTAssertTrue([viewController isMemberOfClass:[InstantiationLevel5ViewController class]]);
+    XCTAssertNil(viewController.nibName);
+    
+    // Cached resolution
+    XCTAssertNotNil([[InstantiationLevel5ViewController alloc] initWithBundle:bundle]);
+    
+    XCTAssertNil([[InstantiationLevel5ViewController alloc] initWithStoryboardName:@"MissingStoryboard" bundle:bundle]);
+}
+
+- (void)testStoryboardLookupWithoutExceptions
+{
+    NSBundle *bundle = [NSBundle bundleForClass:[self class]];
+    XCTAssertNil([UIStoryboard sharedStoryboardWithName:@"MissingStoryboard" bundle:bundle]);
+    XCTAssertFalse([UIStoryboard storyboardWithName:@"MissingStoryboard" bundle:bundle containsViewControllerWithIdentifier:@"Identifier"]);
+}
+
+- (void)testInstantiationPerformance
+{
+    // Each instantiation used to look up a storyboard and a nib for each class in the hierarchy, from
+    // InstantiationLevel5ViewController up to NSObject
+    NSBundle *bundle = [NSBundle bundleForClass:[self class]];
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 1000; ++i) {
+            @autoreleasepool {
+                InstantiationLevel5ViewController *viewController = [[InstantiationLevel5ViewController alloc] initWithBundle:bundle];
+                XCTAssertNotNil(viewController);
+            }
+        }
+    }];
+}
+
+@end
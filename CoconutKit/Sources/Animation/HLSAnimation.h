@@ -43,9 +43,10 @@ typedef void (^HLSAnimationCompletionBlock)(BOOL animated);
  * Animations can be played animated or not (yeah, that sounds weird, but I called it that way :-) ). When played
  * non-animated, an animation reaches its end state instantaneously.
  *
- * Running animations (this includes animations which have been paused) are automatically paused and resumed (if they
- * were running before) when the application enters, respectively exits background. Note that this mechanism works 
- * perfectly within the iOS simulator and on the device, though views will appear to "jump" on the device and on
+ * Running animations (this includes animations which have been paused) are automatically suspended and resumed when 
+ * the application enters, respectively exits background. The step being played is stopped, and played again from
+ * where it was suspended when the application wakes up, after its objects have been restored to the state they had
+ * when the step began (no other step is played again). Note that views will appear to "jump" on the device and on
  * iOS >= 6 simulators. This is not a bug and has no negative effect on the animation behavior (in particular, delegate 
  * methods are still called correctly), but is a consequence of the application screenshot which is displayed when 
  * the application exits background. The screenshot made when the application enters background namely reflects the
@@ -138,6 +139,9 @@ typedef void (^HLSAnimationCompletionBlock)(BOOL animated);
  *
  * Remark: Core Animation steps support arbitrary start times. For UIView-based animation steps, the animation
  *         starts at the end of the step which startTime belongs to
+ *
+ * The steps completed before startTime are not replayed one by one. Their combined effect is calculated instead, and
+ * each animated view or layer is updated once, so that seeking in long animations remains cheap
  */
 - (void)playWithStartTime:(NSTimeInterval)startTime;
 
@@ -8,11 +8,13 @@
 
 #import "HLSAnimationStep+Friend.h"
 #import "HLSAssert.h"
+#import "HLSLayerAnimation.h"
 #import "HLSLayerAnimationStep.h"
 #import "HLSLogger.h"
 #import "HLSTransformer.h"
 #import "HLSUserInterfaceLock.h"
 #import "HLSMAZeroingWeakRef.h"
+#import "HLSViewAnimation.h"
 #import "NSArray+HLSExtensions.h"
 #import "NSString+HLSExtensions.h"
 
@@ -25,15 +27,21 @@
 
 static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
 
+static NSHashTable *s_runningAnimations = nil;                      // weak references to the animations currently running
+static NSMutableSet *s_suspendedAnimations = nil;                   // animations suspended while the application is in background
+
+// Function declarations
+static void applyObjectStates(NSDictionary *objectKeyToStateMap);
+
 @interface HLSAnimation () <HLSAnimationStepDelegate>  {
 @private
     BOOL _animated;
     NSUInteger _repeatCount;
     NSUInteger _currentRepeatCount;
     NSTimeInterval _remainingTimeBeforeStart;                      // the time remaining before the start time is reached
-    NSTimeInterval _elapsedTime;                                   // the currently elapsed time (does not include pauses)
-    BOOL _runningBeforeEnteringBackground;                         // was the animation running before the application entered background?
-    BOOL _pausedBeforeEnteringBackground;                          // was the animation paused before the application entered background?
+    BOOL _suspended;                                               // has the animation been suspended when the application entered background?
+    BOOL _pausedBeforeSuspension;                                  // was the animation paused when it was suspended?
+    NSTimeInterval _suspensionStepElapsedTime;                     // the time elapsed in the current step when the animation was suspended
 }
 
 @property (nonatomic, strong) NSArray *animationSteps;                          // a copy of the HLSAnimationSteps passed at initialization time
@@ -53,6 +61,27 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
 
 #pragma mark Class methods
 
++ (void)initialize
+{
+    // Perform initialization once for the whole inheritance hierarchy
+    if (self != [HLSAnimation class]) {
+        return;
+    }
+    
+    s_runningAnimations = [NSHashTable weakObjectsHashTable];
+    s_suspendedAnimations = [NSMutableSet set];
+    
+    // A single observer for all animations, which only need to be registered while they are running
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(applicationDidEnterBackground:)
+                                                 name:UIApplicationDidEnterBackgroundNotification
+                                               object:nil];
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(applicationWillEnterForeground:)
+                                                 name:UIApplicationWillEnterForegroundNotification
+                                               object:nil];
+}
+
 + (instancetype)animationWithAnimationSteps:(NSArray *)animationSteps
 {
     return [[[self class] alloc] initWithAnimationSteps:animationSteps];
@@ -88,28 +117,12 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
             HLSAssertObjectsInEnumerationAreKindOfClass(animationSteps, HLSAnimationStep);
             self.animationSteps = [HLSAnimation duplicateAnimationSteps:animationSteps];
         }
-        
-        [[NSNotificationCenter defaultCenter] addObserver:self
-                                                 selector:@selector(applicationDidEnterBackground:)
-                                                     name:UIApplicationDidEnterBackgroundNotification
-                                                   object:nil];
-        [[NSNotificationCenter defaultCenter] addObserver:self
-                                                 selector:@selector(applicationWillEnterForeground:)
-                                                     name:UIApplicationWillEnterForegroundNotification
-                                                   object:nil];
     }
     return self;
 }
 
 - (void)dealloc
 {
-    [[NSNotificationCenter defaultCenter] removeObserver:self
-                                                    name:UIApplicationDidEnterBackgroundNotification
-                                                  object:nil];
-    [[NSNotificationCenter defaultCenter] removeObserver:self
-                                                    name:UIApplicationWillEnterForegroundNotification
-                                                  object:nil];
-    
     [self cancel];
 }
 
@@ -117,6 +130,10 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
 
 - (BOOL)isPaused
 {
+    if (_suspended) {
+        return _pausedBeforeSuspension;
+    }
+    
     return [self.currentAnimationStep isPaused];
 }
 
@@ -223,6 +240,8 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
                 
         self.running = YES;
         self.playing = YES;
+        
+        [s_runningAnimations addObject:self];
     
         // Lock the UI during the animation
         if (self.lockingUI) {
@@ -238,7 +257,6 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
     _repeatCount = repeatCount;
     _currentRepeatCount = currentRepeatCount;
     _remainingTimeBeforeStart = startTime;
-    _elapsedTime = 0.;
     
     // Create a dummy animation step to simulate the delay. This way we avoid two potential issues:
     //   - if an animation step subclass is implemented using an animation framework which does not support delays,
@@ -281,7 +299,7 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
 {
     // First call?
     if (! self.animationStepsEnumerator) {
-        self.animationStepsEnumerator = [self.animationStepCopies objectEnumerator];
+        self.animationStepsEnumerator = [[self animationStepsAfterSeekingInAnimationSteps:self.animationStepCopies] objectEnumerator];
     }
     
     // Proceeed with the next step (if any)
@@ -326,6 +344,8 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
             }
             
             // End of the animation
+            [s_runningAnimations removeObject:self];
+            
             self.running = NO;
             self.cancelling = NO;
             self.terminating = NO;
@@ -341,6 +361,35 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
     }
 }
 
+/**
+ * Animation steps completing before the start time are not played one by one. Their combined effect is calculated 
+ * instead, and each animated object is updated once. Return the animation steps which still need to be played (steps 
+ * which cannot be evaluated are played instantaneously as usual, see -playAnimationStep:animated:)
+ */
+- (NSArray *)animationStepsAfterSeekingInAnimationSteps:(NSArray *)animationSteps
+{
+    if (! isgreater(_remainingTimeBeforeStart, 0.)) {
+        return animationSteps;
+    }
+    
+    NSMutableDictionary *objectKeyToStateMap = [NSMutableDictionary dictionary];
+    NSUInteger numberOfCompletedAnimationSteps = 0;
+    for (HLSAnimationStep *animationStep in animationSteps) {
+        if (! isgreater(_remainingTimeBeforeStart, animationStep.duration)
+                || ! [animationStep applyToObjectStates:objectKeyToStateMap]) {
+            break;
+        }
+        
+        // Same bookkeeping as if the animation step had been played
+        _remainingTimeBeforeStart -= animationStep.duration;
+        ++numberOfCompletedAnimationSteps;
+    }
+    
+    applyObjectStates(objectKeyToStateMap);
+    
+    return [animationSteps subarrayWithRange:NSMakeRange(numberOfCompletedAnimationSteps, [animationSteps count] - numberOfCompletedAnimationSteps)];
+}
+
 - (void)pause
 {
     if (! self.running) {
@@ -358,6 +407,11 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
         return;
     }
     
+    if (_suspended) {
+        _pausedBeforeSuspension = YES;
+        return;
+    }
+    
     [self.currentAnimationStep pause];
 }
 
@@ -368,6 +422,11 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
         return;
     }
     
+    if (_suspended) {
+        _pausedBeforeSuspension = NO;
+        return;
+    }
+    
     [self.currentAnimationStep resume];
 }
 
@@ -385,6 +444,13 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
     
     self.cancelling = YES;
     
+    // The current step of a suspended animation has already been stopped. Simply end the animation
+    if (_suspended) {
+        _suspended = NO;
+        [self animationStepDidStop:self.currentAnimationStep animated:NO finished:NO];
+        return;
+    }
+    
     // Cancel all animations
     [self.currentAnimationStep terminate];
 }
@@ -403,6 +469,13 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
     
     self.terminating = YES;
     
+    // The current step of a suspended animation has already been stopped. Simply end the animation
+    if (_suspended) {
+        _suspended = NO;
+        [self animationStepDidStop:self.currentAnimationStep animated:NO finished:NO];
+        return;
+    }
+    
     // Cancel all animations
     [self.currentAnimationStep terminate];
 }
@@ -474,6 +547,11 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
 
 - (void)animationStepDidStop:(HLSAnimationStep *)animationStep animated:(BOOL)animated finished:(BOOL)finished
 {
+    // The current step of a suspended animation has been stopped. The animation stays where it is until resumed
+    if (_suspended) {
+        return;
+    }
+    
     // Still send all delegate notifications if terminating and if not playing animation steps instantaneously
     // when a start time has been set
     if (! self.cancelling && _remainingTimeBeforeStart == 0.) {
@@ -500,11 +578,6 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
         }
     }
     
-    // We accumulate the effective duration of the animation which has been run until now
-    if (! self.cancelling && ! self.terminating) {
-        _elapsedTime += [self.currentAnimationStep duration];
-    }
-    
     // Play the next step (or the first step if the initial delay animation step has ended(), but non-animated if the
     // animation did not reach completion normally. Moreover, if some animation steps are played non-animated because
     // a start time has been set, we must override animated = NO with the original _animated value of the animation
@@ -538,41 +611,71 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
     return animationCopy;
 }
 
-#pragma mark Notification callbacks
+#pragma mark Suspension
 
-- (void)applicationDidEnterBackground:(NSNotification *)notification
+/**
+ * Core Animations are removed when the application enters background, which makes it impossible to simply resume 
+ * them when the application wakes up. Instead of rewinding and replaying animations, the current step is stopped and
+ * the time elapsed in it is recorded. When the application enters foreground again, the objects it animates are 
+ * restored to the state they had when the step began, and the step is played again from where it was suspended.
+ * The remaining delegate events are then received as usual
+ *
+ * Return YES iff the animation has been suspended
+ */
+- (BOOL)suspend
 {
-    _runningBeforeEnteringBackground = self.running;
+    if (! self.running || _suspended || self.cancelling || self.terminating) {
+        return NO;
+    }
     
-    if (_runningBeforeEnteringBackground) {
-        // Core Animations are removed and added back again automatically when the application enters / leaves background. This makes
-        // it very hard to resume running animations after the application wakes up, since we have no real control over this process.
-        // But since HLSAnimations can be given a start time, we can apply the following strategy to solve those issues:
-        //   1) Remember how much time has elapsed and cancel the animation when the application enters background. The remaining
-        //      delegate events are not received
-        //   2) Rewind the animation at the beginning, without a delegate
-        //   3) Play the animation from where it was cancelled when the application enters foreground
-        _elapsedTime += [self.currentAnimationStep elapsedTime];
-        _pausedBeforeEnteringBackground = self.paused;
-        
-        [self cancel];
-        
-        HLSAnimation *reverseAnimation = [self reverseAnimation];
-        reverseAnimation.delegate = nil;
-        [reverseAnimation playAnimated:NO];
+    _suspensionStepElapsedTime = MIN(MAX([self.currentAnimationStep elapsedTime], 0.), [self.currentAnimationStep duration]);
+    _pausedBeforeSuspension = self.paused;
+    _suspended = YES;
+    
+    [self.currentAnimationStep terminate];
+    return YES;
+}
+
+- (void)resumeAfterSuspension
+{
+    if (! _suspended) {
+        return;
+    }
+    
+    _suspended = NO;
+    
+    // Steps carry state information and cannot be played twice. Play a fresh copy instead
+    HLSAnimationStep *animationStep = self.currentAnimationStep;
+    applyObjectStates([animationStep initialObjectStates]);
+    
+    self.currentAnimationStep = [animationStep copy];
+    _remainingTimeBeforeStart = _suspensionStepElapsedTime;
+    [self playAnimationStep:self.currentAnimationStep animated:YES];
+    
+    if (_pausedBeforeSuspension) {
+        [self pause];
     }
 }
 
-- (void)applicationWillEnterForeground:(NSNotification *)notification
+#pragma mark Notification callbacks
+
++ (void)applicationDidEnterBackground:(NSNotification *)notification
 {
-    if (_runningBeforeEnteringBackground) {
-        [self playWithStartTime:_elapsedTime repeatCount:_repeatCount];
-        if (_pausedBeforeEnteringBackground) {
-            [self pause];
+    for (HLSAnimation *animation in [s_runningAnimations allObjects]) {
+        if ([animation suspend]) {
+            [s_suspendedAnimations addObject:animation];
         }
-        
-        _runningBeforeEnteringBackground = NO;
-        _pausedBeforeEnteringBackground = NO;
+    }
+}
+
++ (void)applicationWillEnterForeground:(NSNotification *)notification
+{
+    // Suspended animations are retained until they have been resumed
+    NSSet *suspendedAnimations = [NSSet setWithSet:s_suspendedAnimations];
+    [s_suspendedAnimations removeAllObjects];
+    
+    for (HLSAnimation *animation in suspendedAnimations) {
+        [animation resumeAfterSuspension];
     }
 }
 
@@ -590,3 +693,22 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
 }
 
 @end
+
+#pragma mark Static functions
+
+static void applyObjectStates(NSDictionary *objectKeyToStateMap)
+{
+    [objectKeyToStateMap enumerateKeysAndObjectsUsingBlock:^(NSValue *objectKey, NSValue *stateValue, BOOL *stop) {
+        id object = [objectKey nonretainedObjectValue];
+        if (strcmp([stateValue objCType], @encode(HLSLayerAnimationState)) == 0) {
+            HLSLayerAnimationState state;
+            [stateValue getValue:&state];
+            HLSLayerApplyAnimationState(object, state);
+        }
+        else if (strcmp([stateValue objCType], @encode(HLSViewAnimationState)) == 0) {
+            HLSViewAnimationState state;
+            [stateValue getValue:&state];
+            HLSViewApplyAnimationState(object, state);
+        }
+    }];
+}
@@ -49,6 +49,20 @@
  */
 - (id)reverseAnimationStep;
 
+/**
+ * Compose the effect of the animation step with the object states stored in the given dictionary (keyed by non-retained 
+ * object values), without altering the objects themselves. States of objects missing from the dictionary are read from
+ * the objects first. Return NO if the effect of the step cannot be evaluated this way, in which case the dictionary is
+ * left unchanged
+ */
+- (BOOL)applyToObjectStates:(NSMutableDictionary *)objectKeyToStateMap;
+
+/**
+ * The states of the animated objects before the step was last played animated, keyed by non-retained object values
+ * (in the same format as for -applyToObjectStates:)
+ */
+- (NSDictionary *)initialObjectStates;
+
 /**
  * Return YES iff the animation has been paused
  */
@@ -98,6 +98,13 @@
  */
 - (NSTimeInterval)elapsedTime;
 
+/**
+ * Subclasses must call this method for each object they animate when the step is played animated, with the state 
+ * of the object before it is altered (an NSValue wrapping an HLSLayerAnimationState or an HLSViewAnimationState). 
+ * This makes it possible to restore the objects and play the step again after it has been suspended
+ */
+- (void)saveInitialStateValue:(NSValue *)stateValue forObject:(id)object;
+
 /**
  * Return a string describing the involved object animations
  */
@@ -17,6 +17,7 @@
 
 @property (nonatomic, strong) NSMutableArray *objectKeys;
 @property (nonatomic, strong) NSMutableDictionary *objectToObjectAnimationMap;
+@property (nonatomic, strong) NSMutableDictionary *objectKeyToInitialStateMap;
 @property (nonatomic, strong) id<HLSAnimationStepDelegate> delegate;        // Set during animated animations to retain the delegate
 @property (nonatomic, assign, getter=isCancelling) BOOL terminating;
 
@@ -38,6 +39,7 @@
     if (self = [super init]) {
         self.objectKeys = [NSMutableArray array];
         self.objectToObjectAnimationMap = [NSMutableDictionary dictionary];
+        self.objectKeyToInitialStateMap = [NSMutableDictionary dictionary];
         
         // Default animation settings (as given in UIKit documentation)
         self.duration = 0.2;        
@@ -108,6 +110,7 @@
 - (void)playWithDelegate:(id<HLSAnimationStepDelegate>)delegate startTime:(NSTimeInterval)startTime animated:(BOOL)animated
 {
     self.terminating = NO;
+    [self.objectKeyToInitialStateMap removeAllObjects];
     
     // We do not perform the animation if the duration is 0 (this can lead to unnecessary flickering in animations)
     BOOL actuallyAnimated = animated && (self.duration - startTime != 0.);
@@ -204,6 +207,26 @@
     return 0.;
 }
 
+#pragma mark Object states
+
+- (void)saveInitialStateValue:(NSValue *)stateValue forObject:(id)object
+{
+    [self.objectKeyToInitialStateMap setObject:stateValue forKey:[NSValue valueWithNonretainedObject:object]];
+}
+
+- (NSDictionary *)initialObjectStates
+{
+    return [NSDictionary dictionaryWithDictionary:self.objectKeyToInitialStateMap];
+}
+
+#pragma mark Evaluating the animation
+
+- (BOOL)applyToObjectStates:(NSMutableDictionary *)objectKeyToStateMap
+{
+    // Cannot be evaluated without being played by default
+    return NO;
+}
+
 #pragma mark Reverse animation
 
 - (id)reverseAnimationStep
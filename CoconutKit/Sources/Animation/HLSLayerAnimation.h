@@ -8,6 +8,34 @@
 
 #import <CoreGraphics/CoreGraphics.h>
 #import <Foundation/Foundation.h>
+#import <QuartzCore/QuartzCore.h>
+
+/**
+ * The layer properties altered by layer animations. A state can be read from a layer, transformed by applying layer
+ * animations to it, and written back to a layer. Applying layer animations to a state is a pure calculation which 
+ * does not involve any layer, so that the effect of several animations can be composed before being written once
+ */
+typedef struct {
+    CGFloat opacity;
+    CATransform3D transform;
+    CGPoint anchorPoint;
+    CGFloat anchorPointZ;
+    BOOL shouldRasterize;
+    CGFloat rasterizationScale;
+    CATransform3D nonProjectedSublayerTransform;            // The sublayer transform, without perspective
+    CGFloat sublayerCameraZPosition;                        // The position of the camera from which sublayers are seen
+} HLSLayerAnimationState;
+
+/**
+ * Read the current state of a layer, respectively write a state to a layer (without animation)
+ */
+OBJC_EXPORT HLSLayerAnimationState HLSLayerAnimationStateForLayer(CALayer *layer);
+OBJC_EXPORT void HLSLayerApplyAnimationState(CALayer *layer, HLSLayerAnimationState state);
+
+/**
+ * The sublayer transform corresponding to a state (i.e. including perspective)
+ */
+OBJC_EXPORT CATransform3D HLSLayerAnimationStateSublayerTransform(HLSLayerAnimationState state);
 
 /**
  * A layer animation (HLSLayerAnimation) describes the changes applied to a layer within an animation step
@@ -105,4 +133,9 @@
  */
 - (void)addToRasterizationScale:(CGFloat)rasterizationScaleIncrement;
 
+/**
+ * Return the state obtained when the layer animation is applied to a layer in the specified state
+ */
+- (HLSLayerAnimationState)stateByApplyingToState:(HLSLayerAnimationState)state;
+
 @end
@@ -11,6 +11,9 @@
 #import "HLSVector.h"
 #import "NSString+HLSExtensions.h"
 
+static NSString * const kLayerNonProjectedSublayerTransformKey = @"HLSNonProjectedSublayerTransform";
+static NSString * const kLayerCameraZPositionForSublayersKey = @"HLSLayerCameraZPositionForSublayers";
+
 /**
  * Just a few important remarks about transforms (CATransform3D and CGAffineTransform):
  *   - transforms are applied on the right: F' = F * T, where F is a frame (this is what CGRectApplyAffineTransform
@@ -240,6 +243,53 @@
     self.rasterizationScaleIncrement = rasterizationScaleIncrement;
 }
 
+#pragma mark Applying the animation
+
+- (HLSLayerAnimationState)stateByApplyingToState:(HLSLayerAnimationState)state
+{
+    HLSLayerAnimationState resultState = state;
+    
+    // Opacity (must always lie between -1.f and 1.f)
+    resultState.opacity = state.opacity + self.opacityIncrement;
+    if (isless(resultState.opacity, -1.f)) {
+        HLSLoggerWarn(@"Layer animations adding to an opacity value larger than -1. Fixed to -1, but your animation is incorrect");
+        resultState.opacity = -1.f;
+    }
+    else if (isgreater(resultState.opacity, 1.f)) {
+        HLSLoggerWarn(@"Layer animations adding to an opacity value larger than 1. Fixed to 1, but your animation is incorrect");
+        resultState.opacity = 1.f;
+    }
+    
+    // The transform has to be applied on the layer center. This requires a conversion in the coordinate system centered
+    // on the layer
+    CATransform3D translationTransform = CATransform3DMakeTranslation(-state.transform.m41, -state.transform.m42, 0.f);
+    CATransform3D convTransform = CATransform3DConcat(CATransform3DConcat(translationTransform, [self transform]),
+                                                      CATransform3DInvert(translationTransform));
+    resultState.transform = CATransform3DConcat(state.transform, convTransform);
+    
+    // Anchor point
+    resultState.anchorPoint = CGPointMake(state.anchorPoint.x + self.anchorPointTranslationParameters.v1,
+                                          state.anchorPoint.y + self.anchorPointTranslationParameters.v2);
+    resultState.anchorPointZ = state.anchorPointZ + self.anchorPointTranslationParameters.v3;
+    
+    // Rasterization
+    if (self.togglingShouldRasterize) {
+        resultState.shouldRasterize = ! state.shouldRasterize;
+    }
+    resultState.rasterizationScale = state.rasterizationScale + self.rasterizationScaleIncrement;
+    
+    // Sublayer transform (without perspective component) and camera position
+    CATransform3D sublayerTranslationTransform = CATransform3DMakeTranslation(-state.nonProjectedSublayerTransform.m41,
+                                                                              -state.nonProjectedSublayerTransform.m42,
+                                                                              0.f);
+    CATransform3D sublayerConvTransform = CATransform3DConcat(CATransform3DConcat(sublayerTranslationTransform, [self sublayerTransform]),
+                                                              CATransform3DInvert(sublayerTranslationTransform));
+    resultState.nonProjectedSublayerTransform = CATransform3DConcat(state.nonProjectedSublayerTransform, sublayerConvTransform);
+    resultState.sublayerCameraZPosition = state.sublayerCameraZPosition + self.sublayerCameraTranslationZ;
+    
+    return resultState;
+}
+
 #pragma mark Reverse animation
 
 - (id)reverseObjectAnimation
@@ -318,3 +368,62 @@
 }
 
 @end
+
+#pragma mark Functions
+
+HLSLayerAnimationState HLSLayerAnimationStateForLayer(CALayer *layer)
+{
+    HLSLayerAnimationState state;
+    state.opacity = layer.opacity;
+    state.transform = layer.transform;
+    state.anchorPoint = layer.anchorPoint;
+    state.anchorPointZ = layer.anchorPointZ;
+    state.shouldRasterize = layer.shouldRasterize;
+    state.rasterizationScale = layer.rasterizationScale;
+    
+    // Get the sublayer transform without its perspective component, and the camera position (saved as additional layer
+    // information)
+    NSValue *nonProjectedSublayerTransformValue = [layer valueForKey:kLayerNonProjectedSublayerTransformKey];
+    if (nonProjectedSublayerTransformValue) {
+        state.nonProjectedSublayerTransform = [nonProjectedSublayerTransformValue CATransform3DValue];
+    }
+    else {
+        state.nonProjectedSublayerTransform = layer.sublayerTransform;
+    }
+    
+    NSNumber *sublayerCameraZPositionNumber = [layer valueForKey:kLayerCameraZPositionForSublayersKey];
+    if (sublayerCameraZPositionNumber) {
+        state.sublayerCameraZPosition = [sublayerCameraZPositionNumber floatValue];
+    }
+    else {
+        state.sublayerCameraZPosition = (layer.sublayerTransform.m34 == 0.f) ? 0.f : 1.f / layer.sublayerTransform.m34;
+    }
+    
+    return state;
+}
+
+void HLSLayerApplyAnimationState(CALayer *layer, HLSLayerAnimationState state)
+{
+    layer.opacity = state.opacity;
+    layer.transform = state.transform;
+    layer.anchorPoint = state.anchorPoint;
+    layer.anchorPointZ = state.anchorPointZ;
+    layer.shouldRasterize = state.shouldRasterize;
+    layer.rasterizationScale = state.rasterizationScale;
+    
+    // Save the information relative / not relative to the perspective separately
+    [layer setValue:@(state.sublayerCameraZPosition) forKey:kLayerCameraZPositionForSublayersKey];
+    [layer setValue:[NSValue valueWithCATransform3D:state.nonProjectedSublayerTransform] forKey:kLayerNonProjectedSublayerTransformKey];
+    layer.sublayerTransform = HLSLayerAnimationStateSublayerTransform(state);
+}
+
+CATransform3D HLSLayerAnimationStateSublayerTransform(HLSLayerAnimationState state)
+{
+    // Create the perspective matrix (see http://en.wikipedia.org/wiki/3D_projection#Perspective_projection)
+    CATransform3D perspectiveProjectionTransform = CATransform3DIdentity;
+    if (state.sublayerCameraZPosition != 0.f) {
+        perspectiveProjectionTransform.m34 = -1.f / state.sublayerCameraZPosition;
+    }
+    
+    return CATransform3DConcat(state.nonProjectedSublayerTransform, perspectiveProjectionTransform);
+}
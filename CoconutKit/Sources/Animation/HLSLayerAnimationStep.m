@@ -8,8 +8,8 @@
 
 #import "CALayer+HLSExtensions.h"
 #import "CAMediaTimingFunction+HLSExtensions.h"
+#import "HLSAnimationStep+Friend.h"
 #import "HLSAnimationStep+Protected.h"
-#import "HLSLayerAnimation+Friend.h"
 #import "HLSLogger.h"
 
 #if TARGET_IPHONE_SIMULATOR
@@ -19,9 +19,6 @@
 static NSString * const kLayerAnimationGroupKey = @"HLSLayerAnimationGroup";
 static NSString * const kDummyViewLayerAnimationKey = @"HLSDummyViewLayerAnimation";
 
-static NSString * const kLayerNonProjectedSublayerTransformKey = @"HLSNonProjectedSublayerTransform";
-static NSString * const kLayerCameraZPositionForSublayersKey = @"HLSLayerCameraZPositionForSublayers";
-
 // Remark: CoreAnimation default settings are duration = 0.25 and linear timing function, but
 //         to be consistent with UIView block-based animations we do not override the default
 //         duration received from HLSAnimationStep (0.2) and set an ease-in ease-out function
@@ -116,132 +113,51 @@ static NSString * const kLayerCameraZPositionForSublayersKey = @"HLSLayerCameraZ
         // Remark: For each property we animate, we still must set the final value manually (CoreAnimations animate properties
         // but do not set them). Since we do not need to support delays (which are implemented at the HLSAnimation level), we
         // can do it right here, eliminating potentially flickering animations (for more information, see HLSAnimation.m)
-        NSMutableArray *animations = [NSMutableArray array];
-        
-        // Opacity animation (opacity must always lie between 0.f and 1.f)
-        CGFloat opacity = layer.opacity + layerAnimation.opacityIncrement;
-        if (isless(opacity, -1.f)) {
-            HLSLoggerWarn(@"Layer animations adding to an opacity value larger than -1 for layer %@. Fixed to -1, but your animation is incorrect", layer);
-            opacity = -1.f;
-        }
-        else if (isgreater(opacity, 1.f)) {
-            HLSLoggerWarn(@"Layer animations adding to an opacity value larger than 1 for layer %@. Fixed to 1, but your animation is incorrect", layer);
-            opacity = 1.f;
-        }
+        HLSLayerAnimationState fromState = HLSLayerAnimationStateForLayer(layer);
+        HLSLayerAnimationState toState = [layerAnimation stateByApplyingToState:fromState];
         
+        NSMutableArray *animations = [NSMutableArray array];
         if (animated) {
+            [self saveInitialStateValue:[NSValue valueWithBytes:&fromState objCType:@encode(HLSLayerAnimationState)] forObject:layer];
+            
             CABasicAnimation *opacityAnimation = [CABasicAnimation animationWithKeyPath:@"opacity"];
-            [opacityAnimation setFromValue:@(layer.opacity)];
-            [opacityAnimation setToValue:@(opacity)];
+            [opacityAnimation setFromValue:@(fromState.opacity)];
+            [opacityAnimation setToValue:@(toState.opacity)];
             [animations addObject:opacityAnimation];
-        }
-        layer.opacity = opacity;
-        
-        // Animate the transform. The transform has to be applied on the layer center. This requires a conversion in the coordinate system
-        // centered on the layer
-        CATransform3D translationTransform = CATransform3DMakeTranslation(-layer.transform.m41, -layer.transform.m42, 0.f);
-        CATransform3D convTransform = CATransform3DConcat(CATransform3DConcat(translationTransform, layerAnimation.transform),
-                                                          CATransform3DInvert(translationTransform));
-        CATransform3D transform = CATransform3DConcat(layer.transform, convTransform);
-        
-        if (animated) {
+            
             CABasicAnimation *transformAnimation = [CABasicAnimation animationWithKeyPath:@"transform"];
-            [transformAnimation setFromValue:[NSValue valueWithCATransform3D:layer.transform]];
-            [transformAnimation setToValue:[NSValue valueWithCATransform3D:transform]];
+            [transformAnimation setFromValue:[NSValue valueWithCATransform3D:fromState.transform]];
+            [transformAnimation setToValue:[NSValue valueWithCATransform3D:toState.transform]];
             [animations addObject:transformAnimation];
-        }
-        layer.transform = transform;
-        
-        // Animate the anchor point
-        CGPoint anchorPoint = CGPointMake(layer.anchorPoint.x + layerAnimation.anchorPointTranslationParameters.v1,
-                                          layer.anchorPoint.y + layerAnimation.anchorPointTranslationParameters.v2);
-        CGFloat anchorPointZ = layer.anchorPointZ + layerAnimation.anchorPointTranslationParameters.v3;
-        
-        if (animated) {
+            
             CABasicAnimation *anchorPointAnimation = [CABasicAnimation animationWithKeyPath:@"anchorPoint"];
-            [anchorPointAnimation setFromValue:[NSValue valueWithCGPoint:layer.anchorPoint]];
-            [anchorPointAnimation setToValue:[NSValue valueWithCGPoint:anchorPoint]];
+            [anchorPointAnimation setFromValue:[NSValue valueWithCGPoint:fromState.anchorPoint]];
+            [anchorPointAnimation setToValue:[NSValue valueWithCGPoint:toState.anchorPoint]];
             [animations addObject:anchorPointAnimation];
             
             CABasicAnimation *anchorPointZAnimation = [CABasicAnimation animationWithKeyPath:@"anchorPointZ"];
-            [anchorPointZAnimation setFromValue:@(layer.anchorPointZ)];
-            [anchorPointZAnimation setToValue:@(anchorPointZ)];
+            [anchorPointZAnimation setFromValue:@(fromState.anchorPointZ)];
+            [anchorPointZAnimation setToValue:@(toState.anchorPointZ)];
             [animations addObject:anchorPointZAnimation];
-        }
-        layer.anchorPoint = anchorPoint;
-        layer.anchorPointZ = anchorPointZ;
-        
-        // Rasterization
-        if (layerAnimation.togglingShouldRasterize) {
-            BOOL shouldRasterize = ! layer.shouldRasterize;
-            if (animated) {
+            
+            if (layerAnimation.togglingShouldRasterize) {
                 CABasicAnimation *shouldRasterizeAnimation = [CABasicAnimation animationWithKeyPath:@"shouldRasterize"];
-                [shouldRasterizeAnimation setFromValue:@(layer.shouldRasterize)];
-                [shouldRasterizeAnimation setToValue:@(shouldRasterize)];
+                [shouldRasterizeAnimation setFromValue:@(fromState.shouldRasterize)];
+                [shouldRasterizeAnimation setToValue:@(toState.shouldRasterize)];
                 [animations addObject:shouldRasterizeAnimation];
             }
-            layer.shouldRasterize = shouldRasterize;
-        }
-        
-        // Rasterization scale
-        CGFloat rasterizationScale = layer.rasterizationScale + layerAnimation.rasterizationScaleIncrement;
-        if (animated) {
+            
             CABasicAnimation *rasterizationScaleAnimation = [CABasicAnimation animationWithKeyPath:@"rasterizationScale"];
-            [rasterizationScaleAnimation setFromValue:@(layer.rasterizationScale)];
-            [rasterizationScaleAnimation setToValue:@(rasterizationScale)];
+            [rasterizationScaleAnimation setFromValue:@(fromState.rasterizationScale)];
+            [rasterizationScaleAnimation setToValue:@(toState.rasterizationScale)];
             [animations addObject:rasterizationScaleAnimation];
-        }
-        layer.rasterizationScale = rasterizationScale;
-        
-        // Get the sublayer transform without its perspective component (saved as additional layer information)
-        NSValue *nonProjectedSublayerTransformValue = [layer valueForKey:kLayerNonProjectedSublayerTransformKey];
-        CATransform3D nonProjectedSublayerTransform = CATransform3DIdentity;
-        if (nonProjectedSublayerTransformValue) {
-            nonProjectedSublayerTransform = [nonProjectedSublayerTransformValue CATransform3DValue];
-        }
-        else {
-            nonProjectedSublayerTransform = layer.sublayerTransform;
-        }
-        
-        // Get the current camera position (saved as additional layer information)
-        NSNumber *sublayerCameraZPositionNumber = [layer valueForKey:kLayerCameraZPositionForSublayersKey];
-        CGFloat sublayerCameraZPosition = 0.f;
-        if (sublayerCameraZPositionNumber) {
-            sublayerCameraZPosition = [sublayerCameraZPositionNumber floatValue];
-        }
-        else {
-            sublayerCameraZPosition = (layer.sublayerTransform.m34 == 0.f) ? 0.f : 1.f / layer.sublayerTransform.m34;
-        }
-        
-        // Calculate the sublayer transform (without perspective component)
-        CATransform3D sublayerTranslationTransform = CATransform3DMakeTranslation(-nonProjectedSublayerTransform.m41, -nonProjectedSublayerTransform.m42, 0.f);
-        CATransform3D sublayerConvTransform = CATransform3DConcat(CATransform3DConcat(sublayerTranslationTransform, layerAnimation.sublayerTransform),
-                                                                  CATransform3DInvert(sublayerTranslationTransform));
-        CATransform3D sublayerTransform = CATransform3DConcat(nonProjectedSublayerTransform, sublayerConvTransform);
-        
-        // Calculate the new z-position of the camera
-        sublayerCameraZPosition += layerAnimation.sublayerCameraTranslationZ;
-        
-        // Save the information relative / not relative to the perspective separately
-        [layer setValue:@(sublayerCameraZPosition) forKey:kLayerCameraZPositionForSublayersKey];
-        [layer setValue:[NSValue valueWithCATransform3D:sublayerTransform] forKey:kLayerNonProjectedSublayerTransformKey];
-        
-        // Create the perspective matrix (see http://en.wikipedia.org/wiki/3D_projection#Perspective_projection)
-        CATransform3D perspectiveProjectionTransform = CATransform3DIdentity;
-        if (sublayerCameraZPosition != 0.f) {
-            perspectiveProjectionTransform.m34 = -1.f / sublayerCameraZPosition;
-        }
-        
-        // Apply the perspective
-        sublayerTransform = CATransform3DConcat(sublayerTransform, perspectiveProjectionTransform);
-        
-        if (animated) {
+            
             CABasicAnimation *sublayerTransformAnimation = [CABasicAnimation animationWithKeyPath:@"sublayerTransform"];
             [sublayerTransformAnimation setFromValue:[NSValue valueWithCATransform3D:layer.sublayerTransform]];
-            [sublayerTransformAnimation setToValue:[NSValue valueWithCATransform3D:sublayerTransform]];
+            [sublayerTransformAnimation setToValue:[NSValue valueWithCATransform3D:HLSLayerAnimationStateSublayerTransform(toState)]];
             [animations addObject:sublayerTransformAnimation];
         }
-        layer.sublayerTransform = sublayerTransform;
+        HLSLayerApplyAnimationState(layer, toState);
         
         // Create the animation group and attach it to the layer
         if (animated) {
@@ -293,6 +209,35 @@ static NSString * const kLayerCameraZPositionForSublayersKey = @"HLSLayerCameraZ
     }
 }
 
+- (BOOL)applyToObjectStates:(NSMutableDictionary *)objectKeyToStateMap
+{
+    // The frame of a view whose layer is also animated by view animations cannot be calculated without the view
+    for (CALayer *layer in [self objects]) {
+        if ([layer.delegate isKindOfClass:[UIView class]]
+                && [objectKeyToStateMap objectForKey:[NSValue valueWithNonretainedObject:layer.delegate]]) {
+            return NO;
+        }
+    }
+    
+    for (CALayer *layer in [self objects]) {
+        HLSLayerAnimation *layerAnimation = (HLSLayerAnimation *)[self objectAnimationForObject:layer];
+        NSValue *objectKey = [NSValue valueWithNonretainedObject:layer];
+        
+        HLSLayerAnimationState state;
+        NSValue *stateValue = [objectKeyToStateMap objectForKey:objectKey];
+        if (stateValue) {
+            [stateValue getValue:&state];
+        }
+        else {
+            state = HLSLayerAnimationStateForLayer(layer);
+        }
+        
+        state = [layerAnimation stateByApplyingToState:state];
+        [objectKeyToStateMap setObject:[NSValue valueWithBytes:&state objCType:@encode(HLSLayerAnimationState)] forKey:objectKey];
+    }
+    return YES;
+}
+
 - (void)pauseAnimation
 {
     for (CALayer *layer in [self objects]) {
@@ -8,6 +8,24 @@
 
 #import <Foundation/Foundation.h>
 #import <CoreGraphics/CoreGraphics.h>
+#import <UIKit/UIKit.h>
+
+/**
+ * The view properties altered by view animations. As for layer animations (see HLSLayerAnimation.h), states can be
+ * read from a view, transformed by applying view animations to them, and written back to the view
+ */
+typedef struct {
+    CGFloat alpha;
+    CGRect frame;
+    CGPoint anchorPoint;                                    // The position of the view center relative to its frame
+} HLSViewAnimationState;
+
+/**
+ * Read the current state of a view, respectively write a state to a view (without animation). The view is laid out
+ * after the state has been written
+ */
+OBJC_EXPORT HLSViewAnimationState HLSViewAnimationStateForView(UIView *view);
+OBJC_EXPORT void HLSViewApplyAnimationState(UIView *view, HLSViewAnimationState state);
 
 /**
  * A view animation (HLSViewAnimation) describes the changes applied to a view within an animation step 
@@ -54,4 +72,9 @@
  */
 - (void)addToAlpha:(CGFloat)alphaIncrement;
 
+/**
+ * Return the state obtained when the view animation is applied to a view in the specified state
+ */
+- (HLSViewAnimationState)stateByApplyingToState:(HLSViewAnimationState)state;
+
 @end
@@ -90,6 +90,35 @@
                                                 CGRectGetMidY(toRect) - CGRectGetMidY(fromRect));
 }
 
+#pragma mark Applying the animation
+
+- (HLSViewAnimationState)stateByApplyingToState:(HLSViewAnimationState)state
+{
+    HLSViewAnimationState resultState = state;
+    
+    // Alpha (must always lie between -1.f and 1.f)
+    resultState.alpha = state.alpha + self.alphaIncrement;
+    if (isless(resultState.alpha, -1.f)) {
+        HLSLoggerWarn(@"View animations adding to an alpha value larger than -1. Fixed to -1, but your animation is incorrect");
+        resultState.alpha = -1.f;
+    }
+    else if (isgreater(resultState.alpha, 1.f)) {
+        HLSLoggerWarn(@"View animations adding to an alpha value larger than 1. Fixed to 1, but your animation is incorrect");
+        resultState.alpha = 1.f;
+    }
+    
+    // The transform has to be applied on the view center. This requires a conversion in the coordinate system centered
+    // on the view
+    CGPoint center = CGPointMake(CGRectGetMinX(state.frame) + state.anchorPoint.x * CGRectGetWidth(state.frame),
+                                 CGRectGetMinY(state.frame) + state.anchorPoint.y * CGRectGetHeight(state.frame));
+    CGAffineTransform translationTransform = CGAffineTransformMakeTranslation(-center.x, -center.y);
+    CGAffineTransform convTransform = CGAffineTransformConcat(CGAffineTransformConcat(translationTransform, [self transform]),
+                                                              CGAffineTransformInvert(translationTransform));
+    resultState.frame = CGRectApplyAffineTransform(state.frame, convTransform);
+    
+    return resultState;
+}
+
 #pragma mark Reverse animation
 
 - (id)reverseObjectAnimation
@@ -128,3 +157,23 @@
 }
 
 @end
+
+#pragma mark Functions
+
+HLSViewAnimationState HLSViewAnimationStateForView(UIView *view)
+{
+    HLSViewAnimationState state;
+    state.alpha = view.alpha;
+    state.frame = view.frame;
+    state.anchorPoint = view.layer.anchorPoint;
+    return state;
+}
+
+void HLSViewApplyAnimationState(UIView *view, HLSViewAnimationState state)
+{
+    view.alpha = state.alpha;
+    view.frame = state.frame;
+    
+    // Ensure better subview resizing in some cases (e.g. UISearchBar)
+    [view layoutIfNeeded];
+}
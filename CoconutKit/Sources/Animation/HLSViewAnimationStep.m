@@ -9,8 +9,6 @@
 #import "CALayer+HLSExtensions.h"
 #import "HLSAnimationStep+Friend.h"
 #import "HLSAnimationStep+Protected.h"
-#import "HLSLogger.h"
-#import "HLSViewAnimation+Friend.h"
 
 @interface HLSViewAnimationStep ()
 
@@ -66,28 +64,11 @@
         HLSViewAnimation *viewAnimation = (HLSViewAnimation *)[self objectAnimationForObject:view];
         NSAssert(viewAnimation != nil, @"Missing view animation; data consistency failure");
         
-        // Alpha animation (alpha must always lie between 0.f and 1.f)
-        CGFloat alpha = view.alpha + viewAnimation.alphaIncrement;
-        if (isless(alpha, -1.f)) {
-            HLSLoggerWarn(@"View animations adding to an alpha value larger than -1 for view %@. Fixed to -1, but your animation is incorrect", view);
-            alpha = -1.f;
+        HLSViewAnimationState fromState = HLSViewAnimationStateForView(view);
+        if (animated) {
+            [self saveInitialStateValue:[NSValue valueWithBytes:&fromState objCType:@encode(HLSViewAnimationState)] forObject:view];
         }
-        else if (isgreater(alpha, 1.f)) {
-            HLSLoggerWarn(@"View animations adding to an alpha value larger than 1 for view %@. Fixed to 1, but your animation is incorrect", view);
-            alpha = 1.f;
-        }
-        
-        view.alpha = alpha;
-        
-        // Animate the frame. The transform has to be applied on the view center. This requires a conversion in the coordinate system
-        // centered on the view
-        CGAffineTransform translationTransform = CGAffineTransformMakeTranslation(-view.center.x, -view.center.y);
-        CGAffineTransform convTransform = CGAffineTransformConcat(CGAffineTransformConcat(translationTransform, viewAnimation.transform),
-                                                                  CGAffineTransformInvert(translationTransform));
-        view.frame = CGRectApplyAffineTransform(view.frame, convTransform);
-        
-        // Ensure better subview resizing in some cases (e.g. UISearchBar)
-        [view layoutIfNeeded];
+        HLSViewApplyAnimationState(view, [viewAnimation stateByApplyingToState:fromState]);
     }
         
     if (animated) {
@@ -100,6 +81,34 @@
     }
 }
 
+- (BOOL)applyToObjectStates:(NSMutableDictionary *)objectKeyToStateMap
+{
+    // The frame of a view whose layer is also animated by layer animations cannot be calculated without the view
+    for (UIView *view in [self objects]) {
+        if ([objectKeyToStateMap objectForKey:[NSValue valueWithNonretainedObject:view.layer]]) {
+            return NO;
+        }
+    }
+    
+    for (UIView *view in [self objects]) {
+        HLSViewAnimation *viewAnimation = (HLSViewAnimation *)[self objectAnimationForObject:view];
+        NSValue *objectKey = [NSValue valueWithNonretainedObject:view];
+        
+        HLSViewAnimationState state;
+        NSValue *stateValue = [objectKeyToStateMap objectForKey:objectKey];
+        if (stateValue) {
+            [stateValue getValue:&state];
+        }
+        else {
+            state = HLSViewAnimationStateForView(view);
+        }
+        
+        state = [viewAnimation stateByApplyingToState:state];
+        [objectKeyToStateMap setObject:[NSValue valueWithBytes:&state objCType:@encode(HLSViewAnimationState)] forKey:objectKey];
+    }
+    return YES;
+}
+
 - (void)pauseAnimation
 {
     for (UIView *view in [self objects]) {
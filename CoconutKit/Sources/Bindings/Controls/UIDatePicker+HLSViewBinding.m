@@ -26,10 +26,12 @@ static void swizzle_setDate_animated(UIDatePicker *self, SEL _cmd, NSDate *date,
 
 + (void)load
 {
+    HLSSwizzleGroup_Begin
     HLSSwizzleSelector(self, @selector(initWithFrame:), swizzle_initWithFrame, &s_initWithFrame);
     HLSSwizzleSelector(self, @selector(initWithCoder:), swizzle_initWithCoder, &s_initWithCoder);
     HLSSwizzleSelector(self, @selector(setDate:), swizzle_setDate, &s_setDate);
     HLSSwizzleSelector(self, @selector(setDate:animated:), swizzle_setDate_animated, &s_setDate_animated);
+    HLSSwizzleGroup_End
 }
 
 #pragma mark HLSViewBindingImplementation protocol implementation
@@ -14,7 +14,28 @@
  *   - binds to UIImage, NSString (image name in bundle, or path to image) or NSURL model values (file URL to image)
  *   - displays the underlying model value, but cannot update it
  *   - does not animate updates
+ *
+ * Images bound by name, path or file URL are loaded and decoded in the background, downsampled to the image view size
+ * (in pixels) if they are larger, and stored in a shared memory cache. While an image is being loaded, the image view
+ * displays its placeholder image (if any). Images available from the cache are displayed immediately. Images which
+ * cannot be found as files (e.g. images in asset catalogs) are loaded synchronously using +[UIImage imageNamed:]. Images
+ * bound to image views with empty bounds are only loaded after the image views have been laid out
  */
 @interface UIImageView (HLSViewBinding) <HLSViewBindingImplementation>
 
+/**
+ * Fraction of bound image requests which could be served from the shared cache (between 0 and 1)
+ */
++ (CGFloat)bindingImageCacheHitRate;
+
+/**
+ * Total time spent loading and decoding bound images in the background, i.e. time saved on the main thread
+ */
++ (NSTimeInterval)bindingImageDecodingDuration;
+
+/**
+ * The image to display while a bound image is being loaded. Default is nil
+ */
+@property (nonatomic, strong) IBInspectable UIImage *bindPlaceholderImage;
+
 @end
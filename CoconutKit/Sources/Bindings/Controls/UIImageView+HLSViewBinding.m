@@ -6,8 +6,62 @@
 
 #import "UIImageView+HLSViewBinding.h"
 
+#import "HLSImageLoader.h"
+#import "HLSRuntime.h"
+
+// Associated object keys
+static void *s_bindPlaceholderImageKey = &s_bindPlaceholderImageKey;
+static void *s_imageLoadOperationKey = &s_imageLoadOperationKey;
+static void *s_imageLoadPathKey = &s_imageLoadPathKey;
+static void *s_pendingImageLoadPathKey = &s_pendingImageLoadPathKey;
+
+// Original implementation of the methods we swizzle
+static void (*s_layoutSubviews)(id, SEL) = NULL;
+
+// Swizzled method implementations
+static void swizzle_layoutSubviews(UIImageView *self, SEL _cmd);
+
+@interface UIImageView (HLSViewBindingPrivate)
+
+- (void)loadImageWithContentsOfFile:(NSString *)path targetSize:(CGSize)targetSize;
+
+@end
+
 @implementation UIImageView (HLSViewBinding)
 
+#pragma mark Class methods
+
++ (void)load
+{
+    HLSSwizzleGroup_Begin
+    HLSSwizzleSelector(self, @selector(layoutSubviews), swizzle_layoutSubviews, &s_layoutSubviews);
+    HLSSwizzleGroup_End
+}
+
++ (CGFloat)bindingImageCacheHitRate
+{
+    HLSImageLoader *imageLoader = [HLSImageLoader sharedImageLoader];
+    NSUInteger requestCount = imageLoader.hitCount + imageLoader.missCount;
+    return (requestCount != 0) ? (CGFloat)imageLoader.hitCount / requestCount : 0.f;
+}
+
++ (NSTimeInterval)bindingImageDecodingDuration
+{
+    return [HLSImageLoader sharedImageLoader].decodingDuration;
+}
+
+#pragma mark Accessors and mutators
+
+- (UIImage *)bindPlaceholderImage
+{
+    return hls_getAssociatedObject(self, s_bindPlaceholderImageKey);
+}
+
+- (void)setBindPlaceholderImage:(UIImage *)bindPlaceholderImage
+{
+    hls_setAssociatedObject(self, s_bindPlaceholderImageKey, bindPlaceholderImage, HLS_ASSOCIATION_STRONG_NONATOMIC);
+}
+
 #pragma mark HLSViewBindingImplementation protocol implementation
 
 + (NSArray *)supportedBindingClasses
@@ -18,19 +72,114 @@
 - (void)updateViewWithValue:(id)value animated:(BOOL)animated
 {
     if ([value isKindOfClass:[UIImage class]]) {
+        [self cancelImageLoad];
         self.image = value;
     }
     else if ([value isKindOfClass:[NSString class]]) {
-        UIImage *image = [UIImage imageNamed:value];
-        if (! image) {
-            image = [UIImage imageWithContentsOfFile:value];
+        NSString *path = [value isAbsolutePath] ? value : [HLSImageLoader pathForImageNamed:value];
+        if (path) {
+            [self loadImageWithContentsOfFile:path];
+        }
+        else {
+            // Not available as a file (e.g. asset catalog)
+            [self cancelImageLoad];
+            self.image = [UIImage imageNamed:value];
         }
-        self.image = image;
     }
     else {
         NSURL *URL = value;
-        self.image = [URL isFileURL] ? [UIImage imageWithContentsOfFile:[URL path]] : nil;
+        if ([URL isFileURL]) {
+            [self loadImageWithContentsOfFile:[URL path]];
+        }
+        else {
+            [self cancelImageLoad];
+            self.image = nil;
+        }
+    }
+}
+
+#pragma mark Image loading
+
+- (void)loadImageWithContentsOfFile:(NSString *)path
+{
+    // The target size is not known yet. Wait until the image view has been laid out to decode the image at the
+    // correct size
+    if (CGRectIsEmpty(self.bounds)) {
+        if (! [hls_getAssociatedObject(self, s_pendingImageLoadPathKey) isEqualToString:path]) {
+            [self cancelImageLoad];
+            self.image = self.bindPlaceholderImage;
+            hls_setAssociatedObject(self, s_pendingImageLoadPathKey, path, HLS_ASSOCIATION_STRONG_NONATOMIC);
+        }
+        return;
+    }
+    
+    CGFloat scale = [UIScreen mainScreen].scale;
+    CGSize targetSize = CGSizeMake(CGRectGetWidth(self.bounds) * scale, CGRectGetHeight(self.bounds) * scale);
+    [self loadImageWithContentsOfFile:path targetSize:targetSize];
+}
+
+- (void)loadImageWithContentsOfFile:(NSString *)path targetSize:(CGSize)targetSize
+{
+    hls_setAssociatedObject(self, s_pendingImageLoadPathKey, nil, HLS_ASSOCIATION_STRONG_NONATOMIC);
+    
+    HLSImageLoader *imageLoader = [HLSImageLoader sharedImageLoader];
+    UIImage *cachedImage = [imageLoader cachedImageWithContentsOfFile:path targetSize:targetSize];
+    if (cachedImage) {
+        [self cancelImageLoad];
+        self.image = cachedImage;
+        return;
+    }
+    
+    // Same image already being loaded
+    NSOperation *operation = hls_getAssociatedObject(self, s_imageLoadOperationKey);
+    if (operation && [hls_getAssociatedObject(self, s_imageLoadPathKey) isEqualToString:path]) {
+        return;
     }
+    
+    [self cancelImageLoad];
+    self.image = self.bindPlaceholderImage;
+    
+    __weak __typeof(self) weakSelf = self;
+    operation = [imageLoader loadImageWithContentsOfFile:path targetSize:targetSize completionBlock:^(UIImage *image) {
+        __strong __typeof(weakSelf) strongSelf = weakSelf;
+        if (! strongSelf) {
+            return;
+        }
+        
+        hls_setAssociatedObject(strongSelf, s_imageLoadOperationKey, nil, HLS_ASSOCIATION_STRONG_NONATOMIC);
+        hls_setAssociatedObject(strongSelf, s_imageLoadPathKey, nil, HLS_ASSOCIATION_STRONG_NONATOMIC);
+        strongSelf.image = image;
+    }];
+    hls_setAssociatedObject(self, s_imageLoadOperationKey, operation, HLS_ASSOCIATION_STRONG_NONATOMIC);
+    hls_setAssociatedObject(self, s_imageLoadPathKey, path, HLS_ASSOCIATION_STRONG_NONATOMIC);
+}
+
+- (void)cancelImageLoad
+{
+    NSOperation *operation = hls_getAssociatedObject(self, s_imageLoadOperationKey);
+    [operation cancel];
+    
+    hls_setAssociatedObject(self, s_imageLoadOperationKey, nil, HLS_ASSOCIATION_STRONG_NONATOMIC);
+    hls_setAssociatedObject(self, s_imageLoadPathKey, nil, HLS_ASSOCIATION_STRONG_NONATOMIC);
+    hls_setAssociatedObject(self, s_pendingImageLoadPathKey, nil, HLS_ASSOCIATION_STRONG_NONATOMIC);
 }
 
 @end
+
+#pragma mark Static functions
+
+static void swizzle_layoutSubviews(UIImageView *self, SEL _cmd)
+{
+    s_layoutSubviews(self, _cmd);
+    
+    NSString *pendingPath = hls_getAssociatedObject(self, s_pendingImageLoadPathKey);
+    if (! pendingPath || ! self.window) {
+        return;
+    }
+    
+    // Image views sized after their content (e.g. using the image intrinsic size with Auto Layout) still have empty
+    // bounds after layout. Load the image at its original size in such cases
+    CGFloat scale = [UIScreen mainScreen].scale;
+    CGSize targetSize = CGSizeMake(CGRectGetWidth(self.bounds) * scale, CGRectGetHeight(self.bounds) * scale);
+    [self loadImageWithContentsOfFile:pendingPath targetSize:CGRectIsEmpty(self.bounds) ? CGSizeZero : targetSize];
+}
@@ -24,9 +24,11 @@ static void swizzle_setCurrentPage(UIPageControl *self, SEL _cmd, NSInteger curr
 
 + (void)load
 {
+    HLSSwizzleGroup_Begin
     HLSSwizzleSelector(self, @selector(initWithFrame:), swizzle_initWithFrame, &s_initWithFrame);
     HLSSwizzleSelector(self, @selector(initWithCoder:), swizzle_initWithCoder, &s_initWithCoder);
     HLSSwizzleSelector(self, @selector(setCurrentPage:), swizzle_setCurrentPage, &s_setCurrentPage);
+    HLSSwizzleGroup_End
 }
 
 #pragma mark HLSViewBindingImplementation protocol implementation
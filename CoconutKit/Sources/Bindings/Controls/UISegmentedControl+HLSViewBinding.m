@@ -24,10 +24,11 @@ static void swizzle_setSelectedSegmentIndex(UISegmentedControl *self, SEL _cmd,
 
 + (void)load
 {
+    HLSSwizzleGroup_Begin
     HLSSwizzleSelector(self, @selector(initWithFrame:), swizzle_initWithFrame, &s_initWithFrame);
     HLSSwizzleSelector(self, @selector(initWithCoder:), swizzle_initWithCoder, &s_initWithCoder);
     HLSSwizzleSelector(self, @selector(setSelectedSegmentIndex:), swizzle_setSelectedSegmentIndex, &s_setSelectedSegmentIndex);
-    
+    HLSSwizzleGroup_End
 }
 
 #pragma mark HLSViewBindingImplementation protocol implementation
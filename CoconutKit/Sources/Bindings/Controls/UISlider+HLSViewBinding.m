@@ -23,6 +23,7 @@ static void swizzle_setValue_animated(UISlider *self, SEL _cmd, float value, BOO
 
 + (void)load
 {
+    HLSSwizzleGroup_Begin
     // Binding implementation resolve bindings at the latest moment, when -didMoveToWindow is called, using swizzling.
     // Prior to iOS 7.1, -[UISlider didMoveToWindow] implementation failed to call the super method counterpart. The
     // -[UISlider didMoveToWindow] method implementation has been removed starting with iOS 7.1, which fixes this
@@ -32,6 +33,7 @@ static void swizzle_setValue_animated(UISlider *self, SEL _cmd, float value, BOO
     }
     
     HLSSwizzleSelector(self, @selector(setValue:animated:), swizzle_setValue_animated, &s_setValue_animated);
+    HLSSwizzleGroup_End
 }
 
 #pragma mark HLSViewBindingImplementation protocol implementation
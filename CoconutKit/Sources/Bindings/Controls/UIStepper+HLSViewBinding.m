@@ -20,7 +20,9 @@ static void swizzle_setValue(UIStepper *self, SEL _cmd, double value);
 
 + (void)load
 {
+    HLSSwizzleGroup_Begin
     HLSSwizzleSelector(self, @selector(setValue:), swizzle_setValue, &s_setValue);
+    HLSSwizzleGroup_End
 }
 
 #pragma mark HLSViewBindingImplementation protocol implementation
@@ -25,9 +25,11 @@ static void swizzle_setOn_animated(UISwitch *self, SEL _cmd, BOOL on, BOOL anima
 
 + (void)load
 {
+    HLSSwizzleGroup_Begin
     HLSSwizzleSelector(self, @selector(initWithFrame:), swizzle_initWithFrame, &s_initWithFrame);
     HLSSwizzleSelector(self, @selector(initWithCoder:), swizzle_initWithCoder, &s_initWithCoder);
     HLSSwizzleSelector(self, @selector(setOn:animated:), swizzle_setOn_animated, &s_setOn_animated);
+    HLSSwizzleGroup_End
 }
 
 #pragma mark HLSViewBindingImplementation protocol implementation
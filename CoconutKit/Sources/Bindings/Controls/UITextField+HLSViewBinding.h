@@ -14,7 +14,8 @@
  *   - binds to NSString model values
  *   - displays and updates the underlying model value
  *   - does not animate updates
- *   - check (if not disabled via bindInputChecked) and update the value each time it is changed
+ *   - check (if not disabled via bindInputChecked) and update the value each time it is changed, or according to
+ *     its bindWriteBackPolicy
  */
 @interface UITextField (HLSViewBindingImplementation) <HLSViewBindingImplementation>
 
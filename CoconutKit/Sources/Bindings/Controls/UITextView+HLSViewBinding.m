@@ -7,6 +7,7 @@
 #import "UITextView+HLSViewBinding.h"
 
 #import "HLSRuntime.h"
+#import "UIView+HLSViewBinding.h"
 
 // Original implementation of the methods we swizzle
 static id (*s_initWithFrame)(id, SEL, CGRect) = NULL;
@@ -26,10 +27,12 @@ static void swizzle_setText(UITextField *self, SEL _cmd, NSString *text);
 
 + (void)load
 {
+    HLSSwizzleGroup_Begin
     HLSSwizzleSelector(self, @selector(initWithFrame:), swizzle_initWithFrame, &s_initWithFrame);
     HLSSwizzleSelector(self, @selector(initWithCoder:), swizzle_initWithCoder, &s_initWithCoder);
     HLSSwizzleSelector(self, sel_getUid("dealloc"), swizzle_dealloc, &s_dealloc);
     HLSSwizzleSelector(self, @selector(setText:), swizzle_setText, &s_setText);
+    HLSSwizzleGroup_End
 }
 
 #pragma mark HLSViewBindingImplementation protocol implementation
@@ -48,7 +51,12 @@ static void swizzle_setText(UITextField *self, SEL _cmd, NSString *text);
 
 - (void)textViewDidChange:(NSNotification *)notification
 {
-    [self check:YES update:YES withInputValue:self.text error:NULL];
+    [self bindInputDidChangeToValue:self.text];
+}
+
+- (void)textViewDidEndEditing:(NSNotification *)notification
+{
+    [self bindInputDidEndEditing];
 }
 
 @end
@@ -61,6 +69,10 @@ static void commonInit(UITextView *self)
                                              selector:@selector(textViewDidChange:)
                                                  name:UITextViewTextDidChangeNotification
                                                object:self];
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(textViewDidEndEditing:)
+                                                 name:UITextViewTextDidEndEditingNotification
+                                               object:self];
 }
 
 static id swizzle_initWithFrame(UITextView *self, SEL _cmd, CGRect frame)
@@ -85,14 +97,24 @@ static void swizzle_dealloc(__unsafe_unretained UITextView *self, SEL _cmd)
     [[NSNotificationCenter defaultCenter] removeObserver:self
                                                     name:UITextViewTextDidChangeNotification
                                                   object:self];
+    [[NSNotificationCenter defaultCenter] removeObserver:self
+                                                    name:UITextViewTextDidEndEditingNotification
+                                                  object:self];
     
     s_dealloc(self, _cmd);
 }
 
 static void swizzle_setText(UITextField *self, SEL _cmd, NSString *text)
 {
+    HLSSwizzleCountCall(&s_setText);
+    
     s_setText(self, _cmd, text);
     
-    [self check:YES update:YES withInputValue:text error:NULL];
+    [self bindInputDidChangeToValue:text];
+    
+    // No end of editing will be received for programmatic changes made outside an editing session
+    if (self.bindWriteBackPolicy == HLSViewBindingWriteBackPolicyOnEndEditing && ! [self isFirstResponder]) {
+        [self bindInputDidEndEditing];
+    }
 }
 
@@ -10,6 +10,9 @@
 /**
  * Protocol to be implemented by classes whose instances want to show interest in receiving binding events. Information 
  * about the binding arameters can be obtained by accessing the bindingInformation property of the boundView parameter
+ *
+ * Events are not received again when a text input value which has already been processed is received again, as long as
+ * no bound model object has changed in the meantime (see UIView+HLSViewBinding.h, write-back policy)
  */
 @protocol HLSViewBindingDelegate <NSObject>
 
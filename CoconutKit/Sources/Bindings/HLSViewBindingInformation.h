@@ -135,6 +135,65 @@
  */
 - (BOOL)check:(BOOL)check update:(BOOL)update withInputValue:(id)inputValue error:(NSError *__autoreleasing *)pError;
 
+/**
+ * Same as -check:update:withInputValue:error:, but if cached is set to YES, the result is cached: If called again with an
+ * equal input value while the model has not changed in the meantime, the cached result is returned without transforming, 
+ * checking or updating the value again. The delegate is not notified again in this case. The cache is discarded when the 
+ * value the binding points at changes, as well as when any binding updates a model object
+ *
+ * Only used for text input, which is processed for each keystroke and often received several times unchanged
+ */
+- (BOOL)check:(BOOL)check update:(BOOL)update withInputValue:(id)inputValue cached:(BOOL)cached error:(NSError *__autoreleasing *)pError;
+
+/**
+ * Return YES iff an input value has been recorded but not written back to the model yet
+ */
+@property (nonatomic, readonly, assign, getter=hasPendingInput) BOOL pendingInput;
+
+/**
+ * Record an input value to be written back later, replacing any previously recorded one. If delay is strictly positive, 
+ * the value is automatically committed after this delay, provided no other value is recorded in the meantime. Values
+ * are discarded when the view is updated from the model
+ */
+- (void)recordPendingInputValue:(id)inputValue commitDelay:(NSTimeInterval)delay;
+
+/**
+ * Check (according to the bindInputChecked setting of the view) and update the model using the pending input value, if
+ * any. Return YES iff successful or if there was nothing to commit, otherwise NO and error information. The result is
+ * cached (see -check:update:withInputValue:cached:error:)
+ */
+- (BOOL)commitPendingInputWithError:(NSError *__autoreleasing *)pError;
+
+/**
+ * Profiling information about view updates (-updateViewAnimated:), collected since the binding was created or since
+ * -resetProfilingInformation was last called. Durations are cumulative
+ */
+@property (nonatomic, readonly, assign) NSUInteger updateCount;
+@property (nonatomic, readonly, assign) NSTimeInterval keyPathResolutionDuration;
+@property (nonatomic, readonly, assign) NSTimeInterval transformationDuration;
+@property (nonatomic, readonly, assign) NSTimeInterval viewUpdateDuration;
+
+/**
+ * The sum of the above durations
+ */
+@property (nonatomic, readonly, assign) NSTimeInterval totalUpdateDuration;
+
+/**
+ * The recent view update rate, measured over about one second
+ */
+@property (nonatomic, readonly, assign) CGFloat updatesPerSecond;
+
+/**
+ * Return profiling information as a dictionary containing property list objects only (durations are in milliseconds),
+ * suitable for export
+ */
+- (NSDictionary *)profilingInformationDictionary;
+
+/**
+ * Reset profiling information
+ */
+- (void)resetProfilingInformation;
+
 @end
 
 @interface HLSViewBindingInformation (UnavailableMethods)
@@ -20,6 +20,8 @@
 #import "UIView+HLSViewBindingFriend.h"
 #import "UIView+HLSViewBindingImplementation.h"
 
+#import <QuartzCore/QuartzCore.h>
+
 /**
  * Internal status flag. Use to avoid performing already successful binding verification steps
  */
@@ -37,6 +39,10 @@ typedef NS_OPTIONS(NSInteger, HLSViewBindingStatus) {
                                     | HLSViewBindingStatusAutomaticUpdatesResolved)
 };
 
+// Incremented each time a binding updates a model object. Checks of other bindings might depend on the updated value
+// (e.g. cross-field validation), cached input value results are therefore only valid while this value is unchanged
+static NSUInteger s_modelUpdateCount = 0;
+
 @interface HLSViewBindingInformation ()
 
 @property (nonatomic, strong) NSString *keyPath;
@@ -70,9 +76,26 @@ typedef NS_OPTIONS(NSInteger, HLSViewBindingStatus) {
 // Same as above, but when updating the model
 @property (nonatomic, assign, getter=isUpdatingModel) BOOL updatingModel;
 
+// Result of the last input value check and / or update, returned as is if the same input value is received again
+@property (nonatomic, strong) id cachedInputValue;
+@property (nonatomic, assign) BOOL cachedInputValueChecked;
+@property (nonatomic, assign) BOOL cachedInputValueUpdated;
+@property (nonatomic, assign) BOOL cachedInputValueSuccess;
+@property (nonatomic, strong) NSError *cachedInputValueError;
+@property (nonatomic, assign) NSUInteger cachedInputValueModelUpdateCount;
+@property (nonatomic, assign, getter=isInputValueResultCached) BOOL inputValueResultCached;
+
+@property (nonatomic, strong) id pendingInputValue;
+@property (nonatomic, assign, getter=hasPendingInput) BOOL pendingInput;
+
 @end
 
-@implementation HLSViewBindingInformation
+@implementation HLSViewBindingInformation {
+@private
+    CFTimeInterval _updateRateWindowStartTime;
+    NSUInteger _updateRateWindowCount;
+    CGFloat _lastUpdatesPerSecond;
+}
 
 #pragma mark Object creation and destruction
 
@@ -114,7 +137,11 @@ typedef NS_OPTIONS(NSInteger, HLSViewBindingStatus) {
         return nil;
     }
     
-    id rawValue = [self.objectTarget valueForKeyPath:self.keyPath];
+    return [self valueForRawValue:[self.objectTarget valueForKeyPath:self.keyPath]];
+}
+
+- (id)valueForRawValue:(id)rawValue
+{
     id value = self.transformer ? [self.transformer transformObject:rawValue] : rawValue;
     return [self canDisplayValue:value] ? value : nil;
 }
@@ -148,10 +175,16 @@ typedef NS_OPTIONS(NSInteger, HLSViewBindingStatus) {
     
     _objectTarget = objectTarget;
     
+    [self invalidateCachedInputValueResult];
+    
     // KVO bug: Doing KVO on key paths containing keypath operators (which cannot be used with KVO) and catching the exception leads to retaining the
     // observer (though KVO itself neither retains the observer nor its observee). Catch such key paths before
     if (objectTarget && [self.keyPath rangeOfString:@"@"].length == 0) {
         [objectTarget addObserver:self keyPath:self.keyPath options:NSKeyValueObservingOptionNew block:^(HLSMAKVONotification *notification) {
+            // Changes made to the model by other means than input invalidate the cached input value result
+            if (! self.updatingModel) {
+                [self invalidateCachedInputValueResult];
+            }
             [self.view updateBoundView];
         }];
         
@@ -172,19 +205,32 @@ typedef NS_OPTIONS(NSInteger, HLSViewBindingStatus) {
         return;
     }
     
+    // The view now displays the model value, input not written back yet is lost
+    if (self.pendingInput) {
+        [self discardPendingInput];
+    }
+    
     // Lazily check and fill binding information
     [self verify];
     
+    CFTimeInterval startTime = CACurrentMediaTime();
+    
+    // The raw value is resolved once and transformed if needed
+    id rawValue = [self rawValue];
+    CFTimeInterval keyPathResolutionEndTime = CACurrentMediaTime();
+    
     id value = nil;
-    if ([self canDisplayPlaceholder]) {
-        id rawValue = [self rawValue];
-        if (rawValue && (! [rawValue isKindOfClass:[NSNumber class]] || ! [rawValue isEqualToNumber:@0])) {
-            value = [self value];
+    if ((self.status & HLSViewBindingStatusObjectTargetResolved) != 0) {
+        if ([self canDisplayPlaceholder]) {
+            if (rawValue && (! [rawValue isKindOfClass:[NSNumber class]] || ! [rawValue isEqualToNumber:@0])) {
+                value = [self valueForRawValue:rawValue];
+            }
+        }
+        else {
+            value = [self valueForRawValue:rawValue];
         }
     }
-    else {
-        value = [self value];
-    }
+    CFTimeInterval transformationEndTime = CACurrentMediaTime();
     
     self.updatingView = YES;
     
@@ -192,6 +238,76 @@ typedef NS_OPTIONS(NSInteger, HLSViewBindingStatus) {
     (*methodImp)(self.view, @selector(updateViewWithValue:animated:), value, animated);
     
     self.updatingView = NO;
+    
+    CFTimeInterval endTime = CACurrentMediaTime();
+    [self recordUpdateWithKeyPathResolutionDuration:keyPathResolutionEndTime - startTime
+                             transformationDuration:transformationEndTime - keyPathResolutionEndTime
+                                 viewUpdateDuration:endTime - transformationEndTime
+                                            endTime:endTime];
+}
+
+#pragma mark Profiling
+
+- (void)recordUpdateWithKeyPathResolutionDuration:(NSTimeInterval)keyPathResolutionDuration
+                           transformationDuration:(NSTimeInterval)transformationDuration
+                               viewUpdateDuration:(NSTimeInterval)viewUpdateDuration
+                                          endTime:(CFTimeInterval)endTime
+{
+    ++_updateCount;
+    _keyPathResolutionDuration += keyPathResolutionDuration;
+    _transformationDuration += transformationDuration;
+    _viewUpdateDuration += viewUpdateDuration;
+    
+    // Close the rate measurement window after one second
+    CFTimeInterval windowDuration = endTime - _updateRateWindowStartTime;
+    if (windowDuration >= 1.) {
+        _lastUpdatesPerSecond = _updateRateWindowCount / windowDuration;
+        _updateRateWindowStartTime = endTime;
+        _updateRateWindowCount = 0;
+    }
+    ++_updateRateWindowCount;
+}
+
+- (NSTimeInterval)totalUpdateDuration
+{
+    return self.keyPathResolutionDuration + self.transformationDuration + self.viewUpdateDuration;
+}
+
+- (CGFloat)updatesPerSecond
+{
+    // If the current window is over, use it so that the rate decreases when updates stop
+    CFTimeInterval windowDuration = CACurrentMediaTime() - _updateRateWindowStartTime;
+    if (windowDuration >= 1.) {
+        return _updateRateWindowCount / windowDuration;
+    }
+    else {
+        return _lastUpdatesPerSecond;
+    }
+}
+
+- (NSDictionary *)profilingInformationDictionary
+{
+    return @{ @"viewClass" : NSStringFromClass([self.view class]) ?: @"",
+              @"keyPath" : self.keyPath,
+              @"transformerName" : self.transformerName ?: @"",
+              @"updateCount" : @(self.updateCount),
+              @"keyPathResolutionDuration" : @(self.keyPathResolutionDuration * 1000.),
+              @"transformationDuration" : @(self.transformationDuration * 1000.),
+              @"viewUpdateDuration" : @(self.viewUpdateDuration * 1000.),
+              @"totalUpdateDuration" : @(self.totalUpdateDuration * 1000.),
+              @"updatesPerSecond" : @(self.updatesPerSecond) };
+}
+
+- (void)resetProfilingInformation
+{
+    _updateCount = 0;
+    _keyPathResolutionDuration = 0.;
+    _transformationDuration = 0.;
+    _viewUpdateDuration = 0.;
+    
+    _updateRateWindowStartTime = CACurrentMediaTime();
+    _updateRateWindowCount = 0;
+    _lastUpdatesPerSecond = 0.f;
 }
 
 #pragma mark Transforming, checking and updating values (these operations notify the delegate about their status)
@@ -358,6 +474,8 @@ typedef NS_OPTIONS(NSInteger, HLSViewBindingStatus) {
         }
     }
     
+    ++s_modelUpdateCount;
+    
     if ([self.delegate respondsToSelector:@selector(boundView:updateDidSucceedWithObject:)]) {
         [self.delegate boundView:self.view updateDidSucceedWithObject:self.objectTarget];
     }
@@ -367,10 +485,16 @@ typedef NS_OPTIONS(NSInteger, HLSViewBindingStatus) {
 
 - (BOOL)check:(BOOL)check update:(BOOL)update withError:(NSError *__autoreleasing *)pError
 {
-    return [self check:check update:update withInputValue:[self inputValue] error:pError];
+    // Explicit checks are always performed, so that the delegate receives the corresponding events
+    return [self check:check update:update withInputValue:[self inputValue] cached:NO error:pError];
 }
 
 - (BOOL)check:(BOOL)check update:(BOOL)update withInputValue:(id)inputValue error:(NSError *__autoreleasing *)pError
+{
+    return [self check:check update:update withInputValue:inputValue cached:NO error:pError];
+}
+
+- (BOOL)check:(BOOL)check update:(BOOL)update withInputValue:(id)inputValue cached:(BOOL)cached error:(NSError *__autoreleasing *)pError
 {
     NSAssert(check || update, @"The method should at least check or update");
         
@@ -397,6 +521,13 @@ typedef NS_OPTIONS(NSInteger, HLSViewBindingStatus) {
         return NO;
     }
     
+    if (cached && [self isInputValueResultCachedForInputValue:inputValue check:check update:update]) {
+        if (! self.cachedInputValueSuccess && pError) {
+            *pError = self.cachedInputValueError;
+        }
+        return self.cachedInputValueSuccess;
+    }
+    
     id value = nil;
     NSError *error = nil;
     
@@ -415,6 +546,17 @@ typedef NS_OPTIONS(NSInteger, HLSViewBindingStatus) {
         }
     }
     
+    // Only cache results if model changes can be detected (KVO)
+    if (cached && self.viewAutomaticallyUpdated) {
+        self.cachedInputValue = inputValue;
+        self.cachedInputValueChecked = check;
+        self.cachedInputValueUpdated = update;
+        self.cachedInputValueSuccess = success;
+        self.cachedInputValueError = error;
+        self.cachedInputValueModelUpdateCount = s_modelUpdateCount;
+        self.inputValueResultCached = YES;
+    }
+    
     if (pError) {
         *pError = error;
     }
@@ -422,6 +564,69 @@ typedef NS_OPTIONS(NSInteger, HLSViewBindingStatus) {
     return success;
 }
 
+- (BOOL)isInputValueResultCachedForInputValue:(id)inputValue check:(BOOL)check update:(BOOL)update
+{
+    if (! self.inputValueResultCached || self.cachedInputValueChecked != check || self.cachedInputValueUpdated != update
+            || self.cachedInputValueModelUpdateCount != s_modelUpdateCount) {
+        return NO;
+    }
+    
+    return inputValue == self.cachedInputValue || [inputValue isEqual:self.cachedInputValue];
+}
+
+- (void)invalidateCachedInputValueResult
+{
+    self.cachedInputValue = nil;
+    self.cachedInputValueError = nil;
+    self.inputValueResultCached = NO;
+}
+
+#pragma mark Deferred input
+
+- (void)recordPendingInputValue:(id)inputValue commitDelay:(NSTimeInterval)delay
+{
+    // Skip when triggered by view update implementations
+    if (self.updatingView) {
+        return;
+    }
+    
+    self.pendingInputValue = inputValue;
+    self.pendingInput = YES;
+    
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(commitPendingInput) object:nil];
+    if (delay > 0.) {
+        [self performSelector:@selector(commitPendingInput) withObject:nil afterDelay:delay];
+    }
+}
+
+- (BOOL)commitPendingInputWithError:(NSError *__autoreleasing *)pError
+{
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(commitPendingInput) object:nil];
+    
+    if (! self.pendingInput) {
+        return YES;
+    }
+    
+    id inputValue = self.pendingInputValue;
+    self.pendingInputValue = nil;
+    self.pendingInput = NO;
+    
+    return [self check:self.view.bindInputChecked update:YES withInputValue:inputValue cached:YES error:pError];
+}
+
+- (void)commitPendingInput
+{
+    [self commitPendingInputWithError:NULL];
+}
+
+- (void)discardPendingInput
+{
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(commitPendingInput) object:nil];
+    
+    self.pendingInputValue = nil;
+    self.pendingInput = NO;
+}
+
 #pragma mark Binding
 
 - (BOOL)resolveObjectTarget:(id *)pObjectTarget withError:(NSError *__autoreleasing *)pError
@@ -630,7 +835,7 @@ typedef NS_OPTIONS(NSInteger, HLSViewBindingStatus) {
     
     // Wrap native Foundation transformers into HLSTransformer instances
     if ([transformer isKindOfClass:[NSFormatter class]]) {
-        transformer = [HLSBlockTransformer blockTransformerFromFormatter:transformer];
+        transformer = [HLSViewBindingInformation transformerForFormatter:transformer];
     }
     else if ([transformer isKindOfClass:[NSValueTransformer class]]) {
         transformer = [HLSBlockTransformer blockTransformerFromValueTransformer:transformer];
@@ -871,6 +1076,7 @@ typedef NS_OPTIONS(NSInteger, HLSViewBindingStatus) {
                 [transformationTarget addObserver:self keyPath:NSStringFromSelector(transformationSelector) options:NSKeyValueObservingOptionNew block:^(HLSMAKVONotification *notification) {
                     // Clear the flag and force an update (will trigger the corresponding resolution mechanism again and upate views)
                     weakSelf.status &= ~HLSViewBindingStatusTransformerResolved;
+                    [weakSelf invalidateCachedInputValueResult];
                     [weakSelf.view updateBoundView];
                 }];
                 
@@ -1008,6 +1214,29 @@ typedef NS_OPTIONS(NSInteger, HLSViewBindingStatus) {
     }
 }
 
+#pragma mark Transformers
+
+/**
+ * Return a transformer wrapping the specified formatter. Bindings sharing a formatter (e.g. the fields of a form using
+ * the same global formatter) share the same transformer
+ */
++ (id<HLSTransformer>)transformerForFormatter:(NSFormatter *)formatter
+{
+    static NSMapTable *s_formatterToTransformerMap = nil;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        // The transformer retains its formatter and is retained by bindings. Both references can therefore be weak
+        s_formatterToTransformerMap = [NSMapTable weakToWeakObjectsMapTable];
+    });
+    
+    id<HLSTransformer> transformer = [s_formatterToTransformerMap objectForKey:formatter];
+    if (! transformer) {
+        transformer = [HLSBlockTransformer blockTransformerFromFormatter:formatter];
+        [s_formatterToTransformerMap setObject:transformer forKey:formatter];
+    }
+    return transformer;
+}
+
 #pragma mark Context binding lookup along the responder chain
 
 /**
@@ -15,6 +15,11 @@ CGFloat HLSViewBindingDebugOverlayBorderWidth(BOOL isViewAutomaticallyUpdated);
 UIColor *HLSViewBindingDebugOverlayBorderColor(BOOL isVerified, BOOL hasError);
 UIColor *HLSViewBindingDebugOverlayBackgroundColor(BOOL isVerified, BOOL hasError, BOOL isModelAutomaticallyUpdated);
 
+/**
+ * Heat map background color for a binding, from blue (heat = 0, cheap) to red (heat = 1, most expensive)
+ */
+UIColor *HLSViewBindingDebugOverlayHeatColor(CGFloat heat);
+
 /**
  * Basic apperance settings for binding debugging overlay buttons
  */
@@ -38,6 +38,12 @@ UIColor *HLSViewBindingDebugOverlayBackgroundColor(BOOL isVerified, BOOL hasErro
     }
 }
 
+UIColor *HLSViewBindingDebugOverlayHeatColor(CGFloat heat)
+{
+    CGFloat clampedHeat = MAX(0.f, MIN(heat, 1.f));
+    return [UIColor colorWithHue:(1.f - clampedHeat) * 2.f / 3.f saturation:1.f brightness:1.f alpha:2.f * HLSViewBindingDebugOverlayAlpha()];
+}
+
 UIImage *HLSViewBindingDebugOverlayStripesPatternImage(void)
 {
     return [UIImage coconutKitImageNamed:@"BackgroundStripes.png"];
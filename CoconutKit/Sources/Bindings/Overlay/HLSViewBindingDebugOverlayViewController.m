@@ -6,6 +6,7 @@
 
 #import "HLSViewBindingDebugOverlayViewController.h"
 
+#import "HLSApplicationInformation.h"
 #import "HLSLogger.h"
 #import "HLSMAKVONotificationCenter.h"
 #import "HLSViewBindingDebugOverlayApperance.h"
@@ -17,15 +18,28 @@
 #import "UIView+HLSViewBindingFriend.h"
 #import "UIView+HLSExtensions.h"
 
+#import <QuartzCore/QuartzCore.h>
+
 static UIWindow *s_overlayWindow = nil;
 static UIWindow *s_previousKeyWindow = nil;
 
 static NSString * const HLSViewBindingDebugOverlayUnderlyingViewKey = @"underlyingView";
 
+// Minimum interval between two heat map refreshes
+static const CFTimeInterval HLSViewBindingDebugOverlayHeatMapRefreshInterval = 0.25;
+
 @interface HLSViewBindingDebugOverlayViewController ()
 
 @property (nonatomic, weak) UIWindow *debuggedWindow;
 
+@property (nonatomic, weak) UIView *overlayContainerView;
+@property (nonatomic, weak) UIButton *heatMapButton;
+
+@property (nonatomic, strong) CADisplayLink *displayLink;
+@property (nonatomic, assign) BOOL needsOverlayViewFramesUpdate;
+@property (nonatomic, assign, getter=isDisplayingHeatMap) BOOL displayingHeatMap;
+@property (nonatomic, assign) CFTimeInterval heatMapRefreshTimestamp;
+
 @property (nonatomic, strong) UIPopoverController *bindingInformationPopoverController;
 @property (nonatomic, weak) HLSViewBindingInformationViewController *bindingInformationViewController;
 
@@ -94,9 +108,36 @@ static NSString * const HLSViewBindingDebugOverlayUnderlyingViewKey = @"underlyi
     UIGestureRecognizer *gestureRecognizer = [[UITapGestureRecognizer alloc] initWithTarget:self action:@selector(close:)];
     [view addGestureRecognizer:gestureRecognizer];
     
+    // Overlay views are kept in a separate container so that they can be distinguished from controls
+    UIView *overlayContainerView = [[UIView alloc] initWithFrame:view.bounds];
+    overlayContainerView.autoresizingMask = UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight;
+    [view addSubview:overlayContainerView];
+    self.overlayContainerView = overlayContainerView;
+    
+    UIButton *heatMapButton = [self controlButtonWithTitle:@"Heat map" action:@selector(toggleHeatMap:)];
+    heatMapButton.frame = CGRectMake(10.f, CGRectGetHeight(view.bounds) - 50.f, 100.f, 40.f);
+    [view addSubview:heatMapButton];
+    self.heatMapButton = heatMapButton;
+    
+    UIButton *exportButton = [self controlButtonWithTitle:@"Export" action:@selector(exportProfilingInformation:)];
+    exportButton.frame = CGRectMake(120.f, CGRectGetHeight(view.bounds) - 50.f, 100.f, 40.f);
+    [view addSubview:exportButton];
+    
     self.view = view;
 }
 
+- (UIButton *)controlButtonWithTitle:(NSString *)title action:(SEL)action
+{
+    UIButton *button = [UIButton buttonWithType:UIButtonTypeCustom];
+    button.autoresizingMask = UIViewAutoresizingFlexibleTopMargin;
+    button.backgroundColor = [UIColor colorWithWhite:0.2f alpha:0.8f];
+    button.layer.cornerRadius = 5.f;
+    button.titleLabel.font = [UIFont boldSystemFontOfSize:14.f];
+    [button setTitle:title forState:UIControlStateNormal];
+    [button addTarget:self action:action forControlEvents:UIControlEventTouchUpInside];
+    return button;
+}
+
 - (void)viewDidLoad
 {
     [super viewDidLoad];
@@ -111,6 +152,12 @@ static NSString * const HLSViewBindingDebugOverlayUnderlyingViewKey = @"underlyi
     }
     self.view.frame = [UIScreen mainScreen].bounds;
     
+    // Geometry changes are coalesced and applied at most once per display frame. While the heat map is displayed, it
+    // is refreshed on the same display link. The display link is paused when there is nothing to update
+    self.displayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(refreshOverlay:)];
+    self.displayLink.paused = YES;
+    [self.displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+    
     [self displayDebugInformationForBindingsInView:self.debuggedWindow];
     
     __weak __typeof(self) weakSelf = self;
@@ -119,7 +166,7 @@ static NSString * const HLSViewBindingDebugOverlayUnderlyingViewKey = @"underlyi
     NSArray *scrollViews = [HLSViewBindingDebugOverlayViewController scrollViewsInView:previousWindowRootView];
     for (UIScrollView *scrollView in scrollViews) {
         [scrollView addObserver:self keyPath:@"contentOffset" options:NSKeyValueObservingOptionNew block:^(HLSMAKVONotification *notification) {
-            [weakSelf updateOverlayViewFrames];
+            [weakSelf setNeedsOverlayViewFramesUpdate];
         }];
     }
 }
@@ -173,14 +220,16 @@ static NSString * const HLSViewBindingDebugOverlayUnderlyingViewKey = @"underlyi
         overlayButton.userInfo_hls = @{ HLSViewBindingDebugOverlayUnderlyingViewKey : view };
         [overlayButton addTarget:self action:@selector(showInfos:) forControlEvents:UIControlEventTouchUpInside];
         
+        overlayButton.titleLabel.font = [UIFont boldSystemFontOfSize:10.f];
+        overlayButton.titleLabel.adjustsFontSizeToFitWidth = YES;
+        
         // Track frame changes
-        __weak UIView *weakView = view;
         __weak __typeof(self) weakSelf = self;
         [view addObserver:self keyPath:@"frame" options:NSKeyValueObservingOptionNew block:^(HLSMAKVONotification *notification) {
-            overlayButton.frame = [weakSelf overlayViewFrameForView:weakView];
+            [weakSelf setNeedsOverlayViewFramesUpdate];
         }];
         
-        [self.view addSubview:overlayButton];
+        [self.overlayContainerView addSubview:overlayButton];
     }
     
     for (UIView *subview in view.subviews) {
@@ -217,9 +266,34 @@ static NSString * const HLSViewBindingDebugOverlayUnderlyingViewKey = @"underlyi
     }
 }
 
+- (void)setNeedsOverlayViewFramesUpdate
+{
+    self.needsOverlayViewFramesUpdate = YES;
+    self.displayLink.paused = NO;
+}
+
+- (void)refreshOverlay:(CADisplayLink *)displayLink
+{
+    if (self.needsOverlayViewFramesUpdate) {
+        [self updateOverlayViewFrames];
+        self.needsOverlayViewFramesUpdate = NO;
+    }
+    
+    // Bindings keep being updated behind the overlay. Refresh the heat map periodically so that it reflects them
+    if (self.displayingHeatMap) {
+        if (displayLink.timestamp - self.heatMapRefreshTimestamp >= HLSViewBindingDebugOverlayHeatMapRefreshInterval) {
+            [self updateOverlayButtonAppearances];
+            self.heatMapRefreshTimestamp = displayLink.timestamp;
+        }
+    }
+    else {
+        displayLink.paused = YES;
+    }
+}
+
 - (void)updateOverlayViewFrames
 {
-    for (UIView *overlayView in self.view.subviews) {
+    for (UIView *overlayView in self.overlayContainerView.subviews) {
         UIView *underlyingView = [overlayView.userInfo_hls objectForKey:HLSViewBindingDebugOverlayUnderlyingViewKey];
         if (! underlyingView) {
             HLSLoggerWarn(@"The view %@ has no underlying view. Its frame will not be correctly updated", overlayView);
@@ -230,6 +304,78 @@ static NSString * const HLSViewBindingDebugOverlayUnderlyingViewKey = @"underlyi
     }
 }
 
+#pragma mark Profiling
+
+- (NSArray *)overlayButtons
+{
+    NSMutableArray *overlayButtons = [NSMutableArray array];
+    for (UIView *overlayView in self.overlayContainerView.subviews) {
+        UIView *underlyingView = [overlayView.userInfo_hls objectForKey:HLSViewBindingDebugOverlayUnderlyingViewKey];
+        if ([overlayView isKindOfClass:[UIButton class]] && underlyingView.bindingInformation) {
+            [overlayButtons addObject:overlayView];
+        }
+    }
+    return [NSArray arrayWithArray:overlayButtons];
+}
+
+- (void)updateOverlayButtonAppearances
+{
+    NSArray *overlayButtons = [self overlayButtons];
+    
+    // The most expensive binding is the hottest one
+    NSTimeInterval maxTotalUpdateDuration = 0.;
+    for (UIButton *overlayButton in overlayButtons) {
+        UIView *underlyingView = [overlayButton.userInfo_hls objectForKey:HLSViewBindingDebugOverlayUnderlyingViewKey];
+        maxTotalUpdateDuration = fmax(maxTotalUpdateDuration, underlyingView.bindingInformation.totalUpdateDuration);
+    }
+    
+    for (UIButton *overlayButton in overlayButtons) {
+        UIView *underlyingView = [overlayButton.userInfo_hls objectForKey:HLSViewBindingDebugOverlayUnderlyingViewKey];
+        HLSViewBindingInformation *bindingInformation = underlyingView.bindingInformation;
+        
+        if (self.displayingHeatMap) {
+            CGFloat heat = (maxTotalUpdateDuration > 0.) ? bindingInformation.totalUpdateDuration / maxTotalUpdateDuration : 0.f;
+            overlayButton.backgroundColor = HLSViewBindingDebugOverlayHeatColor(heat);
+            
+            NSString *title = [NSString stringWithFormat:@"%@× · %.1f ms · %.0f/s", @(bindingInformation.updateCount),
+                               bindingInformation.totalUpdateDuration * 1000., bindingInformation.updatesPerSecond];
+            [overlayButton setTitle:title forState:UIControlStateNormal];
+        }
+        else {
+            overlayButton.backgroundColor = HLSViewBindingDebugOverlayBackgroundColor(bindingInformation.verified,
+                                                                                      bindingInformation.error != nil,
+                                                                                      bindingInformation.modelAutomaticallyUpdated);
+            [overlayButton setTitle:nil forState:UIControlStateNormal];
+        }
+    }
+}
+
+/**
+ * Write the profiling information of all displayed bindings as a JSON file in the application documents directory,
+ * so that runs can be compared offline. Return the file URL, nil on failure
+ */
+- (NSURL *)exportProfilingInformationWithError:(NSError *__autoreleasing *)pError
+{
+    NSMutableArray *profilingInformationDictionaries = [NSMutableArray array];
+    for (UIButton *overlayButton in [self overlayButtons]) {
+        UIView *underlyingView = [overlayButton.userInfo_hls objectForKey:HLSViewBindingDebugOverlayUnderlyingViewKey];
+        [profilingInformationDictionaries addObject:[underlyingView.bindingInformation profilingInformationDictionary]];
+    }
+    
+    NSData *data = [NSJSONSerialization dataWithJSONObject:profilingInformationDictionaries options:NSJSONWritingPrettyPrinted error:pError];
+    if (! data) {
+        return nil;
+    }
+    
+    NSString *fileName = [NSString stringWithFormat:@"BindingProfile-%.0f.json", [[NSDate date] timeIntervalSince1970]];
+    NSURL *fileURL = [HLSApplicationDocumentDirectoryURL() URLByAppendingPathComponent:fileName];
+    if (! [data writeToURL:fileURL options:NSDataWritingAtomic error:pError]) {
+        return nil;
+    }
+    
+    return fileURL;
+}
+
 #pragma mark Highlighting
 
 - (void)highlightView:(UIView *)view
@@ -243,7 +389,7 @@ static NSString * const HLSViewBindingDebugOverlayUnderlyingViewKey = @"underlyi
     highlightOverlayView.userInfo_hls = @{ HLSViewBindingDebugOverlayUnderlyingViewKey : view };
     highlightOverlayView.backgroundColor = [UIColor blueColor];
     highlightOverlayView.alpha = 0.f;
-    [self.view addSubview:highlightOverlayView];
+    [self.overlayContainerView addSubview:highlightOverlayView];
     
     [UIView animateWithDuration:0.2 animations:^{
         highlightOverlayView.alpha = 0.5f;
@@ -267,12 +413,39 @@ static NSString * const HLSViewBindingDebugOverlayUnderlyingViewKey = @"underlyi
 
 - (void)close:(id)sender
 {
+    // The display link retains the overlay
+    [self.displayLink invalidate];
+    
     [s_previousKeyWindow makeKeyAndVisible];
     s_previousKeyWindow = nil;
     
     s_overlayWindow = nil;
 }
 
+- (void)toggleHeatMap:(id)sender
+{
+    self.displayingHeatMap = ! self.displayingHeatMap;
+    [self.heatMapButton setTitle:self.displayingHeatMap ? @"Status" : @"Heat map" forState:UIControlStateNormal];
+    [self updateOverlayButtonAppearances];
+    
+    if (self.displayingHeatMap) {
+        self.heatMapRefreshTimestamp = CACurrentMediaTime();
+        self.displayLink.paused = NO;
+    }
+}
+
+- (void)exportProfilingInformation:(id)sender
+{
+    NSError *error = nil;
+    NSURL *fileURL = [self exportProfilingInformationWithError:&error];
+    if (fileURL) {
+        HLSLoggerInfo(@"Binding profiling information exported to %@", fileURL);
+    }
+    else {
+        HLSLoggerError(@"Binding profiling information could not be exported. Reason: %@", error);
+    }
+}
+
 - (void)showInfos:(id)sender
 {
     NSAssert([sender isKindOfClass:[UIButton class]], @"Expect a button");
@@ -46,8 +46,8 @@
         
         self.title = @"Properties";
         
-        self.headerTitles = @[@"Status", @"Capabilities", @"Parameters", @"Resolved information", @"Values"];
-        self.footerTitles = @[[NSNull null], [NSNull null], [NSNull null], @"Tap to highlight objects", [NSNull null]];
+        self.headerTitles = @[@"Status", @"Capabilities", @"Parameters", @"Resolved information", @"Values", @"Profiling"];
+        self.footerTitles = @[[NSNull null], [NSNull null], [NSNull null], @"Tap to highlight objects", [NSNull null], @"Cumulative durations of view updates"];
         
         __weak __typeof(self) weakSelf = self;
         if ([bindingInformation.keyPath rangeOfString:@"@"].length == 0) {
@@ -223,6 +223,29 @@
     return [NSArray arrayWithArray:valueEntries];
 }
 
+- (NSArray *)profilingEntries
+{
+    NSMutableArray *profilingEntries = [NSMutableArray array];
+    
+    HLSViewBindingInformationEntry *updateCountEntry = [[HLSViewBindingInformationEntry alloc] initWithName:@"Updates"
+                                                                                                      text:[NSString stringWithFormat:@"%@ (%.1f/s)", @(self.bindingInformation.updateCount), self.bindingInformation.updatesPerSecond]];
+    [profilingEntries addObject:updateCountEntry];
+    
+    HLSViewBindingInformationEntry *keyPathResolutionEntry = [[HLSViewBindingInformationEntry alloc] initWithName:@"Key path resolution"
+                                                                                                            text:[NSString stringWithFormat:@"%.2f ms", self.bindingInformation.keyPathResolutionDuration * 1000.]];
+    [profilingEntries addObject:keyPathResolutionEntry];
+    
+    HLSViewBindingInformationEntry *transformationEntry = [[HLSViewBindingInformationEntry alloc] initWithName:@"Transformation"
+                                                                                                         text:[NSString stringWithFormat:@"%.2f ms", self.bindingInformation.transformationDuration * 1000.]];
+    [profilingEntries addObject:transformationEntry];
+    
+    HLSViewBindingInformationEntry *viewUpdateEntry = [[HLSViewBindingInformationEntry alloc] initWithName:@"View update"
+                                                                                                     text:[NSString stringWithFormat:@"%.2f ms", self.bindingInformation.viewUpdateDuration * 1000.]];
+    [profilingEntries addObject:viewUpdateEntry];
+    
+    return [NSArray arrayWithArray:profilingEntries];
+}
+
 - (void)reloadEntries
 {
     NSMutableArray *entries = [NSMutableArray array];
@@ -231,6 +254,7 @@
     [entries addObject:[self parameterEntries]];
     [entries addObject:[self resolvedInformationEntries]];
     [entries addObject:[self valueEntries]];
+    [entries addObject:[self profilingEntries]];
     self.entries = [NSArray arrayWithArray:entries];
 }
 
@@ -9,6 +9,16 @@
 #import <Foundation/Foundation.h>
 #import <UIKit/UIKit.h>
 
+// When values changed by the user are written back to the model
+typedef NS_ENUM(NSInteger, HLSViewBindingWriteBackPolicy) {
+    HLSViewBindingWriteBackPolicyEnumBegin = 0,
+    HLSViewBindingWriteBackPolicyOnChange = HLSViewBindingWriteBackPolicyEnumBegin,        // Each time the value changes, or after bindWriteBackDelay if set
+    HLSViewBindingWriteBackPolicyOnEndEditing,                                              // When the user stops editing the view
+    HLSViewBindingWriteBackPolicyExplicit,                                                  // Only when -commitBoundViewHierarchyWithError: is called
+    HLSViewBindingWriteBackPolicyEnumEnd,
+    HLSViewBindingWriteBackPolicyEnumSize = HLSViewBindingWriteBackPolicyEnumEnd - HLSViewBindingWriteBackPolicyEnumBegin
+};
+
 /**
  * Cocoa-inspired bindings on iOS
  * ------------------------------
@@ -260,6 +270,26 @@
  * can be validated automatically when the view changes.
  *
  *
+ * 6.3. Write-back policy
+ * ----------------------
+ *
+ * By default, each change made to a view accepting input is immediately transformed, checked (if bindInputChecked is
+ * set to YES) and written back to the model. For text fields and text views, this happens for each keystroke. When
+ * transformation or validation is expensive, or when many other views are bound to the same model, this can be avoided
+ * by setting the bindWriteBackPolicy of the view:
+ *   - HLSViewBindingWriteBackPolicyOnChange (default): Changes are written back immediately or, if bindWriteBackDelay 
+ *     is set, when no other change has been made during this delay. Pending changes are also written back when the
+ *     user stops editing the view
+ *   - HLSViewBindingWriteBackPolicyOnEndEditing: Changes are written back when the user stops editing the view (for
+ *     views without a notion of editing, e.g. sliders, this is the same as HLSViewBindingWriteBackPolicyExplicit)
+ *   - HLSViewBindingWriteBackPolicyExplicit: Changes are written back when -commitBoundViewHierarchyWithError: is
+ *     called, typically before the model is saved
+ *
+ * Changes which have not been written back yet are lost if the view is updated from the model in the meantime. Moreover,
+ * text input values which have already been transformed, checked and written back are not processed again (nor reported
+ * again to the binding delegate) as long as no bound model object has changed.
+ *
+ *
  *
  * 7. Natively supported views
  * ---------------------------
@@ -348,6 +378,21 @@
  */
 @property (nonatomic, assign, getter=isBindInputChecked) IBInspectable BOOL bindInputChecked;
 
+/**
+ * When changes made to the bound view are written back to the model (see 6.3.)
+ *
+ * The default value is HLSViewBindingWriteBackPolicyOnChange
+ */
+@property (nonatomic, assign) HLSViewBindingWriteBackPolicy bindWriteBackPolicy;
+
+/**
+ * For the HLSViewBindingWriteBackPolicyOnChange policy, the time to wait without any further change before writing
+ * a change back to the model
+ *
+ * The default value is 0 (changes are written back immediately)
+ */
+@property (nonatomic, assign) IBInspectable NSTimeInterval bindWriteBackDelay;
+
 /**
  * Return YES iff binding is possible against the receiver. This method is provided for information purposes, trying
  * to bind a view which does not support bindings is safe (i.e. won't crash) but does nothing
@@ -374,6 +419,14 @@
  */
 - (BOOL)checkBoundViewHierarchyWithError:(NSError *__autoreleasing *)pError;
 
+/**
+ * Write back all changes which have not been written back to the model yet, for the receiver and the whole view 
+ * hierarchy rooted at it, stopping at view controller boundaries. Values are checked if bindInputChecked is set.
+ * Errors are individually reported to the validation delegate, and chained as a single error returned to the caller
+ * as well. The method returns YES iff all operations have been successful
+ */
+- (BOOL)commitBoundViewHierarchyWithError:(NSError *__autoreleasing *)pError;
+
 @end
 
 @interface UIView (HLSViewBindingProgrammatic)
@@ -19,6 +19,8 @@ static void *s_bindKeyPath = &s_bindKeyPath;
 static void *s_bindTransformerKey = &s_bindTransformerKey;
 static void *s_bindUpdateAnimatedKey = &s_bindUpdateAnimatedKey;
 static void *s_bindInputCheckedKey = &s_bindInputCheckedKey;
+static void *s_bindWriteBackPolicyKey = &s_bindWriteBackPolicyKey;
+static void *s_bindWriteBackDelayKey = &s_bindWriteBackDelayKey;
 static void *s_bindingInformationKey = &s_bindingInformationKey;
 
 // Original implementation of the methods we swizzle
@@ -36,6 +38,7 @@ static void swizzle_didMoveToWindow(UIView *self, SEL _cmd);
 
 - (void)updateBoundViewHierarchyAnimated:(NSNumber *)animated inViewController:(UIViewController *)viewController;
 - (BOOL)checkBoundViewHierarchyInViewController:(UIViewController *)viewController withError:(NSError *__autoreleasing *)pError;
+- (BOOL)commitBoundViewHierarchyInViewController:(UIViewController *)viewController withError:(NSError *__autoreleasing *)pError;
 
 @end
 
@@ -45,7 +48,9 @@ static void swizzle_didMoveToWindow(UIView *self, SEL _cmd);
 
 + (void)load
 {
+    HLSSwizzleGroup_Begin
     HLSSwizzleSelector(self, @selector(didMoveToWindow), swizzle_didMoveToWindow, &s_didMoveToWindow);
+    HLSSwizzleGroup_End
 }
 
 + (void)showBindingsDebugOverlay
@@ -75,6 +80,26 @@ static void swizzle_didMoveToWindow(UIView *self, SEL _cmd);
     hls_setAssociatedObject(self, s_bindInputCheckedKey, @(bindInputChecked), OBJC_ASSOCIATION_RETAIN_NONATOMIC);
 }
 
+- (HLSViewBindingWriteBackPolicy)bindWriteBackPolicy
+{
+    return [hls_getAssociatedObject(self, s_bindWriteBackPolicyKey) integerValue];
+}
+
+- (void)setBindWriteBackPolicy:(HLSViewBindingWriteBackPolicy)bindWriteBackPolicy
+{
+    hls_setAssociatedObject(self, s_bindWriteBackPolicyKey, @(bindWriteBackPolicy), OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+}
+
+- (NSTimeInterval)bindWriteBackDelay
+{
+    return [hls_getAssociatedObject(self, s_bindWriteBackDelayKey) doubleValue];
+}
+
+- (void)setBindWriteBackDelay:(NSTimeInterval)bindWriteBackDelay
+{
+    hls_setAssociatedObject(self, s_bindWriteBackDelayKey, @(bindWriteBackDelay), OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+}
+
 - (BOOL)isBindingSupported
 {
     return [self respondsToSelector:@selector(updateViewWithValue:animated:)];
@@ -97,6 +122,11 @@ static void swizzle_didMoveToWindow(UIView *self, SEL _cmd);
     return [self checkBoundViewHierarchyInViewController:[self nearestViewController] withError:pError];
 }
 
+- (BOOL)commitBoundViewHierarchyWithError:(NSError *__autoreleasing *)pError
+{
+    return [self commitBoundViewHierarchyInViewController:[self nearestViewController] withError:pError];
+}
+
 @end
 
 @implementation UIView (HLSViewBindingPrivate)
@@ -197,6 +227,32 @@ static void swizzle_didMoveToWindow(UIView *self, SEL _cmd);
     return success;
 }
 
+- (BOOL)commitBoundViewHierarchyInViewController:(UIViewController *)viewController withError:(NSError *__autoreleasing *)pError
+{
+    // Stop at view controller boundaries. The following also correctly deals with viewController = nil
+    UIViewController *nearestViewController = self.nearestViewController;
+    if (nearestViewController && nearestViewController != viewController) {
+        return YES;
+    }
+    
+    BOOL success = YES;
+    if (self.bindingInformation) {
+        NSError *error = nil;
+        if (! [self.bindingInformation commitPendingInputWithError:&error]) {
+            success = NO;
+            [NSError combineError:error withError:pError];
+        }
+    }
+    
+    for (UIView *subview in self.subviews) {
+        if (! [subview commitBoundViewHierarchyInViewController:viewController withError:pError]) {
+            success = NO;
+        }
+    }
+    
+    return success;
+}
+
 @end
 
 @implementation UIView (HLSViewBindingUpdateImplementation)
@@ -211,6 +267,36 @@ static void swizzle_didMoveToWindow(UIView *self, SEL _cmd);
     return [self.bindingInformation check:check && self.bindInputChecked update:update withInputValue:inputValue error:pError];
 }
 
+- (void)bindInputDidChangeToValue:(id)inputValue
+{
+    if (! self.bindingInformation) {
+        return;
+    }
+    
+    HLSViewBindingWriteBackPolicy bindWriteBackPolicy = self.bindWriteBackPolicy;
+    if (bindWriteBackPolicy == HLSViewBindingWriteBackPolicyOnChange) {
+        NSTimeInterval bindWriteBackDelay = self.bindWriteBackDelay;
+        if (bindWriteBackDelay > 0.) {
+            [self.bindingInformation recordPendingInputValue:inputValue commitDelay:bindWriteBackDelay];
+        }
+        else {
+            [self.bindingInformation check:self.bindInputChecked update:YES withInputValue:inputValue cached:YES error:NULL];
+        }
+    }
+    else {
+        [self.bindingInformation recordPendingInputValue:inputValue commitDelay:0.];
+    }
+}
+
+- (void)bindInputDidEndEditing
+{
+    if (self.bindWriteBackPolicy == HLSViewBindingWriteBackPolicyExplicit) {
+        return;
+    }
+    
+    [self.bindingInformation commitPendingInputWithError:NULL];
+}
+
 @end
 
 @implementation UIView (HLSViewBindingProgrammatic)
@@ -238,6 +324,8 @@ static void swizzle_didMoveToWindow(UIView *self, SEL _cmd);
 // complete
 static void swizzle_didMoveToWindow(UIView *self, SEL _cmd)
 {
+    HLSSwizzleCountCall(&s_didMoveToWindow);
+    
     s_didMoveToWindow(self, _cmd);
     
     if (self.window) {
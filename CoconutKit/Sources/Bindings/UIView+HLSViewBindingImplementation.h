@@ -77,4 +77,16 @@
  */
 - (BOOL)check:(BOOL)check update:(BOOL)update withInputValue:(id)inputValue error:(NSError *__autoreleasing *)pError;
 
+/**
+ * Alternatively, call this method when the value displayed by the view is changed, so that the value is checked and
+ * written back to the model according to the bindWriteBackPolicy and bindWriteBackDelay settings of the view
+ */
+- (void)bindInputDidChangeToValue:(id)inputValue;
+
+/**
+ * For views supporting an editing session, call this method when editing ends, so that pending changes get written
+ * back to the model (except for the HLSViewBindingWriteBackPolicyExplicit policy)
+ */
+- (void)bindInputDidEndEditing;
+
 @end
@@ -36,4 +36,34 @@
  */
 - (UIImage *)flattenedImage;
 
+/**
+ * Same as -flattenedImage, but only rendering the specified rectangle (in the coordinate system of the image returned
+ * by -flattenedImage, CGRectNull for the whole image) at the specified scale (0 for the device scale). Rendering a
+ * smaller region or at a smaller scale is faster and requires less memory, e.g. for previews
+ */
+- (UIImage *)flattenedImageInRect:(CGRect)rect scale:(CGFloat)scale;
+
+/**
+ * Asynchronous version of -flattenedImageInRect:scale:. The image is rendered in the background when possible, from
+ * the presentation layer tree (i.e. with the layer as it is currently displayed, including running animations).
+ * Layers which have never been displayed are rendered on the main thread
+ *
+ * If a content version is provided, the image is cached, and later requests with the same rectangle, scale and
+ * content version are served from the cache. The content version can be any object (compared using -isEqual:),
+ * and must be changed by the caller when the layer contents change. Providing another content version discards
+ * all images cached for the layer. If no content version is provided, the image is not cached
+ *
+ * The completion block is called on the main thread, immediately if the image was available from the cache. This
+ * method must be called from the main thread
+ */
+- (void)flattenImageInRect:(CGRect)rect
+                     scale:(CGFloat)scale
+            contentVersion:(id<NSObject>)contentVersion
+           completionBlock:(void (^)(UIImage *image))completionBlock;
+
+/**
+ * Discard all images cached for the layer by -flattenImageInRect:scale:contentVersion:completionBlock:
+ */
+- (void)discardFlattenedImages;
+
 @end
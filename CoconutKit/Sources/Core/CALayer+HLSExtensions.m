@@ -6,6 +6,7 @@
 
 #import "CALayer+HLSExtensions.h"
 
+#import "HLSLayerSnapshotter.h"
 #import "HLSLogger.h"
 
 static NSString * const kLayerSpeedBeforePauseKey = @"HLSLayerSpeedBeforePause";
@@ -81,29 +82,31 @@ static NSString * const kLayerSpeedBeforePauseKey = @"HLSLayerSpeedBeforePause";
     return [self valueForKey:kLayerSpeedBeforePauseKey] != nil;
 }
 
-// See http://developer.apple.com/library/ios/#qa/qa1703/_index.html
 - (UIImage *)flattenedImage
 {
-    UIGraphicsBeginImageContextWithOptions(self.bounds.size, self.opaque, 0.f /* use the device scale factor */);
-    
-    // -renderInContext: renders in the layer coordinate space, i.e. the origin of the layer is ignored. This has
-    // to be fixed before creating the image
-    CGContextRef context = UIGraphicsGetCurrentContext();
-    CGContextSaveGState(context);
-    
-    CGContextTranslateCTM(context, CGRectGetMidX(self.frame), CGRectGetMidY(self.frame));
-    CGContextConcatCTM(context, CATransform3DGetAffineTransform(self.transform));
-    CGContextTranslateCTM(context,
-                          -CGRectGetWidth(self.bounds) * self.anchorPoint.x,
-                          -CGRectGetHeight(self.bounds) * self.anchorPoint.y);
-    [self renderInContext:context];
-    
-    CGContextRestoreGState(context);
-    
-    UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
-    UIGraphicsEndImageContext();
-    
-    return image;
+    return [self flattenedImageInRect:CGRectNull scale:0.f /* use the device scale factor */];
+}
+
+- (UIImage *)flattenedImageInRect:(CGRect)rect scale:(CGFloat)scale
+{
+    return [HLSLayerSnapshotter snapshotOfLayer:self inRect:rect scale:scale];
+}
+
+- (void)flattenImageInRect:(CGRect)rect
+                     scale:(CGFloat)scale
+            contentVersion:(id<NSObject>)contentVersion
+           completionBlock:(void (^)(UIImage *image))completionBlock
+{
+    [[HLSLayerSnapshotter sharedLayerSnapshotter] snapshotLayer:self
+                                                         inRect:rect
+                                                          scale:scale
+                                                 contentVersion:contentVersion
+                                                completionBlock:completionBlock];
+}
+
+- (void)discardFlattenedImages
+{
+    [[HLSLayerSnapshotter sharedLayerSnapshotter] removeSnapshotsOfLayer:self];
 }
 
 @end
@@ -9,10 +9,10 @@
 
 /**
  * Collects the code which can be executed right after an application has started so that perceived performance can be
- * increased. For the moment only UIWebView is preloaded so that the time usually required when instantiating the first
- * web view is reduced
+ * increased. For the moment only the shared web view pool is prewarmed so that the time usually required when instantiating
+ * the first web view is reduced
  */
-@interface HLSApplicationPreloader : NSObject <UIWebViewDelegate>
+@interface HLSApplicationPreloader : NSObject
 
 /**
  * Initialize the preloader. An application is required
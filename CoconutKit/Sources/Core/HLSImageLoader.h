@@ -0,0 +1,70 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+
+/**
+ * Private class loading images from files in the background. Images are decoded (and downsampled to a target size
+ * if they are larger) before they are handed out, so that displaying them does not require any additional work on
+ * the main thread. Decoded images are stored in a shared cache, keyed by file path and target size
+ *
+ * This class must be used from the main thread
+ */
+@interface HLSImageLoader : NSObject
+
+/**
+ * The shared loader instance
+ */
++ (instancetype)sharedImageLoader;
+
+/**
+ * Return the file path of an image, given its name in the main bundle (as for +[UIImage imageNamed:]). Return nil
+ * if the image is not available as a file (e.g. if stored in an asset catalog)
+ */
++ (NSString *)pathForImageNamed:(NSString *)name;
+
+/**
+ * Same as +pathForImageNamed:, but for the given bundle, screen scale and user interface idiom. Variants are looked
+ * up from the given scale down to 1x, the variant for the idiom (~iphone or ~ipad) first for each scale
+ */
++ (NSString *)pathForImageNamed:(NSString *)name
+                       inBundle:(NSBundle *)bundle
+                          scale:(CGFloat)scale
+             userInterfaceIdiom:(UIUserInterfaceIdiom)userInterfaceIdiom;
+
+/**
+ * Return the decoded image for the given file path and target size (in pixels) if available from the cache, nil 
+ * otherwise. If the target size is CGSizeZero, images are not downsampled
+ */
+- (UIImage *)cachedImageWithContentsOfFile:(NSString *)path targetSize:(CGSize)targetSize;
+
+/**
+ * Load and decode the image at the given path in the background, downsampling it to the given target size (in pixels)
+ * if it is larger. The completion block is called on the main thread with the decoded image (nil on failure), except
+ * if the returned operation has been cancelled in the meantime
+ *
+ * Requests for an image which is already being loaded (same path and target size) join the load in progress. The
+ * load itself is cancelled once all requests which joined it have been cancelled
+ */
+- (NSOperation *)loadImageWithContentsOfFile:(NSString *)path
+                                  targetSize:(CGSize)targetSize
+                             completionBlock:(void (^)(UIImage *image))completionBlock;
+
+/**
+ * Number of cache lookups which succeeded or failed. Failed lookups for images which are being loaded are not
+ * counted as misses, since requests for them join the load in progress
+ */
+@property (nonatomic, readonly, assign) NSUInteger hitCount;
+@property (nonatomic, readonly, assign) NSUInteger missCount;
+
+/**
+ * Total time spent loading and decoding images in the background, i.e. time which would otherwise have been spent
+ * on the main thread
+ */
+@property (nonatomic, readonly, assign) NSTimeInterval decodingDuration;
+
+@end
@@ -0,0 +1,295 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import "HLSImageLoader.h"
+
+// Maximum total size of the decoded images kept in the cache, in bytes
+static const NSUInteger kImageCacheByteCostLimit = 32 * 1024 * 1024;
+
+#pragma mark -
+#pragma mark HLSImageLoadRequest class interface
+
+/**
+ * A request for an image. Several requests can share the same load, which is cancelled when all of them have been
+ * cancelled. Requests are never enqueued, they are only used as cancellable handles
+ */
+@interface HLSImageLoadRequest : NSOperation
+
+- (instancetype)initWithImageLoader:(HLSImageLoader *)imageLoader key:(NSString *)key completionBlock:(void (^)(UIImage *image))completionBlock;
+
+@property (nonatomic, readonly, weak) HLSImageLoader *imageLoader;
+@property (nonatomic, readonly, strong) NSString *key;
+@property (nonatomic, readonly, copy) void (^imageCompletionBlock)(UIImage *image);
+
+@end
+
+#pragma mark -
+#pragma mark HLSImageLoader class implementation
+
+@interface HLSImageLoader ()
+
+@property (nonatomic, strong) NSCache *cache;
+@property (nonatomic, strong) NSOperationQueue *operationQueue;
+@property (nonatomic, strong) NSMutableDictionary *keyToOperationMap;           // Loads in progress
+@property (nonatomic, strong) NSMutableDictionary *keyToRequestsMap;            // Requests which joined a load in progress
+
+@property (nonatomic, assign) NSUInteger hitCount;
+@property (nonatomic, assign) NSUInteger missCount;
+@property (nonatomic, assign) NSTimeInterval decodingDuration;
+
+- (void)cancelRequest:(HLSImageLoadRequest *)request;
+
+@end
+
+@implementation HLSImageLoader
+
+#pragma mark Class methods
+
++ (instancetype)sharedImageLoader
+{
+    static HLSImageLoader *s_instance = nil;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        s_instance = [[[self class] alloc] init];
+    });
+    return s_instance;
+}
+
++ (NSString *)pathForImageNamed:(NSString *)name
+{
+    return [self pathForImageNamed:name
+                          inBundle:[NSBundle mainBundle]
+                             scale:[UIScreen mainScreen].scale
+                userInterfaceIdiom:[UIDevice currentDevice].userInterfaceIdiom];
+}
+
++ (NSString *)pathForImageNamed:(NSString *)name
+                       inBundle:(NSBundle *)bundle
+                          scale:(CGFloat)scale
+             userInterfaceIdiom:(UIUserInterfaceIdiom)userInterfaceIdiom
+{
+    NSString *pathExtension = [name pathExtension];
+    NSString *baseName = name;
+    NSArray *extensions = @[@"png", @"jpg", @"jpeg"];
+    if ([pathExtension length] != 0) {
+        baseName = [name stringByDeletingPathExtension];
+        extensions = @[pathExtension];
+    }
+    
+    // Same lookup order as +[UIImage imageNamed:] for files: Screen scale variant first, then lower scales down to 1x.
+    // For each scale, the variant for the current device comes first
+    NSString *deviceModifier = (userInterfaceIdiom == UIUserInterfaceIdiomPad) ? @"~ipad" : @"~iphone";
+    NSMutableArray *candidateNames = [NSMutableArray array];
+    for (NSInteger i = MAX((NSInteger)round(scale), 1); i >= 1; --i) {
+        NSString *scaledName = (i == 1) ? baseName : [NSString stringWithFormat:@"%@@%@x", baseName, @(i)];
+        [candidateNames addObject:[scaledName stringByAppendingString:deviceModifier]];
+        [candidateNames addObject:scaledName];
+    }
+    
+    for (NSString *extension in extensions) {
+        for (NSString *candidateName in candidateNames) {
+            NSString *path = [bundle pathForResource:candidateName ofType:extension];
+            if (path) {
+                return path;
+            }
+        }
+    }
+    return nil;
+}
+
+/**
+ * Load and decode an image file, downsampling it if larger than the target size (in pixels). Can be called from any
+ * thread
+ */
++ (UIImage *)decodedImageWithContentsOfFile:(NSString *)path targetSize:(CGSize)targetSize
+{
+    UIImage *image = [UIImage imageWithContentsOfFile:path];
+    if (! image) {
+        return nil;
+    }
+    
+    CGImageRef imageRef = image.CGImage;
+    size_t width = CGImageGetWidth(imageRef);
+    size_t height = CGImageGetHeight(imageRef);
+    if (width == 0 || height == 0) {
+        return image;
+    }
+    
+    // Downsample so that the image still covers the target size in both directions, whatever the content mode
+    CGFloat ratio = 1.f;
+    if (targetSize.width > 0.f && targetSize.height > 0.f) {
+        ratio = MIN(1.f, MAX(targetSize.width / width, targetSize.height / height));
+    }
+    
+    size_t decodedWidth = (size_t)ceil(width * ratio);
+    size_t decodedHeight = (size_t)ceil(height * ratio);
+    
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate(NULL, decodedWidth, decodedHeight, 8, 0, colorSpace,
+                                                 kCGBitmapByteOrder32Host | kCGImageAlphaPremultipliedFirst);
+    CGColorSpaceRelease(colorSpace);
+    if (! context) {
+        return image;
+    }
+    
+    CGContextSetInterpolationQuality(context, kCGInterpolationHigh);
+    CGContextDrawImage(context, CGRectMake(0.f, 0.f, decodedWidth, decodedHeight), imageRef);
+    CGImageRef decodedImageRef = CGBitmapContextCreateImage(context);
+    CGContextRelease(context);
+    if (! decodedImageRef) {
+        return image;
+    }
+    
+    // Keep the same size in points
+    UIImage *decodedImage = [UIImage imageWithCGImage:decodedImageRef scale:image.scale * ratio orientation:image.imageOrientation];
+    CGImageRelease(decodedImageRef);
+    return decodedImage;
+}
+
++ (NSString *)keyForPath:(NSString *)path targetSize:(CGSize)targetSize
+{
+    return [NSString stringWithFormat:@"%@_%.0fx%.0f", path, targetSize.width, targetSize.height];
+}
+
+#pragma mark Object creation and destruction
+
+- (instancetype)init
+{
+    if (self = [super init]) {
+        self.cache = [[NSCache alloc] init];
+        self.cache.totalCostLimit = kImageCacheByteCostLimit;
+        
+        self.operationQueue = [[NSOperationQueue alloc] init];
+        self.operationQueue.name = @"ch.defagos.CoconutKit.HLSImageLoader";
+        self.operationQueue.maxConcurrentOperationCount = 2;
+        
+        self.keyToOperationMap = [NSMutableDictionary dictionary];
+        self.keyToRequestsMap = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+#pragma mark Image loading
+
+- (UIImage *)cachedImageWithContentsOfFile:(NSString *)path targetSize:(CGSize)targetSize
+{
+    NSAssert([NSThread isMainThread], @"Must be called from the main thread");
+    
+    NSString *key = [HLSImageLoader keyForPath:path targetSize:targetSize];
+    UIImage *image = [self.cache objectForKey:key];
+    if (image) {
+        ++self.hitCount;
+    }
+    else if (! [self.keyToRequestsMap objectForKey:key]) {
+        ++self.missCount;
+    }
+    return image;
+}
+
+- (NSOperation *)loadImageWithContentsOfFile:(NSString *)path
+                                  targetSize:(CGSize)targetSize
+                             completionBlock:(void (^)(UIImage *image))completionBlock
+{
+    NSAssert([NSThread isMainThread], @"Must be called from the main thread");
+    
+    NSString *key = [HLSImageLoader keyForPath:path targetSize:targetSize];
+    HLSImageLoadRequest *request = [[HLSImageLoadRequest alloc] initWithImageLoader:self key:key completionBlock:completionBlock];
+    
+    // Join the load in progress, if any
+    NSMutableArray *requests = [self.keyToRequestsMap objectForKey:key];
+    if (requests) {
+        [requests addObject:request];
+        return request;
+    }
+    [self.keyToRequestsMap setObject:[NSMutableArray arrayWithObject:request] forKey:key];
+    
+    NSBlockOperation *operation = [[NSBlockOperation alloc] init];
+    __weak NSBlockOperation *weakOperation = operation;
+    [operation addExecutionBlock:^{
+        NSBlockOperation *strongOperation = weakOperation;
+        if (! strongOperation || [strongOperation isCancelled]) {
+            return;
+        }
+        
+        CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+        UIImage *image = [HLSImageLoader decodedImageWithContentsOfFile:path targetSize:targetSize];
+        NSTimeInterval duration = CFAbsoluteTimeGetCurrent() - startTime;
+        
+        if (image) {
+            CGImageRef imageRef = image.CGImage;
+            [self.cache setObject:image forKey:key cost:CGImageGetBytesPerRow(imageRef) * CGImageGetHeight(imageRef)];
+        }
+        
+        // Cancellation is always made from the main thread, the check is therefore reliable
+        dispatch_async(dispatch_get_main_queue(), ^{
+            self.decodingDuration += duration;
+            
+            if ([strongOperation isCancelled]) {
+                return;
+            }
+            
+            NSArray *requests = [self.keyToRequestsMap objectForKey:key];
+            [self.keyToRequestsMap removeObjectForKey:key];
+            [self.keyToOperationMap removeObjectForKey:key];
+            
+            for (HLSImageLoadRequest *request in requests) {
+                request.imageCompletionBlock ? request.imageCompletionBlock(image) : nil;
+            }
+        });
+    }];
+    [self.keyToOperationMap setObject:operation forKey:key];
+    [self.operationQueue addOperation:operation];
+    return request;
+}
+
+- (void)cancelRequest:(HLSImageLoadRequest *)request
+{
+    NSAssert([NSThread isMainThread], @"Must be called from the main thread");
+    
+    NSMutableArray *requests = [self.keyToRequestsMap objectForKey:request.key];
+    if (! requests) {
+        return;
+    }
+    
+    [requests removeObject:request];
+    if ([requests count] != 0) {
+        return;
+    }
+    
+    // No request is interested in the image anymore
+    [[self.keyToOperationMap objectForKey:request.key] cancel];
+    [self.keyToOperationMap removeObjectForKey:request.key];
+    [self.keyToRequestsMap removeObjectForKey:request.key];
+}
+
+@end
+
+#pragma mark -
+#pragma mark HLSImageLoadRequest class implementation
+
+@implementation HLSImageLoadRequest
+
+#pragma mark Object creation and destruction
+
+- (instancetype)initWithImageLoader:(HLSImageLoader *)imageLoader key:(NSString *)key completionBlock:(void (^)(UIImage *image))completionBlock
+{
+    if (self = [super init]) {
+        _imageLoader = imageLoader;
+        _key = key;
+        _imageCompletionBlock = [completionBlock copy];
+    }
+    return self;
+}
+
+#pragma mark Cancellation
+
+- (void)cancel
+{
+    [super cancel];
+    [self.imageLoader cancelRequest:self];
+}
+
+@end
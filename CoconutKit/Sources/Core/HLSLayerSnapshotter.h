@@ -0,0 +1,63 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import <Foundation/Foundation.h>
+#import <QuartzCore/QuartzCore.h>
+#import <UIKit/UIKit.h>
+
+/**
+ * Private class rendering layer snapshots. Snapshots can be restricted to a region of interest and rendered at
+ * a reduced scale. Asynchronous snapshots are rendered in the background from the presentation layer tree, which
+ * Core Animation maintains as a copy of the layer tree, and stored in a shared cache keyed by layer, region, scale
+ * and a content version supplied by the caller
+ *
+ * This class must be used from the main thread
+ */
+@interface HLSLayerSnapshotter : NSObject
+
+/**
+ * The shared snapshotter instance
+ */
++ (instancetype)sharedLayerSnapshotter;
+
+/**
+ * Render a snapshot synchronously. The rectangle is given in the coordinate system of the snapshot of the whole
+ * layer (CGRectNull for the whole layer), the scale is the scale of the resulting image (0 for the device scale).
+ * Can be called from any thread if the layer is not modified in the meantime (e.g. for a presentation layer)
+ */
++ (UIImage *)snapshotOfLayer:(CALayer *)layer inRect:(CGRect)rect scale:(CGFloat)scale;
+
+/**
+ * Render a snapshot in the background (if possible, otherwise on the main thread). If a content version is provided,
+ * the snapshot is cached, and later requests for the same layer, rectangle, scale and content version are fulfilled
+ * from the cache. Requesting a snapshot with another content version discards all snapshots cached for the layer
+ *
+ * The completion block is called on the main thread, synchronously if the snapshot was available from the cache
+ */
+- (void)snapshotLayer:(CALayer *)layer
+               inRect:(CGRect)rect
+                scale:(CGFloat)scale
+       contentVersion:(id<NSObject>)contentVersion
+      completionBlock:(void (^)(UIImage *image))completionBlock;
+
+/**
+ * Discard all snapshots cached for a layer
+ */
+- (void)removeSnapshotsOfLayer:(CALayer *)layer;
+
+/**
+ * Number of cache lookups which succeeded or failed
+ */
+@property (nonatomic, readonly, assign) NSUInteger hitCount;
+@property (nonatomic, readonly, assign) NSUInteger missCount;
+
+/**
+ * Total time spent rendering snapshots in the background, i.e. time which would otherwise have been spent on the
+ * main thread
+ */
+@property (nonatomic, readonly, assign) NSTimeInterval renderingDuration;
+
+@end
@@ -0,0 +1,231 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import "HLSLayerSnapshotter.h"
+
+// Maximum total size of the snapshots kept in the cache, in bytes
+static const NSUInteger kSnapshotCacheByteCostLimit = 32 * 1024 * 1024;
+
+#pragma mark -
+#pragma mark HLSLayerSnapshot class interface
+
+/**
+ * A cached snapshot. Cache keys are built from layer addresses, which can be reused once a layer has been deallocated.
+ * The layer is therefore kept as a weak reference to check that a snapshot still corresponds to the layer
+ */
+@interface HLSLayerSnapshot : NSObject
+
+- (instancetype)initWithLayer:(CALayer *)layer image:(UIImage *)image;
+
+@property (nonatomic, readonly, weak) CALayer *layer;
+@property (nonatomic, readonly, strong) UIImage *image;
+
+@end
+
+#pragma mark -
+#pragma mark HLSLayerSnapshotter class implementation
+
+@interface HLSLayerSnapshotter ()
+
+@property (nonatomic, strong) NSCache *cache;
+@property (nonatomic, strong) NSMapTable *layerToContentVersionMap;
+@property (nonatomic, strong) NSMapTable *layerToKeysMap;                   // Keys of the snapshots cached for a layer
+@property (nonatomic, strong) NSOperationQueue *operationQueue;
+
+@property (nonatomic, assign) NSUInteger hitCount;
+@property (nonatomic, assign) NSUInteger missCount;
+@property (nonatomic, assign) NSTimeInterval renderingDuration;
+
+@end
+
+@implementation HLSLayerSnapshotter
+
+#pragma mark Class methods
+
++ (instancetype)sharedLayerSnapshotter
+{
+    static HLSLayerSnapshotter *s_instance = nil;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        s_instance = [[[self class] alloc] init];
+    });
+    return s_instance;
+}
+
+// See http://developer.apple.com/library/ios/#qa/qa1703/_index.html
++ (UIImage *)snapshotOfLayer:(CALayer *)layer inRect:(CGRect)rect scale:(CGFloat)scale
+{
+    CGRect snapshotRect = CGRectMake(0.f, 0.f, CGRectGetWidth(layer.bounds), CGRectGetHeight(layer.bounds));
+    if (! CGRectIsNull(rect)) {
+        snapshotRect = CGRectIntersection(snapshotRect, rect);
+    }
+    
+    if (CGRectIsEmpty(snapshotRect)) {
+        return nil;
+    }
+    
+    UIGraphicsBeginImageContextWithOptions(snapshotRect.size, layer.opaque, scale);
+    
+    // Only the region of interest is rendered
+    CGContextRef context = UIGraphicsGetCurrentContext();
+    CGContextSaveGState(context);
+    CGContextTranslateCTM(context, -CGRectGetMinX(snapshotRect), -CGRectGetMinY(snapshotRect));
+    
+    // -renderInContext: renders in the layer coordinate space, i.e. the origin of the layer is ignored. This has
+    // to be fixed before creating the image
+    CGContextTranslateCTM(context, CGRectGetMidX(layer.frame), CGRectGetMidY(layer.frame));
+    CGContextConcatCTM(context, CATransform3DGetAffineTransform(layer.transform));
+    CGContextTranslateCTM(context,
+                          -CGRectGetWidth(layer.bounds) * layer.anchorPoint.x,
+                          -CGRectGetHeight(layer.bounds) * layer.anchorPoint.y);
+    [layer renderInContext:context];
+    
+    CGContextRestoreGState(context);
+    
+    UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    
+    return image;
+}
+
++ (NSString *)keyForLayer:(CALayer *)layer rect:(CGRect)rect scale:(CGFloat)scale
+{
+    return [NSString stringWithFormat:@"%p_%@_%.2f", layer, NSStringFromCGRect(rect), scale];
+}
+
+#pragma mark Object creation and destruction
+
+- (instancetype)init
+{
+    if (self = [super init]) {
+        self.cache = [[NSCache alloc] init];
+        self.cache.totalCostLimit = kSnapshotCacheByteCostLimit;
+        
+        self.layerToContentVersionMap = [NSMapTable weakToStrongObjectsMapTable];
+        self.layerToKeysMap = [NSMapTable weakToStrongObjectsMapTable];
+        
+        self.operationQueue = [[NSOperationQueue alloc] init];
+        self.operationQueue.name = @"ch.defagos.CoconutKit.HLSLayerSnapshotter";
+        self.operationQueue.maxConcurrentOperationCount = 2;
+    }
+    return self;
+}
+
+#pragma mark Snapshots
+
+- (void)snapshotLayer:(CALayer *)layer
+               inRect:(CGRect)rect
+                scale:(CGFloat)scale
+       contentVersion:(id<NSObject>)contentVersion
+      completionBlock:(void (^)(UIImage *image))completionBlock
+{
+    NSAssert([NSThread isMainThread], @"Must be called from the main thread");
+    NSParameterAssert(layer);
+    
+    if (scale == 0.f) {
+        scale = [UIScreen mainScreen].scale;
+    }
+    
+    NSString *key = nil;
+    if (contentVersion) {
+        id<NSObject> cachedContentVersion = [self.layerToContentVersionMap objectForKey:layer];
+        if (cachedContentVersion && ! [cachedContentVersion isEqual:contentVersion]) {
+            [self removeSnapshotsOfLayer:layer];
+        }
+        [self.layerToContentVersionMap setObject:contentVersion forKey:layer];
+        
+        key = [HLSLayerSnapshotter keyForLayer:layer rect:rect scale:scale];
+        HLSLayerSnapshot *snapshot = [self.cache objectForKey:key];
+        if (snapshot.layer == layer) {
+            ++self.hitCount;
+            completionBlock ? completionBlock(snapshot.image) : nil;
+            return;
+        }
+        else {
+            ++self.missCount;
+        }
+    }
+    
+    // The presentation layer tree is a copy of the layer tree which can be safely rendered in the background. Layers
+    // which have not been committed yet have no presentation layer, and must be rendered on the main thread
+    CALayer *presentationLayer = [layer presentationLayer];
+    if (! presentationLayer) {
+        UIImage *image = [HLSLayerSnapshotter snapshotOfLayer:layer inRect:rect scale:scale];
+        [self cacheImage:image ofLayer:layer forKey:key contentVersion:contentVersion];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            completionBlock ? completionBlock(image) : nil;
+        });
+        return;
+    }
+    
+    __weak CALayer *weakLayer = layer;
+    [self.operationQueue addOperationWithBlock:^{
+        CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+        UIImage *image = [HLSLayerSnapshotter snapshotOfLayer:presentationLayer inRect:rect scale:scale];
+        NSTimeInterval duration = CFAbsoluteTimeGetCurrent() - startTime;
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            self.renderingDuration += duration;
+            
+            CALayer *strongLayer = weakLayer;
+            if (strongLayer) {
+                [self cacheImage:image ofLayer:strongLayer forKey:key contentVersion:contentVersion];
+            }
+            
+            completionBlock ? completionBlock(image) : nil;
+        });
+    }];
+}
+
+- (void)cacheImage:(UIImage *)image ofLayer:(CALayer *)layer forKey:(NSString *)key contentVersion:(id<NSObject>)contentVersion
+{
+    // Do not cache snapshots whose content version has changed while they were rendered
+    if (! image || ! key || ! [[self.layerToContentVersionMap objectForKey:layer] isEqual:contentVersion]) {
+        return;
+    }
+    
+    HLSLayerSnapshot *snapshot = [[HLSLayerSnapshot alloc] initWithLayer:layer image:image];
+    CGImageRef imageRef = image.CGImage;
+    [self.cache setObject:snapshot forKey:key cost:CGImageGetBytesPerRow(imageRef) * CGImageGetHeight(imageRef)];
+    
+    NSMutableSet *keys = [self.layerToKeysMap objectForKey:layer];
+    if (! keys) {
+        keys = [NSMutableSet set];
+        [self.layerToKeysMap setObject:keys forKey:layer];
+    }
+    [keys addObject:key];
+}
+
+- (void)removeSnapshotsOfLayer:(CALayer *)layer
+{
+    NSAssert([NSThread isMainThread], @"Must be called from the main thread");
+    
+    for (NSString *key in [self.layerToKeysMap objectForKey:layer]) {
+        [self.cache removeObjectForKey:key];
+    }
+    [self.layerToKeysMap removeObjectForKey:layer];
+    [self.layerToContentVersionMap removeObjectForKey:layer];
+}
+
+@end
+
+#pragma mark -
+#pragma mark HLSLayerSnapshot class implementation
+
+@implementation HLSLayerSnapshot
+
+#pragma mark Object creation and destruction
+
+- (instancetype)initWithLayer:(CALayer *)layer image:(UIImage *)image
+{
+    if (self = [super init]) {
+        _layer = layer;
+        _image = image;
+    }
+    return self;
+}
+
+@end
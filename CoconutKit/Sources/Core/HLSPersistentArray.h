@@ -0,0 +1,29 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ * An immutable array from which modified versions can be obtained cheaply. Adding or removing the last object (e.g.
+ * using -arrayByAddingObject: or -[NSArray(HLSExtensions) arrayByRemovingLastObject]) and replacing an object cost
+ * O(log n) and share almost all of their storage with the receiver, whereas the same methods applied to a standard
+ * array copy it entirely
+ *
+ * Objects are stored in chunks of 32 objects, at the leaves of a trie with 32 children per node. Since
+ * HLSPersistentArray is an NSArray subclass, persistent arrays can be used wherever arrays are expected. Random access
+ * costs O(log n), though. If you need to perform a large number of accesses on an array which does not change anymore,
+ * create a standard array from it using -[NSArray arrayWithArray:]
+ *
+ * To create a persistent array, use any NSArray creation method (e.g. +arrayWithArray:)
+ */
+@interface HLSPersistentArray : NSArray
+
+/**
+ * Return the receiver, with the object at the given index replaced
+ */
+- (NSArray *)arrayByReplacingObjectAtIndex:(NSUInteger)index withObject:(id)object;
+
+@end
@@ -0,0 +1,352 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import "HLSPersistentArray.h"
+
+#import "NSArray+HLSExtensions.h"
+
+// Each trie level consumes 5 bits of the object index
+static const NSUInteger HLSChunkBitsPerLevel = 5;
+static const NSUInteger HLSChunkSize = 32;
+static const NSUInteger HLSChunkLevelMask = 0x1f;
+
+#pragma mark -
+#pragma mark Trie node class
+
+/**
+ * A trie node. Children of leaf nodes are the objects themselves (a chunk), children of other nodes are trie nodes
+ */
+@interface HLSChunkNode : NSObject {
+@public
+    NSArray *_children;
+}
+
+@end
+
+@implementation HLSChunkNode
+
+@end
+
+// Trie operations
+static HLSChunkNode *chunkNodeCreate(NSArray *children);
+static HLSChunkNode *chunkNodePath(NSUInteger level, HLSChunkNode *node);
+static HLSChunkNode *chunkNodePushTail(NSUInteger count, NSUInteger level, HLSChunkNode *parentNode, HLSChunkNode *tailNode);
+static HLSChunkNode *chunkNodePopTail(NSUInteger count, NSUInteger level, HLSChunkNode *node);
+static HLSChunkNode *chunkNodeReplace(NSUInteger level, HLSChunkNode *node, NSUInteger index, id object);
+
+#pragma mark -
+#pragma mark HLSPersistentArray class implementation
+
+@interface HLSPersistentArray ()
+
+- (instancetype)initWithCount:(NSUInteger)count shift:(NSUInteger)shift root:(HLSChunkNode *)root tail:(NSArray *)tail;
+
+@end
+
+@implementation HLSPersistentArray {
+@private
+    NSUInteger _count;
+    NSUInteger _shift;
+    HLSChunkNode *_root;
+    NSArray *_tail;                 // The last chunk, not stored in the trie yet
+}
+
+#pragma mark Object creation and destruction
+
+- (instancetype)initWithCount:(NSUInteger)count shift:(NSUInteger)shift root:(HLSChunkNode *)root tail:(NSArray *)tail
+{
+    if (self = [super init]) {
+        _count = count;
+        _shift = shift;
+        _root = root;
+        _tail = tail;
+    }
+    return self;
+}
+
+- (instancetype)init
+{
+    return [self initWithObjects:NULL count:0];
+}
+
+- (instancetype)initWithObjects:(const id [])objects count:(NSUInteger)count
+{
+    if (self = [self initWithCount:0 shift:HLSChunkBitsPerLevel root:chunkNodeCreate(@[]) tail:@[]]) {
+        NSMutableArray *tail = [NSMutableArray arrayWithCapacity:HLSChunkSize];
+        for (NSUInteger i = 0; i < count; ++i) {
+            [self appendObject:objects[i] toTail:tail];
+        }
+        _tail = [tail copy];
+    }
+    return self;
+}
+
+#pragma mark Trie management
+
+- (NSUInteger)tailOffset
+{
+    return (_count < HLSChunkSize) ? 0 : ((_count - 1) >> HLSChunkBitsPerLevel) << HLSChunkBitsPerLevel;
+}
+
+- (NSArray *)chunkForIndex:(NSUInteger)index
+{
+    if (index >= [self tailOffset]) {
+        return _tail;
+    }
+    
+    HLSChunkNode *node = _root;
+    for (NSUInteger level = _shift; level > 0; level -= HLSChunkBitsPerLevel) {
+        node = [node->_children objectAtIndex:(index >> level) & HLSChunkLevelMask];
+    }
+    return node->_children;
+}
+
+/**
+ * Append an object to a mutable copy of the tail, updating the trie when the tail is full. Only call on instances which
+ * have not been returned yet, and store the tail when done
+ */
+- (void)appendObject:(id)object toTail:(NSMutableArray *)tail
+{
+    if (! object) {
+        [NSException raise:NSInvalidArgumentException format:@"Cannot insert nil objects"];
+    }
+    
+    // Full tail: Move it into the trie, adding a level if the root is full
+    if ([tail count] == HLSChunkSize) {
+        HLSChunkNode *tailNode = chunkNodeCreate([tail copy]);
+        if ((_count >> HLSChunkBitsPerLevel) > ((NSUInteger)1 << _shift)) {
+            _root = chunkNodeCreate(@[_root, chunkNodePath(_shift, tailNode)]);
+            _shift += HLSChunkBitsPerLevel;
+        }
+        else {
+            _root = chunkNodePushTail(_count, _shift, _root, tailNode);
+        }
+        [tail removeAllObjects];
+    }
+    
+    [tail addObject:object];
+    ++_count;
+}
+
+#pragma mark NSArray primitive methods
+
+- (NSUInteger)count
+{
+    return _count;
+}
+
+- (id)objectAtIndex:(NSUInteger)index
+{
+    if (index >= _count) {
+        [NSException raise:NSRangeException format:@"Index %lu beyond bounds [0 .. %lu]", (unsigned long)index, (unsigned long)_count];
+    }
+    
+    return [[self chunkForIndex:index] objectAtIndex:index & HLSChunkLevelMask];
+}
+
+#pragma mark NSArray overrides
+
+- (NSArray *)arrayByAddingObject:(id)object
+{
+    return [self arrayByAddingObjectsFromArray:@[object]];
+}
+
+- (NSArray *)arrayByAddingObjectsFromArray:(NSArray *)otherArray
+{
+    if ([otherArray count] == 0) {
+        return self;
+    }
+    
+    HLSPersistentArray *array = [[HLSPersistentArray alloc] initWithCount:_count shift:_shift root:_root tail:_tail];
+    NSMutableArray *tail = [_tail mutableCopy];
+    for (id object in otherArray) {
+        [array appendObject:object toTail:tail];
+    }
+    array->_tail = [tail copy];
+    return array;
+}
+
+- (NSArray *)arrayByReplacingObjectAtIndex:(NSUInteger)index withObject:(id)object
+{
+    if (index >= _count) {
+        [NSException raise:NSRangeException format:@"Index %lu beyond bounds [0 .. %lu]", (unsigned long)index, (unsigned long)_count];
+    }
+    
+    if (! object) {
+        [NSException raise:NSInvalidArgumentException format:@"Cannot insert nil objects"];
+    }
+    
+    if (index >= [self tailOffset]) {
+        NSMutableArray *tail = [_tail mutableCopy];
+        [tail replaceObjectAtIndex:index & HLSChunkLevelMask withObject:object];
+        return [[HLSPersistentArray alloc] initWithCount:_count shift:_shift root:_root tail:[tail copy]];
+    }
+    else {
+        HLSChunkNode *root = chunkNodeReplace(_shift, _root, index, object);
+        return [[HLSPersistentArray alloc] initWithCount:_count shift:_shift root:root tail:_tail];
+    }
+}
+
+#pragma mark NSArray (HLSExtensions) overrides
+
+- (NSArray *)arrayByRemovingLastObject
+{
+    if (_count == 0) {
+        [NSException raise:NSRangeException format:@"Cannot remove the last object of an empty array"];
+    }
+    
+    if (_count == 1) {
+        return [[HLSPersistentArray alloc] init];
+    }
+    
+    // The tail has more than one object: Simply remove the last one
+    if (_count - [self tailOffset] > 1) {
+        NSArray *tail = [_tail subarrayWithRange:NSMakeRange(0, [_tail count] - 1)];
+        return [[HLSPersistentArray alloc] initWithCount:_count - 1 shift:_shift root:_root tail:tail];
+    }
+    
+    // Otherwise the last chunk in the trie becomes the new tail. Remove a level if the root has a single child
+    NSArray *tail = [self chunkForIndex:_count - 2];
+    NSUInteger shift = _shift;
+    HLSChunkNode *root = chunkNodePopTail(_count, _shift, _root) ?: chunkNodeCreate(@[]);
+    if (shift > HLSChunkBitsPerLevel && [root->_children count] == 1) {
+        root = [root->_children firstObject];
+        shift -= HLSChunkBitsPerLevel;
+    }
+    return [[HLSPersistentArray alloc] initWithCount:_count - 1 shift:shift root:root tail:tail];
+}
+
+#pragma mark NSFastEnumeration protocol implementation
+
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(id __unsafe_unretained [])buffer count:(NSUInteger)length
+{
+    NSUInteger index = state->state;
+    if (index >= _count) {
+        return 0;
+    }
+    
+    // Enumerate chunk by chunk instead of looking up each object
+    NSArray *chunk = [self chunkForIndex:index];
+    NSUInteger offset = index & HLSChunkLevelMask;
+    NSUInteger count = MIN(length, [chunk count] - offset);
+    [chunk getObjects:buffer range:NSMakeRange(offset, count)];
+    
+    state->state = index + count;
+    state->itemsPtr = buffer;
+    
+    // Immutable. Must point at a value which never changes (the object itself must not be used, since its isa word
+    // changes when it is retained or weakly referenced)
+    state->mutationsPtr = &state->extra[0];
+    return count;
+}
+
+#pragma mark NSCopying protocol implementation
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    // Immutable
+    return self;
+}
+
+@end
+
+#pragma mark Static functions
+
+static HLSChunkNode *chunkNodeCreate(NSArray *children)
+{
+    HLSChunkNode *node = [[HLSChunkNode alloc] init];
+    node->_children = children;
+    return node;
+}
+
+/**
+ * Return a branch of single-child nodes leading to the given node from the given level
+ */
+static HLSChunkNode *chunkNodePath(NSUInteger level, HLSChunkNode *node)
+{
+    if (level == 0) {
+        return node;
+    }
+    else {
+        return chunkNodeCreate(@[chunkNodePath(level - HLSChunkBitsPerLevel, node)]);
+    }
+}
+
+/**
+ * Return the parent node with the tail node inserted as last leaf. The count is the number of objects before insertion
+ * (trie and full tail)
+ */
+static HLSChunkNode *chunkNodePushTail(NSUInteger count, NSUInteger level, HLSChunkNode *parentNode, HLSChunkNode *tailNode)
+{
+    NSUInteger subindex = ((count - 1) >> level) & HLSChunkLevelMask;
+    
+    HLSChunkNode *insertedNode = nil;
+    if (level == HLSChunkBitsPerLevel) {
+        insertedNode = tailNode;
+    }
+    else if (subindex < [parentNode->_children count]) {
+        insertedNode = chunkNodePushTail(count, level - HLSChunkBitsPerLevel, [parentNode->_children objectAtIndex:subindex], tailNode);
+    }
+    else {
+        insertedNode = chunkNodePath(level - HLSChunkBitsPerLevel, tailNode);
+    }
+    
+    NSMutableArray *children = [parentNode->_children mutableCopy];
+    if (subindex < [children count]) {
+        [children replaceObjectAtIndex:subindex withObject:insertedNode];
+    }
+    else {
+        [children addObject:insertedNode];
+    }
+    return chunkNodeCreate([children copy]);
+}
+
+/**
+ * Return the node without its last leaf, nil if the node is empty afterwards. The count is the number of objects before
+ * removal (trie and single-object tail)
+ */
+static HLSChunkNode *chunkNodePopTail(NSUInteger count, NSUInteger level, HLSChunkNode *node)
+{
+    NSUInteger subindex = ((count - 2) >> level) & HLSChunkLevelMask;
+    if (level > HLSChunkBitsPerLevel) {
+        HLSChunkNode *childNode = chunkNodePopTail(count, level - HLSChunkBitsPerLevel, [node->_children objectAtIndex:subindex]);
+        if (! childNode && subindex == 0) {
+            return nil;
+        }
+        
+        NSMutableArray *children = [node->_children mutableCopy];
+        if (childNode) {
+            [children replaceObjectAtIndex:subindex withObject:childNode];
+        }
+        else {
+            [children removeObjectAtIndex:subindex];
+        }
+        return chunkNodeCreate([children copy]);
+    }
+    else if (subindex == 0) {
+        return nil;
+    }
+    else {
+        return chunkNodeCreate([node->_children subarrayWithRange:NSMakeRange(0, subindex)]);
+    }
+}
+
+/**
+ * Return the node with the object at the given index replaced
+ */
+static HLSChunkNode *chunkNodeReplace(NSUInteger level, HLSChunkNode *node, NSUInteger index, id object)
+{
+    NSMutableArray *children = [node->_children mutableCopy];
+    if (level == 0) {
+        [children replaceObjectAtIndex:index & HLSChunkLevelMask withObject:object];
+    }
+    else {
+        NSUInteger subindex = (index >> level) & HLSChunkLevelMask;
+        HLSChunkNode *childNode = chunkNodeReplace(level - HLSChunkBitsPerLevel, [children objectAtIndex:subindex], index, object);
+        [children replaceObjectAtIndex:subindex withObject:childNode];
+    }
+    return chunkNodeCreate([children copy]);
+}
@@ -0,0 +1,25 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ * An immutable dictionary from which modified versions can be obtained cheaply. Setting or removing an object using
+ * the NSDictionary (HLSExtensions) methods costs O(log n) and shares almost all of its storage with the receiver,
+ * whereas the same methods applied to a standard dictionary copy it entirely (growing a standard dictionary one key
+ * at a time is therefore quadratic)
+ *
+ * Entries are stored in a hash array mapped trie. Since HLSPersistentDictionary is an NSDictionary subclass, persistent
+ * dictionaries can be used wherever dictionaries are expected. Lookups cost O(log n) as well, though, and enumeration
+ * is slower than for standard dictionaries. If you need to perform a large number of lookups on a dictionary which does
+ * not change anymore, create a standard dictionary from it using -[NSDictionary dictionaryWithDictionary:]
+ *
+ * To create a persistent dictionary, use any NSDictionary creation method (e.g. +dictionaryWithDictionary:). Keys
+ * are copied, as for standard dictionaries
+ */
+@interface HLSPersistentDictionary : NSDictionary
+
+@end
@@ -0,0 +1,496 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import "HLSPersistentDictionary.h"
+
+#import "NSDictionary+HLSExtensions.h"
+
+// Each trie level consumes 5 bits of the key hash
+static const NSUInteger HLSTrieBitsPerLevel = 5;
+static const NSUInteger HLSTrieLevelMask = 0x1f;
+
+#pragma mark -
+#pragma mark Trie node classes
+
+/**
+ * A key-value pair, stored with the key hash
+ */
+@interface HLSTrieEntry : NSObject {
+@public
+    id _key;
+    id _object;
+    NSUInteger _hash;
+}
+
+@end
+
+@implementation HLSTrieEntry
+
+@end
+
+/**
+ * A node whose slots are either entries or child nodes. The bitmap tells which of the 32 possible slots are occupied,
+ * only occupied slots are stored
+ */
+@interface HLSTrieNode : NSObject {
+@public
+    uint32_t _bitmap;
+    NSArray *_slots;
+}
+
+@end
+
+@implementation HLSTrieNode
+
+@end
+
+/**
+ * Entries with distinct keys but identical hashes
+ */
+@interface HLSTrieCollisionNode : NSObject {
+@public
+    NSUInteger _hash;
+    NSArray *_entries;
+}
+
+@end
+
+@implementation HLSTrieCollisionNode
+
+@end
+
+// Trie operations
+static HLSTrieEntry *trieEntryCreate(id key, id object);
+static id trieNodeObjectForKey(HLSTrieNode *node, id key, NSUInteger hash, NSUInteger shift);
+static HLSTrieNode *trieNodeSet(HLSTrieNode *node, HLSTrieEntry *entry, NSUInteger shift, BOOL *pAdded);
+static HLSTrieNode *trieNodeRemove(HLSTrieNode *node, id key, NSUInteger hash, NSUInteger shift);
+static void trieNodeEnumerateEntries(HLSTrieNode *node, void (^block)(HLSTrieEntry *entry));
+
+#pragma mark -
+#pragma mark HLSPersistentDictionary class implementation
+
+@interface HLSPersistentDictionary ()
+
+- (instancetype)initWithRoot:(HLSTrieNode *)root count:(NSUInteger)count;
+
+@end
+
+@implementation HLSPersistentDictionary {
+@private
+    HLSTrieNode *_root;
+    NSUInteger _count;
+}
+
+#pragma mark Object creation and destruction
+
+- (instancetype)initWithRoot:(HLSTrieNode *)root count:(NSUInteger)count
+{
+    if (self = [super init]) {
+        _root = root;
+        _count = count;
+    }
+    return self;
+}
+
+- (instancetype)init
+{
+    return [self initWithObjects:NULL forKeys:NULL count:0];
+}
+
+- (instancetype)initWithObjects:(const id [])objects forKeys:(const id<NSCopying> [])keys count:(NSUInteger)count
+{
+    HLSTrieNode *root = nil;
+    NSUInteger actualCount = 0;
+    for (NSUInteger i = 0; i < count; ++i) {
+        BOOL added = NO;
+        root = trieNodeSet(root, trieEntryCreate(keys[i], objects[i]), 0, &added);
+        if (added) {
+            ++actualCount;
+        }
+    }
+    return [self initWithRoot:root count:actualCount];
+}
+
+#pragma mark NSDictionary primitive methods
+
+- (NSUInteger)count
+{
+    return _count;
+}
+
+- (id)objectForKey:(id)key
+{
+    if (! key) {
+        return nil;
+    }
+    
+    return trieNodeObjectForKey(_root, key, [key hash], 0);
+}
+
+- (NSEnumerator *)keyEnumerator
+{
+    NSMutableArray *keys = [NSMutableArray arrayWithCapacity:_count];
+    trieNodeEnumerateEntries(_root, ^(HLSTrieEntry *entry) {
+        [keys addObject:entry->_key];
+    });
+    return [keys objectEnumerator];
+}
+
+#pragma mark NSDictionary overrides
+
+- (void)enumerateKeysAndObjectsWithOptions:(NSEnumerationOptions)options usingBlock:(void (^)(id key, id object, BOOL *stop))block
+{
+    // Traverse the trie directly instead of looking up each enumerated key
+    __block BOOL stop = NO;
+    trieNodeEnumerateEntries(_root, ^(HLSTrieEntry *entry) {
+        if (! stop) {
+            block(entry->_key, entry->_object, &stop);
+        }
+    });
+}
+
+- (void)enumerateKeysAndObjectsUsingBlock:(void (^)(id key, id object, BOOL *stop))block
+{
+    [self enumerateKeysAndObjectsWithOptions:0 usingBlock:block];
+}
+
+#pragma mark NSCopying protocol implementation
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    // Immutable
+    return self;
+}
+
+#pragma mark NSDictionary (HLSExtensions) overrides
+
+- (NSDictionary *)dictionaryBySettingObject:(id)object forKey:(id)key
+{
+    if (! object || ! key) {
+        [NSException raise:NSInvalidArgumentException format:@"Object and key must not be nil"];
+    }
+    
+    BOOL added = NO;
+    HLSTrieNode *root = trieNodeSet(_root, trieEntryCreate(key, object), 0, &added);
+    if (root == _root) {
+        return self;
+    }
+    return [[HLSPersistentDictionary alloc] initWithRoot:root count:added ? _count + 1 : _count];
+}
+
+- (NSDictionary *)dictionaryByRemovingObjectForKey:(id)key
+{
+    if (! key) {
+        return self;
+    }
+    
+    HLSTrieNode *root = trieNodeRemove(_root, key, [key hash], 0);
+    if (root == _root) {
+        return self;
+    }
+    return [[HLSPersistentDictionary alloc] initWithRoot:root count:_count - 1];
+}
+
+- (NSDictionary *)dictionaryByRemovingObjectsForKeys:(NSArray *)keyArray
+{
+    HLSTrieNode *root = _root;
+    NSUInteger count = _count;
+    for (id key in keyArray) {
+        HLSTrieNode *updatedRoot = trieNodeRemove(root, key, [key hash], 0);
+        if (updatedRoot != root) {
+            root = updatedRoot;
+            --count;
+        }
+    }
+    
+    if (root == _root) {
+        return self;
+    }
+    return [[HLSPersistentDictionary alloc] initWithRoot:root count:count];
+}
+
+@end
+
+#pragma mark Static functions
+
+static HLSTrieEntry *trieEntryCreate(id key, id object)
+{
+    HLSTrieEntry *entry = [[HLSTrieEntry alloc] init];
+    entry->_key = [key copyWithZone:NULL];
+    entry->_object = object;
+    entry->_hash = [entry->_key hash];
+    return entry;
+}
+
+static HLSTrieNode *trieNodeCreate(uint32_t bitmap, NSArray *slots)
+{
+    HLSTrieNode *node = [[HLSTrieNode alloc] init];
+    node->_bitmap = bitmap;
+    node->_slots = slots;
+    return node;
+}
+
+static uint32_t trieBit(NSUInteger hash, NSUInteger shift)
+{
+    return (uint32_t)1 << ((hash >> shift) & HLSTrieLevelMask);
+}
+
+static NSUInteger trieSlotIndex(uint32_t bitmap, uint32_t bit)
+{
+    return __builtin_popcount(bitmap & (bit - 1));
+}
+
+static NSUInteger trieSlotHash(id slot)
+{
+    if ([slot isKindOfClass:[HLSTrieEntry class]]) {
+        return ((HLSTrieEntry *)slot)->_hash;
+    }
+    else {
+        return ((HLSTrieCollisionNode *)slot)->_hash;
+    }
+}
+
+/**
+ * Create the smallest subtree at the given level holding two slots (entries or collision nodes) with different hashes
+ */
+static HLSTrieNode *trieNodeCreateWithSlots(id slot1, id slot2, NSUInteger shift)
+{
+    uint32_t bit1 = trieBit(trieSlotHash(slot1), shift);
+    uint32_t bit2 = trieBit(trieSlotHash(slot2), shift);
+    if (bit1 == bit2) {
+        return trieNodeCreate(bit1, @[trieNodeCreateWithSlots(slot1, slot2, shift + HLSTrieBitsPerLevel)]);
+    }
+    else if (bit1 < bit2) {
+        return trieNodeCreate(bit1 | bit2, @[slot1, slot2]);
+    }
+    else {
+        return trieNodeCreate(bit1 | bit2, @[slot2, slot1]);
+    }
+}
+
+static NSArray *arrayByReplacingObjectAtIndex(NSArray *array, NSUInteger index, id object)
+{
+    NSMutableArray *updatedArray = [array mutableCopy];
+    [updatedArray replaceObjectAtIndex:index withObject:object];
+    return [updatedArray copy];
+}
+
+static NSArray *arrayByInsertingObjectAtIndex(NSArray *array, NSUInteger index, id object)
+{
+    NSMutableArray *updatedArray = [array mutableCopy];
+    [updatedArray insertObject:object atIndex:index];
+    return [updatedArray copy];
+}
+
+static NSArray *arrayByRemovingObjectAtIndex(NSArray *array, NSUInteger index)
+{
+    NSMutableArray *updatedArray = [array mutableCopy];
+    [updatedArray removeObjectAtIndex:index];
+    return [updatedArray copy];
+}
+
+static id trieNodeObjectForKey(HLSTrieNode *node, id key, NSUInteger hash, NSUInteger shift)
+{
+    while (node) {
+        uint32_t bit = trieBit(hash, shift);
+        if ((node->_bitmap & bit) == 0) {
+            return nil;
+        }
+        
+        id slot = [node->_slots objectAtIndex:trieSlotIndex(node->_bitmap, bit)];
+        if ([slot isKindOfClass:[HLSTrieEntry class]]) {
+            HLSTrieEntry *entry = slot;
+            return (entry->_hash == hash && [entry->_key isEqual:key]) ? entry->_object : nil;
+        }
+        else if ([slot isKindOfClass:[HLSTrieCollisionNode class]]) {
+            HLSTrieCollisionNode *collisionNode = slot;
+            if (collisionNode->_hash != hash) {
+                return nil;
+            }
+            for (HLSTrieEntry *entry in collisionNode->_entries) {
+                if ([entry->_key isEqual:key]) {
+                    return entry->_object;
+                }
+            }
+            return nil;
+        }
+        else {
+            node = slot;
+            shift += HLSTrieBitsPerLevel;
+        }
+    }
+    return nil;
+}
+
+/**
+ * Return a node with the entry set. If nothing changed, the node itself is returned
+ */
+static HLSTrieNode *trieNodeSet(HLSTrieNode *node, HLSTrieEntry *entry, NSUInteger shift, BOOL *pAdded)
+{
+    uint32_t bit = trieBit(entry->_hash, shift);
+    if (! node) {
+        *pAdded = YES;
+        return trieNodeCreate(bit, @[entry]);
+    }
+    
+    NSUInteger index = trieSlotIndex(node->_bitmap, bit);
+    if ((node->_bitmap & bit) == 0) {
+        *pAdded = YES;
+        return trieNodeCreate(node->_bitmap | bit, arrayByInsertingObjectAtIndex(node->_slots, index, entry));
+    }
+    
+    id slot = [node->_slots objectAtIndex:index];
+    id updatedSlot = nil;
+    if ([slot isKindOfClass:[HLSTrieEntry class]]) {
+        HLSTrieEntry *existingEntry = slot;
+        if (existingEntry->_hash == entry->_hash && [existingEntry->_key isEqual:entry->_key]) {
+            if (existingEntry->_object == entry->_object) {
+                return node;
+            }
+            updatedSlot = entry;
+        }
+        else if (existingEntry->_hash == entry->_hash) {
+            HLSTrieCollisionNode *collisionNode = [[HLSTrieCollisionNode alloc] init];
+            collisionNode->_hash = entry->_hash;
+            collisionNode->_entries = @[existingEntry, entry];
+            updatedSlot = collisionNode;
+            *pAdded = YES;
+        }
+        else {
+            updatedSlot = trieNodeCreateWithSlots(existingEntry, entry, shift + HLSTrieBitsPerLevel);
+            *pAdded = YES;
+        }
+    }
+    else if ([slot isKindOfClass:[HLSTrieCollisionNode class]]) {
+        HLSTrieCollisionNode *collisionNode = slot;
+        if (collisionNode->_hash == entry->_hash) {
+            NSUInteger entryIndex = [collisionNode->_entries indexOfObjectPassingTest:^BOOL(HLSTrieEntry *existingEntry, NSUInteger idx, BOOL *stop) {
+                return [existingEntry->_key isEqual:entry->_key];
+            }];
+            
+            HLSTrieCollisionNode *updatedCollisionNode = [[HLSTrieCollisionNode alloc] init];
+            updatedCollisionNode->_hash = collisionNode->_hash;
+            if (entryIndex != NSNotFound) {
+                updatedCollisionNode->_entries = arrayByReplacingObjectAtIndex(collisionNode->_entries, entryIndex, entry);
+            }
+            else {
+                updatedCollisionNode->_entries = [collisionNode->_entries arrayByAddingObject:entry];
+                *pAdded = YES;
+            }
+            updatedSlot = updatedCollisionNode;
+        }
+        else {
+            updatedSlot = trieNodeCreateWithSlots(collisionNode, entry, shift + HLSTrieBitsPerLevel);
+            *pAdded = YES;
+        }
+    }
+    else {
+        updatedSlot = trieNodeSet(slot, entry, shift + HLSTrieBitsPerLevel, pAdded);
+        if (updatedSlot == slot) {
+            return node;
+        }
+    }
+    
+    return trieNodeCreate(node->_bitmap, arrayByReplacingObjectAtIndex(node->_slots, index, updatedSlot));
+}
+
+/**
+ * Return a node without the entry for the given key, nil if the node is empty afterwards. If the key was not found,
+ * the node itself is returned
+ */
+static HLSTrieNode *trieNodeRemove(HLSTrieNode *node, id key, NSUInteger hash, NSUInteger shift)
+{
+    if (! node) {
+        return nil;
+    }
+    
+    uint32_t bit = trieBit(hash, shift);
+    if ((node->_bitmap & bit) == 0) {
+        return node;
+    }
+    
+    NSUInteger index = trieSlotIndex(node->_bitmap, bit);
+    id slot = [node->_slots objectAtIndex:index];
+    id updatedSlot = nil;
+    if ([slot isKindOfClass:[HLSTrieEntry class]]) {
+        HLSTrieEntry *entry = slot;
+        if (entry->_hash != hash || ! [entry->_key isEqual:key]) {
+            return node;
+        }
+    }
+    else if ([slot isKindOfClass:[HLSTrieCollisionNode class]]) {
+        HLSTrieCollisionNode *collisionNode = slot;
+        if (collisionNode->_hash != hash) {
+            return node;
+        }
+        
+        NSUInteger entryIndex = [collisionNode->_entries indexOfObjectPassingTest:^BOOL(HLSTrieEntry *entry, NSUInteger idx, BOOL *stop) {
+            return [entry->_key isEqual:key];
+        }];
+        if (entryIndex == NSNotFound) {
+            return node;
+        }
+        
+        // A collision node always holds at least two entries
+        NSArray *entries = arrayByRemovingObjectAtIndex(collisionNode->_entries, entryIndex);
+        if ([entries count] == 1) {
+            updatedSlot = [entries firstObject];
+        }
+        else {
+            HLSTrieCollisionNode *updatedCollisionNode = [[HLSTrieCollisionNode alloc] init];
+            updatedCollisionNode->_hash = hash;
+            updatedCollisionNode->_entries = entries;
+            updatedSlot = updatedCollisionNode;
+        }
+    }
+    else {
+        HLSTrieNode *childNode = slot;
+        HLSTrieNode *updatedChildNode = trieNodeRemove(childNode, key, hash, shift + HLSTrieBitsPerLevel);
+        if (updatedChildNode == childNode) {
+            return node;
+        }
+        
+        // Pull up child nodes reduced to a single entry or collision node to keep the trie compact
+        if (updatedChildNode && [updatedChildNode->_slots count] == 1
+                && ! [[updatedChildNode->_slots firstObject] isKindOfClass:[HLSTrieNode class]]) {
+            updatedSlot = [updatedChildNode->_slots firstObject];
+        }
+        else {
+            updatedSlot = updatedChildNode;
+        }
+    }
+    
+    if (updatedSlot) {
+        return trieNodeCreate(node->_bitmap, arrayByReplacingObjectAtIndex(node->_slots, index, updatedSlot));
+    }
+    else if ([node->_slots count] == 1) {
+        return nil;
+    }
+    else {
+        return trieNodeCreate(node->_bitmap & ~bit, arrayByRemovingObjectAtIndex(node->_slots, index));
+    }
+}
+
+static void trieNodeEnumerateEntries(HLSTrieNode *node, void (^block)(HLSTrieEntry *entry))
+{
+    if (! node) {
+        return;
+    }
+    
+    for (id slot in node->_slots) {
+        if ([slot isKindOfClass:[HLSTrieEntry class]]) {
+            block(slot);
+        }
+        else if ([slot isKindOfClass:[HLSTrieCollisionNode class]]) {
+            for (HLSTrieEntry *entry in ((HLSTrieCollisionNode *)slot)->_entries) {
+                block(entry);
+            }
+        }
+        else {
+            trieNodeEnumerateEntries(slot, block);
+        }
+    }
+}
@@ -11,9 +11,38 @@
 #import "HLSMAZeroingWeakRef.h"
 #import "NSObject+HLSExtensions.h"
 
+#pragma mark -
+#pragma mark HLSRestrictedInterfaceDispatchTable class interface
+
+/**
+ * Immutable description of the instance methods a protocol declares, and of the signatures of those a class implements.
+ * Tables are shared between all proxies with the same protocol and target class
+ */
+@interface HLSRestrictedInterfaceDispatchTable : NSObject
+
+/**
+ * Return the table for a protocol and a class, creating it if needed. Tables are created again when methods have been
+ * added using HLSRuntime functions
+ */
++ (instancetype)dispatchTableForProtocol:(Protocol *)protocol targetClass:(Class)targetClass;
+
+@property (nonatomic, readonly, unsafe_unretained) Class targetClass;
+@property (nonatomic, readonly, assign) int32_t generation;
+
+/**
+ * Return the signature of a method declared by the protocol and implemented by the class, nil otherwise
+ */
+- (NSMethodSignature *)methodSignatureForSelector:(SEL)selector;
+
+@end
+
+#pragma mark -
+#pragma mark HLSRestrictedInterfaceProxy class implementation
+
 @interface HLSRestrictedInterfaceProxy ()
 
 @property (nonatomic, strong) HLSMAZeroingWeakRef *targetZeroingWeakRef;
+@property (atomic, strong) HLSRestrictedInterfaceDispatchTable *dispatchTable;
 
 @end
 
@@ -59,6 +88,10 @@
     self.targetZeroingWeakRef = [HLSMAZeroingWeakRef refWithTarget:target];
     _protocol = protocol;
     
+    if (target) {
+        self.dispatchTable = [HLSRestrictedInterfaceDispatchTable dispatchTableForProtocol:protocol targetClass:[target class]];
+    }
+    
     return self;
 }
 
@@ -68,6 +101,24 @@
 
 @synthesize targetZeroingWeakRef = _targetZeroingWeakRef;
 
+@synthesize dispatchTable = _dispatchTable;
+
+- (HLSRestrictedInterfaceDispatchTable *)dispatchTableForTarget:(id)target
+{
+    if (! target) {
+        return nil;
+    }
+    
+    // The target class might change (e.g. dynamic subclasses), and methods might be added at runtime
+    Class targetClass = [target class];
+    HLSRestrictedInterfaceDispatchTable *dispatchTable = self.dispatchTable;
+    if (dispatchTable.targetClass != targetClass || dispatchTable.generation != hls_methodListsGeneration()) {
+        dispatchTable = [HLSRestrictedInterfaceDispatchTable dispatchTableForProtocol:_protocol targetClass:targetClass];
+        self.dispatchTable = dispatchTable;
+    }
+    return dispatchTable;
+}
+
 #pragma mark Proxy implementation
 
 - (BOOL)conformsToProtocol:(Protocol *)protocol
@@ -77,12 +128,20 @@
 
 - (BOOL)respondsToSelector:(SEL)selector
 {
-    if (! [self protocolDeclaresSelector:selector]) {
-        return NO;
+    // Only methods declared by the protocol and implemented by the target class have a signature in the table
+    return [[self dispatchTableForTarget:[self.targetZeroingWeakRef target]] methodSignatureForSelector:selector] != nil;
+}
+
+- (id)forwardingTargetForSelector:(SEL)selector
+{
+    // Fast path: Allowed methods are directly sent to the target. Other ones go through -forwardInvocation: so that the
+    // usual exceptions are raised
+    id target = [self.targetZeroingWeakRef target];
+    if ([[self dispatchTableForTarget:target] methodSignatureForSelector:selector]) {
+        return target;
     }
     else {
-        // See -[NSObject respondsToSelector:] documentation
-        return [[[self.targetZeroingWeakRef target] class] instancesRespondToSelector:selector];
+        return nil;
     }
 }
 
@@ -103,8 +162,9 @@
 }
 
 - (NSMethodSignature *)methodSignatureForSelector:(SEL)sel
-{    
-    return [[self.targetZeroingWeakRef target] methodSignatureForSelector:sel];
+{
+    id target = [self.targetZeroingWeakRef target];
+    return [[self dispatchTableForTarget:target] methodSignatureForSelector:sel] ?: [target methodSignatureForSelector:sel];
 }
 
 - (void)forwardInvocation:(NSInvocation *)invocation
@@ -133,6 +193,90 @@
 
 @end
 
+#pragma mark -
+#pragma mark HLSRestrictedInterfaceDispatchTable class implementation
+
+@implementation HLSRestrictedInterfaceDispatchTable {
+@private
+    CFDictionaryRef _methodSignatures;          // Selector -> method signature, or kCFNull if not implemented
+}
+
+#pragma mark Class methods
+
++ (instancetype)dispatchTableForProtocol:(Protocol *)protocol targetClass:(Class)targetClass
+{
+    static NSMutableDictionary *s_dispatchTables = nil;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        s_dispatchTables = [NSMutableDictionary dictionary];
+    });
+    
+    NSString *key = [NSString stringWithFormat:@"%p-%p", protocol, targetClass];
+    @synchronized(s_dispatchTables) {
+        HLSRestrictedInterfaceDispatchTable *dispatchTable = [s_dispatchTables objectForKey:key];
+        if (! dispatchTable || dispatchTable.generation != hls_methodListsGeneration()) {
+            dispatchTable = [[HLSRestrictedInterfaceDispatchTable alloc] initWithProtocol:protocol targetClass:targetClass];
+            [s_dispatchTables setObject:dispatchTable forKey:key];
+        }
+        return dispatchTable;
+    }
+}
+
+#pragma mark Object creation and destruction
+
+- (instancetype)initWithProtocol:(Protocol *)protocol targetClass:(Class)targetClass
+{
+    if (self = [super init]) {
+        _targetClass = targetClass;
+        
+        // Read the generation first. If methods are added meanwhile the table will be considered stale
+        _generation = hls_methodListsGeneration();
+        
+        // Selectors are unique, compare them as pointers
+        CFMutableDictionaryRef methodSignatures = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+        [self addMethodsOfProtocol:protocol required:YES toMethodSignatures:methodSignatures];
+        [self addMethodsOfProtocol:protocol required:NO toMethodSignatures:methodSignatures];
+        _methodSignatures = methodSignatures;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    CFRelease(_methodSignatures);
+}
+
+#pragma mark Table creation
+
+- (void)addMethodsOfProtocol:(Protocol *)protocol required:(BOOL)required toMethodSignatures:(CFMutableDictionaryRef)methodSignatures
+{
+    // Parent protocols are taken into account
+    unsigned int numberOfMethods = 0;
+    struct objc_method_description *methodDescriptions = hls_protocol_copyMethodDescriptionList(protocol, required, YES, &numberOfMethods);
+    for (unsigned int i = 0; i < numberOfMethods; ++i) {
+        SEL selector = methodDescriptions[i].name;
+        
+        // See -[NSObject respondsToSelector:] documentation
+        NSMethodSignature *methodSignature = [_targetClass instancesRespondToSelector:selector] ? [_targetClass instanceMethodSignatureForSelector:selector] : nil;
+        CFDictionarySetValue(methodSignatures, selector, methodSignature ? (__bridge CFTypeRef)methodSignature : kCFNull);
+    }
+    free(methodDescriptions);
+}
+
+#pragma mark Lookup
+
+- (NSMethodSignature *)methodSignatureForSelector:(SEL)selector
+{
+    // The dictionary is never mutated after creation and can be safely read from any thread
+    id methodSignature = (__bridge id)CFDictionaryGetValue(_methodSignatures, selector);
+    return (methodSignature != (__bridge id)kCFNull) ? methodSignature : nil;
+}
+
+@end
+
+#pragma mark -
+#pragma mark NSObject (HLSRestrictedInterfaceProxy) category implementation
+
 @implementation NSObject (HLSRestrictedInterfaceProxy)
 
 - (id)proxyWithRestrictedInterface:(Protocol *)protocol
@@ -33,10 +33,10 @@
  *    }
  */
 #define HLSSwizzleSelector(clazz, selector, newImplementation, pPreviousImplementation) \
-    (*pPreviousImplementation) = (__typeof((*pPreviousImplementation)))hls_class_swizzleSelector((clazz), (selector), (IMP)(newImplementation))
+    (*pPreviousImplementation) = (__typeof((*pPreviousImplementation)))hls_class_swizzleSelectorInGroup((clazz), (selector), (IMP)(newImplementation), __FILE__, (pPreviousImplementation))
 
 #define HLSSwizzleClassSelector(clazz, selector, newImplementation, pPreviousImplementation) \
-    (*pPreviousImplementation) = (__typeof((*pPreviousImplementation)))hls_class_swizzleClassSelector((clazz), (selector), (IMP)(newImplementation))
+    (*pPreviousImplementation) = (__typeof((*pPreviousImplementation)))hls_class_swizzleClassSelectorInGroup((clazz), (selector), (IMP)(newImplementation), __FILE__, (pPreviousImplementation))
 
 /**
  * Begin / end macros for block swizzling. The new implementation is supplied using an enclosed block with proper signature
@@ -58,14 +58,68 @@
  */
 #define HLSSwizzleSelectorWithBlock_Begin(clazz, selector) { \
     SEL _cmd = selector; \
-    __block IMP _imp = hls_class_swizzleSelectorWithBlock((clazz), (selector),
+    __block IMP _imp = hls_class_swizzleSelectorWithBlockInGroup(__FILE__, (clazz), (selector),
 #define HLSSwizzleSelectorWithBlock_End );}
 
 #define HLSSwizzleClassSelectorWithBlock_Begin(clazz, selector) { \
     SEL _cmd = selector; \
-    __block IMP _imp = hls_class_swizzleClassSelectorWithBlock((clazz), (selector),
+    __block IMP _imp = hls_class_swizzleClassSelectorWithBlockInGroup(__FILE__, (clazz), (selector),
 #define HLSSwizzleClassSelectorWithBlock_End );}
 
+/**
+ * Swizzles made using the above macros are recorded in a registry (see hls_swizzleRegistryEntries()). Each swizzle
+ * belongs to a group, named after the file it is made from (e.g. UIScrollView+HLSExtensions). Groups can be disabled
+ * before their swizzles are installed, in which case they are not made at all (see hls_isSwizzleGroupEnabled()).
+ * Disabling a group removes its runtime cost, but of course also the features which depend on it
+ *
+ * Enclose the body of a +load method making swizzles between the following macros to measure the time it takes, and
+ * to skip it entirely when its group has been disabled:
+ *
+ *    + (void)load
+ *    {
+ *        HLSSwizzleGroup_Begin
+ *        HLSSwizzleSelector(self, @selector(setValue:animated:), swizzle_setValue_animated, &s_setValue_animated);
+ *        HLSSwizzleGroup_End
+ *    }
+ *
+ * Calls through a swizzled implementation can be counted as well. Call counting is disabled by default (see
+ * hls_setSwizzleCallCountingEnabled()) and costs a single test when disabled. Implementations must record calls
+ * themselves, passing the pointer to the previous implementation given when swizzling:
+ *
+ *    static void swizzle_setValue_animated(UISlider *self, SEL _cmd, float value, BOOL animated)
+ *    {
+ *        HLSSwizzleCountCall(&s_setValue_animated);
+ *        s_setValue_animated(self, _cmd, value, animated);
+ *    }
+ */
+#define HLSSwizzleGroup_Begin { \
+    if (! hls_isSwizzleGroupEnabled(__FILE__)) { \
+        return; \
+    } \
+    CFAbsoluteTime _groupStartTime = CFAbsoluteTimeGetCurrent();
+#define HLSSwizzleGroup_End \
+    hls_recordSwizzleGroupLoadDuration(__FILE__, CFAbsoluteTimeGetCurrent() - _groupStartTime); }
+
+#define HLSSwizzleCountCall(pPreviousImplementation) \
+    if (hls_swizzleCallCountingEnabled) { \
+        hls_recordSwizzledCall((pPreviousImplementation)); \
+    }
+
+/**
+ * Keys of the dictionaries returned by hls_swizzleRegistryEntries()
+ */
+OBJC_EXPORT NSString * const HLSSwizzleClassNameKey;                    // Name of the swizzled class (NSString)
+OBJC_EXPORT NSString * const HLSSwizzleSelectorNameKey;                 // Name of the swizzled selector, prefixed with + or - (NSString)
+OBJC_EXPORT NSString * const HLSSwizzleGroupKey;                        // Group name (NSString)
+OBJC_EXPORT NSString * const HLSSwizzleDurationKey;                     // Time spent swizzling, in seconds (NSNumber)
+OBJC_EXPORT NSString * const HLSSwizzleCallCountKey;                    // Number of calls recorded while call counting was enabled (NSNumber)
+
+/**
+ * Set to YES to count calls through swizzled implementations (see HLSSwizzleCountCall). Do not set directly, use
+ * hls_setSwizzleCallCountingEnabled() instead
+ */
+OBJC_EXPORT volatile BOOL hls_swizzleCallCountingEnabled;
+
 /**
  * Policies for associated objects
  */
@@ -177,6 +231,87 @@ OBJC_EXPORT IMP hls_class_swizzleClassSelectorWithBlock(Class clazz, SEL selecto
  */
 OBJC_EXPORT IMP hls_class_swizzleSelectorWithBlock(Class clazz, SEL selector, id newImplementationBlock);
 
+/**
+ * Same as class_addMethod, but invalidating caches which depend on the methods a class implements (e.g. the one
+ * used by -[NSObject(HLSExtensions) implementsProtocol:]). Use this function instead of class_addMethod when adding
+ * methods at runtime
+ */
+OBJC_EXPORT BOOL hls_class_addMethod(Class cls, SEL name, IMP imp, const char *types);
+
+/**
+ * Same as objc_disposeClassPair, but invalidating caches which store class pointers, since the address of the disposed
+ * class can be reused by a class created afterwards. Use this function instead of objc_disposeClassPair when disposing
+ * of classes created at runtime
+ */
+OBJC_EXPORT void hls_objc_disposeClassPair(Class cls);
+
+/**
+ * Return a counter which is incremented each time methods are added or replaced, or classes disposed of, using HLSRuntime
+ * functions. Caches depending on the methods a class implements must be discarded when this value changes
+ */
+OBJC_EXPORT int32_t hls_methodListsGeneration(void);
+
+/**
+ * Increment the counter returned by hls_methodListsGeneration. Call this function after having added or replaced
+ * methods, or disposed of classes, without using HLSRuntime functions (e.g. with class_addMethod, method_setImplementation
+ * or objc_disposeClassPair)
+ */
+OBJC_EXPORT void hls_invalidateMethodListsCaches(void);
+
+/**
+ * Same as hls_class_swizzleClassSelector() and hls_class_swizzleSelector(), but recording the swizzle in the registry
+ * for the given group (a file path or a group name, see HLSSwizzleSelector). The key (usually the address where the
+ * previous implementation is stored) identifies the swizzle when counting calls, and can be NULL. If the group is
+ * disabled, the method is not swizzled and NULL is returned
+ */
+OBJC_EXPORT IMP hls_class_swizzleClassSelectorInGroup(Class clazz, SEL selector, IMP newImplementation, const char *group, const void *key);
+OBJC_EXPORT IMP hls_class_swizzleSelectorInGroup(Class clazz, SEL selector, IMP newImplementation, const char *group, const void *key);
+
+/**
+ * Same as hls_class_swizzleClassSelectorWithBlock() and hls_class_swizzleSelectorWithBlock(), but recording the swizzle
+ * in the registry for the given group. If the group is disabled, the method is not swizzled and NULL is returned
+ */
+OBJC_EXPORT IMP hls_class_swizzleClassSelectorWithBlockInGroup(const char *group, Class clazz, SEL selector, id newImplementationBlock);
+OBJC_EXPORT IMP hls_class_swizzleSelectorWithBlockInGroup(const char *group, Class clazz, SEL selector, id newImplementationBlock);
+
+/**
+ * Return YES iff swizzles for the given group (a file path or a group name) must be installed. Groups listed in the
+ * HLSDisabledSwizzleGroups array of the main bundle Info.plist are disabled, which is the only way to disable groups
+ * before CoconutKit +load methods are executed. Other groups are enabled unless disabled using hls_setSwizzleGroupEnabled()
+ */
+OBJC_EXPORT BOOL hls_isSwizzleGroupEnabled(const char *group);
+
+/**
+ * Enable or disable a group (a file path or a group name). This only affects swizzles made afterwards
+ */
+OBJC_EXPORT void hls_setSwizzleGroupEnabled(const char *group, BOOL enabled);
+
+/**
+ * Record the time spent in a +load method for a group (see HLSSwizzleGroup_End)
+ */
+OBJC_EXPORT void hls_recordSwizzleGroupLoadDuration(const char *group, NSTimeInterval duration);
+
+/**
+ * Enable or disable call counting. Counters are not reset
+ */
+OBJC_EXPORT void hls_setSwizzleCallCountingEnabled(BOOL enabled);
+
+/**
+ * Record a call through the swizzle identified by the given key (see HLSSwizzleCountCall)
+ */
+OBJC_EXPORT void hls_recordSwizzledCall(const void *key);
+
+/**
+ * Return the swizzles recorded so far, in the order in which they were made, as dictionaries (see keys above)
+ */
+OBJC_EXPORT NSArray *hls_swizzleRegistryEntries(void);
+
+/**
+ * Return the time spent in +load methods enclosed with HLSSwizzleGroup_Begin and HLSSwizzleGroup_End, as a dictionary
+ * mapping group names to durations in seconds (NSNumber)
+ */
+OBJC_EXPORT NSDictionary *hls_swizzleGroupLoadDurations(void);
+
 /**
  * Return YES iff subclass is a subclass of superclass, or if subclass == superclass (in agreement with
  * the behavior of +[NSObject isSubclassOfClass:])
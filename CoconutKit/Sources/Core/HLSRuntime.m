@@ -13,7 +13,49 @@
  *         (see http://www.opensource.apple.com/source/objc4/objc4-532.2/runtime/objc-runtime-new.mm)
  */
 
+#import <libkern/OSAtomic.h>
 #import <objc/message.h>
+#import <pthread.h>
+
+NSString * const HLSSwizzleClassNameKey = @"className";
+NSString * const HLSSwizzleSelectorNameKey = @"selectorName";
+NSString * const HLSSwizzleGroupKey = @"group";
+NSString * const HLSSwizzleDurationKey = @"duration";
+NSString * const HLSSwizzleCallCountKey = @"callCount";
+
+volatile BOOL hls_swizzleCallCountingEnabled = NO;
+
+// Incremented each time methods are added or replaced using HLSRuntime functions
+static volatile int32_t s_methodListsGeneration = 0;
+
+/**
+ * A swizzle recorded in the registry
+ */
+@interface HLSSwizzleRegistryEntry : NSObject {
+@public
+    NSString *_className;
+    NSString *_selectorName;
+    NSString *_groupName;
+    NSTimeInterval _duration;
+    NSUInteger _callCount;
+}
+
+@end
+
+@implementation HLSSwizzleRegistryEntry
+
+@end
+
+// Swizzle registry. All accesses must be made with the mutex locked
+static pthread_mutex_t s_swizzleRegistryMutex = PTHREAD_MUTEX_INITIALIZER;
+static NSMutableArray *s_swizzleRegistryEntries = nil;
+static NSMapTable *s_keyToSwizzleRegistryEntryMap = nil;
+static NSMutableDictionary *s_swizzleGroupLoadDurations = nil;
+static NSMutableSet *s_disabledSwizzleGroupNames = nil;
+
+static NSString *swizzleGroupName(const char *group);
+static void swizzleRegistryInitialize(void);
+static IMP swizzleSelectorInGroup(Class clazz, SEL selector, IMP newImplementation, const char *group, const void *key);
 
 struct objc_method_description *hls_protocol_copyMethodDescriptionList(Protocol *protocol,
                                                                        BOOL isRequiredMethod,
@@ -285,7 +327,9 @@ IMP hls_class_swizzleSelector(Class clazz, SEL selector, IMP newImplementation)
 #endif
     
     // Swizzling
-    return class_replaceMethod(clazz, selector, newImplementation, types);
+    IMP previousImplementation = class_replaceMethod(clazz, selector, newImplementation, types);
+    hls_invalidateMethodListsCaches();
+    return previousImplementation;
 }
 
 IMP hls_class_swizzleClassSelectorWithBlock(Class clazz, SEL selector, id newImplementationBlock)
@@ -300,6 +344,152 @@ IMP hls_class_swizzleSelectorWithBlock(Class clazz, SEL selector, id newImplemen
     return hls_class_swizzleSelector(clazz, selector, newImplementation);
 }
 
+BOOL hls_class_addMethod(Class cls, SEL name, IMP imp, const char *types)
+{
+    BOOL added = class_addMethod(cls, name, imp, types);
+    if (added) {
+        hls_invalidateMethodListsCaches();
+    }
+    return added;
+}
+
+void hls_objc_disposeClassPair(Class cls)
+{
+    objc_disposeClassPair(cls);
+    
+    // Entries stored for the disposed class must not be found by a class later allocated at the same address
+    hls_invalidateMethodListsCaches();
+}
+
+int32_t hls_methodListsGeneration(void)
+{
+    return s_methodListsGeneration;
+}
+
+void hls_invalidateMethodListsCaches(void)
+{
+    OSAtomicIncrement32Barrier(&s_methodListsGeneration);
+}
+
+IMP hls_class_swizzleClassSelectorInGroup(Class clazz, SEL selector, IMP newImplementation, const char *group, const void *key)
+{
+    return swizzleSelectorInGroup(object_getClass(clazz), selector, newImplementation, group, key);
+}
+
+IMP hls_class_swizzleSelectorInGroup(Class clazz, SEL selector, IMP newImplementation, const char *group, const void *key)
+{
+    return swizzleSelectorInGroup(clazz, selector, newImplementation, group, key);
+}
+
+IMP hls_class_swizzleClassSelectorWithBlockInGroup(const char *group, Class clazz, SEL selector, id newImplementationBlock)
+{
+    if (! hls_isSwizzleGroupEnabled(group)) {
+        return NULL;
+    }
+    
+    IMP newImplementation = imp_implementationWithBlock(newImplementationBlock);
+    return hls_class_swizzleClassSelectorInGroup(clazz, selector, newImplementation, group, NULL);
+}
+
+IMP hls_class_swizzleSelectorWithBlockInGroup(const char *group, Class clazz, SEL selector, id newImplementationBlock)
+{
+    if (! hls_isSwizzleGroupEnabled(group)) {
+        return NULL;
+    }
+    
+    IMP newImplementation = imp_implementationWithBlock(newImplementationBlock);
+    return hls_class_swizzleSelectorInGroup(clazz, selector, newImplementation, group, NULL);
+}
+
+BOOL hls_isSwizzleGroupEnabled(const char *group)
+{
+    @autoreleasepool {
+        NSString *groupName = swizzleGroupName(group);
+        
+        pthread_mutex_lock(&s_swizzleRegistryMutex);
+        swizzleRegistryInitialize();
+        BOOL enabled = ! [s_disabledSwizzleGroupNames containsObject:groupName];
+        pthread_mutex_unlock(&s_swizzleRegistryMutex);
+        
+        return enabled;
+    }
+}
+
+void hls_setSwizzleGroupEnabled(const char *group, BOOL enabled)
+{
+    @autoreleasepool {
+        NSString *groupName = swizzleGroupName(group);
+        
+        pthread_mutex_lock(&s_swizzleRegistryMutex);
+        swizzleRegistryInitialize();
+        if (enabled) {
+            [s_disabledSwizzleGroupNames removeObject:groupName];
+        }
+        else {
+            [s_disabledSwizzleGroupNames addObject:groupName];
+        }
+        pthread_mutex_unlock(&s_swizzleRegistryMutex);
+    }
+}
+
+void hls_recordSwizzleGroupLoadDuration(const char *group, NSTimeInterval duration)
+{
+    @autoreleasepool {
+        NSString *groupName = swizzleGroupName(group);
+        
+        pthread_mutex_lock(&s_swizzleRegistryMutex);
+        swizzleRegistryInitialize();
+        NSTimeInterval previousDuration = [[s_swizzleGroupLoadDurations objectForKey:groupName] doubleValue];
+        [s_swizzleGroupLoadDurations setObject:@(previousDuration + duration) forKey:groupName];
+        pthread_mutex_unlock(&s_swizzleRegistryMutex);
+    }
+}
+
+void hls_setSwizzleCallCountingEnabled(BOOL enabled)
+{
+    hls_swizzleCallCountingEnabled = enabled;
+}
+
+void hls_recordSwizzledCall(const void *key)
+{
+    if (! key) {
+        return;
+    }
+    
+    pthread_mutex_lock(&s_swizzleRegistryMutex);
+    HLSSwizzleRegistryEntry *entry = [s_keyToSwizzleRegistryEntryMap objectForKey:(__bridge id)key];
+    if (entry) {
+        ++entry->_callCount;
+    }
+    pthread_mutex_unlock(&s_swizzleRegistryMutex);
+}
+
+NSArray *hls_swizzleRegistryEntries(void)
+{
+    NSMutableArray *entries = [NSMutableArray array];
+    
+    pthread_mutex_lock(&s_swizzleRegistryMutex);
+    for (HLSSwizzleRegistryEntry *entry in s_swizzleRegistryEntries) {
+        [entries addObject:@{ HLSSwizzleClassNameKey : entry->_className,
+                              HLSSwizzleSelectorNameKey : entry->_selectorName,
+                              HLSSwizzleGroupKey : entry->_groupName,
+                              HLSSwizzleDurationKey : @(entry->_duration),
+                              HLSSwizzleCallCountKey : @(entry->_callCount) }];
+    }
+    pthread_mutex_unlock(&s_swizzleRegistryMutex);
+    
+    return [NSArray arrayWithArray:entries];
+}
+
+NSDictionary *hls_swizzleGroupLoadDurations(void)
+{
+    pthread_mutex_lock(&s_swizzleRegistryMutex);
+    NSDictionary *swizzleGroupLoadDurations = [NSDictionary dictionaryWithDictionary:s_swizzleGroupLoadDurations];
+    pthread_mutex_unlock(&s_swizzleRegistryMutex);
+    
+    return swizzleGroupLoadDurations ?: @{};
+}
+
 BOOL hls_class_isSubclassOfClass(Class subclass, Class superclass)
 {
     for (Class class = subclass; class != Nil; class = class_getSuperclass(class)) {
@@ -368,3 +558,71 @@ id hls_getAssociatedObject(id object, const void *key)
         return associatedObject;
     }
 }
+
+#pragma mark Static functions
+
+/**
+ * Return the group name corresponding to a group (file path or group name)
+ */
+static NSString *swizzleGroupName(const char *group)
+{
+    if (! group) {
+        return @"Other";
+    }
+    
+    return [[@(group) lastPathComponent] stringByDeletingPathExtension];
+}
+
+/**
+ * Create registry structures, reading groups disabled from the main bundle Info.plist. Must be called with the registry
+ * mutex locked
+ */
+static void swizzleRegistryInitialize(void)
+{
+    if (s_swizzleRegistryEntries) {
+        return;
+    }
+    
+    s_swizzleRegistryEntries = [NSMutableArray array];
+    s_keyToSwizzleRegistryEntryMap = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsOpaqueMemory | NSPointerFunctionsOpaquePersonality
+                                                           valueOptions:NSPointerFunctionsStrongMemory];
+    s_swizzleGroupLoadDurations = [NSMutableDictionary dictionary];
+    
+    NSArray *disabledSwizzleGroupNames = [[NSBundle mainBundle] objectForInfoDictionaryKey:@"HLSDisabledSwizzleGroups"];
+    s_disabledSwizzleGroupNames = [NSMutableSet setWithArray:[disabledSwizzleGroupNames isKindOfClass:[NSArray class]] ? disabledSwizzleGroupNames : @[]];
+}
+
+/**
+ * Swizzle a method (instance method if the class is a metaclass) and record it in the registry
+ */
+static IMP swizzleSelectorInGroup(Class clazz, SEL selector, IMP newImplementation, const char *group, const void *key)
+{
+    if (! hls_isSwizzleGroupEnabled(group)) {
+        return NULL;
+    }
+    
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    IMP previousImplementation = hls_class_swizzleSelector(clazz, selector, newImplementation);
+    NSTimeInterval duration = CFAbsoluteTimeGetCurrent() - startTime;
+    if (! previousImplementation) {
+        return NULL;
+    }
+    
+    @autoreleasepool {
+        HLSSwizzleRegistryEntry *entry = [[HLSSwizzleRegistryEntry alloc] init];
+        entry->_className = @(class_getName(clazz));
+        entry->_selectorName = [NSString stringWithFormat:@"%@%s", class_isMetaClass(clazz) ? @"+" : @"-", sel_getName(selector)];
+        entry->_groupName = swizzleGroupName(group);
+        entry->_duration = duration;
+        
+        pthread_mutex_lock(&s_swizzleRegistryMutex);
+        swizzleRegistryInitialize();
+        [s_swizzleRegistryEntries addObject:entry];
+        if (key) {
+            [s_keyToSwizzleRegistryEntryMap setObject:entry forKey:(__bridge id)key];
+        }
+        pthread_mutex_unlock(&s_swizzleRegistryMutex);
+    }
+    
+    return previousImplementation;
+}
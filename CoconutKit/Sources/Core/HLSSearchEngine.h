@@ -0,0 +1,91 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ * Block deciding whether an object matches a search string within a scope. Called on a background thread
+ */
+typedef BOOL (^HLSSearchEngineFilterBlock)(id object, NSString *searchString, NSInteger scope);
+
+/**
+ * Block called on the main thread when search results are available. Deleted indexes refer to the previous results,
+ * inserted indexes to the new ones, and can be used to update table view rows in a batch
+ */
+typedef void (^HLSSearchEngineCompletionBlock)(NSArray *results, NSIndexSet *deletedIndexes, NSIndexSet *insertedIndexes);
+
+/**
+ * A search engine filters a fixed list of objects without blocking the main thread:
+ *   - queries are debounced, so that typing quickly does not trigger one search per keystroke
+ *   - filtering is performed on a background queue. When a new query is made, stale queries are cancelled
+ *   - when a search string extends the previous one (within the same scope), only the previous results are filtered
+ *     again (incremental refinement). For this to be valid, an object matching a search string must match all its
+ *     prefixes as well, which is the case for the usual substring or prefix matching. Disable refinement otherwise
+ *   - results are reported with the indexes which changed, so that table views can be updated without reloading
+ *     them entirely
+ *
+ * Results always keep the order of the original object list. Use a search engine from the main thread only (the filter
+ * block excepted). HLSTableSearchDisplayViewController can use a search engine to filter its search results
+ *
+ * Designated initializer: -initWithObjects:filterBlock:
+ */
+@interface HLSSearchEngine : NSObject
+
+/**
+ * Create a search engine for the given objects
+ */
+- (instancetype)initWithObjects:(NSArray *)objects filterBlock:(HLSSearchEngineFilterBlock)filterBlock NS_DESIGNATED_INITIALIZER;
+
+/**
+ * The objects to be searched
+ */
+@property (nonatomic, readonly, strong) NSArray *objects;
+
+/**
+ * The delay after which a query is performed, provided no other query is made in the meantime
+ *
+ * Default value is 0.2
+ */
+@property (nonatomic, assign) NSTimeInterval delay;
+
+/**
+ * Set to NO if the filter block does not allow incremental refinement (see class documentation)
+ *
+ * Default value is YES
+ */
+@property (nonatomic, assign, getter=isIncrementalRefinementEnabled) BOOL incrementalRefinementEnabled;
+
+/**
+ * Search for the given string within a scope. The optional completion block is only called if the query is not
+ * superseded by another one before it completes
+ */
+- (void)searchForString:(NSString *)searchString scope:(NSInteger)scope completionBlock:(HLSSearchEngineCompletionBlock)completionBlock;
+
+/**
+ * Cancel pending and running queries. Current results are kept
+ */
+- (void)cancel;
+
+/**
+ * The results of the last completed query, and the corresponding search string and scope. Before any query completes,
+ * results contain all objects
+ */
+@property (nonatomic, readonly, strong) NSArray *results;
+@property (nonatomic, readonly, copy) NSString *searchString;
+@property (nonatomic, readonly, assign) NSInteger scope;
+
+/**
+ * Return YES iff a query is pending or running
+ */
+@property (nonatomic, readonly, assign, getter=isSearching) BOOL searching;
+
+@end
+
+@interface HLSSearchEngine (UnavailableMethods)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
@@ -0,0 +1,207 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import "HLSSearchEngine.h"
+
+// Number of objects filtered between two cancellation checks
+static const NSUInteger HLSSearchEngineCancellationCheckInterval = 1024;
+
+static void diffIndexes(NSIndexSet *oldIndexes, NSIndexSet *newIndexes, NSMutableIndexSet *deletedIndexes, NSMutableIndexSet *insertedIndexes);
+
+@interface HLSSearchEngine ()
+
+@property (nonatomic, strong) NSArray *objects;
+@property (nonatomic, copy) HLSSearchEngineFilterBlock filterBlock;
+
+@property (nonatomic, strong) NSIndexSet *resultIndexes;                // Indexes of the results in the object list
+@property (nonatomic, copy) NSString *searchString;
+@property (nonatomic, assign) NSInteger scope;
+
+@property (nonatomic, copy) NSString *pendingSearchString;
+@property (nonatomic, assign) NSInteger pendingScope;
+@property (nonatomic, copy) HLSSearchEngineCompletionBlock pendingCompletionBlock;
+
+@property (nonatomic, strong) NSOperationQueue *operationQueue;
+@property (nonatomic, strong) NSOperation *operation;
+
+@end
+
+@implementation HLSSearchEngine
+
+#pragma mark Object creation and destruction
+
+- (instancetype)initWithObjects:(NSArray *)objects filterBlock:(HLSSearchEngineFilterBlock)filterBlock
+{
+    NSParameterAssert(filterBlock);
+    
+    if (self = [super init]) {
+        self.objects = [NSArray arrayWithArray:objects ?: @[]];
+        self.filterBlock = filterBlock;
+        self.resultIndexes = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, [self.objects count])];
+        self.delay = 0.2;
+        self.incrementalRefinementEnabled = YES;
+        
+        self.operationQueue = [[NSOperationQueue alloc] init];
+        self.operationQueue.maxConcurrentOperationCount = 1;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [self.operationQueue cancelAllOperations];
+}
+
+#pragma mark Accessors and mutators
+
+- (NSArray *)results
+{
+    return [self.objects objectsAtIndexes:self.resultIndexes];
+}
+
+- (BOOL)isSearching
+{
+    return self.pendingCompletionBlock || self.pendingSearchString || self.operation;
+}
+
+#pragma mark Searching
+
+- (void)searchForString:(NSString *)searchString scope:(NSInteger)scope completionBlock:(HLSSearchEngineCompletionBlock)completionBlock
+{
+    [self cancel];
+    
+    self.pendingSearchString = searchString ?: @"";
+    self.pendingScope = scope;
+    self.pendingCompletionBlock = completionBlock;
+    
+    if (self.delay > 0.) {
+        [self performSelector:@selector(startSearch) withObject:nil afterDelay:self.delay];
+    }
+    else {
+        [self startSearch];
+    }
+}
+
+- (void)startSearch
+{
+    NSString *searchString = self.pendingSearchString;
+    NSInteger scope = self.pendingScope;
+    HLSSearchEngineCompletionBlock completionBlock = self.pendingCompletionBlock;
+    
+    self.pendingSearchString = nil;
+    self.pendingCompletionBlock = nil;
+    
+    // Refine the current results if possible, otherwise filter all objects
+    NSIndexSet *previousIndexes = self.resultIndexes;
+    NSIndexSet *candidateIndexes = nil;
+    if (self.incrementalRefinementEnabled && self.searchString && scope == self.scope && [searchString hasPrefix:self.searchString]) {
+        candidateIndexes = previousIndexes;
+    }
+    else {
+        candidateIndexes = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, [self.objects count])];
+    }
+    
+    NSArray *objects = self.objects;
+    HLSSearchEngineFilterBlock filterBlock = self.filterBlock;
+    
+    NSBlockOperation *operation = [[NSBlockOperation alloc] init];
+    __weak NSBlockOperation *weakOperation = operation;
+    __weak __typeof(self) weakSelf = self;
+    [operation addExecutionBlock:^{
+        NSMutableIndexSet *resultIndexes = [NSMutableIndexSet indexSet];
+        __block NSUInteger filteredCount = 0;
+        __block BOOL cancelled = NO;
+        [candidateIndexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+            if (++filteredCount % HLSSearchEngineCancellationCheckInterval == 0 && [weakOperation isCancelled]) {
+                cancelled = YES;
+                *stop = YES;
+                return;
+            }
+            
+            if (filterBlock([objects objectAtIndex:index], searchString, scope)) {
+                [resultIndexes addIndex:index];
+            }
+        }];
+        
+        if (cancelled) {
+            return;
+        }
+        
+        NSMutableIndexSet *deletedIndexes = [NSMutableIndexSet indexSet];
+        NSMutableIndexSet *insertedIndexes = [NSMutableIndexSet indexSet];
+        diffIndexes(previousIndexes, resultIndexes, deletedIndexes, insertedIndexes);
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            // Superseded in the meantime
+            __typeof(self) strongSelf = weakSelf;
+            if (! strongSelf || [weakOperation isCancelled] || strongSelf.operation != weakOperation) {
+                return;
+            }
+            
+            strongSelf.operation = nil;
+            strongSelf.resultIndexes = [resultIndexes copy];
+            strongSelf.searchString = searchString;
+            strongSelf.scope = scope;
+            
+            if (completionBlock) {
+                completionBlock(strongSelf.results, [deletedIndexes copy], [insertedIndexes copy]);
+            }
+        });
+    }];
+    
+    self.operation = operation;
+    [self.operationQueue addOperation:operation];
+}
+
+- (void)cancel
+{
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(startSearch) object:nil];
+    self.pendingSearchString = nil;
+    self.pendingCompletionBlock = nil;
+    
+    [self.operation cancel];
+    self.operation = nil;
+}
+
+@end
+
+#pragma mark Static functions
+
+/**
+ * Compare two sets of indexes into the same object list. Fill deleted indexes with the positions (within the old
+ * indexes) of indexes which are not present anymore, and inserted indexes with the positions (within the new indexes)
+ * of indexes which were not present before
+ */
+static void diffIndexes(NSIndexSet *oldIndexes, NSIndexSet *newIndexes, NSMutableIndexSet *deletedIndexes, NSMutableIndexSet *insertedIndexes)
+{
+    NSUInteger oldCount = [oldIndexes count];
+    NSUInteger newCount = [newIndexes count];
+    
+    NSUInteger *oldBuffer = malloc(MAX(oldCount, 1) * sizeof(NSUInteger));
+    NSUInteger *newBuffer = malloc(MAX(newCount, 1) * sizeof(NSUInteger));
+    [oldIndexes getIndexes:oldBuffer maxCount:oldCount inIndexRange:NULL];
+    [newIndexes getIndexes:newBuffer maxCount:newCount inIndexRange:NULL];
+    
+    // Both buffers are sorted: Merge them
+    NSUInteger oldPosition = 0, newPosition = 0;
+    while (oldPosition < oldCount || newPosition < newCount) {
+        if (newPosition == newCount || (oldPosition < oldCount && oldBuffer[oldPosition] < newBuffer[newPosition])) {
+            [deletedIndexes addIndex:oldPosition];
+            ++oldPosition;
+        }
+        else if (oldPosition == oldCount || newBuffer[newPosition] < oldBuffer[oldPosition]) {
+            [insertedIndexes addIndex:newPosition];
+            ++newPosition;
+        }
+        else {
+            ++oldPosition;
+            ++newPosition;
+        }
+    }
+    
+    free(oldBuffer);
+    free(newBuffer);
+}
@@ -10,6 +10,9 @@
 
 /**
  * Return the array obtained by removing the last object
+ *
+ * The receiver is copied entirely. If you need to add or remove objects at the end of a large array repeatedly, use an
+ * HLSPersistentArray instead, for which this method costs O(log n)
  */
 - (NSArray *)arrayByRemovingLastObject;
 
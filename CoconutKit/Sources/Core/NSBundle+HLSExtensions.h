@@ -9,6 +9,12 @@
 #define CoconutKitLocalizedString(key, comment) \
     [[NSBundle coconutKitBundle] localizedStringForKey:(key) value:@"" table:nil]
 
+/**
+ * Notification sent when the bundle cache has been invalidated (see +invalidateBundleCache). Resources looked up
+ * in bundles obtained from +bundleWithName: should then be looked up again
+ */
+OBJC_EXPORT NSString * const HLSBundleCacheDidInvalidateNotification;
+
 @interface NSBundle (HLSExtensions)
 
 /**
@@ -24,13 +30,24 @@
 + (NSBundle *)coconutKitBundle;
 
 /**
- * Return the first bundle contained either in the main bundle, the documents or the library folder (in this order) 
+ * Return the first bundle contained either in the main bundle, the library or the documents folder (in this order) 
  * and having a given name. The extension can be omitted, in which case another attempt with the .bundle extension 
  * will be made. If no matching bundle is found, nil is returned. Note that bundles are searched recursively, and 
  * that results are cached for faster lookup. If name is nil, the main bundle is returned
+ *
+ * Directories are enumerated only once to build a bundle name index, which is then used for all subsequent
+ * lookups. Both successful and failed lookups are cached. This method is thread-safe
  */
 + (NSBundle *)bundleWithName:(NSString *)name;
 
+/**
+ * Discard the bundle name index and all cached lookup results. Call this method when bundles have been added to
+ * or removed from the library or documents folder at runtime (e.g. after a download), so that subsequent calls to
+ * +bundleWithName: see them. The index is lazily rebuilt when needed. A HLSBundleCacheDidInvalidateNotification
+ * notification is then posted
+ */
++ (void)invalidateBundleCache;
+
 /**
  * Return a friendly bundle version number
  *
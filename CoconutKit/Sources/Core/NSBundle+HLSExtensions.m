@@ -10,6 +10,14 @@
 #import "HLSLogger.h"
 #import "NSString+HLSExtensions.h"
 
+NSString * const HLSBundleCacheDidInvalidateNotification = @"HLSBundleCacheDidInvalidateNotification";
+
+// Cached lookup results (NSNull if no bundle could be found), also used as lock for all bundle caches
+static NSMutableDictionary *s_nameToBundleMap = nil;
+
+// Bundle name indexes for searched directories, built when a directory is searched for the first time
+static NSMutableDictionary *s_directoryPathToIndexMap = nil;
+
 @implementation NSBundle (HLSExtensions)
 
 #pragma mark Class methods
@@ -49,73 +57,127 @@
         return [NSBundle mainBundle];
     }
     
-    static NSMutableDictionary *s_nameToBundleMap = nil;
-    static dispatch_once_t s_onceToken;
-    dispatch_once(&s_onceToken, ^{
-        s_nameToBundleMap = [[NSMutableDictionary alloc] init];
-    });
-    
-    NSBundle *bundle = [s_nameToBundleMap objectForKey:name];
-    if (bundle) {
-        return bundle;
-    }
-    NSString *nameDotBundle = [name stringByAppendingPathExtension:@"bundle"];
-    bundle = [s_nameToBundleMap objectForKey:nameDotBundle];
-    if (bundle) {
+    @synchronized([self bundleCacheLock]) {
+        id bundle = [s_nameToBundleMap objectForKey:name];
+        if (bundle) {
+            return (bundle != [NSNull null]) ? bundle : nil;
+        }
+        
+        NSArray *directoryPaths = @[[[NSBundle mainBundle] bundlePath], HLSApplicationLibraryDirectoryPath(), HLSApplicationDocumentDirectoryPath()];
+        bundle = [self bundleWithName:name inDirectories:directoryPaths];
+        
+        // Search again, but with the .bundle extension appended
+        if (! bundle && ! [[name pathExtension] isEqualToString:@"bundle"]) {
+            bundle = [self bundleWithName:[name stringByAppendingPathExtension:@"bundle"] inDirectories:directoryPaths];
+        }
+        
+        // Failed lookups are cached as well, and therefore only reported once
+        if (! bundle) {
+            HLSLoggerWarn(@"No bundle named %@ was found in the main bundle, Library or Documents directory", name);
+        }
+        
+        [s_nameToBundleMap setObject:bundle ?: [NSNull null] forKey:name];
         return bundle;
     }
-    
-    bundle = [self bundleWithName:name inDirectory:[[NSBundle mainBundle] bundlePath]];
-    if (bundle) {
-        [s_nameToBundleMap setObject:bundle forKey:name];
-        return bundle;
+}
+
++ (void)invalidateBundleCache
+{
+    @synchronized([self bundleCacheLock]) {
+        [s_nameToBundleMap removeAllObjects];
+        
+        // The main bundle contents cannot change, its index can therefore be kept
+        NSString *mainBundlePath = [[NSBundle mainBundle] bundlePath];
+        NSDictionary *mainBundleIndex = [s_directoryPathToIndexMap objectForKey:mainBundlePath];
+        [s_directoryPathToIndexMap removeAllObjects];
+        if (mainBundleIndex) {
+            [s_directoryPathToIndexMap setObject:mainBundleIndex forKey:mainBundlePath];
+        }
     }
     
-    bundle = [self bundleWithName:name inDirectory:HLSApplicationLibraryDirectoryPath()];
-    if (bundle) {
-        [s_nameToBundleMap setObject:bundle forKey:name];
-        return bundle;
+    [[NSNotificationCenter defaultCenter] postNotificationName:HLSBundleCacheDidInvalidateNotification object:nil];
+}
+
+/**
+ * Object used to synchronize access to the bundle caches
+ */
++ (id)bundleCacheLock
+{
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        s_nameToBundleMap = [[NSMutableDictionary alloc] init];
+        s_directoryPathToIndexMap = [[NSMutableDictionary alloc] init];
+    });
+    return s_nameToBundleMap;
+}
+
+/**
+ * Return the first bundle with the given name found in a list of directories, searched in order
+ */
++ (NSBundle *)bundleWithName:(NSString *)name inDirectories:(NSArray *)directoryPaths
+{
+    for (NSString *directoryPath in directoryPaths) {
+        NSBundle *bundle = [self bundleWithName:name inDirectory:directoryPath];
+        if (bundle) {
+            return bundle;
+        }
     }
-    
-    bundle = [self bundleWithName:name inDirectory:HLSApplicationDocumentDirectoryPath()];
-    if (bundle) {
-        [s_nameToBundleMap setObject:bundle forKey:name];
-        return bundle;
+    return nil;
+}
+
+/**
+ * Must be called with the bundle cache lock held
+ */
++ (NSBundle *)bundleWithName:(NSString *)name inDirectory:(NSString *)directoryPath
+{
+    if (! directoryPath) {
+        directoryPath = [[NSBundle mainBundle] bundlePath];
     }
     
-    // Search again, but with the .bundle extension appended
-    if (! [[name pathExtension] isEqualToString:@"bundle"]) {
-        bundle = [self bundleWithName:nameDotBundle];
+    NSDictionary *nameToBundlePathsIndex = [s_directoryPathToIndexMap objectForKey:directoryPath];
+    if (! nameToBundlePathsIndex) {
+        nameToBundlePathsIndex = [self nameToBundlePathsIndexForDirectory:directoryPath];
+        [s_directoryPathToIndexMap setObject:nameToBundlePathsIndex forKey:directoryPath];
     }
     
-    if (! bundle) {
-        HLSLoggerWarn(@"No bundle named %@ was found in the main bundle, Library or Documents directory", name);
+    for (NSString *bundlePath in [nameToBundlePathsIndex objectForKey:name]) {
+        NSBundle *bundle = [NSBundle bundleWithPath:bundlePath];
+        if (bundle) {
+            return bundle;
+        }
     }
-    
-    return bundle;
+    return nil;
 }
 
-+ (NSBundle *)bundleWithName:(NSString *)name inDirectory:(NSString *)directoryPath
+/**
+ * Enumerate the contents of a directory recursively, and return a dictionary mapping directory names to the 
+ * corresponding full paths (in enumeration order). Only directories are indexed, since only those can be bundles
+ */
++ (NSDictionary *)nameToBundlePathsIndexForDirectory:(NSString *)directoryPath
 {
-    if (! directoryPath) {
-        directoryPath = [[NSBundle mainBundle] bundlePath];
-    }
+    NSMutableDictionary *nameToBundlePathsIndex = [NSMutableDictionary dictionary];
     
-    NSBundle *bundle = nil;
-    NSArray *contentPaths = [[NSFileManager defaultManager] subpathsOfDirectoryAtPath:directoryPath error:NULL];
-    for (NSString *contentPath in contentPaths) {
-        NSString *lastPathComponent = [contentPath lastPathComponent];
-        if (! [lastPathComponent isEqualToString:name]) {
+    NSURL *directoryURL = [NSURL fileURLWithPath:directoryPath isDirectory:YES];
+    NSDirectoryEnumerator *directoryEnumerator = [[NSFileManager defaultManager] enumeratorAtURL:directoryURL
+                                                                      includingPropertiesForKeys:@[NSURLIsDirectoryKey]
+                                                                                         options:0
+                                                                                    errorHandler:nil];
+    for (NSURL *contentURL in directoryEnumerator) {
+        NSNumber *isDirectory = nil;
+        if (! [contentURL getResourceValue:&isDirectory forKey:NSURLIsDirectoryKey error:NULL] || ! [isDirectory boolValue]) {
             continue;
         }
         
-        NSString *bundlePath = [directoryPath stringByAppendingPathComponent:contentPath];
-        bundle = [NSBundle bundleWithPath:bundlePath];
-        if (bundle) {
-            break;
+        NSString *name = [contentURL lastPathComponent];
+        NSMutableArray *bundlePaths = [nameToBundlePathsIndex objectForKey:name];
+        if (! bundlePaths) {
+            bundlePaths = [NSMutableArray array];
+            [nameToBundlePathsIndex setObject:bundlePaths forKey:name];
         }
+        [bundlePaths addObject:[contentURL path]];
     }
-    return bundle;
+    
+    return [NSDictionary dictionaryWithDictionary:nameToBundlePathsIndex];
 }
 
 #pragma mark Accessors and mutators
@@ -20,7 +20,9 @@ static NSString *swizzle_descriptionWithLocale(NSDate *self, SEL _cmd, id locale
 
 + (void)load
 {
+    HLSSwizzleGroup_Begin
     HLSSwizzleSelector(self, @selector(descriptionWithLocale:), swizzle_descriptionWithLocale, &s_descriptionWithLocale);
+    HLSSwizzleGroup_End
 }
 
 #pragma mark Convenience methods
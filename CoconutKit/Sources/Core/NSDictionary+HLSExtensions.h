@@ -10,6 +10,9 @@
 
 /**
  * Return the receiver, to which object has been set for key
+ *
+ * The receiver is copied entirely. If you need to build a large dictionary one key at a time, use an HLSPersistentDictionary
+ * instead, for which the methods below cost O(log n)
  */
 - (NSDictionary *)dictionaryBySettingObject:(id)object forKey:(id)key;
 
@@ -20,8 +20,18 @@
 - (NSString *)className;
 
 /**
- * Return YES iff the object class implements all methods of a given protocol
+ * Return YES iff the object class implements all optional instance methods of a given protocol (required methods
+ * are checked at compilation time)
+ *
+ * Results are cached per class and protocol, so that repeated checks (e.g. in delegate code running for each table
+ * view cell) are cheap. Cached results are discarded when methods are added or replaced using HLSRuntime functions
+ * (see hls_class_addMethod)
  */
 - (BOOL)implementsProtocol:(Protocol *)protocol;
 
+/**
+ * Return YES iff the object class implements all optional instance methods of all protocols in the given array
+ */
+- (BOOL)implementsProtocols:(NSArray *)protocols;
+
 @end
@@ -6,8 +6,40 @@
 
 #import "NSObject+HLSExtensions.h"
 
+#import <libkern/OSAtomic.h>
 #import <objc/runtime.h>
+#import <pthread.h>
 #import "HLSLogger.h"
+#import "HLSRuntime.h"
+
+// Must be a power of two
+static const NSUInteger HLSProtocolCacheSize = 1024;
+
+/**
+ * Entry of the protocol implementation cache. The sequence number is odd while the entry is being written, and
+ * incremented before and after each write, so that readers can detect concurrent updates without locking
+ */
+typedef struct {
+    volatile int32_t sequence;
+    __unsafe_unretained Class cls;
+    __unsafe_unretained Protocol *protocol;
+    int32_t generation;
+    BOOL result;
+} HLSProtocolCacheEntry;
+
+// Direct-mapped cache storing unretained pointers. Protocols are never deallocated. Classes are only deallocated when
+// disposed of with objc_disposeClassPair, after which their address can be reused by a new class. Entries are then
+// discarded since the generation changes (see hls_objc_disposeClassPair)
+static HLSProtocolCacheEntry s_protocolCacheEntries[HLSProtocolCacheSize];
+
+// Serializes cache writes
+static pthread_mutex_t s_protocolCacheMutex = PTHREAD_MUTEX_INITIALIZER;
+
+// Function declarations
+static HLSProtocolCacheEntry *protocolCacheEntry(Class cls, Protocol *protocol);
+static BOOL protocolCacheLookup(Class cls, Protocol *protocol, BOOL *pResult);
+static void protocolCacheStore(Class cls, Protocol *protocol, int32_t generation, BOOL result);
+static BOOL classImplementsProtocol(Class cls, Protocol *protocol);
 
 @implementation NSObject (HLSExtensions)
 
@@ -22,20 +54,99 @@
 }
 
 - (BOOL)implementsProtocol:(Protocol *)protocol
+{
+    Class cls = [self class];
+    
+    BOOL result = NO;
+    if (protocolCacheLookup(cls, protocol, &result)) {
+        return result;
+    }
+    
+    // Read the generation first. If methods are added meanwhile the stored result is stale and won't be used
+    int32_t generation = hls_methodListsGeneration();
+    result = classImplementsProtocol(cls, protocol);
+    protocolCacheStore(cls, protocol, generation, result);
+    return result;
+}
+
+- (BOOL)implementsProtocols:(NSArray *)protocols
+{
+    for (Protocol *protocol in protocols) {
+        if (! [self implementsProtocol:protocol]) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+@end
+
+#pragma mark Static functions
+
+static HLSProtocolCacheEntry *protocolCacheEntry(Class cls, Protocol *protocol)
+{
+    // Object pointers are aligned, discard the lowest bits
+    uintptr_t hash = ((uintptr_t)cls >> 4) ^ (((uintptr_t)protocol >> 4) * 31);
+    return &s_protocolCacheEntries[hash & (HLSProtocolCacheSize - 1)];
+}
+
+/**
+ * Lock-free cache lookup. Return YES and fill pResult iff a valid result was found
+ */
+static BOOL protocolCacheLookup(Class cls, Protocol *protocol, BOOL *pResult)
+{
+    HLSProtocolCacheEntry *entry = protocolCacheEntry(cls, protocol);
+    
+    int32_t sequence = entry->sequence;
+    if (sequence & 1) {
+        return NO;
+    }
+    OSMemoryBarrier();
+    
+    BOOL found = entry->cls == cls && entry->protocol == protocol && entry->generation == hls_methodListsGeneration();
+    BOOL result = entry->result;
+    
+    // Discard the values read if the entry was updated meanwhile
+    OSMemoryBarrier();
+    if (entry->sequence != sequence || ! found) {
+        return NO;
+    }
+    
+    *pResult = result;
+    return YES;
+}
+
+static void protocolCacheStore(Class cls, Protocol *protocol, int32_t generation, BOOL result)
+{
+    HLSProtocolCacheEntry *entry = protocolCacheEntry(cls, protocol);
+    
+    pthread_mutex_lock(&s_protocolCacheMutex);
+    OSAtomicIncrement32Barrier(&entry->sequence);
+    entry->cls = cls;
+    entry->protocol = protocol;
+    entry->generation = generation;
+    entry->result = result;
+    OSAtomicIncrement32Barrier(&entry->sequence);
+    pthread_mutex_unlock(&s_protocolCacheMutex);
+}
+
+static BOOL classImplementsProtocol(Class cls, Protocol *protocol)
 {
     // Only interested in optional methods. Required methods are checked at compilation time
     unsigned int numberOfMethods = 0;
     struct objc_method_description *methodDescriptions = protocol_copyMethodDescriptionList(protocol, NO /* optional only */, YES, &numberOfMethods);
+    
+    BOOL result = YES;
     for (unsigned int i = 0; i < numberOfMethods; ++i) {
         struct objc_method_description methodDescription = methodDescriptions[i];
         SEL selector = methodDescription.name;
-        if (! class_getInstanceMethod([self class], selector)) {
-            HLSLoggerInfo(@"Class %@ does not implement method %@ of protocol %@", [self className], @(sel_getName(selector)), @(protocol_getName(protocol)));
-            return NO;
+        if (! class_getInstanceMethod(cls, selector)) {
+            HLSLoggerInfo(@"Class %@ does not implement method %@ of protocol %@", @(class_getName(cls)), @(sel_getName(selector)), @(protocol_getName(protocol)));
+            result = NO;
+            break;
         }
     }
+    free(methodDescriptions);
     
-    return YES;
+    return result;
 }
-
-@end
@@ -18,7 +18,7 @@ OBJC_EXPORT NSString *HLSStringFromCATransform3D(CATransform3D transform);
 - (NSString *)stringByTrimmingWhitespaces;
 
 /**
- * Return NO if the string is empty or only made of whitespaces
+ * Return NO if the string is empty or only made of whitespaces. No trimmed copy of the string is made
  */
 - (BOOL)isFilled;
 
@@ -28,6 +28,12 @@ OBJC_EXPORT NSString *HLSStringFromCATransform3D(CATransform3D transform);
  */
 - (NSString *)urlEncodedStringUsingEncoding:(NSStringEncoding)encoding;
 
+/**
+ * URL encode several strings at once, with the same result as -urlEncodedStringUsingEncoding:, but reusing the same
+ * buffers for all strings. Strings which cannot be represented using the specified encoding are replaced with NSNull
+ */
++ (NSArray *)urlEncodedStringsWithStrings:(NSArray *)strings usingEncoding:(NSStringEncoding)encoding;
+
 /**
  * Calculate the MD2 hash of a string (hexadecimal)
  */
@@ -108,7 +114,7 @@ OBJC_EXPORT NSString *HLSStringFromCATransform3D(CATransform3D transform);
 - (NSString *)friendlyVersionNumber;
 
 /**
- * Guess the MIME type from the path extension
+ * Guess the MIME type from the path extension. Results are cached per extension
  */
 - (NSString *)MIMEType;
 
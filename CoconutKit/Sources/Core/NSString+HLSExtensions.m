@@ -12,6 +12,13 @@
 #import <CommonCrypto/CommonDigest.h>
 #import <MobileCoreServices/MobileCoreServices.h>
 
+// Size of the stack buffer used when scanning strings whose characters cannot be accessed directly
+static const CFIndex kStringScanBufferLength = 64;
+
+// Function declarations
+static NSCache *MIMETypeCache(void);
+static NSString *percentEncodedString(NSString *string, NSStringEncoding encoding, NSMutableData *bytesBuffer, NSMutableData *encodedBytesBuffer);
+
 static NSString* digest(NSString *string, unsigned char *(*cc_digest)(const void *, CC_LONG, unsigned char *), CC_LONG digestLength)
 {
     // Hash calculation
@@ -40,7 +47,35 @@ static NSString* digest(NSString *string, unsigned char *(*cc_digest)(const void
 
 - (BOOL)isFilled
 {
-    return [[self stringByTrimmingWhitespaces] length] != 0;
+    // Scan the string until a non-whitespace character is found, without creating a trimmed copy. Whitespace characters
+    // all lie in the basic multilingual plane, surrogates can therefore be tested as is
+    CFStringRef stringRef = (__bridge CFStringRef)self;
+    CFCharacterSetRef whitespaceCharacterSetRef = CFCharacterSetGetPredefined(kCFCharacterSetWhitespace);
+    CFIndex length = CFStringGetLength(stringRef);
+    
+    // Direct access to the characters, if available
+    const UniChar *characters = CFStringGetCharactersPtr(stringRef);
+    if (characters) {
+        for (CFIndex i = 0; i < length; ++i) {
+            if (! CFCharacterSetIsCharacterMember(whitespaceCharacterSetRef, characters[i])) {
+                return YES;
+            }
+        }
+        return NO;
+    }
+    
+    // Otherwise copy characters by chunks into a buffer
+    UniChar buffer[kStringScanBufferLength];
+    for (CFIndex location = 0; location < length; location += kStringScanBufferLength) {
+        CFIndex chunkLength = MIN(kStringScanBufferLength, length - location);
+        CFStringGetCharacters(stringRef, CFRangeMake(location, chunkLength), buffer);
+        for (CFIndex i = 0; i < chunkLength; ++i) {
+            if (! CFCharacterSetIsCharacterMember(whitespaceCharacterSetRef, buffer[i])) {
+                return YES;
+            }
+        }
+    }
+    return NO;
 }
 
 #pragma mark URL encoding
@@ -55,6 +90,25 @@ static NSString* digest(NSString *string, unsigned char *(*cc_digest)(const void
                                                                      cfEncoding));
 }
 
++ (NSArray *)urlEncodedStringsWithStrings:(NSArray *)strings usingEncoding:(NSStringEncoding)encoding
+{
+    // Buffers are reused for all strings
+    NSMutableData *bytesBuffer = [NSMutableData data];
+    NSMutableData *encodedBytesBuffer = [NSMutableData data];
+    
+    NSMutableArray *urlEncodedStrings = [NSMutableArray arrayWithCapacity:[strings count]];
+    for (NSString *string in strings) {
+        NSString *urlEncodedString = percentEncodedString(string, encoding, bytesBuffer, encodedBytesBuffer);
+        if (! urlEncodedString) {
+            HLSLoggerWarn(@"The string %@ could not be URL encoded", string);
+            [urlEncodedStrings addObject:[NSNull null]];
+            continue;
+        }
+        [urlEncodedStrings addObject:urlEncodedString];
+    }
+    return [NSArray arrayWithArray:urlEncodedStrings];
+}
+
 #pragma mark Hash digests
 
 - (NSString *)md2hash
@@ -118,6 +172,13 @@ static NSString* digest(NSString *string, unsigned char *(*cc_digest)(const void
         return nil;
     }
     
+    // Extensions without MIME type are cached as well
+    NSCache *cache = MIMETypeCache();
+    id cachedMIMEType = [cache objectForKey:pathExtension];
+    if (cachedMIMEType) {
+        return (cachedMIMEType != [NSNull null]) ? cachedMIMEType : nil;
+    }
+    
     CFStringRef identifier = UTTypeCreatePreferredIdentifierForTag(kUTTagClassFilenameExtension, (__bridge CFStringRef)pathExtension, NULL);
     if (! identifier) {
         return nil;
@@ -125,7 +186,74 @@ static NSString* digest(NSString *string, unsigned char *(*cc_digest)(const void
     
     NSString *MIMEType = (NSString *)CFBridgingRelease(UTTypeCopyPreferredTagWithClass(identifier, kUTTagClassMIMEType));
     CFRelease(identifier);
+    
+    [cache setObject:MIMEType ?: [NSNull null] forKey:pathExtension];
     return MIMEType;
 }
 
 @end
+
+#pragma mark Static functions
+
+// NSCache is thread-safe
+static NSCache *MIMETypeCache(void)
+{
+    static NSCache *s_cache = nil;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        s_cache = [[NSCache alloc] init];
+        s_cache.name = @"ch.defagos.CoconutKit.MIMETypeCache";
+    });
+    return s_cache;
+}
+
+// Same result as -urlEncodedStringUsingEncoding: (only RFC 3986 unreserved characters are left as is), but using
+// the supplied buffers to avoid allocations. Return nil if the string cannot be represented with the encoding
+static NSString *percentEncodedString(NSString *string, NSStringEncoding encoding, NSMutableData *bytesBuffer, NSMutableData *encodedBytesBuffer)
+{
+    static const char kHexadecimalDigits[] = "0123456789ABCDEF";
+    
+    NSUInteger maximumLength = [string maximumLengthOfBytesUsingEncoding:encoding];
+    if ([bytesBuffer length] < maximumLength) {
+        [bytesBuffer setLength:maximumLength];
+    }
+    
+    NSUInteger length = 0;
+    NSRange remainingRange = NSMakeRange(0, 0);
+    if (! [string getBytes:[bytesBuffer mutableBytes]
+                 maxLength:maximumLength
+                usedLength:&length
+                  encoding:encoding
+                   options:0
+                     range:NSMakeRange(0, [string length])
+            remainingRange:&remainingRange] && [string length] != 0) {
+        return nil;
+    }
+    
+    if (remainingRange.length != 0) {
+        return nil;
+    }
+    
+    // Each byte is encoded with at most 3 characters
+    if ([encodedBytesBuffer length] < 3 * length) {
+        [encodedBytesBuffer setLength:3 * length];
+    }
+    
+    const unsigned char *bytes = [bytesBuffer bytes];
+    char *encodedBytes = [encodedBytesBuffer mutableBytes];
+    NSUInteger encodedLength = 0;
+    for (NSUInteger i = 0; i < length; ++i) {
+        unsigned char byte = bytes[i];
+        if ((byte >= 'a' && byte <= 'z') || (byte >= 'A' && byte <= 'Z') || (byte >= '0' && byte <= '9')
+                || byte == '-' || byte == '.' || byte == '_' || byte == '~') {
+            encodedBytes[encodedLength++] = (char)byte;
+        }
+        else {
+            encodedBytes[encodedLength++] = '%';
+            encodedBytes[encodedLength++] = kHexadecimalDigits[byte >> 4];
+            encodedBytes[encodedLength++] = kHexadecimalDigits[byte & 0x0F];
+        }
+    }
+    
+    return [[NSString alloc] initWithBytes:encodedBytes length:encodedLength encoding:NSASCIIStringEncoding];
+}
@@ -19,7 +19,9 @@ static id swizzle_initWithURL_cachePolicy_timeoutInterval(NSURLRequest *self, SE
 
 + (void)load
 {
+    HLSSwizzleGroup_Begin
     HLSSwizzleSelector(self, @selector(initWithURL:cachePolicy:timeoutInterval:), swizzle_initWithURL_cachePolicy_timeoutInterval, &s_initWithURL_cachePolicy_timeoutInterval);
+    HLSSwizzleGroup_End
 }
 
 @end
@@ -12,7 +12,7 @@
 /**
  * Call this method from your application delegate implementation, when your application has been started (in general
  * in -application:didFinishLaunchingWithOptions:), to preload elements at the expense of memory (for the moment,
- * only UIWebView preloading is made)
+ * only web views are preloaded, see HLSWebViewPool)
  */
 - (void)preload;
 
@@ -121,6 +121,7 @@ static void setColorFormat(UIView *self, SEL _cmd, NSString *colorFormat);
 
 + (void)load
 {
+    HLSSwizzleGroup_Begin
     // Inject KVC-compliant color setter methods on all UIView subclasses
     unsigned int numberOfClasses = 0;
     Class *classes = objc_copyClassList(&numberOfClasses);
@@ -148,11 +149,12 @@ static void setColorFormat(UIView *self, SEL _cmd, NSString *colorFormat);
             }
             
             SEL colorSetterSelector = NSSelectorFromString([methodName stringByReplacingOccurrencesOfString:@":" withString:@"Name:"]);
-            class_addMethod(class, colorSetterSelector, (IMP)setColorFormat, "v@:@");
+            hls_class_addMethod(class, colorSetterSelector, (IMP)setColorFormat, "v@:@");
         }
         free(methods);
     }
     free(classes);
+    HLSSwizzleGroup_End
 }
 
 @end
@@ -7,6 +7,26 @@
 #import <Foundation/Foundation.h>
 #import <UIKit/UIKit.h>
 
+/**
+ * Font registration status
+ */
+typedef NS_ENUM(NSInteger, HLSFontRegistrationStatus) {
+    HLSFontRegistrationStatusEnumBegin = 0,
+    HLSFontRegistrationStatusDeclared = HLSFontRegistrationStatusEnumBegin,     // Declared, but not registered yet
+    HLSFontRegistrationStatusRegistered,                                        // Registered (possibly by another declaration)
+    HLSFontRegistrationStatusFailed,                                            // Registration failed
+    HLSFontRegistrationStatusEnumEnd,
+    HLSFontRegistrationStatusEnumSize = HLSFontRegistrationStatusEnumEnd - HLSFontRegistrationStatusEnumBegin
+};
+
+/**
+ * Keys of the dictionaries returned by +fontRegistryEntries
+ */
+OBJC_EXPORT NSString * const HLSFontNameKey;                            // PostScript name of the font (NSString)
+OBJC_EXPORT NSString * const HLSFontFilePathKey;                        // Path of the font file (NSString)
+OBJC_EXPORT NSString * const HLSFontRegistrationStatusKey;              // Registration status (NSNumber wrapping an HLSFontRegistrationStatus)
+OBJC_EXPORT NSString * const HLSFontRegistrationDurationKey;            // Time spent registering the font, in seconds (NSNumber)
+
 @interface UIFont (HLSExtensions)
 
 /**
@@ -27,4 +47,36 @@
  */
 + (BOOL)loadFontWithData:(NSData *)data;
 
+/**
+ * Loading all fonts an application needs during launch can be expensive. Instead, fonts can be declared up front
+ * and registered when they are first needed. A declared font is registered when +fontWithName:size: is first called
+ * with its PostScript name, or when +registerDeclaredFontsInBackgroundWithCompletionBlock: is called, whichever
+ * comes first. Fonts are registered once, even if declared or loaded several times, and their files are memory-mapped
+ * rather than read into memory (this also applies to +loadFontWithFileName:inBundle:)
+ *
+ * Fonts are only registered lazily when created with +fontWithName:size:. If a declared font is used in a nib or
+ * storyboard, or created using font descriptors, register it eagerly first
+ *
+ * The font name is the PostScript name of the font, the file name must include the extension. If the bundle 
+ * parameter is nil, lookup is performed in the main bundle
+ */
++ (void)declareFontWithName:(NSString *)fontName fileName:(NSString *)fileName inBundle:(NSBundle *)bundle;
+
+/**
+ * Register all declared fonts which have not been registered yet on a background queue. The completion block, if 
+ * any, is called on the main thread when done
+ */
++ (void)registerDeclaredFontsInBackgroundWithCompletionBlock:(void (^)(void))completionBlock;
+
+/**
+ * Return the registration status of a declared or loaded font, HLSFontRegistrationStatusEnumEnd if unknown
+ */
++ (HLSFontRegistrationStatus)registrationStatusForFontWithName:(NSString *)fontName;
+
+/**
+ * Return information about all fonts declared or loaded from files (see keys above), in the order they were declared
+ * or loaded
+ */
++ (NSArray *)fontRegistryEntries;
+
 @end
@@ -7,11 +7,73 @@
 #import "UIFont+HLSExtensions.h"
 
 #import "HLSLogger.h"
+#import "HLSRuntime.h"
 
 #import <CoreText/CoreText.h>
+#import <pthread.h>
+
+NSString * const HLSFontNameKey = @"HLSFontName";
+NSString * const HLSFontFilePathKey = @"HLSFontFilePath";
+NSString * const HLSFontRegistrationStatusKey = @"HLSFontRegistrationStatus";
+NSString * const HLSFontRegistrationDurationKey = @"HLSFontRegistrationDuration";
+
+// Font registry. All accesses must be made on the font registry queue, except for the names of the declared fonts
+// which have not been registered yet. Those are protected by a lock so that they can be quickly checked from any
+// thread, without waiting for registrations in progress on the queue
+static NSMutableArray *s_fontRegistryEntries = nil;
+static NSMutableDictionary *s_fontNameToFontRegistryEntryMap = nil;
+static NSMutableSet *s_registeredFontNames = nil;
+static NSMutableSet *s_pendingFontNames = nil;
+static pthread_mutex_t s_pendingFontNamesMutex = PTHREAD_MUTEX_INITIALIZER;
+
+// Original implementation of the methods we swizzle
+static id (*s_fontWithName_size)(id, SEL, id, CGFloat) = NULL;
+
+// Swizzled method implementations
+static id swizzle_fontWithName_size(Class self, SEL _cmd, NSString *fontName, CGFloat fontSize);
+
+// Function declarations
+static dispatch_queue_t fontRegistryQueue(void);
+static NSData *mappedFontData(NSString *filePath);
+static BOOL registerFontData(NSData *data, NSString **pFontName);
+static BOOL isPendingFontName(NSString *fontName);
+static void setPendingFontName(NSString *fontName, BOOL pending);
+
+#pragma mark -
+#pragma mark HLSFontRegistryEntry class interface
+
+/**
+ * A font declared or loaded through the registry
+ */
+@interface HLSFontRegistryEntry : NSObject
+
+- (instancetype)initWithFontName:(NSString *)fontName filePath:(NSString *)filePath;
+
+@property (nonatomic, strong) NSString *fontName;
+@property (nonatomic, readonly, strong) NSString *filePath;
+@property (nonatomic, assign) HLSFontRegistrationStatus status;
+@property (nonatomic, assign) CFTimeInterval duration;
+
+- (void)registerFont;
+
+- (NSDictionary *)dictionary;
+
+@end
+
+#pragma mark -
+#pragma mark UIFont (HLSExtensions) implementation
 
 @implementation UIFont (HLSExtensions)
 
+#pragma mark Class methods
+
++ (void)load
+{
+    HLSSwizzleGroup_Begin
+    HLSSwizzleClassSelector(self, @selector(fontWithName:size:), swizzle_fontWithName_size, &s_fontWithName_size);
+    HLSSwizzleGroup_End
+}
+
 + (BOOL)loadFontWithFileName:(NSString *)fileName inBundle:(NSBundle *)bundle
 {
     if (! bundle) {
@@ -20,12 +82,256 @@
     
     NSString *fontFilePath = [bundle pathForResource:[fileName stringByDeletingPathExtension]
                                               ofType:[fileName pathExtension]];
-    NSData *fontData = [NSData dataWithContentsOfFile:fontFilePath];
-    return [self loadFontWithData:fontData];
+    if (! fontFilePath) {
+        HLSLoggerError(@"The font file %@ could not be found", fileName);
+        return NO;
+    }
+    
+    __block BOOL result = NO;
+    dispatch_sync(fontRegistryQueue(), ^{
+        HLSFontRegistryEntry *fontRegistryEntry = [[s_fontRegistryEntries filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"filePath == %@", fontFilePath]] firstObject];
+        if (! fontRegistryEntry) {
+            fontRegistryEntry = [[HLSFontRegistryEntry alloc] initWithFontName:nil filePath:fontFilePath];
+            [s_fontRegistryEntries addObject:fontRegistryEntry];
+        }
+        
+        if (fontRegistryEntry.status != HLSFontRegistrationStatusRegistered) {
+            [fontRegistryEntry registerFont];
+        }
+        result = (fontRegistryEntry.status == HLSFontRegistrationStatusRegistered);
+    });
+    return result;
 }
 
 + (BOOL)loadFontWithData:(NSData *)data
 {
+    __block BOOL result = NO;
+    dispatch_sync(fontRegistryQueue(), ^{
+        result = registerFontData(data, NULL);
+    });
+    return result;
+}
+
++ (void)declareFontWithName:(NSString *)fontName fileName:(NSString *)fileName inBundle:(NSBundle *)bundle
+{
+    NSParameterAssert(fontName);
+    NSParameterAssert(fileName);
+    
+    if (! bundle) {
+        bundle = [NSBundle mainBundle];
+    }
+    
+    NSString *fontFilePath = [bundle pathForResource:[fileName stringByDeletingPathExtension]
+                                              ofType:[fileName pathExtension]];
+    if (! fontFilePath) {
+        HLSLoggerError(@"The font file %@ could not be found", fileName);
+        return;
+    }
+    
+    dispatch_sync(fontRegistryQueue(), ^{
+        if ([s_fontNameToFontRegistryEntryMap objectForKey:fontName]) {
+            HLSLoggerWarn(@"The font %@ has already been declared", fontName);
+            return;
+        }
+        
+        HLSFontRegistryEntry *fontRegistryEntry = [[HLSFontRegistryEntry alloc] initWithFontName:fontName filePath:fontFilePath];
+        [s_fontRegistryEntries addObject:fontRegistryEntry];
+        [s_fontNameToFontRegistryEntryMap setObject:fontRegistryEntry forKey:fontName];
+        
+        // Already registered by other means, e.g. using +loadFontWithFileName:inBundle:
+        if ([s_registeredFontNames containsObject:fontName]) {
+            fontRegistryEntry.status = HLSFontRegistrationStatusRegistered;
+        }
+        else {
+            setPendingFontName(fontName, YES);
+        }
+    });
+}
+
++ (void)registerDeclaredFontsInBackgroundWithCompletionBlock:(void (^)(void))completionBlock
+{
+    dispatch_queue_t queue = fontRegistryQueue();
+    dispatch_async(queue, ^{
+        // One block per font, so that lazy registrations requested in the meantime (which need to wait on the queue)
+        // do not have to wait until all fonts have been registered
+        for (HLSFontRegistryEntry *fontRegistryEntry in s_fontRegistryEntries) {
+            if (fontRegistryEntry.status != HLSFontRegistrationStatusDeclared) {
+                continue;
+            }
+            
+            dispatch_async(queue, ^{
+                if (fontRegistryEntry.status == HLSFontRegistrationStatusDeclared) {
+                    [fontRegistryEntry registerFont];
+                }
+            });
+        }
+        
+        // Called after all blocks above have been executed (serial queue)
+        dispatch_async(queue, ^{
+            if (completionBlock) {
+                dispatch_async(dispatch_get_main_queue(), completionBlock);
+            }
+        });
+    });
+}
+
++ (HLSFontRegistrationStatus)registrationStatusForFontWithName:(NSString *)fontName
+{
+    __block HLSFontRegistrationStatus status = HLSFontRegistrationStatusEnumEnd;
+    dispatch_sync(fontRegistryQueue(), ^{
+        HLSFontRegistryEntry *fontRegistryEntry = [s_fontNameToFontRegistryEntryMap objectForKey:fontName];
+        if (fontRegistryEntry) {
+            status = fontRegistryEntry.status;
+        }
+        else if ([s_registeredFontNames containsObject:fontName]) {
+            status = HLSFontRegistrationStatusRegistered;
+        }
+    });
+    return status;
+}
+
++ (NSArray *)fontRegistryEntries
+{
+    NSMutableArray *fontRegistryEntries = [NSMutableArray array];
+    dispatch_sync(fontRegistryQueue(), ^{
+        for (HLSFontRegistryEntry *fontRegistryEntry in s_fontRegistryEntries) {
+            [fontRegistryEntries addObject:[fontRegistryEntry dictionary]];
+        }
+    });
+    return [NSArray arrayWithArray:fontRegistryEntries];
+}
+
+@end
+
+#pragma mark -
+#pragma mark HLSFontRegistryEntry class implementation
+
+@implementation HLSFontRegistryEntry
+
+#pragma mark Object creation and destruction
+
+- (instancetype)initWithFontName:(NSString *)fontName filePath:(NSString *)filePath
+{
+    if (self = [super init]) {
+        self.fontName = fontName;
+        _filePath = filePath;
+        self.status = HLSFontRegistrationStatusDeclared;
+    }
+    return self;
+}
+
+#pragma mark Registration
+
+// Must be called on the font registry queue
+- (void)registerFont
+{
+    HLSFontRegistrationStatus previousStatus = self.status;
+    
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    NSString *fontName = nil;
+    BOOL registered = registerFontData(mappedFontData(self.filePath), &fontName);
+    self.duration = CFAbsoluteTimeGetCurrent() - startTime;
+    
+    if (self.fontName && fontName && ! [self.fontName isEqualToString:fontName]) {
+        HLSLoggerWarn(@"The font %@ has been declared with the incorrect name %@", fontName, self.fontName);
+    }
+    else if (! self.fontName) {
+        self.fontName = fontName;
+    }
+    
+    self.status = registered ? HLSFontRegistrationStatusRegistered : HLSFontRegistrationStatusFailed;
+    
+    if (previousStatus == HLSFontRegistrationStatusDeclared && [s_fontNameToFontRegistryEntryMap objectForKey:self.fontName] == self) {
+        setPendingFontName(self.fontName, NO);
+    }
+}
+
+#pragma mark Information
+
+- (NSDictionary *)dictionary
+{
+    NSMutableDictionary *dictionary = [NSMutableDictionary dictionary];
+    if (self.fontName) {
+        [dictionary setObject:self.fontName forKey:HLSFontNameKey];
+    }
+    [dictionary setObject:self.filePath forKey:HLSFontFilePathKey];
+    [dictionary setObject:@(self.status) forKey:HLSFontRegistrationStatusKey];
+    [dictionary setObject:@(self.duration) forKey:HLSFontRegistrationDurationKey];
+    return [NSDictionary dictionaryWithDictionary:dictionary];
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; fontName: %@; filePath: %@; status: %@; duration: %.3f>",
+            [self class],
+            self,
+            self.fontName,
+            self.filePath,
+            @(self.status),
+            self.duration];
+}
+
+@end
+
+#pragma mark Swizzled method implementations
+
+static id swizzle_fontWithName_size(Class self, SEL _cmd, NSString *fontName, CGFloat fontSize)
+{
+    HLSSwizzleCountCall(&s_fontWithName_size);
+    
+    // Register declared fonts when first used. Only wait on the registry queue if the font actually needs to be registered
+    if (fontName && isPendingFontName(fontName)) {
+        dispatch_sync(fontRegistryQueue(), ^{
+            HLSFontRegistryEntry *fontRegistryEntry = [s_fontNameToFontRegistryEntryMap objectForKey:fontName];
+            if (fontRegistryEntry.status == HLSFontRegistrationStatusDeclared) {
+                [fontRegistryEntry registerFont];
+            }
+        });
+    }
+    
+    return s_fontWithName_size(self, _cmd, fontName, fontSize);
+}
+
+#pragma mark Static functions
+
+static dispatch_queue_t fontRegistryQueue(void)
+{
+    static dispatch_queue_t s_queue;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        s_queue = dispatch_queue_create("ch.defagos.CoconutKit.fontRegistry", DISPATCH_QUEUE_SERIAL);
+        
+        s_fontRegistryEntries = [NSMutableArray array];
+        s_fontNameToFontRegistryEntryMap = [NSMutableDictionary dictionary];
+        s_registeredFontNames = [NSMutableSet set];
+        
+        pthread_mutex_lock(&s_pendingFontNamesMutex);
+        s_pendingFontNames = [NSMutableSet set];
+        pthread_mutex_unlock(&s_pendingFontNamesMutex);
+    });
+    return s_queue;
+}
+
+// Font files are mapped into memory rather than copied
+static NSData *mappedFontData(NSString *filePath)
+{
+    NSError *error = nil;
+    NSData *data = [NSData dataWithContentsOfFile:filePath options:NSDataReadingMappedIfSafe error:&error];
+    if (! data) {
+        HLSLoggerError(@"Could not read font file %@. Reason: %@", filePath, error);
+    }
+    return data;
+}
+
+// Must be called on the font registry queue. Fonts which have already been registered are not registered again
+static BOOL registerFontData(NSData *data, NSString **pFontName)
+{
+    if (! data) {
+        return NO;
+    }
+    
     // See http://www.marco.org/2012/12/21/ios-dynamic-font-loading
     CGDataProviderRef providerRef = CGDataProviderCreateWithCFData((__bridge CFDataRef)data);
     CGFontRef fontRef = CGFontCreateWithDataProvider(providerRef);
@@ -35,15 +341,30 @@
         return NO;
     }
     
+    NSString *fontName = CFBridgingRelease(CGFontCopyPostScriptName(fontRef));
+    if (pFontName) {
+        *pFontName = fontName;
+    }
+    
     BOOL result = YES;
     
-    CFErrorRef errorRef = NULL;
-    if (! CTFontManagerRegisterGraphicsFont(fontRef, &errorRef)) {
-        CFStringRef errorDescriptionStringRef = CFErrorCopyDescription(errorRef);
-        HLSLoggerError(@"Failed to register font, reason: %@", errorDescriptionStringRef);
-        CFRelease(errorDescriptionStringRef);
-        CFRelease(errorRef);
-        result = NO;
+    if (fontName && [s_registeredFontNames containsObject:fontName]) {
+        HLSLoggerDebug(@"The font %@ has already been registered", fontName);
+    }
+    else {
+        CFErrorRef errorRef = NULL;
+        if (CTFontManagerRegisterGraphicsFont(fontRef, &errorRef)) {
+            if (fontName) {
+                [s_registeredFontNames addObject:fontName];
+            }
+        }
+        else {
+            CFStringRef errorDescriptionStringRef = CFErrorCopyDescription(errorRef);
+            HLSLoggerError(@"Failed to register font, reason: %@", errorDescriptionStringRef);
+            CFRelease(errorDescriptionStringRef);
+            CFRelease(errorRef);
+            result = NO;
+        }
     }
     
     CFRelease(fontRef);
@@ -51,4 +372,22 @@
     return result;
 }
 
-@end
+static BOOL isPendingFontName(NSString *fontName)
+{
+    pthread_mutex_lock(&s_pendingFontNamesMutex);
+    BOOL pending = [s_pendingFontNames containsObject:fontName];
+    pthread_mutex_unlock(&s_pendingFontNamesMutex);
+    return pending;
+}
+
+static void setPendingFontName(NSString *fontName, BOOL pending)
+{
+    pthread_mutex_lock(&s_pendingFontNamesMutex);
+    if (pending) {
+        [s_pendingFontNames addObject:fontName];
+    }
+    else {
+        [s_pendingFontNames removeObject:fontName];
+    }
+    pthread_mutex_unlock(&s_pendingFontNamesMutex);
+}
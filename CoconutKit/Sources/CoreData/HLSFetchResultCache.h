@@ -0,0 +1,84 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import <CoreData/CoreData.h>
+#import <Foundation/Foundation.h>
+
+/**
+ * Screens often fetch the same objects over and over, e.g. each time bindings are refreshed or a table view is
+ * reloaded. A fetch result cache stores fetch results for a managed object context, keyed by entity, predicate and
+ * sort descriptors, so that identical fetches only hit the persistent store once. Cached results are discarded
+ * when the context reports changes (NSManagedObjectContextObjectsDidChangeNotification) for an entity a fetch depends
+ * on, i.e. the fetched entity and the entities reached through relationships in its predicate or sort descriptors.
+ * Changes made to other entities leave cached results untouched
+ *
+ * Fetch result caches are opt-in and attached to a managed object context. Once enabled for a context, the fetch
+ * methods of NSManagedObject (HLSExtensions) use it transparently. Only plain object fetches are cached, fetch requests
+ * with limits, offsets, batch sizes or other result types are always forwarded to the context. Changes saved to the
+ * persistent store by other contexts are only seen once they have been merged into the context (which is the usual
+ * way of propagating changes between contexts anyway)
+ *
+ * A cache is bound to its context and must only be used from the thread or queue of this context
+ */
+@interface HLSFetchResultCache : NSObject
+
+/**
+ * Enable a fetch result cache for the specified context (if not already enabled), and return it
+ */
++ (instancetype)enableFetchResultCacheForManagedObjectContext:(NSManagedObjectContext *)managedObjectContext;
+
+/**
+ * Discard the fetch result cache associated with a context, if any
+ */
++ (void)disableFetchResultCacheForManagedObjectContext:(NSManagedObjectContext *)managedObjectContext;
+
+/**
+ * Return the fetch result cache associated with a context, nil if none
+ */
++ (instancetype)fetchResultCacheForManagedObjectContext:(NSManagedObjectContext *)managedObjectContext;
+
+/**
+ * The context the cache is associated with
+ */
+@property (nonatomic, readonly, weak) NSManagedObjectContext *managedObjectContext;
+
+/**
+ * The maximum number of fetch results kept in the cache. When the limit is reached, the least recently used
+ * results are discarded first
+ *
+ * Default value is 100
+ */
+@property (nonatomic, assign) NSUInteger countLimit;
+
+/**
+ * The number of fetch results currently in the cache
+ */
+@property (nonatomic, readonly, assign) NSUInteger count;
+
+/**
+ * Same as -[NSManagedObjectContext executeFetchRequest:error:], but cached when possible
+ */
+- (NSArray *)executeFetchRequest:(NSFetchRequest *)fetchRequest error:(NSError *__autoreleasing *)pError;
+
+/**
+ * Discard all fetch results, and reset statistics
+ */
+- (void)removeAllFetchResults;
+
+/**
+ * Number of cache lookups which succeeded or failed, and number of fetch results discarded because of changes
+ */
+@property (nonatomic, readonly, assign) NSUInteger hitCount;
+@property (nonatomic, readonly, assign) NSUInteger missCount;
+@property (nonatomic, readonly, assign) NSUInteger invalidationCount;
+
+@end
+
+@interface HLSFetchResultCache (UnavailableMethods)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
@@ -0,0 +1,474 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import "HLSFetchResultCache.h"
+
+#import "HLSRuntime.h"
+
+static const NSUInteger HLSFetchResultCacheDefaultCountLimit = 100;
+
+static void *s_fetchResultCacheKey = &s_fetchResultCacheKey;
+
+// Function declarations
+static BOOL collectKeyPathsFromPredicate(NSPredicate *predicate, NSMutableSet *keyPaths);
+static BOOL collectKeyPathsFromExpression(NSExpression *expression, NSMutableSet *keyPaths);
+static NSSet *dependentEntityNames(NSEntityDescription *entity, NSPredicate *predicate, NSArray *sortDescriptors);
+static NSSet *changedEntityNames(NSDictionary *userInfo);
+
+#pragma mark -
+#pragma mark HLSFetchResultKey class interface
+
+/**
+ * Identifies a fetch
+ */
+@interface HLSFetchResultKey : NSObject <NSCopying>
+
+- (instancetype)initWithEntityName:(NSString *)entityName predicate:(NSPredicate *)predicate sortDescriptors:(NSArray *)sortDescriptors;
+
+@property (nonatomic, readonly, strong) NSString *entityName;
+@property (nonatomic, readonly, strong) NSPredicate *predicate;
+@property (nonatomic, readonly, strong) NSArray *sortDescriptors;
+
+@end
+
+#pragma mark -
+#pragma mark HLSFetchResultEntry class interface
+
+/**
+ * A cached fetch result, with the names of the entities whose changes make it stale. If nil, the dependencies
+ * could not be determined and the result is discarded on any change
+ */
+@interface HLSFetchResultEntry : NSObject
+
+- (instancetype)initWithObjects:(NSArray *)objects dependentEntityNames:(NSSet *)dependentEntityNames;
+
+@property (nonatomic, readonly, strong) NSArray *objects;
+@property (nonatomic, readonly, strong) NSSet *dependentEntityNames;
+
+@end
+
+#pragma mark -
+#pragma mark HLSFetchResultCache class implementation
+
+@interface HLSFetchResultCache ()
+
+@property (nonatomic, weak) NSManagedObjectContext *managedObjectContext;
+
+@property (nonatomic, strong) NSMutableDictionary *keyToEntryMap;
+@property (nonatomic, strong) NSMutableOrderedSet *keys;                    // Least recently used first
+
+@property (nonatomic, assign) NSUInteger hitCount;
+@property (nonatomic, assign) NSUInteger missCount;
+@property (nonatomic, assign) NSUInteger invalidationCount;
+
+@end
+
+@implementation HLSFetchResultCache
+
+#pragma mark Class methods
+
++ (instancetype)enableFetchResultCacheForManagedObjectContext:(NSManagedObjectContext *)managedObjectContext
+{
+    NSParameterAssert(managedObjectContext);
+    
+    HLSFetchResultCache *fetchResultCache = [self fetchResultCacheForManagedObjectContext:managedObjectContext];
+    if (! fetchResultCache) {
+        fetchResultCache = [[HLSFetchResultCache alloc] initWithManagedObjectContext:managedObjectContext];
+        hls_setAssociatedObject(managedObjectContext, s_fetchResultCacheKey, fetchResultCache, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    }
+    return fetchResultCache;
+}
+
++ (void)disableFetchResultCacheForManagedObjectContext:(NSManagedObjectContext *)managedObjectContext
+{
+    hls_setAssociatedObject(managedObjectContext, s_fetchResultCacheKey, nil, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+}
+
++ (instancetype)fetchResultCacheForManagedObjectContext:(NSManagedObjectContext *)managedObjectContext
+{
+    if (! managedObjectContext) {
+        return nil;
+    }
+    
+    return hls_getAssociatedObject(managedObjectContext, s_fetchResultCacheKey);
+}
+
+#pragma mark Object creation and destruction
+
+- (instancetype)initWithManagedObjectContext:(NSManagedObjectContext *)managedObjectContext
+{
+    if (self = [super init]) {
+        self.managedObjectContext = managedObjectContext;
+        self.keyToEntryMap = [NSMutableDictionary dictionary];
+        self.keys = [NSMutableOrderedSet orderedSet];
+        self.countLimit = HLSFetchResultCacheDefaultCountLimit;
+        
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(managedObjectContextObjectsDidChange:)
+                                                     name:NSManagedObjectContextObjectsDidChangeNotification
+                                                   object:managedObjectContext];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+#pragma mark Accessors and mutators
+
+- (void)setCountLimit:(NSUInteger)countLimit
+{
+    _countLimit = countLimit;
+    [self evictFetchResults];
+}
+
+- (NSUInteger)count
+{
+    return [self.keys count];
+}
+
+#pragma mark Fetching
+
+- (NSArray *)executeFetchRequest:(NSFetchRequest *)fetchRequest error:(NSError *__autoreleasing *)pError
+{
+    NSManagedObjectContext *managedObjectContext = self.managedObjectContext;
+    if (! [self isFetchRequestCacheable:fetchRequest]) {
+        return [managedObjectContext executeFetchRequest:fetchRequest error:pError];
+    }
+    
+    // A fetch would process pending changes first. Do the same so that stale results are discarded before the lookup
+    [managedObjectContext processPendingChanges];
+    
+    HLSFetchResultKey *key = [[HLSFetchResultKey alloc] initWithEntityName:fetchRequest.entity.name ?: fetchRequest.entityName
+                                                                 predicate:fetchRequest.predicate
+                                                           sortDescriptors:fetchRequest.sortDescriptors];
+    HLSFetchResultEntry *entry = [self.keyToEntryMap objectForKey:key];
+    if (entry) {
+        ++self.hitCount;
+        
+        [self.keys removeObject:key];
+        [self.keys addObject:key];
+        return entry.objects;
+    }
+    
+    ++self.missCount;
+    
+    NSArray *objects = [managedObjectContext executeFetchRequest:fetchRequest error:pError];
+    if (! objects || self.countLimit == 0) {
+        return objects;
+    }
+    
+    NSEntityDescription *entity = fetchRequest.entity ?: [NSEntityDescription entityForName:fetchRequest.entityName
+                                                                      inManagedObjectContext:managedObjectContext];
+    entry = [[HLSFetchResultEntry alloc] initWithObjects:objects
+                                    dependentEntityNames:dependentEntityNames(entity, fetchRequest.predicate, fetchRequest.sortDescriptors)];
+    [self.keyToEntryMap setObject:entry forKey:key];
+    [self.keys addObject:key];
+    [self evictFetchResults];
+    
+    return objects;
+}
+
+- (BOOL)isFetchRequestCacheable:(NSFetchRequest *)fetchRequest
+{
+    return fetchRequest.resultType == NSManagedObjectResultType
+        && (fetchRequest.entity || fetchRequest.entityName)
+        && fetchRequest.fetchLimit == 0
+        && fetchRequest.fetchOffset == 0
+        && fetchRequest.fetchBatchSize == 0
+        && fetchRequest.includesPendingChanges
+        && fetchRequest.includesSubentities
+        && ! fetchRequest.propertiesToFetch
+        && ! fetchRequest.affectedStores
+        && ! fetchRequest.returnsDistinctResults;
+}
+
+#pragma mark Removing fetch results
+
+- (void)evictFetchResults
+{
+    while ([self.keys count] > self.countLimit) {
+        HLSFetchResultKey *key = [self.keys firstObject];
+        [self.keyToEntryMap removeObjectForKey:key];
+        [self.keys removeObjectAtIndex:0];
+    }
+}
+
+- (void)removeAllFetchResults
+{
+    [self.keyToEntryMap removeAllObjects];
+    [self.keys removeAllObjects];
+    
+    self.hitCount = 0;
+    self.missCount = 0;
+    self.invalidationCount = 0;
+}
+
+#pragma mark Notifications
+
+- (void)managedObjectContextObjectsDidChange:(NSNotification *)notification
+{
+    if ([self.keys count] == 0) {
+        return;
+    }
+    
+    BOOL allObjectsInvalidated = [notification.userInfo objectForKey:NSInvalidatedAllObjectsKey] != nil;
+    NSSet *entityNames = changedEntityNames(notification.userInfo);
+    if (! allObjectsInvalidated && [entityNames count] == 0) {
+        return;
+    }
+    
+    for (HLSFetchResultKey *key in [self.keys array]) {
+        HLSFetchResultEntry *entry = [self.keyToEntryMap objectForKey:key];
+        if (allObjectsInvalidated || ! entry.dependentEntityNames || [entry.dependentEntityNames intersectsSet:entityNames]) {
+            [self.keyToEntryMap removeObjectForKey:key];
+            [self.keys removeObject:key];
+            ++self.invalidationCount;
+        }
+    }
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; count: %@; hitCount: %@; missCount: %@; invalidationCount: %@>",
+            [self class],
+            self,
+            @([self count]),
+            @(self.hitCount),
+            @(self.missCount),
+            @(self.invalidationCount)];
+}
+
+@end
+
+#pragma mark -
+#pragma mark HLSFetchResultKey class implementation
+
+@implementation HLSFetchResultKey {
+@private
+    NSUInteger _hash;
+}
+
+#pragma mark Object creation and destruction
+
+- (instancetype)initWithEntityName:(NSString *)entityName predicate:(NSPredicate *)predicate sortDescriptors:(NSArray *)sortDescriptors
+{
+    if (self = [super init]) {
+        _entityName = [entityName copy];
+        _predicate = [predicate copy];
+        _sortDescriptors = [sortDescriptors copy];
+        
+        // Arrays only hash their count, include the first sort descriptor
+        _hash = [_entityName hash] ^ ([_predicate hash] << 1) ^ ([[_sortDescriptors firstObject] hash] << 2) ^ [_sortDescriptors count];
+    }
+    return self;
+}
+
+#pragma mark NSCopying protocol implementation
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    // Immutable
+    return self;
+}
+
+#pragma mark Equality
+
+- (BOOL)isEqual:(id)object
+{
+    if (self == object) {
+        return YES;
+    }
+    
+    if (! [object isKindOfClass:[HLSFetchResultKey class]]) {
+        return NO;
+    }
+    
+    HLSFetchResultKey *otherKey = object;
+    return _hash == otherKey->_hash
+        && [self.entityName isEqualToString:otherKey.entityName]
+        && (self.predicate == otherKey.predicate || [self.predicate isEqual:otherKey.predicate])
+        && (self.sortDescriptors == otherKey.sortDescriptors || [self.sortDescriptors isEqualToArray:otherKey.sortDescriptors]);
+}
+
+- (NSUInteger)hash
+{
+    return _hash;
+}
+
+@end
+
+#pragma mark -
+#pragma mark HLSFetchResultEntry class implementation
+
+@implementation HLSFetchResultEntry
+
+#pragma mark Object creation and destruction
+
+- (instancetype)initWithObjects:(NSArray *)objects dependentEntityNames:(NSSet *)dependentEntityNames
+{
+    if (self = [super init]) {
+        _objects = objects;
+        _dependentEntityNames = dependentEntityNames;
+    }
+    return self;
+}
+
+@end
+
+#pragma mark Static functions
+
+/**
+ * Add the key paths appearing in a predicate to the given set. Return NO if the predicate contains constructs whose
+ * key paths cannot be determined (subqueries, block predicates, etc.)
+ */
+static BOOL collectKeyPathsFromPredicate(NSPredicate *predicate, NSMutableSet *keyPaths)
+{
+    if (! predicate) {
+        return YES;
+    }
+    
+    if ([predicate isKindOfClass:[NSCompoundPredicate class]]) {
+        NSCompoundPredicate *compoundPredicate = (NSCompoundPredicate *)predicate;
+        for (NSPredicate *subpredicate in compoundPredicate.subpredicates) {
+            if (! collectKeyPathsFromPredicate(subpredicate, keyPaths)) {
+                return NO;
+            }
+        }
+        return YES;
+    }
+    else if ([predicate isKindOfClass:[NSComparisonPredicate class]]) {
+        NSComparisonPredicate *comparisonPredicate = (NSComparisonPredicate *)predicate;
+        return collectKeyPathsFromExpression(comparisonPredicate.leftExpression, keyPaths)
+            && collectKeyPathsFromExpression(comparisonPredicate.rightExpression, keyPaths);
+    }
+    else {
+        return NO;
+    }
+}
+
+static BOOL collectKeyPathsFromExpression(NSExpression *expression, NSMutableSet *keyPaths)
+{
+    switch (expression.expressionType) {
+        case NSConstantValueExpressionType:
+        case NSEvaluatedObjectExpressionType:
+        case NSVariableExpressionType: {
+            return YES;
+            break;
+        }
+        
+        case NSKeyPathExpressionType: {
+            [keyPaths addObject:expression.keyPath];
+            return YES;
+            break;
+        }
+        
+        case NSFunctionExpressionType: {
+            if (! collectKeyPathsFromExpression(expression.operand, keyPaths)) {
+                return NO;
+            }
+            for (NSExpression *argument in expression.arguments) {
+                if (! collectKeyPathsFromExpression(argument, keyPaths)) {
+                    return NO;
+                }
+            }
+            return YES;
+            break;
+        }
+        
+        case NSAggregateExpressionType: {
+            id collection = expression.collection;
+            if (! [collection isKindOfClass:[NSArray class]]) {
+                return NO;
+            }
+            for (id element in collection) {
+                if ([element isKindOfClass:[NSExpression class]] && ! collectKeyPathsFromExpression(element, keyPaths)) {
+                    return NO;
+                }
+            }
+            return YES;
+            break;
+        }
+        
+        default: {
+            return NO;
+            break;
+        }
+    }
+}
+
+/**
+ * Return the names of the entities whose changes might alter the result of a fetch: The fetched entity, as well as
+ * the entities reached through relationships by key paths. Return nil if they cannot be determined
+ */
+static NSSet *dependentEntityNames(NSEntityDescription *entity, NSPredicate *predicate, NSArray *sortDescriptors)
+{
+    if (! entity) {
+        return nil;
+    }
+    
+    NSMutableSet *keyPaths = [NSMutableSet set];
+    if (! collectKeyPathsFromPredicate(predicate, keyPaths)) {
+        return nil;
+    }
+    
+    for (NSSortDescriptor *sortDescriptor in sortDescriptors) {
+        if (! sortDescriptor.key) {
+            return nil;
+        }
+        [keyPaths addObject:sortDescriptor.key];
+    }
+    
+    NSMutableSet *entityNames = [NSMutableSet setWithObject:entity.name];
+    for (NSString *keyPath in keyPaths) {
+        NSEntityDescription *currentEntity = entity;
+        for (NSString *key in [keyPath componentsSeparatedByString:@"."]) {
+            // Collection operators (e.g. @count) and self do not change the entity
+            if ([key hasPrefix:@"@"] || [key caseInsensitiveCompare:@"self"] == NSOrderedSame) {
+                continue;
+            }
+            
+            NSPropertyDescription *propertyDescription = [currentEntity.propertiesByName objectForKey:key];
+            if ([propertyDescription isKindOfClass:[NSRelationshipDescription class]]) {
+                currentEntity = [(NSRelationshipDescription *)propertyDescription destinationEntity];
+                [entityNames addObject:currentEntity.name];
+            }
+            else if ([propertyDescription isKindOfClass:[NSAttributeDescription class]]) {
+                break;
+            }
+            // Unknown or fetched property. Cannot tell
+            else {
+                return nil;
+            }
+        }
+    }
+    
+    return [NSSet setWithSet:entityNames];
+}
+
+/**
+ * Return the names of the entities (and of their parent entities, since fetches include subentities) of all objects
+ * changed according to a NSManagedObjectContextObjectsDidChangeNotification user information dictionary
+ */
+static NSSet *changedEntityNames(NSDictionary *userInfo)
+{
+    NSMutableSet *entityNames = [NSMutableSet set];
+    for (NSString *key in @[NSInsertedObjectsKey, NSUpdatedObjectsKey, NSDeletedObjectsKey, NSRefreshedObjectsKey, NSInvalidatedObjectsKey]) {
+        for (NSManagedObject *managedObject in [userInfo objectForKey:key]) {
+            NSEntityDescription *entity = managedObject.entity;
+            while (entity && ! [entityNames containsObject:entity.name]) {
+                [entityNames addObject:entity.name];
+                entity = entity.superentity;
+            }
+        }
+    }
+    
+    return [NSSet setWithSet:entityNames];
+}
@@ -14,6 +14,11 @@
                                                                                                        [NSNumber numberWithBool:YES], NSInferMappingModelAutomaticallyOption,         \
                                                                                                        nil]
 
+/**
+ * Block called on the main thread when changes have been written to disk (error is nil on success)
+ */
+typedef void (^HLSModelManagerSaveCompletionBlock)(NSError *error);
+
 /**
  * A model manager is a lightweight wrapper around a Core Data managed object context, eliminating most of the 
  * usual boilerplate you have to write when creating stores and contexts, and providing some additional convenience 
@@ -43,6 +48,21 @@
  *   - go on working with the previously pushed model manager
  *   - if you need to perform database operations on another thread, duplicate the current context and push 
  *     the new instance onto the other thread model manager stack
+ *
+ * By default, contexts directly talk to the persistent store coordinator, and saving a context writes changes to
+ * disk synchronously on the calling thread (most of the time the main thread). Model managers can also save
+ * asynchronously (see +asynchronousSQLiteManagerWithModelFileName:inBundle:configuration:storeDirectory:fileManager:options:).
+ * In this case:
+ *   - a private queue writer context sits at the root and talks to the persistent store coordinator
+ *   - the model manager context is a main queue context, child of the writer context. It must be used from the
+ *     main thread only
+ *   - duplicates have their own context, also child of the writer context. As for standard model managers, they
+ *     must be used from the thread they are pushed onto, and never involve the main queue when fetching or saving
+ * Saving a context then only propagates changes in memory up to the writer context. Changes saved by duplicates are
+ * merged into the main queue context, whose own unsaved changes are never saved implicitly (and can therefore
+ * still be rolled back). Changes are written to disk asynchronously, saves requested in the meantime being coalesced
+ * into a single write. Saved changes which have not been written yet are written to disk synchronously when the
+ * application enters the background, or when calling -flush:
  */
 @interface HLSModelManager : NSObject
 
@@ -63,6 +83,17 @@
                                    fileManager:(HLSFileManager *)fileManager
                                        options:(NSDictionary *)options;
 
+/**
+ * Same as +SQLiteManagerWithModelFileName:inBundle:configuration:storeDirectory:fileManager:options:, but for a model
+ * manager saving changes asynchronously (see class documentation)
+ */
++ (instancetype)asynchronousSQLiteManagerWithModelFileName:(NSString *)modelFileName
+                                                  inBundle:(NSBundle *)bundle
+                                             configuration:(NSString *)configuration
+                                            storeDirectory:(NSString *)storeDirectory
+                                               fileManager:(HLSFileManager *)fileManager
+                                                   options:(NSDictionary *)options;
+
 /**
  * Create a model manager using the model file given as parameter (lookup is performed in the specified bundle,
  * or in the main bundle if nil) and saving data in-memory
@@ -107,6 +138,14 @@
 + (void)pushModelManager:(HLSModelManager *)modelManager;
 + (void)popModelManager;
 
+/**
+ * Push a model manager onto the stack of the current thread, execute the block, and pop the model manager. The block
+ * receives the model manager context, so that it can be resolved once for a whole batch of operations (e.g. when
+ * importing data, insert objects using -[NSManagedObject(HLSExtensions) insertIntoManagedObjectContext:] instead of
+ * -[NSManagedObject(HLSExtensions) insert]). Context-free methods can also be called from within the block
+ */
++ (void)performWithModelManager:(HLSModelManager *)modelManager block:(void (^)(NSManagedObjectContext *managedObjectContext))block;
+
 /**
  * Return the model manager at the top of model manager stack, for the current thread, respectively for the 
  * main thread
@@ -122,10 +161,12 @@
 + (HLSModelManager *)rootModelManagerForMainThread;
 
 /**
- * Convenience methods to work with the current model manager context
+ * Convenience methods to work with the current model manager context. Saving is performed as for -saveWithCompletionBlock:.
+ * For model managers saving asynchronously, +saveCurrentModelContext: returns once changes have been propagated in memory
  */
 + (NSManagedObjectContext *)currentModelContext;
 + (BOOL)saveCurrentModelContext:(NSError *__autoreleasing *)pError;
++ (void)saveCurrentModelContextWithCompletionBlock:(HLSModelManagerSaveCompletionBlock)completionBlock;
 + (void)rollbackCurrentModelContext;
 + (void)deleteObjectFromCurrentModelContext:(NSManagedObject *)managedObject;
 
@@ -150,12 +191,44 @@
                         configuration:(NSString *)configuration
                        storeDirectory:(NSString *)storeDirectory
                           fileManager:(HLSFileManager *)fileManager
-                              options:(NSDictionary *)options NS_DESIGNATED_INITIALIZER;
+                              options:(NSDictionary *)options
+                   asynchronousSaving:(BOOL)asynchronousSaving NS_DESIGNATED_INITIALIZER;
+
+/**
+ * Same as -initWithModelFileName:inBundle:storeType:configuration:storeDirectory:fileManager:options:asynchronousSaving:,
+ * saving synchronously
+ */
+- (instancetype)initWithModelFileName:(NSString *)modelFileName
+                             inBundle:(NSBundle *)bundle
+                            storeType:(NSString *)storeType
+                        configuration:(NSString *)configuration
+                       storeDirectory:(NSString *)storeDirectory
+                          fileManager:(HLSFileManager *)fileManager
+                              options:(NSDictionary *)options;
+
 /**
  * Duplicate an existing manager
  */
 - (HLSModelManager *)duplicate;
 
+/**
+ * Save the model manager context. For model managers saving asynchronously, changes are written to disk in the
+ * background, and the optional completion block is called on the main thread when done. Otherwise changes are
+ * written synchronously and the completion block is called before the method returns
+ */
+- (void)saveWithCompletionBlock:(HLSModelManagerSaveCompletionBlock)completionBlock;
+
+/**
+ * For model managers saving asynchronously, write all saved changes to disk, blocking until done. Unsaved changes
+ * are not written. Return YES iff successful. Does nothing for model managers saving synchronously
+ */
+- (BOOL)flush:(NSError *__autoreleasing *)pError;
+
+/**
+ * Return YES iff the model manager saves asynchronously
+ */
+@property (nonatomic, readonly, assign, getter=isSavingAsynchronously) BOOL savingAsynchronously;
+
 /**
  * Migrate the persistence store. See -[NSPersistentStoreCoordinator migratePersistentStore:toURL:options:withType:error:]
  * for more information. Due to implementation constraints, migration can only be performed to a file URL, no arbitrary
@@ -12,11 +12,48 @@
 #import "NSArray+HLSExtensions.h"
 #import "NSError+HLSExtensions.h"
 
+#import <pthread.h>
+#import <UIKit/UIKit.h>
+
+// The model manager stack of the main thread, also stored in its thread-local storage
+static NSMutableArray *s_mainThreadModelManagerStack = nil;
+
+static NSMutableArray *currentThreadModelManagerStack(void);
+static void releaseModelManagerStack(void *modelManagerStack);
+
+#pragma mark -
+#pragma mark HLSModelManagerWriter class interface
+
+/**
+ * Asynchronous save pipeline shared by a model manager saving asynchronously and its duplicates. Changes saved into
+ * the main queue context or into duplicate contexts (all children of a private queue writer context) are written
+ * to disk by the writer context. Changes saved by duplicates are merged into the main queue context
+ */
+@interface HLSModelManagerWriter : NSObject
+
+- (instancetype)initWithPersistentStoreCoordinator:(NSPersistentStoreCoordinator *)persistentStoreCoordinator;
+
+@property (nonatomic, readonly, strong) NSManagedObjectContext *writerContext;
+@property (nonatomic, readonly, strong) NSManagedObjectContext *mainContext;
+
+// Write changes saved into the writer context to disk asynchronously. Requests made before the write starts are
+// coalesced
+- (void)writeWithCompletionBlock:(HLSModelManagerSaveCompletionBlock)completionBlock;
+
+// Write changes saved into the writer context to disk synchronously
+- (BOOL)flush:(NSError *__autoreleasing *)pError;
+
+@end
+
+#pragma mark -
+#pragma mark HLSModelManager class implementation
+
 @interface HLSModelManager ()
 
 @property (nonatomic, strong) NSManagedObjectModel *managedObjectModel;
 @property (nonatomic, strong) NSPersistentStoreCoordinator *persistentStoreCoordinator;
 @property (nonatomic, strong) NSManagedObjectContext *managedObjectContext;
+@property (nonatomic, strong) HLSModelManagerWriter *writer;
 
 @end
 
@@ -40,6 +77,23 @@
                                                options:options];
 }
 
++ (instancetype)asynchronousSQLiteManagerWithModelFileName:(NSString *)modelFileName
+                                                  inBundle:(NSBundle *)bundle
+                                             configuration:(NSString *)configuration
+                                            storeDirectory:(NSString *)storeDirectory
+                                               fileManager:(HLSFileManager *)fileManager
+                                                   options:(NSDictionary *)options
+{
+    return [[[self class] alloc] initWithModelFileName:modelFileName
+                                              inBundle:bundle
+                                             storeType:NSSQLiteStoreType
+                                         configuration:configuration
+                                        storeDirectory:storeDirectory
+                                           fileManager:fileManager
+                                               options:options
+                                    asynchronousSaving:YES];
+}
+
 + (instancetype)inMemoryModelManagerWithModelFileName:(NSString *)modelFileName
                                              inBundle:(NSBundle *)bundle
                                         configuration:(NSString *)configuration
@@ -120,13 +174,12 @@
         return;
     }
     
-    NSMutableArray *modelManagerStack = [self modelManagerStackForThread:[NSThread currentThread]];
-    [modelManagerStack addObject:modelManager];
+    [currentThreadModelManagerStack() addObject:modelManager];
 }
 
 + (void)popModelManager
 {
-    NSMutableArray *modelManagerStack = [self modelManagerStackForThread:[NSThread currentThread]];
+    NSMutableArray *modelManagerStack = currentThreadModelManagerStack();
     if ([modelManagerStack count] == 0) {
         HLSLoggerInfo(@"No model manager to pop");
         return;
@@ -135,58 +188,51 @@
     [modelManagerStack removeLastObject];
 }
 
-+ (NSMutableArray *)modelManagerStackForThread:(NSThread *)thread
++ (void)performWithModelManager:(HLSModelManager *)modelManager block:(void (^)(NSManagedObjectContext *managedObjectContext))block
 {
-    static NSString * const HLSModelManagerStackThreadLocalStorageKey = @"HLSModelManagerStackThreadLocalStorageKey";
+    NSParameterAssert(block);
     
-    NSMutableArray *modelManagerStack = [[thread threadDictionary] objectForKey:HLSModelManagerStackThreadLocalStorageKey];
-    if (! modelManagerStack) {
-        modelManagerStack = [NSMutableArray array];
-        [[thread threadDictionary] setObject:modelManagerStack forKey:HLSModelManagerStackThreadLocalStorageKey];
+    if (! modelManager) {
+        HLSLoggerError(@"Missing model manager");
+        return;
     }
-    return modelManagerStack;
+    
+    NSMutableArray *modelManagerStack = currentThreadModelManagerStack();
+    [modelManagerStack addObject:modelManager];
+    block(modelManager.managedObjectContext);
+    [modelManagerStack removeLastObject];
 }
 
 + (HLSModelManager *)currentModelManager
 {
-    return [self currentModelManagerForThread:[NSThread currentThread]];
+    return [currentThreadModelManagerStack() lastObject];
 }
 
 + (HLSModelManager *)currentModelManagerForMainThread
 {
-    return [self currentModelManagerForThread:[NSThread mainThread]];
-}
-
-+ (HLSModelManager *)currentModelManagerForThread:(NSThread *)thread
-{
-    NSMutableArray *modelManagerStack = [self modelManagerStackForThread:thread];
-    return [modelManagerStack lastObject];
+    return [s_mainThreadModelManagerStack lastObject];
 }
 
 + (HLSModelManager *)rootModelManager
 {
-    return [self rootModelManagerForThread:[NSThread currentThread]];
+    return [currentThreadModelManagerStack() firstObject];
 }
 
 + (HLSModelManager *)rootModelManagerForMainThread
 {
-    return [self rootModelManagerForThread:[NSThread mainThread]];
-}
-
-+ (HLSModelManager *)rootModelManagerForThread:(NSThread *)thread
-{
-    NSMutableArray *modelManagerStack = [self modelManagerStackForThread:thread];
-    return [modelManagerStack firstObject];
+    return [s_mainThreadModelManagerStack firstObject];
 }
 
 + (NSManagedObjectContext *)currentModelContext
 {
-    return [self currentModelManager].managedObjectContext;
+    HLSModelManager *currentModelManager = [currentThreadModelManagerStack() lastObject];
+    return currentModelManager.managedObjectContext;
 }
 
 + (BOOL)saveCurrentModelContext:(NSError *__autoreleasing *)pError
 {
-    NSManagedObjectContext *currentModelContext = [self currentModelContext];
+    HLSModelManager *currentModelManager = [self currentModelManager];
+    NSManagedObjectContext *currentModelContext = currentModelManager.managedObjectContext;
     if (! currentModelContext) {
         if (pError) {
             *pError = [NSError errorWithDomain:NSCocoaErrorDomain
@@ -196,7 +242,26 @@
         return NO;
     }
     
-    return [currentModelContext save:pError];
+    if (! [currentModelManager saveManagedObjectContext:pError]) {
+        return NO;
+    }
+    
+    [currentModelManager.writer writeWithCompletionBlock:nil];
+    return YES;
+}
+
++ (void)saveCurrentModelContextWithCompletionBlock:(HLSModelManagerSaveCompletionBlock)completionBlock
+{
+    HLSModelManager *currentModelManager = [self currentModelManager];
+    if (! currentModelManager) {
+        HLSLoggerError(@"No current context");
+        if (completionBlock) {
+            completionBlock([NSError errorWithDomain:NSCocoaErrorDomain code:NSCoreDataError]);
+        }
+        return;
+    }
+    
+    [currentModelManager saveWithCompletionBlock:completionBlock];
 }
 
 + (void)rollbackCurrentModelContext
@@ -230,6 +295,25 @@
                        storeDirectory:(NSString *)storeDirectory
                           fileManager:(HLSFileManager *)fileManager
                               options:(NSDictionary *)options
+{
+    return [self initWithModelFileName:modelFileName
+                              inBundle:bundle
+                             storeType:storeType
+                         configuration:configuration
+                        storeDirectory:storeDirectory
+                           fileManager:fileManager
+                               options:options
+                    asynchronousSaving:NO];
+}
+
+- (instancetype)initWithModelFileName:(NSString *)modelFileName
+                             inBundle:(NSBundle *)bundle
+                            storeType:(NSString *)storeType
+                        configuration:(NSString *)configuration
+                       storeDirectory:(NSString *)storeDirectory
+                          fileManager:(HLSFileManager *)fileManager
+                              options:(NSDictionary *)options
+                   asynchronousSaving:(BOOL)asynchronousSaving
 {
     if (self = [super init]) {
         if (! fileManager) {
@@ -258,7 +342,14 @@
             return nil;
         }
         
-        self.managedObjectContext = [self managedObjectContextForPersistentStoreCoordinator:self.persistentStoreCoordinator];
+        if (asynchronousSaving) {
+            self.writer = [[HLSModelManagerWriter alloc] initWithPersistentStoreCoordinator:self.persistentStoreCoordinator];
+            self.managedObjectContext = self.writer.mainContext;
+        }
+        else {
+            self.managedObjectContext = [self managedObjectContextForPersistentStoreCoordinator:self.persistentStoreCoordinator];
+        }
+        
         if (! self.managedObjectContext) {
             return nil;
         }
@@ -266,6 +357,13 @@
     return self;
 }
 
+#pragma mark Accessors and mutators
+
+- (BOOL)isSavingAsynchronously
+{
+    return self.writer != nil;
+}
+
 #pragma mark Initialization
 
 - (NSManagedObjectModel *)managedObjectModelFromModelFileName:(NSString *)modelFileName inBundle:(NSBundle *)bundle
@@ -338,13 +436,66 @@
 {
     // Duplicate the context, the rest is the same
     HLSModelManager *modelManager = [[[self class] alloc] init];
-    modelManager.managedObjectContext = [self managedObjectContextForPersistentStoreCoordinator:self.persistentStoreCoordinator];
+    if (self.writer) {
+        // Sibling of the main queue context, used from the thread it is pushed onto. Fetches and saves are performed
+        // by the private queue writer context and do not involve the main queue
+        NSManagedObjectContext *managedObjectContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSConfinementConcurrencyType];
+        managedObjectContext.parentContext = self.writer.writerContext;
+        modelManager.managedObjectContext = managedObjectContext;
+        modelManager.writer = self.writer;
+    }
+    else {
+        modelManager.managedObjectContext = [self managedObjectContextForPersistentStoreCoordinator:self.persistentStoreCoordinator];
+    }
     modelManager.managedObjectModel = self.managedObjectModel;
     modelManager.persistentStoreCoordinator = self.persistentStoreCoordinator;
     
     return modelManager;
 }
 
+#pragma mark Saving
+
+- (void)saveWithCompletionBlock:(HLSModelManagerSaveCompletionBlock)completionBlock
+{
+    NSError *error = nil;
+    if (! [self saveManagedObjectContext:&error]) {
+        if (completionBlock) {
+            completionBlock(error);
+        }
+        return;
+    }
+    
+    if (self.writer) {
+        [self.writer writeWithCompletionBlock:completionBlock];
+    }
+    else if (completionBlock) {
+        completionBlock(nil);
+    }
+}
+
+- (BOOL)saveManagedObjectContext:(NSError *__autoreleasing *)pError
+{
+    // Objects inserted into a context saving into the writer context need permanent IDs before their changes can be
+    // merged into other contexts
+    if (self.writer) {
+        NSArray *insertedObjects = [[self.managedObjectContext insertedObjects] allObjects];
+        if ([insertedObjects count] != 0 && ! [self.managedObjectContext obtainPermanentIDsForObjects:insertedObjects error:pError]) {
+            return NO;
+        }
+    }
+    
+    return [self.managedObjectContext save:pError];
+}
+
+- (BOOL)flush:(NSError *__autoreleasing *)pError
+{
+    if (! self.writer) {
+        return YES;
+    }
+    
+    return [self.writer flush:pError];
+}
+
 - (BOOL)migrateStoreToURL:(NSURL *)url withStoreType:(NSString *)storeType error:(NSError *__autoreleasing *)pError
 {
     NSPersistentStore *persistentStore = [[self.persistentStoreCoordinator persistentStores] firstObject];
@@ -352,3 +503,177 @@
 }
 
 @end
+
+#pragma mark -
+#pragma mark HLSModelManagerWriter class implementation
+
+@interface HLSModelManagerWriter ()
+
+@property (nonatomic, strong) NSManagedObjectContext *writerContext;
+@property (nonatomic, strong) NSManagedObjectContext *mainContext;
+@property (nonatomic, strong) NSMutableArray *pendingCompletionBlocks;
+
+@end
+
+@implementation HLSModelManagerWriter {
+@private
+    BOOL _writeScheduled;
+}
+
+#pragma mark Object creation and destruction
+
+- (instancetype)initWithPersistentStoreCoordinator:(NSPersistentStoreCoordinator *)persistentStoreCoordinator
+{
+    if (self = [super init]) {
+        self.writerContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSPrivateQueueConcurrencyType];
+        self.writerContext.persistentStoreCoordinator = persistentStoreCoordinator;
+        
+        self.mainContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSMainQueueConcurrencyType];
+        self.mainContext.parentContext = self.writerContext;
+        
+        self.pendingCompletionBlocks = [NSMutableArray array];
+        
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(applicationDidEnterBackground:)
+                                                     name:UIApplicationDidEnterBackgroundNotification
+                                                   object:nil];
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(managedObjectContextDidSave:)
+                                                     name:NSManagedObjectContextDidSaveNotification
+                                                   object:nil];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self
+                                                    name:UIApplicationDidEnterBackgroundNotification
+                                                  object:nil];
+    [[NSNotificationCenter defaultCenter] removeObserver:self
+                                                    name:NSManagedObjectContextDidSaveNotification
+                                                  object:nil];
+}
+
+#pragma mark Writing
+
+- (void)writeWithCompletionBlock:(HLSModelManagerSaveCompletionBlock)completionBlock
+{
+    @synchronized(self) {
+        if (completionBlock) {
+            [self.pendingCompletionBlocks addObject:[completionBlock copy]];
+        }
+        
+        if (_writeScheduled) {
+            return;
+        }
+        _writeScheduled = YES;
+    }
+    
+    // Only changes which have been explicitly saved into the writer context are written. Unsaved changes of the
+    // main queue context are left untouched, so that they can still be rolled back
+    NSManagedObjectContext *writerContext = self.writerContext;
+    [writerContext performBlock:^{
+        // Requests made from now on need another write, since their changes might not be written below
+        NSArray *completionBlocks = nil;
+        @synchronized(self) {
+            completionBlocks = [NSArray arrayWithArray:self.pendingCompletionBlocks];
+            [self.pendingCompletionBlocks removeAllObjects];
+            _writeScheduled = NO;
+        }
+        
+        NSError *error = nil;
+        if ([writerContext hasChanges] && ! [writerContext save:&error]) {
+            HLSLoggerError(@"Could not write changes. Reason: %@", error);
+        }
+        [self callCompletionBlocks:completionBlocks withError:error];
+    }];
+}
+
+- (void)callCompletionBlocks:(NSArray *)completionBlocks withError:(NSError *)error
+{
+    if ([completionBlocks count] == 0) {
+        return;
+    }
+    
+    dispatch_async(dispatch_get_main_queue(), ^{
+        for (HLSModelManagerSaveCompletionBlock completionBlock in completionBlocks) {
+            completionBlock(error);
+        }
+    });
+}
+
+- (BOOL)flush:(NSError *__autoreleasing *)pError
+{
+    __block BOOL success = YES;
+    __block NSError *error = nil;
+    NSManagedObjectContext *writerContext = self.writerContext;
+    [writerContext performBlockAndWait:^{
+        if ([writerContext hasChanges]) {
+            success = [writerContext save:&error];
+        }
+    }];
+    
+    if (! success && pError) {
+        *pError = error;
+    }
+    return success;
+}
+
+#pragma mark Notifications
+
+- (void)applicationDidEnterBackground:(NSNotification *)notification
+{
+    NSError *error = nil;
+    if (! [self flush:&error]) {
+        HLSLoggerError(@"Could not write pending changes. Reason: %@", error);
+    }
+}
+
+- (void)managedObjectContextDidSave:(NSNotification *)notification
+{
+    // Only changes saved by duplicates, i.e. by siblings of the main queue context, need to be merged
+    NSManagedObjectContext *managedObjectContext = notification.object;
+    if (managedObjectContext == self.mainContext || managedObjectContext.parentContext != self.writerContext) {
+        return;
+    }
+    
+    NSManagedObjectContext *mainContext = self.mainContext;
+    [mainContext performBlock:^{
+        [mainContext mergeChangesFromContextDidSaveNotification:notification];
+    }];
+}
+
+@end
+
+#pragma mark Static functions
+
+/**
+ * Return the model manager stack of the current thread, stored in its thread-local storage. The stack is created if
+ * needed, and released when the thread exits
+ */
+static NSMutableArray *currentThreadModelManagerStack(void)
+{
+    static pthread_key_t s_modelManagerStackKey;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        pthread_key_create(&s_modelManagerStackKey, releaseModelManagerStack);
+    });
+    
+    void *modelManagerStack = pthread_getspecific(s_modelManagerStackKey);
+    if (! modelManagerStack) {
+        NSMutableArray *newModelManagerStack = [NSMutableArray array];
+        modelManagerStack = (__bridge_retained void *)newModelManagerStack;
+        pthread_setspecific(s_modelManagerStackKey, modelManagerStack);
+        
+        if ([NSThread isMainThread]) {
+            s_mainThreadModelManagerStack = newModelManagerStack;
+        }
+    }
+    return (__bridge NSMutableArray *)modelManagerStack;
+}
+
+static void releaseModelManagerStack(void *modelManagerStack)
+{
+    CFRelease(modelManagerStack);
+}
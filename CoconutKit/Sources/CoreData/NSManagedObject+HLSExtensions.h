@@ -15,6 +15,8 @@
  * Working with model managers and context-free methods reduces errors and is the preferred way of interacting with 
  * Core Data in CoconutKit. You should therefore only used the methods expecting a context parameter if you directly
  * have or want to interact with a managed object context
+ *
+ * Fetches are made through the fetch result cache of the context if one has been enabled (see HLSFetchResultCache.h)
  */
 @interface NSManagedObject (HLSExtensions)
 
@@ -7,6 +7,7 @@
 #import "NSManagedObject+HLSExtensions.h"
 
 #import "HLSAssert.h"
+#import "HLSFetchResultCache.h"
 #import "HLSLogger.h"
 #import "HLSManagedObjectCopying.h"
 #import "HLSModelManager.h"
@@ -45,7 +46,14 @@
     fetchRequest.predicate = predicate;
     
     NSError *error = nil;
-    NSArray *objects = [managedObjectContext executeFetchRequest:fetchRequest error:&error];
+    HLSFetchResultCache *fetchResultCache = [HLSFetchResultCache fetchResultCacheForManagedObjectContext:managedObjectContext];
+    NSArray *objects = nil;
+    if (fetchResultCache) {
+        objects = [fetchResultCache executeFetchRequest:fetchRequest error:&error];
+    }
+    else {
+        objects = [managedObjectContext executeFetchRequest:fetchRequest error:&error];
+    }
     if (error) {
         HLSLoggerError(@"Could not retrieve objects; reason: %@", error);
         return nil;
@@ -8,6 +8,7 @@
 
 #import "HLSAnimation.h"
 #import "HLSLogger.h"
+#import "HLSTextMeasurementCache.h"
 #import "HLSViewAnimationStep.h"
 #import "NSArray+HLSExtensions.h"
 #import "NSBundle+HLSExtensions.h"
@@ -247,8 +248,9 @@
         
         // Create a label with appropriate size. The size must accomodate both the font sizes for selected and non-selected
         // states
-        CGSize titleSize = [title sizeWithAttributes:@{ NSFontAttributeName : font }];
-        CGSize otherTitleSize = [title sizeWithAttributes:@{ NSFontAttributeName : otherFont }];
+        HLSTextMeasurementCache *textMeasurementCache = [HLSTextMeasurementCache sharedTextMeasurementCache];
+        CGSize titleSize = [textMeasurementCache sizeForString:title withAttributes:@{ NSFontAttributeName : font }];
+        CGSize otherTitleSize = [textMeasurementCache sizeForString:title withAttributes:@{ NSFontAttributeName : otherFont }];
         UILabel *elementLabel = [[UILabel alloc] initWithFrame:CGRectMake(0.f,
                                                                           0.f,
                                                                           fmaxf(titleSize.width, otherTitleSize.width),
@@ -32,4 +32,11 @@ typedef NS_ENUM(NSInteger, HLSLabelVerticalAlignment) {
  */
 @property (nonatomic, assign) HLSLabelVerticalAlignment verticalAlignment;
 
+/**
+ * Text measurements made when drawing labels are stored in the shared HLSTextMeasurementCache. Call this method to
+ * measure texts in the background before they are displayed in labels with the given font and size (e.g. labels
+ * of table view cells)
+ */
++ (void)precomputeMeasurementsForTexts:(NSArray *)texts withFont:(UIFont *)font size:(CGSize)size;
+
 @end
@@ -7,10 +7,24 @@
 #import "HLSLabel.h"
 
 #import "HLSLogger.h"
+#import "HLSTextMeasurementCache.h"
 #import "NSString+HLSExtensions.h"
 
+static const NSStringDrawingOptions HLSLabelDrawingOptions = NSStringDrawingUsesLineFragmentOrigin | NSStringDrawingUsesFontLeading;
+
 @implementation HLSLabel
 
+#pragma mark Class methods
+
++ (void)precomputeMeasurementsForTexts:(NSArray *)texts withFont:(UIFont *)font size:(CGSize)size
+{
+    [[HLSTextMeasurementCache sharedTextMeasurementCache] precomputeBoundingRectsForStrings:texts
+                                                                                    withSize:size
+                                                                                     options:HLSLabelDrawingOptions
+                                                                                  attributes:@{ NSFontAttributeName : font }
+                                                                             completionBlock:nil];
+}
+
 #pragma mark Accessors and mutators
 
 - (void)setVerticalAlignment:(HLSLabelVerticalAlignment)verticalAlignment
@@ -53,10 +67,10 @@
 
 - (void)drawTextInRect:(CGRect)requestedRect
 {
-    CGRect rect = [self.text boundingRectWithSize:requestedRect.size
-                                          options:NSStringDrawingUsesLineFragmentOrigin | NSStringDrawingUsesFontLeading
-                                       attributes:@{ NSFontAttributeName : self.font }
-                                          context:nil];
+    CGRect rect = [[HLSTextMeasurementCache sharedTextMeasurementCache] boundingRectForString:self.text
+                                                                                      withSize:requestedRect.size
+                                                                                       options:HLSLabelDrawingOptions
+                                                                                    attributes:@{ NSFontAttributeName : self.font }];
     CGRect actualRect = [self textRectForBounds:rect limitedToNumberOfLines:self.numberOfLines];
     [self.text drawInRect:actualRect withAttributes:@{ NSFontAttributeName : self.font }];
 }
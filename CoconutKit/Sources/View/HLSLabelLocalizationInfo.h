@@ -45,7 +45,8 @@ typedef NS_ENUM(NSInteger, HLSLabelRepresentation) {
 
 /**
  * Build and return the corresponding localized text. Return nil if the object does not contain localized information
- * (i.e. if isLocalized returns NO)
+ * (i.e. if isLocalized returns NO). Texts are calculated once per localization and shared among all objects with
+ * the same key, table, bundle and representation
  */
 - (NSString *)localizedText;
 
@@ -8,12 +8,32 @@
 
 #import "HLSLogger.h"
 #import "NSArray+HLSExtensions.h"
+#import "NSBundle+HLSDynamicLocalization.h"
 #import "NSBundle+HLSExtensions.h"
 
 static NSString * const kMissingLocalizedString = @"UILabel_HLSDynamicLocalization_missing";
 
+// Localized texts shared by all labels, grouped by localization. Also used as lock
+static NSMutableDictionary *s_localizationToLocalizedTextsMap = nil;
+
 static NSString *stringForLabelRepresentation(HLSLabelRepresentation representation);
 
+#pragma mark -
+#pragma mark HLSLocalizedText class interface
+
+/**
+ * Final text displayed for some localization information, and whether a translation was missing
+ */
+@interface HLSLocalizedText : NSObject
+
+@property (nonatomic, strong) NSString *text;
+@property (nonatomic, assign, getter=isIncomplete) BOOL incomplete;
+
+@end
+
+#pragma mark -
+#pragma mark HLSLabelLocalizationInfo class implementation
+
 @interface HLSLabelLocalizationInfo ()
 
 @property (nonatomic, strong) NSString *localizationKey;
@@ -21,10 +41,35 @@ static NSString *stringForLabelRepresentation(HLSLabelRepresentation representat
 @property (nonatomic, strong) NSString *bundleName;
 @property (nonatomic, assign) HLSLabelRepresentation representation;
 
+@property (nonatomic, strong) NSString *memoKey;            // Identifies the localized text among those for a given localization
+
 @end
 
 @implementation HLSLabelLocalizationInfo
 
+#pragma mark Class methods
+
++ (void)initialize
+{
+    if (self != [HLSLabelLocalizationInfo class]) {
+        return;
+    }
+    
+    s_localizationToLocalizedTextsMap = [NSMutableDictionary dictionary];
+    
+    // Texts for other localizations will not be needed anymore (except if switching back)
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(currentLocalizationDidChange:)
+                                                 name:HLSCurrentLocalizationDidChangeNotification
+                                               object:nil];
+    
+    // Bundles might have been added or removed, texts looked up in them must be looked up again
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(bundleCacheDidInvalidate:)
+                                                 name:HLSBundleCacheDidInvalidateNotification
+                                               object:nil];
+}
+
 #pragma mark Object creation and destruction
 
 - (instancetype)initWithText:(NSString *)text tableName:(NSString *)tableName bundleName:(NSString *)bundleName
@@ -34,6 +79,10 @@ static NSString *stringForLabelRepresentation(HLSLabelRepresentation representat
         
         self.tableName = tableName;
         self.bundleName = bundleName;
+        
+        if (self.localizationKey) {
+            self.memoKey = [NSString stringWithFormat:@"%@|%@|%@|%@", bundleName ?: @"", tableName ?: @"", @(self.representation), self.localizationKey];
+        }
     }
     return self;
 }
@@ -88,21 +137,7 @@ static NSString *stringForLabelRepresentation(HLSLabelRepresentation representat
         return YES;
     }
     
-    // Missing translation
-    NSBundle *bundle = [NSBundle bundleWithName:self.bundleName];
-    if (! bundle) {
-        HLSLoggerWarn(@"The bundle %@ was not found", self.bundleName);
-        return NO;
-    }
-    
-    NSString *text = [bundle localizedStringForKey:self.localizationKey
-                                             value:kMissingLocalizedString
-                                             table:self.tableName];
-    if ([text isEqualToString:kMissingLocalizedString]) {
-        return YES;
-    }
-    
-    return NO;
+    return [self memoizedLocalizedText].incomplete;
 }
 
 - (NSString *)localizedText
@@ -116,12 +151,45 @@ static NSString *stringForLabelRepresentation(HLSLabelRepresentation representat
         return @"(no key)";
     }
     
+    return [self memoizedLocalizedText].text;
+}
+
+/**
+ * Return the localized text for the current localization, calculating it only if not already available
+ */
+- (HLSLocalizedText *)memoizedLocalizedText
+{
+    NSString *localization = [NSBundle localization];
+    
+    @synchronized(s_localizationToLocalizedTextsMap) {
+        NSMutableDictionary *memoKeyToLocalizedTextMap = [s_localizationToLocalizedTextsMap objectForKey:localization];
+        if (! memoKeyToLocalizedTextMap) {
+            memoKeyToLocalizedTextMap = [NSMutableDictionary dictionary];
+            [s_localizationToLocalizedTextsMap setObject:memoKeyToLocalizedTextMap forKey:localization];
+        }
+        
+        HLSLocalizedText *localizedText = [memoKeyToLocalizedTextMap objectForKey:self.memoKey];
+        if (! localizedText) {
+            localizedText = [self calculateLocalizedText];
+            [memoKeyToLocalizedTextMap setObject:localizedText forKey:self.memoKey];
+        }
+        return localizedText;
+    }
+}
+
+- (HLSLocalizedText *)calculateLocalizedText
+{
+    NSAssert([self.localizationKey length] != 0, @"A localization key is required");
+    
+    HLSLocalizedText *localizedText = [[HLSLocalizedText alloc] init];
+    
     // We use an explicit constant string for missing localizations since otherwise the localization key itself would 
     // be returned by the localizedStringForKey:value:table method
     NSBundle *bundle = [NSBundle bundleWithName:self.bundleName];
     if (! bundle) {
         HLSLoggerWarn(@"The bundle %@ was not found", self.bundleName);
-        return self.localizationKey;
+        localizedText.text = self.localizationKey;
+        return localizedText;
     }
     
     NSString *text = [bundle localizedStringForKey:self.localizationKey
@@ -131,6 +199,7 @@ static NSString *stringForLabelRepresentation(HLSLabelRepresentation representat
     // Use the localization key as text if missing
     if ([text isEqualToString:kMissingLocalizedString]) {
         text = self.localizationKey;
+        localizedText.incomplete = YES;
     }
     
     // Formatting
@@ -155,7 +224,24 @@ static NSString *stringForLabelRepresentation(HLSLabelRepresentation representat
         }
     }
     
-    return text;
+    localizedText.text = text;
+    return localizedText;
+}
+
+#pragma mark Notification callbacks
+
++ (void)currentLocalizationDidChange:(NSNotification *)notification
+{
+    @synchronized(s_localizationToLocalizedTextsMap) {
+        [s_localizationToLocalizedTextsMap removeAllObjects];
+    }
+}
+
++ (void)bundleCacheDidInvalidate:(NSNotification *)notification
+{
+    @synchronized(s_localizationToLocalizedTextsMap) {
+        [s_localizationToLocalizedTextsMap removeAllObjects];
+    }
 }
 
 #pragma mark Description
@@ -173,6 +259,13 @@ static NSString *stringForLabelRepresentation(HLSLabelRepresentation representat
 
 @end
 
+#pragma mark -
+#pragma mark HLSLocalizedText class implementation
+
+@implementation HLSLocalizedText
+
+@end
+
 #pragma mark Helper functions
 
 static NSString *stringForLabelRepresentation(HLSLabelRepresentation representation)
@@ -0,0 +1,74 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+
+/**
+ * Measuring text is expensive and often repeated for the same text, attributes and constraints (e.g. when cells are
+ * reused or when views are laid out again). A text measurement cache stores measurement results, keyed by string,
+ * attributes, constraint size and drawing options, so that identical measurements are only made once. HLSLabel and
+ * HLSCursor use the shared cache, which you can also use for your own measurements
+ *
+ * The cache is bounded and can be safely used from any thread. Measurements can be precomputed in the background,
+ * e.g. when data has been received, so that they are available when views are displayed
+ */
+@interface HLSTextMeasurementCache : NSObject
+
+/**
+ * The shared cache instance
+ */
++ (instancetype)sharedTextMeasurementCache;
+
+/**
+ * The maximum number of measurements kept in the cache
+ *
+ * Default value is 1000
+ */
+@property (nonatomic, assign) NSUInteger countLimit;
+
+/**
+ * Same as -[NSString boundingRectWithSize:options:attributes:context:] (without context), but cached
+ */
+- (CGRect)boundingRectForString:(NSString *)string
+                       withSize:(CGSize)size
+                        options:(NSStringDrawingOptions)options
+                     attributes:(NSDictionary *)attributes;
+
+/**
+ * Same as -[NSString sizeWithAttributes:], but cached
+ */
+- (CGSize)sizeForString:(NSString *)string withAttributes:(NSDictionary *)attributes;
+
+/**
+ * Compute bounding rectangles for the given strings on a background thread and store them in the cache. The optional
+ * completion block is called on the main thread when all measurements have been made
+ */
+- (void)precomputeBoundingRectsForStrings:(NSArray *)strings
+                                 withSize:(CGSize)size
+                                  options:(NSStringDrawingOptions)options
+                               attributes:(NSDictionary *)attributes
+                          completionBlock:(void (^)(void))completionBlock;
+
+/**
+ * Same as -precomputeBoundingRectsForStrings:withSize:options:attributes:completionBlock:, but for -sizeForString:withAttributes:
+ */
+- (void)precomputeSizesForStrings:(NSArray *)strings
+                   withAttributes:(NSDictionary *)attributes
+                  completionBlock:(void (^)(void))completionBlock;
+
+/**
+ * Discard all measurements, and reset hit and miss counters
+ */
+- (void)removeAllMeasurements;
+
+/**
+ * Number of cache lookups which succeeded or failed
+ */
+@property (nonatomic, readonly, assign) NSUInteger hitCount;
+@property (nonatomic, readonly, assign) NSUInteger missCount;
+
+@end
@@ -0,0 +1,293 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import "HLSTextMeasurementCache.h"
+
+static const NSUInteger HLSTextMeasurementCacheDefaultCountLimit = 1000;
+
+#pragma mark -
+#pragma mark HLSTextMeasurementKey class interface
+
+/**
+ * Identifies a measurement. Size measurements (-sizeWithAttributes:) are distinguished from bounding rectangle
+ * measurements, since both do not yield the same results
+ */
+@interface HLSTextMeasurementKey : NSObject <NSCopying>
+
+- (instancetype)initWithString:(NSString *)string
+                          size:(CGSize)size
+                       options:(NSStringDrawingOptions)options
+                    attributes:(NSDictionary *)attributes
+               sizeMeasurement:(BOOL)sizeMeasurement;
+
+@property (nonatomic, readonly, strong) NSString *string;
+@property (nonatomic, readonly, assign) CGSize size;
+@property (nonatomic, readonly, assign) NSStringDrawingOptions options;
+@property (nonatomic, readonly, strong) NSDictionary *attributes;
+@property (nonatomic, readonly, assign, getter=isSizeMeasurement) BOOL sizeMeasurement;
+
+// Perform the measurement corresponding to the key
+- (CGRect)measure;
+
+@end
+
+#pragma mark -
+#pragma mark HLSTextMeasurementCache class implementation
+
+@interface HLSTextMeasurementCache ()
+
+@property (nonatomic, strong) NSCache *cache;
+@property (nonatomic, strong) NSOperationQueue *operationQueue;
+
+@end
+
+@implementation HLSTextMeasurementCache {
+@private
+    NSUInteger _hitCount;
+    NSUInteger _missCount;
+}
+
+#pragma mark Class methods
+
++ (instancetype)sharedTextMeasurementCache
+{
+    static HLSTextMeasurementCache *s_instance = nil;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        s_instance = [[[self class] alloc] init];
+    });
+    return s_instance;
+}
+
+#pragma mark Object creation and destruction
+
+- (instancetype)init
+{
+    if (self = [super init]) {
+        self.cache = [[NSCache alloc] init];
+        self.cache.countLimit = HLSTextMeasurementCacheDefaultCountLimit;
+        
+        self.operationQueue = [[NSOperationQueue alloc] init];
+        self.operationQueue.maxConcurrentOperationCount = 1;
+    }
+    return self;
+}
+
+#pragma mark Accessors and mutators
+
+- (NSUInteger)countLimit
+{
+    return self.cache.countLimit;
+}
+
+- (void)setCountLimit:(NSUInteger)countLimit
+{
+    self.cache.countLimit = countLimit;
+}
+
+- (NSUInteger)hitCount
+{
+    @synchronized(self) {
+        return _hitCount;
+    }
+}
+
+- (NSUInteger)missCount
+{
+    @synchronized(self) {
+        return _missCount;
+    }
+}
+
+#pragma mark Measurements
+
+- (CGRect)boundingRectForString:(NSString *)string
+                       withSize:(CGSize)size
+                        options:(NSStringDrawingOptions)options
+                     attributes:(NSDictionary *)attributes
+{
+    HLSTextMeasurementKey *key = [[HLSTextMeasurementKey alloc] initWithString:string
+                                                                          size:size
+                                                                       options:options
+                                                                    attributes:attributes
+                                                               sizeMeasurement:NO];
+    return [self measurementForKey:key];
+}
+
+- (CGSize)sizeForString:(NSString *)string withAttributes:(NSDictionary *)attributes
+{
+    HLSTextMeasurementKey *key = [[HLSTextMeasurementKey alloc] initWithString:string
+                                                                          size:CGSizeZero
+                                                                       options:0
+                                                                    attributes:attributes
+                                                               sizeMeasurement:YES];
+    return [self measurementForKey:key].size;
+}
+
+- (CGRect)measurementForKey:(HLSTextMeasurementKey *)key
+{
+    if ([key.string length] == 0) {
+        return CGRectZero;
+    }
+    
+    NSValue *measurementValue = [self.cache objectForKey:key];
+    if (measurementValue) {
+        @synchronized(self) {
+            ++_hitCount;
+        }
+        return [measurementValue CGRectValue];
+    }
+    
+    @synchronized(self) {
+        ++_missCount;
+    }
+    
+    CGRect measurement = [key measure];
+    [self.cache setObject:[NSValue valueWithCGRect:measurement] forKey:key];
+    return measurement;
+}
+
+#pragma mark Precomputation
+
+- (void)precomputeBoundingRectsForStrings:(NSArray *)strings
+                                 withSize:(CGSize)size
+                                  options:(NSStringDrawingOptions)options
+                               attributes:(NSDictionary *)attributes
+                          completionBlock:(void (^)(void))completionBlock
+{
+    NSMutableArray *keys = [NSMutableArray array];
+    for (NSString *string in strings) {
+        [keys addObject:[[HLSTextMeasurementKey alloc] initWithString:string
+                                                                 size:size
+                                                              options:options
+                                                           attributes:attributes
+                                                      sizeMeasurement:NO]];
+    }
+    [self precomputeMeasurementsForKeys:keys completionBlock:completionBlock];
+}
+
+- (void)precomputeSizesForStrings:(NSArray *)strings
+                   withAttributes:(NSDictionary *)attributes
+                  completionBlock:(void (^)(void))completionBlock
+{
+    NSMutableArray *keys = [NSMutableArray array];
+    for (NSString *string in strings) {
+        [keys addObject:[[HLSTextMeasurementKey alloc] initWithString:string
+                                                                 size:CGSizeZero
+                                                              options:0
+                                                           attributes:attributes
+                                                      sizeMeasurement:YES]];
+    }
+    [self precomputeMeasurementsForKeys:keys completionBlock:completionBlock];
+}
+
+- (void)precomputeMeasurementsForKeys:(NSArray *)keys completionBlock:(void (^)(void))completionBlock
+{
+    // Precomputed measurements are neither hits nor misses. Existing measurements are not computed again
+    NSCache *cache = self.cache;
+    [self.operationQueue addOperationWithBlock:^{
+        for (HLSTextMeasurementKey *key in keys) {
+            if ([key.string length] == 0 || [cache objectForKey:key]) {
+                continue;
+            }
+            [cache setObject:[NSValue valueWithCGRect:[key measure]] forKey:key];
+        }
+        
+        if (completionBlock) {
+            dispatch_async(dispatch_get_main_queue(), completionBlock);
+        }
+    }];
+}
+
+- (void)removeAllMeasurements
+{
+    [self.cache removeAllObjects];
+    
+    @synchronized(self) {
+        _hitCount = 0;
+        _missCount = 0;
+    }
+}
+
+@end
+
+#pragma mark -
+#pragma mark HLSTextMeasurementKey class implementation
+
+@implementation HLSTextMeasurementKey {
+@private
+    NSUInteger _hash;
+}
+
+#pragma mark Object creation and destruction
+
+- (instancetype)initWithString:(NSString *)string
+                          size:(CGSize)size
+                       options:(NSStringDrawingOptions)options
+                    attributes:(NSDictionary *)attributes
+               sizeMeasurement:(BOOL)sizeMeasurement
+{
+    if (self = [super init]) {
+        _string = [string copy];
+        _size = size;
+        _options = options;
+        _attributes = [attributes copy];
+        _sizeMeasurement = sizeMeasurement;
+        
+        // Attribute dictionaries only hash their count, include the font which is almost always present
+        _hash = [_string hash] ^ [[_attributes objectForKey:NSFontAttributeName] hash] ^ ([@(size.width) hash] << 1)
+            ^ ([@(size.height) hash] << 2) ^ (options << 3) ^ sizeMeasurement;
+    }
+    return self;
+}
+
+#pragma mark Measurement
+
+- (CGRect)measure
+{
+    if (self.sizeMeasurement) {
+        return (CGRect){CGPointZero, [self.string sizeWithAttributes:self.attributes]};
+    }
+    else {
+        return [self.string boundingRectWithSize:self.size options:self.options attributes:self.attributes context:nil];
+    }
+}
+
+#pragma mark NSCopying protocol implementation
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    // Immutable
+    return self;
+}
+
+#pragma mark Equality
+
+- (BOOL)isEqual:(id)object
+{
+    if (self == object) {
+        return YES;
+    }
+    
+    if (! [object isKindOfClass:[HLSTextMeasurementKey class]]) {
+        return NO;
+    }
+    
+    HLSTextMeasurementKey *otherKey = object;
+    return _hash == otherKey->_hash
+        && self.sizeMeasurement == otherKey.sizeMeasurement
+        && self.options == otherKey.options
+        && CGSizeEqualToSize(self.size, otherKey.size)
+        && [self.string isEqualToString:otherKey.string]
+        && (self.attributes == otherKey.attributes || [self.attributes isEqualToDictionary:otherKey.attributes]);
+}
+
+- (NSUInteger)hash
+{
+    return _hash;
+}
+
+@end
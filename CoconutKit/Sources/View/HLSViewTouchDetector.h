@@ -8,22 +8,23 @@
 #import <UIKit/UIKit.h>
 
 /**
- * For a view and a pair of begin / end notifications, traps touches outside the view frame and resigns responder
- * status if enabled
+ * Traps taps outside the text field or text view currently being edited, and makes it resign its responder status
+ * if it has been registered for this purpose. A single detector (with a single gesture recognizer, attached to the
+ * key window while a registered view is being edited) is shared by all views. It is only created when the first view
+ * gets registered
  */
 @interface HLSViewTouchDetector : NSObject <UIGestureRecognizerDelegate>
 
 /**
- * Create a touch detector for the specified text field (not retained) and notification pair
+ * Return the shared detector
  */
-- (instancetype)initWithView:(UIView *)view beginNotificationName:(NSString *)beginNotificationName endNotificationName:(NSString *)endNotificationName NS_DESIGNATED_INITIALIZER;
++ (instancetype)sharedViewTouchDetector;
 
 /**
- * If set to YES, and between the time the begin and end notifications are received, taps outside the view frame
- * make the view resign its responder status
- *
- * The default value is NO
+ * Register a text field or text view (not retained) so that taps outside it make it resign its responder status
+ * while it is being edited. Unregister it to restore the normal behavior
  */
-@property (nonatomic, assign, getter=isResigningFirstResponderOnTap) BOOL resigningFirstResponderOnTap;
+- (void)registerView:(UIView *)view;
+- (void)unregisterView:(UIView *)view;
 
 @end
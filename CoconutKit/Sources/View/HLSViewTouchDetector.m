@@ -8,21 +8,32 @@
 
 @interface HLSViewTouchDetector ()
 
-@property (nonatomic, weak) UIView *view;               // weak ref. Detector lifetime is managed by the text field
+@property (nonatomic, strong) NSHashTable *views;                   // weak refs. Registered views
+@property (nonatomic, weak) UIView *editedView;                     // The registered view currently being edited, if any
 @property (nonatomic, strong) UIGestureRecognizer *gestureRecognizer;
 
 @end
 
 @implementation HLSViewTouchDetector
 
+#pragma mark Class methods
+
++ (instancetype)sharedViewTouchDetector
+{
+    static HLSViewTouchDetector *s_instance = nil;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        s_instance = [[[self class] alloc] init];
+    });
+    return s_instance;
+}
+
 #pragma mark Object creation and destruction
 
-- (instancetype)initWithView:(UIView *)view beginNotificationName:(NSString *)beginNotificationName endNotificationName:(NSString *)endNotificationName
+- (instancetype)init
 {
-    NSAssert(beginNotificationName && endNotificationName, @"Notifications required");
-    
     if (self = [super init]) {
-        self.view = view;
+        self.views = [NSHashTable weakObjectsHashTable];
         
         // Create a gesture recognizer capturing taps on the whole window
         self.gestureRecognizer = [[UITapGestureRecognizer alloc] initWithTarget:self
@@ -30,14 +41,23 @@
         self.gestureRecognizer.cancelsTouchesInView = NO;       // Let the taps go through
         self.gestureRecognizer.delegate = self;
         
+        // Observe all text fields and text views, checking whether they have been registered when notified
         [[NSNotificationCenter defaultCenter] addObserver:self
                                                  selector:@selector(viewDidBeginEditing:)
-                                                     name:beginNotificationName
-                                                   object:view];
+                                                     name:UITextFieldTextDidBeginEditingNotification
+                                                   object:nil];
         [[NSNotificationCenter defaultCenter] addObserver:self
                                                  selector:@selector(viewDidEndEditing:)
-                                                     name:endNotificationName
-                                                   object:view];
+                                                     name:UITextFieldTextDidEndEditingNotification
+                                                   object:nil];
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(viewDidBeginEditing:)
+                                                     name:UITextViewTextDidBeginEditingNotification
+                                                   object:nil];
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(viewDidEndEditing:)
+                                                     name:UITextViewTextDidEndEditingNotification
+                                                   object:nil];
     }
     return self;
 }
@@ -47,31 +67,84 @@
     [[NSNotificationCenter defaultCenter] removeObserver:self];
 }
 
+#pragma mark Registration
+
+- (void)registerView:(UIView *)view
+{
+    if (! view) {
+        return;
+    }
+    
+    [self.views addObject:view];
+    
+    // Registered while already being edited
+    if ([view isFirstResponder]) {
+        [self beginTrackingView:view];
+    }
+}
+
+- (void)unregisterView:(UIView *)view
+{
+    if (! view) {
+        return;
+    }
+    
+    [self.views removeObject:view];
+    
+    if (view == self.editedView) {
+        [self endTracking];
+    }
+}
+
+#pragma mark Tracking
+
+- (void)beginTrackingView:(UIView *)view
+{
+    self.editedView = view;
+    [[UIApplication sharedApplication].keyWindow addGestureRecognizer:self.gestureRecognizer];
+}
+
+- (void)endTracking
+{
+    self.editedView = nil;
+    [self.gestureRecognizer.view removeGestureRecognizer:self.gestureRecognizer];
+}
+
 #pragma mark UIGestureRecognizerDelegate protocol implementation
 
 - (BOOL)gestureRecognizer:(UIGestureRecognizer *)gestureRecognizer shouldReceiveTouch:(UITouch *)touch
 {
-	return ! [touch.view isDescendantOfView:self.view];
+	return self.editedView && ! [touch.view isDescendantOfView:self.editedView];
 }
 
 #pragma mark Notification callbacks
 
 - (void)viewDidBeginEditing:(NSNotification *)notification
 {
-    [[UIApplication sharedApplication].keyWindow addGestureRecognizer:self.gestureRecognizer];
+    UIView *view = notification.object;
+    if (! [self.views containsObject:view]) {
+        return;
+    }
+    
+    [self beginTrackingView:view];
 }
 
 - (void)viewDidEndEditing:(NSNotification *)notification
 {
-    [[UIApplication sharedApplication].keyWindow removeGestureRecognizer:self.gestureRecognizer];
+    if (notification.object != self.editedView) {
+        return;
+    }
+    
+    [self endTracking];
 }
 
 #pragma mark Event callbacks
 
 - (void)dismissKeyboard:(UIGestureRecognizer *)gestureRecognizer
 {
-    if (self.resigningFirstResponderOnTap) {
-        [self.view resignFirstResponder];
+    UIView *editedView = self.editedView;
+    if ([editedView isFirstResponder]) {
+        [editedView resignFirstResponder];
     }
 }
 
@@ -0,0 +1,65 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+
+/**
+ * Creating a web view is expensive, especially the first one an application creates. A web view pool keeps a few
+ * web views ready for use, creating them when the main run loop has nothing else to do, so that they can be handed
+ * out when needed (e.g. when a web view controller is displayed) at virtually no cost. HLSWebViewController draws
+ * its web views from the shared pool, and you can use it as well for your own web views
+ *
+ * Pooled web views are WKWebView instances if available (iOS 8 and above), UIWebView instances otherwise. Since both
+ * classes only share UIView as common superclass, web views are returned as UIView instances, which you must cast
+ * appropriately
+ *
+ * Web views which are returned to the pool are reset (loading is stopped, delegates are removed and the view is
+ * removed from its superview). Web views cannot have their content and history cleared using public API, though.
+ * Returned web views which have loaded content are therefore discarded, and replaced with fresh instances during
+ * idle time
+ *
+ * This class must be used from the main thread
+ */
+@interface HLSWebViewPool : NSObject
+
+/**
+ * The shared pool instance
+ */
++ (instancetype)sharedWebViewPool;
+
+/**
+ * The maximum number of web views kept ready for use. No web view is created until the pool is used for the first
+ * time (prewarm or dequeue)
+ *
+ * Default value is 2
+ */
+@property (nonatomic, assign) NSUInteger capacity;
+
+/**
+ * The number of web views currently ready for use
+ */
+@property (nonatomic, readonly, assign) NSUInteger availableWebViewCount;
+
+/**
+ * Warm up the web engine and fill the pool during idle time. The pool is otherwise filled lazily after the first
+ * web view has been requested
+ */
+- (void)prewarm;
+
+/**
+ * Return a web view with the specified frame, either from the pool or created on the fly if the pool is empty. The
+ * pool is refilled during idle time
+ */
+- (UIView *)dequeueWebViewWithFrame:(CGRect)frame;
+
+/**
+ * Return a web view to the pool once you do not need it anymore. If you observed web view properties using KVO, you
+ * must stop observing them before calling this method
+ */
+- (void)enqueueWebView:(UIView *)webView;
+
+@end
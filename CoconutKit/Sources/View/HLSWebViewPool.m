@@ -0,0 +1,241 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import "HLSWebViewPool.h"
+
+#import "HLSLogger.h"
+
+#import <WebKit/WebKit.h>
+
+static const NSUInteger HLSWebViewPoolDefaultCapacity = 2;
+
+@interface HLSWebViewPool () <UIWebViewDelegate, WKNavigationDelegate>
+
+@property (nonatomic, strong) NSMutableArray *webViews;
+@property (nonatomic, strong) UIView *warmUpWebView;
+@property (nonatomic, assign, getter=isWarm) BOOL warm;
+@property (nonatomic, assign, getter=isUsed) BOOL used;
+
+@end
+
+@implementation HLSWebViewPool
+
+#pragma mark Class methods
+
++ (instancetype)sharedWebViewPool
+{
+    static HLSWebViewPool *s_instance = nil;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        s_instance = [[[self class] alloc] init];
+    });
+    return s_instance;
+}
+
+// TODO: Remove when CoconutKit requires at least iOS 8
++ (Class)webViewClass
+{
+    return [WKWebView class] ?: [UIWebView class];
+}
+
+#pragma mark Object creation and destruction
+
+- (instancetype)init
+{
+    if (self = [super init]) {
+        self.webViews = [NSMutableArray array];
+        self.capacity = HLSWebViewPoolDefaultCapacity;
+    }
+    return self;
+}
+
+#pragma mark Accessors and mutators
+
+- (void)setCapacity:(NSUInteger)capacity
+{
+    _capacity = capacity;
+    
+    if ([self.webViews count] > capacity) {
+        [self.webViews removeObjectsInRange:NSMakeRange(capacity, [self.webViews count] - capacity)];
+    }
+    else {
+        [self setNeedsFill];
+    }
+}
+
+- (NSUInteger)availableWebViewCount
+{
+    return [self.webViews count];
+}
+
+#pragma mark Pool management
+
+- (void)prewarm
+{
+    NSAssert([NSThread isMainThread], @"Must be called from the main thread");
+    
+    self.used = YES;
+    
+    if (! self.warm && ! self.warmUpWebView) {
+        // The first web view loading content starts the web engine. Load an empty page in a throwaway web view (pooled
+        // web views must not load anything so that their history remains empty). A large web view displayed out of
+        // screen bounds seems to be more effective
+        CGRect screenBounds = [UIScreen mainScreen].bounds;
+        UIView *warmUpWebView = [[[HLSWebViewPool webViewClass] alloc] initWithFrame:CGRectOffset(screenBounds,
+                                                                                                  CGRectGetWidth(screenBounds),
+                                                                                                  CGRectGetHeight(screenBounds))];
+        [[UIApplication sharedApplication].keyWindow addSubview:warmUpWebView];
+        
+        if ([WKWebView class]) {
+            ((WKWebView *)warmUpWebView).navigationDelegate = self;
+            [(WKWebView *)warmUpWebView loadHTMLString:@"" baseURL:nil];
+        }
+        else {
+            ((UIWebView *)warmUpWebView).delegate = self;
+            [(UIWebView *)warmUpWebView loadHTMLString:@"" baseURL:nil];
+        }
+        self.warmUpWebView = warmUpWebView;
+    }
+    
+    [self setNeedsFill];
+}
+
+- (UIView *)dequeueWebViewWithFrame:(CGRect)frame
+{
+    NSAssert([NSThread isMainThread], @"Must be called from the main thread");
+    
+    self.used = YES;
+    
+    UIView *webView = [self.webViews lastObject];
+    if (webView) {
+        [self.webViews removeLastObject];
+        webView.frame = frame;
+    }
+    else {
+        webView = [[[HLSWebViewPool webViewClass] alloc] initWithFrame:frame];
+    }
+    
+    [self setNeedsFill];
+    return webView;
+}
+
+- (void)enqueueWebView:(UIView *)webView
+{
+    NSAssert([NSThread isMainThread], @"Must be called from the main thread");
+    
+    if (! webView) {
+        return;
+    }
+    
+    if (! [webView isKindOfClass:[HLSWebViewPool webViewClass]]) {
+        HLSLoggerError(@"The web view %@ does not originate from the pool", webView);
+        return;
+    }
+    
+    // Reset the web view so that it does not send messages to its former owner anymore
+    BOOL hasContent = NO;
+    if ([WKWebView class]) {
+        WKWebView *wkWebView = (WKWebView *)webView;
+        [wkWebView stopLoading];
+        wkWebView.navigationDelegate = nil;
+        wkWebView.UIDelegate = nil;
+        wkWebView.scrollView.delegate = nil;
+        hasContent = wkWebView.URL || wkWebView.backForwardList.currentItem;
+    }
+    else {
+        UIWebView *uiWebView = (UIWebView *)webView;
+        [uiWebView stopLoading];
+        uiWebView.delegate = nil;
+        hasContent = uiWebView.request || uiWebView.canGoBack || uiWebView.canGoForward;
+    }
+    [webView removeFromSuperview];
+    
+    // History cannot be cleared, discard the web view and let the pool create a fresh one instead
+    if (hasContent || [self.webViews count] >= self.capacity || [self.webViews containsObject:webView]) {
+        [self setNeedsFill];
+        return;
+    }
+    
+    webView.alpha = 1.f;
+    webView.hidden = NO;
+    webView.userInteractionEnabled = YES;
+    webView.transform = CGAffineTransformIdentity;
+    webView.autoresizingMask = UIViewAutoresizingNone;
+    [self.webViews addObject:webView];
+}
+
+- (void)setNeedsFill
+{
+    // Web views are expensive. Only create them once the pool is actually used, not when it is merely instantiated or
+    // configured
+    if (! self.used || [self.webViews count] >= self.capacity) {
+        return;
+    }
+    
+    // Only scheduled in the default mode, so that web views are never created while the user is interacting with
+    // the application (e.g. scrolling)
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(fill) object:nil];
+    [self performSelector:@selector(fill) withObject:nil afterDelay:0. inModes:@[NSDefaultRunLoopMode]];
+}
+
+- (void)fill
+{
+    if ([self.webViews count] >= self.capacity) {
+        return;
+    }
+    
+    // Create a single web view per run loop iteration so that pending events can be processed in between
+    UIView *webView = [[[HLSWebViewPool webViewClass] alloc] initWithFrame:[UIScreen mainScreen].bounds];
+    [self.webViews addObject:webView];
+    
+    [self setNeedsFill];
+}
+
+#pragma mark WKNavigationDelegate protocol implementation
+
+- (void)webView:(WKWebView *)webView didFinishNavigation:(WKNavigation *)navigation
+{
+    [self warmUpWebViewDidFinishLoad:webView];
+}
+
+- (void)webView:(WKWebView *)webView didFailNavigation:(WKNavigation *)navigation withError:(NSError *)error
+{
+    [self warmUpWebViewDidFinishLoad:webView];
+}
+
+#pragma mark UIWebViewDelegate protocol implementation
+
+- (void)webViewDidFinishLoad:(UIWebView *)webView
+{
+    [self warmUpWebViewDidFinishLoad:webView];
+}
+
+- (void)webView:(UIWebView *)webView didFailLoadWithError:(NSError *)error
+{
+    [self warmUpWebViewDidFinishLoad:webView];
+}
+
+#pragma mark Warm-up
+
+- (void)warmUpWebViewDidFinishLoad:(UIView *)webView
+{
+    if (webView != self.warmUpWebView) {
+        return;
+    }
+    
+    // The web engine has been started and is kept alive by the pooled web views. The warm-up web view is not needed anymore
+    if ([WKWebView class]) {
+        ((WKWebView *)webView).navigationDelegate = nil;
+    }
+    else {
+        ((UIWebView *)webView).delegate = nil;
+    }
+    [webView removeFromSuperview];
+    self.warmUpWebView = nil;
+    self.warm = YES;
+}
+
+@end
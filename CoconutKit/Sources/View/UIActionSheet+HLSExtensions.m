@@ -33,12 +33,14 @@ static void swizzle_dismissWithClickedButtonIndex_animated(UIActionSheet *self,
 
 + (void)load
 {
+    HLSSwizzleGroup_Begin
     HLSSwizzleSelector(self, @selector(showFromToolbar:), swizzle_showFromToolbar, &s_showFromToolbar);
     HLSSwizzleSelector(self, @selector(showFromTabBar:), swizzle_showFromTabBar, &s_showFromTabBar);
     HLSSwizzleSelector(self, @selector(showFromBarButtonItem:animated:), swizzle_showFromBarButtonItem_animated, &s_showFromBarButtonItem_animated);
     HLSSwizzleSelector(self, @selector(showFromRect:inView:animated:), swizzle_showFromRect_inView_animated, &s_showFromRect_inView_animated);
     HLSSwizzleSelector(self, @selector(showInView:), swizzle_showInView, &s_showInView);
     HLSSwizzleSelector(self, @selector(dismissWithClickedButtonIndex:animated:), swizzle_dismissWithClickedButtonIndex_animated, &s_dismissWithClickedButtonIndex_animated);
+    HLSSwizzleGroup_End
 }
 
 #pragma mark Accessors and mutators
@@ -78,10 +78,12 @@ static void swizzle_setBackgroundColor(UILabel *self, SEL _cmd, UIColor *backgro
 
 + (void)load
 {
+    HLSSwizzleGroup_Begin
     HLSSwizzleSelector(self, sel_getUid("dealloc"), swizzle_dealloc, &s_dealloc);
     HLSSwizzleSelector(self, @selector(awakeFromNib), swizzle_awakeFromNib, &s_awakeFromNib);
     HLSSwizzleSelector(self, @selector(setText:), swizzle_setText, &s_setText);
     HLSSwizzleSelector(self, @selector(setBackgroundColor:), swizzle_setBackgroundColor, &s_setBackgroundColor);
+    HLSSwizzleGroup_End
 }
 
 #pragma mark Localization
@@ -290,6 +292,8 @@ static void swizzle_awakeFromNib(UILabel *self, SEL _cmd)
 
 static void swizzle_setText(UILabel *self, SEL _cmd, NSString *text)
 {
+    HLSSwizzleCountCall(&s_setText);
+    
     [self setAndLocalizeText:text];
 }
 
@@ -97,7 +97,9 @@ static NSDictionary *s_scrollViewOriginalIndicatorBottomInsets = nil;
 
 + (void)load
 {
+    HLSSwizzleGroup_Begin
     HLSSwizzleSelector(self, @selector(setContentOffset:), swizzle_setContentOffset, &s_setContentOffset);
+    HLSSwizzleGroup_End
 }
 
 #pragma mark Scrolling synchronization
@@ -285,6 +287,8 @@ __attribute__ ((constructor)) static void HLSTextFieldInit(void)
 
 static void swizzle_setContentOffset(UIScrollView *self, SEL _cmd, CGPoint contentOffset)
 {
+    HLSSwizzleCountCall(&s_setContentOffset);
+    
     s_setContentOffset(self, _cmd, contentOffset);
     [self synchronizeScrolling];
 }
@@ -10,85 +10,32 @@
 #import "HLSViewTouchDetector.h"
 
 // Associated object keys
-static void *s_touchDetectorKey = &s_touchDetectorKey;
-
-// Original implementation of the methods we swizzle
-static id (*s_initWithFrame)(id, SEL, CGRect) = NULL;
-static id (*s_initWithCoder)(id, SEL, id) = NULL;
-
-// Swizzled method implementations
-static id swizzle_initWithFrame(UITextField *self, SEL _cmd, CGRect frame);
-static id swizzle_initWithCoder(UITextField *self, SEL _cmd, NSCoder *aDecoder);
-
-@interface UITextField (HLSExtensionsPrivate)
-
-@property (nonatomic, strong) HLSViewTouchDetector *touchDetector;
-
-@end
+static void *s_resigningFirstResponderOnTapKey = &s_resigningFirstResponderOnTapKey;
 
 @implementation UITextField (HLSExtensions)
 
-#pragma mark Class methods
-
-+ (void)load
-{
-    HLSSwizzleSelector(self, @selector(initWithFrame:), swizzle_initWithFrame, &s_initWithFrame);
-    HLSSwizzleSelector(self, @selector(initWithCoder:), swizzle_initWithCoder, &s_initWithCoder);
-}
-
 #pragma mark Accessors and mutators
 
 - (BOOL)isResigningFirstResponderOnTap
 {
-    return self.touchDetector.resigningFirstResponderOnTap;
+    return [hls_getAssociatedObject(self, s_resigningFirstResponderOnTapKey) boolValue];
 }
 
 - (void)setResigningFirstResponderOnTap:(BOOL)resigningFirstResponderOnTap
 {
-    self.touchDetector.resigningFirstResponderOnTap = resigningFirstResponderOnTap;
-}
-
-@end
-
-@implementation UITextField (HLSExtensionsPrivate)
-
-#pragma mark Accessors and mutators
-
-- (HLSViewTouchDetector *)touchDetector
-{
-    return hls_getAssociatedObject(self, s_touchDetectorKey);
-}
-
-- (void)setTouchDetector:(HLSViewTouchDetector *)touchDetector
-{
-    hls_setAssociatedObject(self, s_touchDetectorKey, touchDetector, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
-}
-
-@end
-
-#pragma mark Common initialization
-
-static void commonInit(UITextField *self)
-{
-    self.touchDetector = [[HLSViewTouchDetector alloc] initWithView:self
-                                              beginNotificationName:UITextFieldTextDidBeginEditingNotification
-                                                endNotificationName:UITextFieldTextDidEndEditingNotification];
-}
-
-#pragma mark Swizzled method implementations
-
-static id swizzle_initWithFrame(UITextField *self, SEL _cmd, CGRect frame)
-{
-    if ((self = s_initWithFrame(self, _cmd, frame))) {
-        commonInit(self);
+    if (resigningFirstResponderOnTap == self.resigningFirstResponderOnTap) {
+        return;
     }
-    return self;
-}
-
-static id swizzle_initWithCoder(UITextField *self, SEL _cmd, NSCoder *aDecoder)
-{
-    if ((self = s_initWithCoder(self, _cmd, aDecoder))) {
-        commonInit(self);
+    
+    hls_setAssociatedObject(self, s_resigningFirstResponderOnTapKey, @(resigningFirstResponderOnTap), OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    
+    // The shared touch detector is only instantiated when first needed
+    if (resigningFirstResponderOnTap) {
+        [[HLSViewTouchDetector sharedViewTouchDetector] registerView:self];
+    }
+    else {
+        [[HLSViewTouchDetector sharedViewTouchDetector] unregisterView:self];
     }
-    return self;
 }
+
+@end
@@ -28,7 +28,9 @@ static BOOL swizzle_becomeFirstResponder(UIView *self, SEL _cmd);
 
 + (void)load
 {
+    HLSSwizzleGroup_Begin
     HLSSwizzleSelector(self, @selector(becomeFirstResponder), swizzle_becomeFirstResponder, &s_UIView_becomeFirstResponder);
+    HLSSwizzleGroup_End
 }
 
 #pragma mark Accessors and mutators
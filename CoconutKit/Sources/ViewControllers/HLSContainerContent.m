@@ -362,9 +362,11 @@ static BOOL swizzle_isMovingFromParentViewController(UIViewController *self, SEL
 
 + (void)load
 {
+    HLSSwizzleGroup_Begin
     // Swizzle the methods introduced by the containment API so that view controllers can get a correct information even when inserted into a custom container
     HLSSwizzleSelector(self, @selector(isMovingToParentViewController), swizzle_isMovingToParentViewController, &s_isMovingToParentViewController);
     HLSSwizzleSelector(self, @selector(isMovingFromParentViewController), swizzle_isMovingFromParentViewController, &s_isMovingFromParentViewController);
+    HLSSwizzleGroup_End
 }
 
 @end
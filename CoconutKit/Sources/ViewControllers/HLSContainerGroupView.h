@@ -47,9 +47,22 @@
 /**
  * The back content view wrapper. If you want to animate the group view, animate this view (which has
  * a guaranteed initial alpha of 1.f)
+ *
+ * The back view is created as a subview of the group view, but it can be moved elsewhere (see HLSContainerStackView
+ * flat mode), in which case -attachBackView must be called before animating the group view
  */
 @property (nonatomic, readonly, strong) UIView *backView;
 
+/**
+ * Return YES iff the back view exists and is a subview of the group view
+ */
+@property (nonatomic, readonly, assign, getter=isBackViewAttached) BOOL backViewAttached;
+
+/**
+ * Move the back view back into the group view (below the front view) if it had been moved elsewhere
+ */
+- (void)attachBackView;
+
 @end
 
 @interface HLSContainerGroupView (UnavailableMethods)
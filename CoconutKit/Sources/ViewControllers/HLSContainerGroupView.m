@@ -10,6 +10,13 @@
 #import "NSArray+HLSExtensions.h"
 #import "UIView+HLSExtensions.h"
 
+@interface HLSContainerGroupView ()
+
+@property (nonatomic, strong) UIView *frontView;
+@property (nonatomic, strong) UIView *backView;
+
+@end
+
 @implementation HLSContainerGroupView
 
 #pragma mark Object creation and destruction
@@ -37,6 +44,7 @@
         [frontView addSubview:frontContentView];
         
         [self addSubview:frontView];
+        self.frontView = frontView;
     }
     return self;
 }
@@ -48,11 +56,6 @@
     return [self.frontView.subviews firstObject];
 }
 
-- (UIView *)frontView
-{
-    return [self.subviews lastObject];
-}
-
 - (UIView *)backContentView
 {
     return [self.backView.subviews firstObject];
@@ -63,6 +66,7 @@
     UIView *backView = self.backView;
     if (! backContentView) {
         [backView removeFromSuperview];
+        self.backView = nil;
         return;
     }
     
@@ -73,6 +77,7 @@
         backView.backgroundColor = [UIColor clearColor];
         backView.autoresizingMask = HLSViewAutoresizingAll;
         [self insertSubview:backView atIndex:0];
+        self.backView = backView;
     }
     
     // Remark: If backContentView was previously added to another superview, it is removed while kept alive. No need for
@@ -80,14 +85,21 @@
     [backView addSubview:backContentView];
 }
 
-- (UIView *)backView
+- (BOOL)isBackViewAttached
 {
-    if ([self.subviews count] == 2) {
-        return [self.subviews firstObject];
+    return self.backView && self.backView.superview == self;
+}
+
+#pragma mark Back view management
+
+- (void)attachBackView
+{
+    if (! self.backView || self.backViewAttached) {
+        return;
     }
-    else {
-        return nil;
-    }    
+    
+    // Remark: The back view is removed from its current superview automatically
+    [self insertSubview:self.backView atIndex:0];
 }
 
 @end
@@ -173,6 +173,18 @@ extern const NSUInteger HLSContainerStackUnlimitedCapacity;
  */
 @property (nonatomic, assign) BOOL lockingUI;
 
+/**
+ * By default, child view controller's views are nested into each other so that transition animations and alphas are
+ * collectively applied to all views below (see HLSContainerStackView.h for more information). For stacks with a large
+ * capacity (e.g. HLSContainerStackUnlimitedCapacity) and many children, the resulting view hierarchy gets deep, which
+ * makes layout and rotation expensive. Set this property to YES to keep the view hierarchy flat instead. Disappearing
+ * views are then only affected by the transition animation of the view controller directly above them, which is fine
+ * as long as transitions hide or move disappearing views offscreen (this is the case for most transitions)
+ *
+ * This property must be set before the container view is set. Default is NO
+ */
+@property (nonatomic, assign) BOOL flatViewHierarchy;
+
 /**
  * Return the root view controller loaded into the stack, or nil if none
  */
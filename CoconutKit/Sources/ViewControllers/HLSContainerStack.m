@@ -12,6 +12,7 @@
 #import "HLSLogger.h"
 #import "NSArray+HLSExtensions.h"
 #import "UIViewController+HLSExtensions.h"
+#import "UIViewController+HLSExtensionsFriend.h"
 
 // Constants
 const NSUInteger HLSContainerStackMinimalCapacity = 1;
@@ -97,6 +98,7 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
         
         // Create the container base view maintaining the whole container view hiearchy
         HLSContainerStackView *containerStackView = [[HLSContainerStackView alloc] initWithFrame:containerView.bounds];
+        containerStackView.flat = self.flatViewHierarchy;
         containerStackView.delegate = self;
         [containerView addSubview:containerStackView];
     }
@@ -104,6 +106,16 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
     _containerView = containerView;
 }
 
+- (void)setFlatViewHierarchy:(BOOL)flatViewHierarchy
+{
+    if (self.containerView) {
+        HLSLoggerWarn(@"The view hierarchy mode must be set before the container view is set");
+        return;
+    }
+    
+    _flatViewHierarchy = flatViewHierarchy;
+}
+
 - (HLSContainerStackView *)containerStackView
 {
     return [self.containerView.subviews firstObject];
@@ -318,6 +330,8 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
         // Notify the delegate before the view controller is actually installed on top of the stack and associated with the
         // container (see HLSContainerStackDelegate interface contract)
         if (index == [self.containerContents count]) {
+            [viewController recordPushForLifeCycleProfiling];
+            
             if ([self.delegate respondsToSelector:@selector(containerStack:willPushViewController:coverViewController:animated:)]) {
                 [self.delegate containerStack:self
                        willPushViewController:viewController
@@ -445,7 +459,7 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
             [self addViewForContainerContent:containerContentAtCapacity inserting:NO animated:NO];
         }
         
-        HLSContainerGroupView *groupView = [[self containerStackView] groupViewForContentView:[containerContent viewIfLoaded]];
+        HLSContainerGroupView *groupView = [[self containerStackView] transitionGroupViewForContentView:[containerContent viewIfLoaded]];
         
         HLSAnimation *reverseAnimation = [containerContent.transitionClass reverseAnimationWithAppearingView:groupView.backView
                                                                                             disappearingView:groupView.frontView
@@ -654,6 +668,9 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
                 // where the frame is the final one obtained after rotation. This trick is invisible to the user and avoids
                 // having issues because of view rotation (this can lead to small floating-point imprecisions, leading to
                 // non-integral frames, and thus to blurry views)
+                //
+                // Animations are only replayed to reset view states, and do not require the back view to be attached to
+                // its group view in flat mode (it is a sibling with the same frame). The views are therefore not moved
                 HLSContainerGroupView *groupView = [[self containerStackView] groupViewForContentView:[containerContent viewIfLoaded]];
                 
                 // If the container view controller presents a modal on its view (i.e. defines a presentation context and
@@ -850,7 +867,7 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
             HLSContainerContent *aboveContainerContent = [self.containerContents objectAtIndex:i];
             if (aboveContainerContent.isAddedToContainerView) {
                 [containerContent insertAsSubviewIntoContainerStackView:stackView
-                                                                atIndex:[stackView.contentViews indexOfObject:[aboveContainerContent viewIfLoaded]]];
+                                                                atIndex:[stackView indexOfContentView:[aboveContainerContent viewIfLoaded]]];
                 inserted = YES;
                 break;
             }
@@ -863,7 +880,7 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
         
         // Play the corresponding animation to put the view into the correct location
         HLSContainerContent *aboveContainerContent = [self.containerContents objectAtIndex:index + 1];
-        HLSContainerGroupView *aboveGroupView = [[self containerStackView] groupViewForContentView:[aboveContainerContent viewIfLoaded]];
+        HLSContainerGroupView *aboveGroupView = [[self containerStackView] transitionGroupViewForContentView:[aboveContainerContent viewIfLoaded]];
         HLSAnimation *aboveAnimation = [aboveContainerContent.transitionClass animationWithAppearingView:nil      /* only play the animation for the view we added */
                                                                                         disappearingView:aboveGroupView.backView
                                                                                                   inView:aboveGroupView
@@ -873,7 +890,7 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
     }
     
     // Play the corresponding animation so that the view controllers are brought into correct positions
-    HLSContainerGroupView *groupView = [[self containerStackView] groupViewForContentView:[containerContent viewIfLoaded]];
+    HLSContainerGroupView *groupView = [[self containerStackView] transitionGroupViewForContentView:[containerContent viewIfLoaded]];
     HLSAnimation *animation = [containerContent.transitionClass animationWithAppearingView:groupView.frontView
                                                                           disappearingView:groupView.backView
                                                                                     inView:groupView
@@ -99,6 +99,35 @@
  *
  * The HLSContainerStackView class simply implements the above view hierarchy and provides methods for easy insertion
  * and removal of views.
+ *
+ * For deep stacks, the nesting depth of the above hierarchy (about three views per level) makes layout, hit testing
+ * and rotation increasingly expensive. A flat mode is therefore available, in which group views are kept side by
+ * side. The back view of a group view (containing the group view below) is then a sibling of the group view, and is
+ * only moved back into the group view while a transition involving the two group views is made (the pairing is 
+ * then kept until the next insertion or removal, or until another pairing is made):
+ *
+ *       container view
+ *         |
+ *         \- HLSContainerStackView
+ *              |
+ *              |-- back view of group view 1
+ *              |     |
+ *              |     \-- group view 0 (HLSContainerGroupView) -- child view 0 (bottom)
+ *              |
+ *              |-- back view of group view 2
+ *              |     |
+ *              |     \-- group view 1 (HLSContainerGroupView) -- child view 1
+ *              .
+ *              .
+ *              |-- back view of group view N
+ *              |     |
+ *              |     \-- group view N-1 (HLSContainerGroupView) -- child view N-1
+ *              |
+ *              \-- group view N (HLSContainerGroupView) -- child view N (top)
+ *
+ * In flat mode, the alpha and transform applied to a back view only affect the group view directly below, not all
+ * the views further down. This makes no difference when disappearing views end up hidden or moved offscreen (as is
+ * the case for most transitions), but transitions leaving views partially visible can look different when mixed
  */
 @interface HLSContainerStackView : UIView
 
@@ -107,6 +136,12 @@
  */
 - (instancetype)initWithFrame:(CGRect)frame NS_DESIGNATED_INITIALIZER;
 
+/**
+ * If set to YES, the flat view hierarchy described above is used. This property can only be changed when the
+ * stack view is empty. Default value is NO
+ */
+@property (nonatomic, assign, getter=isFlat) BOOL flat;
+
 /**
  * Return the array of views used to display content (child views), from the bottommost to the topmost one
  */
@@ -122,11 +157,22 @@
  */
 - (void)removeContentView:(UIView *)contentView;
 
+/**
+ * Return the index of a content view, NSNotFound if not found
+ */
+- (NSUInteger)indexOfContentView:(UIView *)contentView;
+
 /**
  * Return the group view containing a given view as topmost subview. Return nil if not found
  */
 - (HLSContainerGroupView *)groupViewForContentView:(UIView *)contentView;
 
+/**
+ * Same as -groupViewForContentView:, but ensures that the back view of the group view is attached to it so that 
+ * a transition animation can be played on the group view. Always use this method when an animation is involved
+ */
+- (HLSContainerGroupView *)transitionGroupViewForContentView:(UIView *)contentView;
+
 @property (nonatomic, weak) id<HLSContainerStackViewDelegate> delegate;
 
 @end
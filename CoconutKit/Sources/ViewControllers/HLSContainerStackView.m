@@ -11,7 +11,10 @@
 
 @interface HLSContainerStackView ()
 
-@property (nonatomic, strong) NSMutableArray *groupViews;           // The HLSContainerGroupView in the hierarchy, from the bottommost to the topmost one
+@property (nonatomic, strong) NSMutableArray *groupViews;                       // The HLSContainerGroupView in the hierarchy, from the bottommost to the topmost one
+@property (nonatomic, strong) NSMapTable *contentViewToGroupViewMap;            // Map content views to their group view
+@property (nonatomic, strong) NSMapTable *contentViewToIndexMap;                // Map content views to their index (NSNumber)
+@property (nonatomic, weak) HLSContainerGroupView *attachedGroupView;           // Flat mode: The group view whose back view is currently attached
 
 @end
 
@@ -23,6 +26,10 @@
 {
     if (self = [super initWithFrame:frame]) {
         self.groupViews = [NSMutableArray array];
+        self.contentViewToGroupViewMap = [NSMapTable mapTableWithKeyOptions:NSMapTableStrongMemory | NSMapTableObjectPointerPersonality
+                                                               valueOptions:NSMapTableStrongMemory];
+        self.contentViewToIndexMap = [NSMapTable mapTableWithKeyOptions:NSMapTableStrongMemory | NSMapTableObjectPointerPersonality
+                                                           valueOptions:NSMapTableStrongMemory];
         self.backgroundColor = [UIColor clearColor];
         self.autoresizingMask = HLSViewAutoresizingAll;
     }
@@ -38,18 +45,30 @@
     [self.delegate containerStackViewDidChangeFrame:self];
 }
 
+- (void)setFlat:(BOOL)flat
+{
+    if (_flat == flat) {
+        return;
+    }
+    
+    if ([self.groupViews count] != 0) {
+        HLSLoggerWarn(@"The view hierarchy mode can only be changed when the stack view is empty");
+        return;
+    }
+    
+    _flat = flat;
+}
+
 #pragma mark View management
 
 - (NSUInteger)indexOfContentView:(UIView *)contentView
 {
-    NSUInteger i = 0;
-    for (HLSContainerGroupView *groupView in self.groupViews) {
-        if (groupView.frontContentView == contentView) {
-            return i;
-        }
-        ++i;
+    if (! contentView) {
+        return NSNotFound;
     }
-    return NSNotFound;
+    
+    NSNumber *index = [self.contentViewToIndexMap objectForKey:contentView];
+    return index ? [index unsignedIntegerValue] : NSNotFound;
 }
 
 - (NSArray *)contentViews
@@ -68,6 +87,8 @@
         return;
     }
     
+    [self detachAttachedBackView];
+    
     // Add to the top
     if (index == [self.groupViews count]) {
         HLSContainerGroupView *topGroupView = [self.groupViews lastObject];
@@ -77,6 +98,10 @@
         
         [self.groupViews addObject:newGroupView];
         [self addSubview:newGroupView];
+        
+        if (self.flat) {
+            [self detachBackViewForGroupView:newGroupView];
+        }
     }
     // Insert in the middle
     else {
@@ -88,7 +113,15 @@
         groupViewAtIndex.backContentView = newGroupView;
         
         [self.groupViews insertObject:newGroupView atIndex:index];
+        
+        // The back view of the group view above must be detached first, so that the new back view can be inserted below it
+        if (self.flat) {
+            [self detachBackViewForGroupView:groupViewAtIndex];
+            [self detachBackViewForGroupView:newGroupView];
+        }
     }
+    
+    [self updateMapsFromIndex:index];
 }
 
 - (void)removeContentView:(UIView *)contentView
@@ -99,6 +132,8 @@
         return;
     }
     
+    [self detachAttachedBackView];
+    
     HLSContainerGroupView *groupView = [self.groupViews objectAtIndex:index];
     HLSContainerGroupView *belowGroupView = (index > 0) ? [self.groupViews objectAtIndex:index - 1] : nil;
     
@@ -106,28 +141,96 @@
     if (index == [self.groupViews count] - 1) {
         // No need to call -removeFromSuperview, the view is moved between superviews automatically. No need
         // for a retain-autorelease: The view is kept alive during this process. See UIView documentation
-        [self insertSubview:belowGroupView atIndex:0];
+        if (self.flat) {
+            if (belowGroupView) {
+                [self insertSubview:belowGroupView belowSubview:groupView];
+            }
+            
+            // Discard the back view, which is a sibling in flat mode
+            groupView.backContentView = nil;
+        }
+        else {
+            [self insertSubview:belowGroupView atIndex:0];
+        }
     }
     // Remove in the middle
     else {
         HLSContainerGroupView *aboveGroupView = [self.groupViews objectAtIndex:index + 1];
         aboveGroupView.backContentView = belowGroupView;
+        
+        if (self.flat) {
+            groupView.backContentView = nil;
+        }
     }
     
     [groupView removeFromSuperview];
     [self.groupViews removeObjectAtIndex:index];
+    
+    [self.contentViewToGroupViewMap removeObjectForKey:contentView];
+    [self.contentViewToIndexMap removeObjectForKey:contentView];
+    [self updateMapsFromIndex:index];
 }
 
 - (HLSContainerGroupView *)groupViewForContentView:(UIView *)contentView
 {
-    NSUInteger i = 0;
-    for (HLSContainerGroupView *groupView in self.groupViews) {
-        if (groupView.frontContentView == contentView) {
-            return groupView;
-        }
-        ++i;
+    if (! contentView) {
+        return nil;
+    }
+    
+    return [self.contentViewToGroupViewMap objectForKey:contentView];
+}
+
+- (HLSContainerGroupView *)transitionGroupViewForContentView:(UIView *)contentView
+{
+    HLSContainerGroupView *groupView = [self groupViewForContentView:contentView];
+    if (! self.flat || ! groupView || groupView == self.attachedGroupView) {
+        return groupView;
+    }
+    
+    // Only one pairing at a time, so that the hierarchy depth stays bounded
+    [self detachAttachedBackView];
+    
+    if (groupView.backView) {
+        [groupView attachBackView];
+        self.attachedGroupView = groupView;
+    }
+    return groupView;
+}
+
+/**
+ * Update the lookup maps for all group views starting at the given index
+ */
+- (void)updateMapsFromIndex:(NSUInteger)index
+{
+    for (NSUInteger i = index; i < [self.groupViews count]; ++i) {
+        HLSContainerGroupView *groupView = [self.groupViews objectAtIndex:i];
+        [self.contentViewToGroupViewMap setObject:groupView forKey:groupView.frontContentView];
+        [self.contentViewToIndexMap setObject:@(i) forKey:groupView.frontContentView];
     }
-    return nil;
+}
+
+/**
+ * Flat mode: Move the back view of a group view into the stack view, right below the view containing the group view
+ * (the group view itself if at the top, otherwise the back view of the group view above)
+ */
+- (void)detachBackViewForGroupView:(HLSContainerGroupView *)groupView
+{
+    if (! groupView.backViewAttached) {
+        return;
+    }
+    
+    UIView *containingView = (groupView.superview == self) ? groupView : groupView.superview;
+    [self insertSubview:groupView.backView belowSubview:containingView];
+}
+
+- (void)detachAttachedBackView
+{
+    if (! self.attachedGroupView) {
+        return;
+    }
+    
+    [self detachBackViewForGroupView:self.attachedGroupView];
+    self.attachedGroupView = nil;
 }
 
 @end
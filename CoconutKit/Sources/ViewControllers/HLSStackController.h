@@ -103,6 +103,15 @@
  */
 @property (nonatomic, assign) BOOL lockingUI;
 
+/**
+ * If set to YES, child view controller's views are not nested into each other, which is faster for stacks with a large
+ * capacity. Refer to the HLSContainerStack flatViewHierarchy property documentation for more information. Must be set
+ * before the stack controller view is loaded
+ *
+ * Default is NO
+ */
+@property (nonatomic, assign) BOOL flatViewHierarchy;
+
 /**
  * Return the view controller at the bottom
  */
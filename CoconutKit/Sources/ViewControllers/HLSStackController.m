@@ -146,6 +146,16 @@
     return self.containerStack.lockingUI;
 }
 
+- (void)setFlatViewHierarchy:(BOOL)flatViewHierarchy
+{
+    self.containerStack.flatViewHierarchy = flatViewHierarchy;
+}
+
+- (BOOL)flatViewHierarchy
+{
+    return self.containerStack.flatViewHierarchy;
+}
+
 #pragma mark View lifecycle
 
 - (BOOL)shouldAutomaticallyForwardAppearanceMethods
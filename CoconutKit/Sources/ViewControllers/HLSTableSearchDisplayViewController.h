@@ -4,6 +4,7 @@
 //  Licence information is available from the LICENCE file.
 //
 
+#import "HLSSearchEngine.h"
 #import "HLSViewController.h"
 
 #import <Foundation/Foundation.h>
@@ -33,6 +34,11 @@
  * UISearchDisplayDelegate methods to return YES when the table view needs reloading. These methods are called each 
  * time the search string or the search scope are changed.
  *
+ * Filtering large lists synchronously on each keystroke freezes typing. In such cases, set a search engine instead
+ * (see HLSSearchEngine). Queries are then debounced and filtered in the background, and search results table view rows
+ * are updated when results are available. The data source methods must then use the searchEngine results when called
+ * for the searchResultsTableView. If you override the two methods above, return the value of their super counterpart.
+ *
  * This class only implements the standard UISearchDisplayController behavior (scope buttons are only active when a
  * search string has been entered). Having scope buttons active even if no search criterium is entered requires
  * further investigation (it would be nice to implement this behavior using UISearchDisplayController. Otherwise
@@ -66,4 +72,10 @@
  */
 @property (nonatomic, readonly, weak) UITableView *searchResultsTableView;
 
+/**
+ * If set, the search engine is used to filter search results (see class documentation). Results are displayed in a
+ * single section. Searches are made for the search bar text and selected scope button index
+ */
+@property (nonatomic, strong) HLSSearchEngine *searchEngine;
+
 @end
@@ -12,6 +12,9 @@
 // Height of the UIKit search bar
 static const CGFloat kSearchBarStandardHeight = 44.f;
 
+// Above this number of changed rows, reloading the search results table view is faster than animating changes
+static const NSUInteger kMaximumAnimatedRowChangeCount = 200;
+
 @interface HLSTableSearchDisplayViewController ()
 
 @property (nonatomic, strong) UISearchBar *searchBar;
@@ -80,7 +83,7 @@ static const CGFloat kSearchBarStandardHeight = 44.f;
 
 - (void)searchDisplayControllerWillEndSearch:(UISearchDisplayController *)controller
 {
-    // Must provide a dummy implementation for subclasses (which are asked to call the super methods)
+    [self.searchEngine cancel];
 }
 
 - (void)searchDisplayControllerDidEndSearch:(UISearchDisplayController *)controller
@@ -120,14 +123,60 @@ static const CGFloat kSearchBarStandardHeight = 44.f;
 
 - (BOOL)searchDisplayController:(UISearchDisplayController *)controller shouldReloadTableForSearchString:(NSString *)searchString
 {
-    // Must provide a dummy implementation for subclasses (which are asked to call the super methods)
-    return YES;
+    if (! self.searchEngine) {
+        return YES;
+    }
+    
+    [self searchForString:searchString scope:self.searchBar.selectedScopeButtonIndex];
+    return NO;
 }
 
 - (BOOL)searchDisplayController:(UISearchDisplayController *)controller shouldReloadTableForSearchScope:(NSInteger)searchOption
 {
-    // Must provide a dummy implementation for subclasses (which are asked to call the super methods)
-    return YES;
+    if (! self.searchEngine) {
+        return YES;
+    }
+    
+    [self searchForString:self.searchBar.text scope:searchOption];
+    return NO;
+}
+
+#pragma mark Search engine
+
+- (void)searchForString:(NSString *)searchString scope:(NSInteger)scope
+{
+    __weak __typeof(self) weakSelf = self;
+    [self.searchEngine searchForString:searchString scope:scope completionBlock:^(NSArray *results, NSIndexSet *deletedIndexes, NSIndexSet *insertedIndexes) {
+        [weakSelf updateSearchResultsTableViewWithDeletedIndexes:deletedIndexes insertedIndexes:insertedIndexes];
+    }];
+}
+
+- (void)updateSearchResultsTableViewWithDeletedIndexes:(NSIndexSet *)deletedIndexes insertedIndexes:(NSIndexSet *)insertedIndexes
+{
+    if ([deletedIndexes count] == 0 && [insertedIndexes count] == 0) {
+        return;
+    }
+    
+    UITableView *searchResultsTableView = self.searchResultsTableView;
+    if (! searchResultsTableView.window || [deletedIndexes count] + [insertedIndexes count] > kMaximumAnimatedRowChangeCount) {
+        [searchResultsTableView reloadData];
+        return;
+    }
+    
+    NSMutableArray *deletedIndexPaths = [NSMutableArray arrayWithCapacity:[deletedIndexes count]];
+    [deletedIndexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+        [deletedIndexPaths addObject:[NSIndexPath indexPathForRow:index inSection:0]];
+    }];
+    
+    NSMutableArray *insertedIndexPaths = [NSMutableArray arrayWithCapacity:[insertedIndexes count]];
+    [insertedIndexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+        [insertedIndexPaths addObject:[NSIndexPath indexPathForRow:index inSection:0]];
+    }];
+    
+    [searchResultsTableView beginUpdates];
+    [searchResultsTableView deleteRowsAtIndexPaths:deletedIndexPaths withRowAnimation:UITableViewRowAnimationFade];
+    [searchResultsTableView insertRowsAtIndexPaths:insertedIndexPaths withRowAnimation:UITableViewRowAnimationFade];
+    [searchResultsTableView endUpdates];
 }
 
 #pragma mark UITableViewDataSource protocol implementation
@@ -0,0 +1,24 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import "HLSViewControllerLifeCycleProfiler.h"
+
+#import <Foundation/Foundation.h>
+
+/**
+ * Interface meant to be used by friend classes of HLSViewControllerLifeCycleProfiler (= classes which must have access
+ * to private implementation details)
+ */
+@interface HLSViewControllerLifeCycleProfiler (Friend)
+
+/**
+ * Record a duration. Does nothing if profiling is disabled
+ */
+- (void)recordDuration:(NSTimeInterval)duration
+             forMetric:(HLSViewControllerLifeCycleMetric)metric
+   viewControllerClass:(Class)viewControllerClass;
+
+@end
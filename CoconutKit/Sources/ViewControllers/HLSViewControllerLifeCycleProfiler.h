@@ -0,0 +1,76 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+
+// Profiled view controller lifecycle durations
+typedef NS_ENUM(NSInteger, HLSViewControllerLifeCycleMetric) {
+    HLSViewControllerLifeCycleMetricEnumBegin = 0,
+    HLSViewControllerLifeCycleMetricInit = HLSViewControllerLifeCycleMetricEnumBegin,      // UIViewController designated initializer (-initWithNibName:bundle: or -initWithCoder:)
+    HLSViewControllerLifeCycleMetricViewLoading,                                            // View creation on first access, including -loadView and -viewDidLoad
+    HLSViewControllerLifeCycleMetricAppearance,                                             // From -viewWillAppear: to -viewDidAppear:
+    HLSViewControllerLifeCycleMetricDisappearance,                                          // From -viewWillDisappear: to -viewDidDisappear:
+    HLSViewControllerLifeCycleMetricPushToAppearance,                                       // From a push into an HLSContainerStack to -viewDidAppear:
+    HLSViewControllerLifeCycleMetricEnumEnd,
+    HLSViewControllerLifeCycleMetricEnumSize = HLSViewControllerLifeCycleMetricEnumEnd - HLSViewControllerLifeCycleMetricEnumBegin
+};
+
+/**
+ * Collects view controller lifecycle durations per view controller class, for all view controllers. Profiling is
+ * opt-in and disabled by default. When disabled, the lifecycle hooks of UIViewController (HLSExtensions) do not
+ * measure anything. View loading is measured by an additional hook on -[UIViewController view], only installed
+ * when profiling is enabled for the first time
+ *
+ * Since the hooks are installed at the UIViewController level, initialization durations only include the time spent
+ * in the UIViewController designated initializer (e.g. nib or storyboard decoding), not the time spent in subclass
+ * initializers. Other durations include the work done by subclasses
+ *
+ * Profiles can be read from tests using the count and duration accessors, or dumped as a JSON file. Only use the
+ * profiler from the main thread
+ */
+@interface HLSViewControllerLifeCycleProfiler : NSObject
+
+/**
+ * The shared profiler instance
+ */
++ (instancetype)sharedProfiler;
+
+/**
+ * Enable or disable profiling
+ *
+ * Default value is NO
+ */
+@property (nonatomic, assign, getter=isEnabled) BOOL enabled;
+
+/**
+ * Number of durations recorded for a metric and a view controller class (subclasses are profiled separately)
+ */
+- (NSUInteger)countForMetric:(HLSViewControllerLifeCycleMetric)metric viewControllerClass:(Class)viewControllerClass;
+
+/**
+ * Cumulative, respectively maximum duration recorded for a metric and a view controller class
+ */
+- (NSTimeInterval)totalDurationForMetric:(HLSViewControllerLifeCycleMetric)metric viewControllerClass:(Class)viewControllerClass;
+- (NSTimeInterval)maximumDurationForMetric:(HLSViewControllerLifeCycleMetric)metric viewControllerClass:(Class)viewControllerClass;
+
+/**
+ * Return the profile as a dictionary containing property list objects only. Keys are class names, values are
+ * dictionaries mapping metric names to their count, total, average and maximum durations (in milliseconds)
+ */
+- (NSDictionary *)profileDictionary;
+
+/**
+ * Write the profile as a JSON file at the given path. Return YES iff successful
+ */
+- (BOOL)writeProfileToFile:(NSString *)filePath error:(NSError *__autoreleasing *)pError;
+
+/**
+ * Discard all recorded durations
+ */
+- (void)reset;
+
+@end
@@ -0,0 +1,186 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import "HLSViewControllerLifeCycleProfiler.h"
+
+#import "HLSViewControllerLifeCycleProfiler+Friend.h"
+#import "UIViewController+HLSExtensionsFriend.h"
+
+typedef struct {
+    NSUInteger count;
+    NSTimeInterval totalDuration;
+    NSTimeInterval maximumDuration;
+} HLSLifeCycleStatistics;
+
+// Function declarations
+static NSString *metricName(HLSViewControllerLifeCycleMetric metric);
+
+#pragma mark -
+#pragma mark HLSViewControllerLifeCycleClassProfile class
+
+/**
+ * Statistics for all metrics of a view controller class
+ */
+@interface HLSViewControllerLifeCycleClassProfile : NSObject {
+@public
+    HLSLifeCycleStatistics _statistics[HLSViewControllerLifeCycleMetricEnumSize];
+}
+
+@end
+
+@implementation HLSViewControllerLifeCycleClassProfile
+
+@end
+
+#pragma mark -
+#pragma mark HLSViewControllerLifeCycleProfiler class implementation
+
+@interface HLSViewControllerLifeCycleProfiler ()
+
+@property (nonatomic, strong) NSMutableDictionary *classNameToProfileMap;
+
+@end
+
+@implementation HLSViewControllerLifeCycleProfiler
+
+#pragma mark Class methods
+
++ (instancetype)sharedProfiler
+{
+    static HLSViewControllerLifeCycleProfiler *s_instance = nil;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        s_instance = [[[self class] alloc] init];
+    });
+    return s_instance;
+}
+
+#pragma mark Object creation and destruction
+
+- (instancetype)init
+{
+    if (self = [super init]) {
+        self.classNameToProfileMap = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+#pragma mark Accessors and mutators
+
+- (void)setEnabled:(BOOL)enabled
+{
+    _enabled = enabled;
+    
+    if (enabled) {
+        [UIViewController installViewLoadingProfilingHook];
+    }
+}
+
+#pragma mark Statistics
+
+- (HLSLifeCycleStatistics)statisticsForMetric:(HLSViewControllerLifeCycleMetric)metric viewControllerClass:(Class)viewControllerClass
+{
+    NSAssert(metric >= HLSViewControllerLifeCycleMetricEnumBegin && metric < HLSViewControllerLifeCycleMetricEnumEnd, @"Invalid metric");
+    
+    HLSViewControllerLifeCycleClassProfile *classProfile = [self.classNameToProfileMap objectForKey:NSStringFromClass(viewControllerClass)];
+    if (! classProfile) {
+        return (HLSLifeCycleStatistics){0};
+    }
+    return classProfile->_statistics[metric];
+}
+
+- (NSUInteger)countForMetric:(HLSViewControllerLifeCycleMetric)metric viewControllerClass:(Class)viewControllerClass
+{
+    return [self statisticsForMetric:metric viewControllerClass:viewControllerClass].count;
+}
+
+- (NSTimeInterval)totalDurationForMetric:(HLSViewControllerLifeCycleMetric)metric viewControllerClass:(Class)viewControllerClass
+{
+    return [self statisticsForMetric:metric viewControllerClass:viewControllerClass].totalDuration;
+}
+
+- (NSTimeInterval)maximumDurationForMetric:(HLSViewControllerLifeCycleMetric)metric viewControllerClass:(Class)viewControllerClass
+{
+    return [self statisticsForMetric:metric viewControllerClass:viewControllerClass].maximumDuration;
+}
+
+- (void)reset
+{
+    [self.classNameToProfileMap removeAllObjects];
+}
+
+#pragma mark Export
+
+- (NSDictionary *)profileDictionary
+{
+    NSMutableDictionary *profileDictionary = [NSMutableDictionary dictionary];
+    [self.classNameToProfileMap enumerateKeysAndObjectsUsingBlock:^(NSString *className, HLSViewControllerLifeCycleClassProfile *classProfile, BOOL *stop) {
+        NSMutableDictionary *classProfileDictionary = [NSMutableDictionary dictionary];
+        for (HLSViewControllerLifeCycleMetric metric = HLSViewControllerLifeCycleMetricEnumBegin; metric < HLSViewControllerLifeCycleMetricEnumEnd; ++metric) {
+            HLSLifeCycleStatistics statistics = classProfile->_statistics[metric];
+            if (statistics.count == 0) {
+                continue;
+            }
+            
+            [classProfileDictionary setObject:@{ @"count" : @(statistics.count),
+                                                 @"totalDuration" : @(statistics.totalDuration * 1000.),
+                                                 @"averageDuration" : @(statistics.totalDuration * 1000. / statistics.count),
+                                                 @"maximumDuration" : @(statistics.maximumDuration * 1000.) }
+                                       forKey:metricName(metric)];
+        }
+        [profileDictionary setObject:[NSDictionary dictionaryWithDictionary:classProfileDictionary] forKey:className];
+    }];
+    return [NSDictionary dictionaryWithDictionary:profileDictionary];
+}
+
+- (BOOL)writeProfileToFile:(NSString *)filePath error:(NSError *__autoreleasing *)pError
+{
+    NSData *data = [NSJSONSerialization dataWithJSONObject:[self profileDictionary] options:NSJSONWritingPrettyPrinted error:pError];
+    if (! data) {
+        return NO;
+    }
+    
+    return [data writeToFile:filePath options:NSDataWritingAtomic error:pError];
+}
+
+@end
+
+@implementation HLSViewControllerLifeCycleProfiler (Friend)
+
+- (void)recordDuration:(NSTimeInterval)duration
+             forMetric:(HLSViewControllerLifeCycleMetric)metric
+   viewControllerClass:(Class)viewControllerClass
+{
+    if (! self.enabled) {
+        return;
+    }
+    
+    NSString *className = NSStringFromClass(viewControllerClass);
+    HLSViewControllerLifeCycleClassProfile *classProfile = [self.classNameToProfileMap objectForKey:className];
+    if (! classProfile) {
+        classProfile = [[HLSViewControllerLifeCycleClassProfile alloc] init];
+        [self.classNameToProfileMap setObject:classProfile forKey:className];
+    }
+    
+    HLSLifeCycleStatistics *pStatistics = &classProfile->_statistics[metric];
+    ++pStatistics->count;
+    pStatistics->totalDuration += duration;
+    pStatistics->maximumDuration = fmax(pStatistics->maximumDuration, duration);
+}
+
+@end
+
+#pragma mark Static functions
+
+static NSString *metricName(HLSViewControllerLifeCycleMetric metric)
+{
+    static NSArray *s_names = nil;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        s_names = @[@"init", @"viewLoading", @"appearance", @"disappearance", @"pushToAppearance"];
+    });
+    return [s_names objectAtIndex:metric];
+}
@@ -13,6 +13,7 @@
 #import "HLSLogger.h"
 #import "HLSNotifications.h"
 #import "HLSSafariActivity.h"
+#import "HLSWebViewPool.h"
 #import "NSBundle+HLSDynamicLocalization.h"
 #import "NSBundle+HLSExtensions.h"
 #import "NSError+HLSExtensions.h"
@@ -25,11 +26,10 @@
 
 static void *s_KVOContext = &s_KVOContext;
 
-// TODO: Remove fake constants and variables when CoconutKit requires iOS 8 and above
-static const NSTimeInterval HLSWebViewMaxFakeDuration = 3.;
-static const NSTimeInterval HLSWebViewFakeTimerInterval = 1. / 60.;
-static const CGFloat HLSWebViewFakeTimerMaxProgress = 0.95f;
-static const CGFloat HLSWebViewFakeTimerProgressIncrement = HLSWebViewFakeTimerMaxProgress / HLSWebViewMaxFakeDuration * HLSWebViewFakeTimerInterval;
+// TODO: Remove UIWebView progress constants when CoconutKit requires iOS 8 and above
+static const CGFloat HLSWebViewInitialProgress = 0.1f;
+static const CGFloat HLSWebViewInteractiveProgress = 0.5f;
+static const CGFloat HLSWebViewMaxLoadProgress = 0.95f;
 static const NSTimeInterval HLSWebViewFadeAnimationDuration = 0.3;
 
 @interface HLSWebViewController ()
@@ -60,13 +60,16 @@ static const NSTimeInterval HLSWebViewFadeAnimationDuration = 0.3;
 
 @property (nonatomic, strong) UIPopoverController *activityPopoverController;
 
-@property (nonatomic, strong) NSTimer *fakeProgressTimer;
-
 @end
 
 @implementation HLSWebViewController {
 @private
     CGFloat _progress;
+    
+    // UIWebView load events are received for each frame. Count them to derive progress information
+    // TODO: Remove when CoconutKit requires iOS 8 and above
+    NSUInteger _startedLoadCount;
+    NSUInteger _finishedLoadCount;
 }
 
 #pragma mark Object creation and destruction
@@ -83,22 +86,11 @@ static const NSTimeInterval HLSWebViewFadeAnimationDuration = 0.3;
 {
     [[NSNotificationCenter defaultCenter] removeObserver:self];
     
-    if ([WKWebView class]) {
-        @try {
-            [self.webView removeObserver:self forKeyPath:@"estimatedProgress"];
-        }
-        @catch (NSException *exception) {}
-    }
+    [self returnWebViews];
 }
 
 #pragma mark Accessors and mutators
 
-- (void)setFakeProgressTimer:(NSTimer *)fakeProgressTimer
-{
-    [_fakeProgressTimer invalidate];
-    _fakeProgressTimer = fakeProgressTimer;
-}
-
 - (void)setProgress:(CGFloat)progress animated:(BOOL)animated
 {
     if (isless(progress, 0.f)) {
@@ -113,21 +105,6 @@ static const NSTimeInterval HLSWebViewFadeAnimationDuration = 0.3;
         _progress = progress;
     }
     
-    // Fake progress on iOS 7 since progress information not available from UIWebView
-    // See http://stackoverflow.com/questions/21263358/uiwebview-with-progress-bar
-    if (! [WKWebView class]) {
-        if (_progress == 0.f) {
-            self.fakeProgressTimer = [NSTimer scheduledTimerWithTimeInterval:HLSWebViewFakeTimerInterval
-                                                                      target:self
-                                                                    selector:@selector(updateFakeProgress:)
-                                                                    userInfo:nil
-                                                                     repeats:YES];
-        }
-        else if (isgreaterequal(progress, HLSWebViewFakeTimerMaxProgress)) {
-            self.fakeProgressTimer = nil;
-        }
-    }
-    
     if (_progress == 0.f) {
         if (animated) {
             [UIView animateWithDuration:HLSWebViewFadeAnimationDuration animations:^{
@@ -168,32 +145,98 @@ static const NSTimeInterval HLSWebViewFadeAnimationDuration = 0.3;
 {
     [super viewDidLoad];
     
+    [self loadWebView];
+    
+    self.progressView.alpha = 0.f;
+    
+    self.normalToolbarItems = self.toolbar.items;
+    
+    // Build the toolbar displayed when the web view is loading content
+    NSMutableArray *loadingToolbarItems = [NSMutableArray arrayWithArray:self.normalToolbarItems];
+    UIBarButtonItem *stopBarButtonItem = [[UIBarButtonItem alloc] initWithBarButtonSystemItem:UIBarButtonSystemItemStop target:self action:@selector(stop:)];
+    [loadingToolbarItems replaceObjectAtIndex:[loadingToolbarItems indexOfObject:self.refreshBarButtonItem] withObject:stopBarButtonItem];
+    self.loadingToolbarItems = [NSArray arrayWithArray:loadingToolbarItems];
+    
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(keyboardDidChangeFrame:)
+                                                 name:UIKeyboardDidChangeFrameNotification
+                                               object:nil];
+}
+
+- (void)viewWillAppear:(BOOL)animated
+{
+    [super viewWillAppear:animated];
+    
+    // Web views are returned to the pool when the controller is dismissed. Get new ones if displayed again
+    if (! self.webView) {
+        [self loadWebView];
+    }
+    
+    [self updateInterfaceAnimated:animated];
+}
+
+- (void)viewWillDisappear:(BOOL)animated
+{
+    [super viewWillDisappear:animated];
+    
+    if ([WKWebView class]) {
+        [(WKWebView *)self.webView stopLoading];
+    }
+    else {
+        [(UIWebView *)self.webView stopLoading];
+    }
+}
+
+- (void)viewDidDisappear:(BOOL)animated
+{
+    [super viewDidDisappear:animated];
+    
+    // Return web views to the pool as soon as they are not needed anymore, not only when the controller is deallocated
+    if ([self isMovingFromParentViewController] || [self isBeingDismissed]) {
+        [self returnWebViews];
+    }
+}
+
+#pragma mark Web views
+
+- (void)loadWebView
+{
     // Trick: We use outlets marked as WKWebView to avoid redundancies. On iOS 7 the web view is an old web view. Since the
     //        web view class interfaces have only slightly changed, we will use a cast where appropriate
     // TODO: Remove when CoconutKit requires at least iOS 8. Improve using new WKWebView abilities
-    Class webViewClass = [WKWebView class] ?: [UIWebView class];
-    
-    UIView *webView = [[webViewClass alloc] initWithFrame:self.view.bounds];
+    UIView *webView = [[HLSWebViewPool sharedWebViewPool] dequeueWebViewWithFrame:self.view.bounds];
     webView.autoresizingMask = UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight;
     webView.alpha = 0.f;
+    
+    // Resume at the last page displayed if the controller is displayed again
+    NSURLRequest *request = self.currentURL ? [NSURLRequest requestWithURL:self.currentURL] : self.request;
     if ([WKWebView class]) {
         ((WKWebView *)webView).navigationDelegate = self;
-        [(WKWebView *)webView loadRequest:self.request];
+        [(WKWebView *)webView loadRequest:request];
         
         // Progress information is available from WKWebView
         [webView addObserver:self forKeyPath:@"estimatedProgress" options:NSKeyValueObservingOptionNew context:s_KVOContext];
     }
     else {
         ((UIWebView *)webView).delegate = self;
-        [(UIWebView *)webView loadRequest:self.request];
+        [(UIWebView *)webView loadRequest:request];
     }
     
     // Scroll view content insets are adjusted automatically, but only for the scroll view at index 0. This
     // is the main content web view, we therefore put it at index 0
     [self.view insertSubview:webView atIndex:0];
     self.webView = webView;
+}
+
+// The error web view is only drawn from the pool when an error needs to be displayed. Most controllers never display
+// errors and thus do not consume a second pooled web view, which would be returned with content and discarded
+- (void)loadErrorWebViewIfNeeded
+{
+    if (self.errorWebView) {
+        return;
+    }
     
-    UIView *errorWebView = [[webViewClass alloc] initWithFrame:self.view.bounds];
+    UIView *errorWebView = [[HLSWebViewPool sharedWebViewPool] dequeueWebViewWithFrame:self.view.bounds];
     errorWebView.autoresizingMask = UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight;
     errorWebView.alpha = 0.f;
     if ([WKWebView class]) {
@@ -205,7 +248,7 @@ static const NSTimeInterval HLSWebViewFadeAnimationDuration = 0.3;
     errorWebView.userInteractionEnabled = NO;
     
     NSBundle *coconutKitBundle = [NSBundle coconutKitBundle];
-
+    
     // WKWebView cannot load file URLs, except in the temporary directory, see
     //   http://stackoverflow.com/questions/24882834/wkwebview-not-working-in-ios-8-beta-4
     // As a workaround, copy CoconutKit resource bundle to the temporary directory, and load pages from there. Since there are not so many
@@ -238,42 +281,25 @@ static const NSTimeInterval HLSWebViewFadeAnimationDuration = 0.3;
     }
     
     // No automatic scroll inset adjustment, but not a problem since the error view displays static centered content
-    [self.view insertSubview:errorWebView atIndex:1];
+    [self.view insertSubview:errorWebView aboveSubview:self.webView];
     self.errorWebView = errorWebView;
-    
-    self.progressView.alpha = 0.f;
-    
-    self.normalToolbarItems = self.toolbar.items;
-    
-    // Build the toolbar displayed when the web view is loading content
-    NSMutableArray *loadingToolbarItems = [NSMutableArray arrayWithArray:self.normalToolbarItems];
-    UIBarButtonItem *stopBarButtonItem = [[UIBarButtonItem alloc] initWithBarButtonSystemItem:UIBarButtonSystemItemStop target:self action:@selector(stop:)];
-    [loadingToolbarItems replaceObjectAtIndex:[loadingToolbarItems indexOfObject:self.refreshBarButtonItem] withObject:stopBarButtonItem];
-    self.loadingToolbarItems = [NSArray arrayWithArray:loadingToolbarItems];
-    
-    [[NSNotificationCenter defaultCenter] addObserver:self
-                                             selector:@selector(keyboardDidChangeFrame:)
-                                                 name:UIKeyboardDidChangeFrameNotification
-                                               object:nil];
 }
 
-- (void)viewWillAppear:(BOOL)animated
+- (void)returnWebViews
 {
-    [super viewWillAppear:animated];
-    
-    [self updateInterfaceAnimated:animated];
-}
-
-- (void)viewWillDisappear:(BOOL)animated
-{
-    [super viewWillDisappear:animated];
-    
     if ([WKWebView class]) {
-        [(WKWebView *)self.webView stopLoading];
-    }
-    else {
-        [(UIWebView *)self.webView stopLoading];
+        @try {
+            [self.webView removeObserver:self forKeyPath:@"estimatedProgress"];
+        }
+        @catch (NSException *exception) {}
     }
+    
+    // Web views are returned to the pool, which decides whether they can be reused
+    [[HLSWebViewPool sharedWebViewPool] enqueueWebView:self.webView];
+    [[HLSWebViewPool sharedWebViewPool] enqueueWebView:self.errorWebView];
+    
+    self.webView = nil;
+    self.errorWebView = nil;
 }
 
 #pragma mark Layout
@@ -513,6 +539,8 @@ static const NSTimeInterval HLSWebViewFadeAnimationDuration = 0.3;
     }
     
     if (! [error hasCode:NSURLErrorCancelled withinDomain:NSURLErrorDomain]) {
+        [self loadErrorWebViewIfNeeded];
+        
         [UIView animateWithDuration:HLSWebViewFadeAnimationDuration animations:^{
             self.webView.alpha = 0.f;
             self.errorWebView.alpha = 1.f;
@@ -531,19 +559,79 @@ static const NSTimeInterval HLSWebViewFadeAnimationDuration = 0.3;
 
 #pragma mark WKWebViewDelegate protocol implementation
 
+// UIWebView load events are received for each frame. The page itself is considered loading until all frames have
+// been loaded
 - (void)webViewDidStartLoad:(UIWebView *)webView
 {
-    [self webView:(WKWebView *)webView didStartProvisionalNavigation:nil];
+    if (webView != self.webView) {
+        [self webView:(WKWebView *)webView didStartProvisionalNavigation:nil];
+        return;
+    }
+    
+    if (_finishedLoadCount >= _startedLoadCount) {
+        _startedLoadCount = 1;
+        _finishedLoadCount = 0;
+        
+        [self webView:(WKWebView *)webView didStartProvisionalNavigation:nil];
+        [self setProgress:HLSWebViewInitialProgress animated:YES];
+    }
+    else {
+        ++_startedLoadCount;
+        [self updateLoadProgress];
+    }
 }
 
 - (void)webViewDidFinishLoad:(UIWebView *)webView
 {
-    [self webView:(WKWebView *)webView didFinishNavigation:nil];
+    if (webView != self.webView) {
+        [self webView:(WKWebView *)webView didFinishNavigation:nil];
+        return;
+    }
+    
+    ++_finishedLoadCount;
+    if (_finishedLoadCount >= _startedLoadCount) {
+        [self webView:(WKWebView *)webView didFinishNavigation:nil];
+    }
+    else {
+        [self updateLoadProgress];
+    }
 }
 
 - (void)webView:(UIWebView *)webView didFailLoadWithError:(NSError *)error
 {
-    [self webView:(WKWebView *)webView didFailProvisionalNavigation:nil withError:error];
+    if (webView != self.webView) {
+        [self webView:(WKWebView *)webView didFailProvisionalNavigation:nil withError:error];
+        return;
+    }
+    
+    ++_finishedLoadCount;
+    if (_finishedLoadCount >= _startedLoadCount) {
+        [self webView:(WKWebView *)webView didFailProvisionalNavigation:nil withError:error];
+    }
+    else {
+        [self updateLoadProgress];
+    }
+}
+
+// Derive UIWebView progress from the number of frames loaded and from the document state
+// TODO: Remove when CoconutKit requires iOS 8 and above
+- (void)updateLoadProgress
+{
+    if (_startedLoadCount == 0) {
+        return;
+    }
+    
+    CGFloat progress = HLSWebViewInitialProgress + (HLSWebViewMaxLoadProgress - HLSWebViewInitialProgress) * _finishedLoadCount / _startedLoadCount;
+    
+    NSString *readyState = [(UIWebView *)self.webView stringByEvaluatingJavaScriptFromString:@"document.readyState"];
+    if ([readyState isEqualToString:@"interactive"] || [readyState isEqualToString:@"complete"]) {
+        progress = MAX(progress, HLSWebViewInteractiveProgress);
+    }
+    
+    // Progress never decreases, even if further frames start loading
+    if (isgreater(progress, _progress)) {
+        [self setProgress:progress animated:YES];
+    }
 }
 
 #pragma mark Action callbacks
@@ -630,16 +718,6 @@ static const NSTimeInterval HLSWebViewFadeAnimationDuration = 0.3;
     }
 }
 
-#pragma mark Timer callbacks
-
-- (void)updateFakeProgress:(NSTimer *)timer
-{
-    // 33% update chance to make fake progress more realistic
-    if (arc4random_uniform(3) == 0) {
-        [self setProgress:[self progress] + HLSWebViewFakeTimerProgressIncrement animated:YES];
-    }
-}
-
 #pragma mark Notification callbacks
 
 - (void)keyboardDidChangeFrame:(NSNotification *)notification
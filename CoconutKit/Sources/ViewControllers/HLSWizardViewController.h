@@ -10,6 +10,7 @@
 #import <UIKit/UIKit.h>
 
 // Forward declarations
+@protocol HLSWizardViewControllerDataSource;
 @protocol HLSWizardViewControllerDelegate;
 
 typedef NS_ENUM(NSInteger, HLSWizardTransitionStyle) {
@@ -38,6 +39,15 @@ typedef NS_ENUM(NSInteger, HLSWizardTransitionStyle) {
  * HLSValidable protocol, the page is checked for validity before displaying the next one. Similarly
  * when clicking on the "done" button. If the page does not implement this protocol, the page is
  * always assumed to be valid.
+ *
+ * Pages can either be provided all at once (viewControllers property), or on demand by a data source. With a data
+ * source, only the current page and the pages within preloadedPageCount of it are instantiated. Other pages are 
+ * released when a memory warning is received, and requested again from the data source when needed. Pages must
+ * therefore store their state in a model object, from which the data source can restore them.
+ *
+ * The validation state of pages is recorded: When jumping forward using -moveToPage:, pages which have been successfully 
+ * validated and not displayed since are not validated again. If the content of such a page is changed by other means 
+ * (e.g. by updating the underlying model), call -setNeedsValidationForPage: so that it gets validated again.
  */
 @interface HLSWizardViewController : HLSPlaceholderViewController
 
@@ -50,10 +60,31 @@ typedef NS_ENUM(NSInteger, HLSWizardTransitionStyle) {
 @property (nonatomic, weak) IBOutlet UIButton *doneButton;
 
 /**
- * The view controllers to display as pages
+ * The view controllers to display as pages. Setting this property resets the data source to nil
  */
 @property (nonatomic, strong) NSArray *viewControllers;
 
+/**
+ * The data source providing pages on demand. Setting this property resets the viewControllers property to nil
+ */
+@property (nonatomic, weak) id<HLSWizardViewControllerDataSource> dataSource;
+
+/**
+ * When a data source is used, the number of pages before and after the current one which are instantiated in advance.
+ * Default is 1
+ */
+@property (nonatomic, assign) NSUInteger preloadedPageCount;
+
+/**
+ * When a data source is used, discard all pages and ask the data source for them again, starting with the first page
+ */
+- (void)reloadPages;
+
+/**
+ * Mark a page as requiring validation, even if it has been successfully validated before
+ */
+- (void)setNeedsValidationForPage:(NSInteger)page;
+
 /**
  * The transition style to use when changing pages. Default is HLSWizardTransitionStyleNone
  */
@@ -66,6 +97,21 @@ typedef NS_ENUM(NSInteger, HLSWizardTransitionStyle) {
 
 @end
 
+@protocol HLSWizardViewControllerDataSource <NSObject>
+
+/**
+ * The number of pages to display
+ */
+- (NSInteger)numberOfPagesInWizardViewController:(HLSWizardViewController *)wizardViewController;
+
+/**
+ * Return the view controller to display for a page. Called when the page is needed, and again if the page was released
+ * in the meantime
+ */
+- (UIViewController *)wizardViewController:(HLSWizardViewController *)wizardViewController viewControllerForPage:(NSInteger)page;
+
+@end
+
 @protocol HLSWizardViewControllerDelegate <HLSPlaceholderViewControllerDelegate>
 @optional
 
@@ -16,6 +16,10 @@ static const NSInteger kWizardViewControllerNoPage = -1;
 @interface HLSWizardViewController ()
 
 @property (nonatomic, assign) NSInteger currentPage;
+@property (nonatomic, assign) NSInteger numberOfPages;
+
+@property (nonatomic, strong) NSMutableDictionary *pageToViewControllerMap;         // Pages obtained from the data source
+@property (nonatomic, strong) NSMutableIndexSet *validatedPages;                    // Pages validated and not displayed since
 
 @end
 
@@ -48,6 +52,10 @@ static const NSInteger kWizardViewControllerNoPage = -1;
 {
     _currentPage = kWizardViewControllerNoPage;
     _wizardTransitionStyle = HLSWizardTransitionStyleNone;
+    
+    self.preloadedPageCount = 1;
+    self.pageToViewControllerMap = [NSMutableDictionary dictionary];
+    self.validatedPages = [NSMutableIndexSet indexSet];
 }
 
 #pragma mark View lifecycle management
@@ -69,6 +77,20 @@ static const NSInteger kWizardViewControllerNoPage = -1;
     [self refreshWizardInterface];
 }
 
+#pragma mark Memory warnings
+
+- (void)didReceiveMemoryWarning
+{
+    [super didReceiveMemoryWarning];
+    
+    // Release pages outside the preloading window. They will be requested again from the data source when needed
+    for (NSNumber *page in [self.pageToViewControllerMap allKeys]) {
+        if (labs([page integerValue] - self.currentPage) > (NSInteger)self.preloadedPageCount) {
+            [self.pageToViewControllerMap removeObjectForKey:page];
+        }
+    }
+}
+
 #pragma mark Accessors and mutators
 
 - (void)setViewControllers:(NSArray *)viewControllers
@@ -80,6 +102,11 @@ static const NSInteger kWizardViewControllerNoPage = -1;
     }
     
     _viewControllers = viewControllers;
+    _dataSource = nil;
+    
+    [self.pageToViewControllerMap removeAllObjects];
+    [self.validatedPages removeAllIndexes];
+    self.numberOfPages = [viewControllers count];
     
     // Start with the first page
     if ([_viewControllers count] > 0) {
@@ -87,6 +114,18 @@ static const NSInteger kWizardViewControllerNoPage = -1;
     }    
 }
 
+- (void)setDataSource:(id<HLSWizardViewControllerDataSource>)dataSource
+{
+    if (_dataSource == dataSource) {
+        return;
+    }
+    
+    _dataSource = dataSource;
+    _viewControllers = nil;
+    
+    [self reloadPages];
+}
+
 - (void)setCurrentPage:(NSInteger)currentPage
 {
     if (currentPage == _currentPage) {
@@ -104,8 +143,8 @@ static const NSInteger kWizardViewControllerNoPage = -1;
     }
     
     // Sanitize input
-    if (currentPage < 0 || currentPage >= [self.viewControllers count]) {
-        HLSLoggerError(@"Incorrect page number %ld, must lie between 0 and %lu", (long)currentPage, (unsigned long)[self.viewControllers count]);
+    if (currentPage < 0 || currentPage >= self.numberOfPages) {
+        HLSLoggerError(@"Incorrect page number %ld, must lie between 0 and %lu", (long)currentPage, (unsigned long)self.numberOfPages);
         return;
     }
     
@@ -139,9 +178,14 @@ static const NSInteger kWizardViewControllerNoPage = -1;
         }            
     }
     
+    // Once displayed, a page might be edited and must therefore be validated again
+    [self.validatedPages removeIndex:_currentPage];
+    
     // Display the current page
-    UIViewController *viewController = [self.viewControllers objectAtIndex:_currentPage];
+    UIViewController *viewController = [self viewControllerForPage:_currentPage];
     [self setInsetViewController:viewController atIndex:0 withTransitionClass:transitionClass];
+    
+    [self preloadPagesAroundPage:_currentPage];
 }
 
 #pragma mark Refreshing the UI
@@ -159,13 +203,13 @@ static const NSInteger kWizardViewControllerNoPage = -1;
     }
     
     // Sanitize input
-    if (self.currentPage < 0 || self.currentPage >= [self.viewControllers count]) {
-        HLSLoggerError(@"Incorrect page number %ld, must lie between 0 and %lu", (long)self.currentPage, (unsigned long)[self.viewControllers count]);
+    if (self.currentPage < 0 || self.currentPage >= self.numberOfPages) {
+        HLSLoggerError(@"Incorrect page number %ld, must lie between 0 and %lu", (long)self.currentPage, (unsigned long)self.numberOfPages);
         return;
     }
     
     // Done button on last page only
-    if (self.currentPage == [self.viewControllers count] - 1) {
+    if (self.currentPage == self.numberOfPages - 1) {
         self.doneButton.hidden = NO;
     }
     else {
@@ -181,7 +225,7 @@ static const NSInteger kWizardViewControllerNoPage = -1;
     }
     
     // Next button on all but the last page
-    if (self.currentPage < [self.viewControllers count] - 1) {
+    if (self.currentPage < self.numberOfPages - 1) {
         self.nextButton.hidden = NO;
     }
     else {
@@ -191,30 +235,85 @@ static const NSInteger kWizardViewControllerNoPage = -1;
 
 #pragma mark Handling pages
 
+- (void)reloadPages
+{
+    [self.pageToViewControllerMap removeAllObjects];
+    [self.validatedPages removeAllIndexes];
+    self.numberOfPages = [self.dataSource numberOfPagesInWizardViewController:self];
+    
+    // Start with the first page
+    self.currentPage = kWizardViewControllerNoPage;
+    if (self.numberOfPages > 0) {
+        self.currentPage = 0;
+    }
+}
+
+- (UIViewController *)viewControllerForPage:(NSInteger)page
+{
+    if (! self.dataSource) {
+        return [self.viewControllers objectAtIndex:page];
+    }
+    
+    UIViewController *viewController = [self.pageToViewControllerMap objectForKey:@(page)];
+    if (! viewController) {
+        viewController = [self.dataSource wizardViewController:self viewControllerForPage:page];
+        if (! viewController) {
+            HLSLoggerError(@"The data source did not return any view controller for page %ld", (long)page);
+            return nil;
+        }
+        [self.pageToViewControllerMap setObject:viewController forKey:@(page)];
+    }
+    return viewController;
+}
+
+- (void)preloadPagesAroundPage:(NSInteger)page
+{
+    if (! self.dataSource) {
+        return;
+    }
+    
+    NSInteger firstPage = MAX(page - (NSInteger)self.preloadedPageCount, 0);
+    NSInteger lastPage = MIN(page + (NSInteger)self.preloadedPageCount, self.numberOfPages - 1);
+    for (NSInteger i = firstPage; i <= lastPage; ++i) {
+        [self viewControllerForPage:i];
+    }
+}
+
+- (void)setNeedsValidationForPage:(NSInteger)page
+{
+    if (page < 0) {
+        return;
+    }
+    
+    [self.validatedPages removeIndex:page];
+}
+
 - (BOOL)validatePage:(NSInteger)page
 {
     // Sanitize input (deals with the "no page" case)
-    if (page < 0 || page >= [self.viewControllers count]) {
-        HLSLoggerError(@"Incorrect page number %ld, must lie between 0 and %lu", (long)page, (unsigned long)[self.viewControllers count]);
+    if (page < 0 || page >= self.numberOfPages) {
+        HLSLoggerError(@"Incorrect page number %ld, must lie between 0 and %lu", (long)page, (unsigned long)self.numberOfPages);
         return YES;
     }
     
     // Validate the current page if it implements a validation mechanism
-    UIViewController *viewController = [self.viewControllers objectAtIndex:page];
+    UIViewController *viewController = [self viewControllerForPage:page];
     if ([viewController conformsToProtocol:@protocol(HLSValidable)]) {
-        return [(UIViewController<HLSValidable>*)viewController validate];
+        if (! [(UIViewController<HLSValidable>*)viewController validate]) {
+            return NO;
+        }
     }
     // Else assume it is always valid
-    else {
-        return YES;
-    }
+    
+    [self.validatedPages addIndex:page];
+    return YES;
 }
 
 - (void)moveToPage:(NSInteger)page
 {
     // Sanitize input
-    if (page < 0 || page >= [self.viewControllers count]) {
-        HLSLoggerError(@"Incorrect page number %ld, must lie between 0 and %lu", (long)page, (unsigned long)[self.viewControllers count]);
+    if (page < 0 || page >= self.numberOfPages) {
+        HLSLoggerError(@"Incorrect page number %ld, must lie between 0 and %lu", (long)page, (unsigned long)self.numberOfPages);
         return;
     }
     
@@ -226,6 +325,11 @@ static const NSInteger kWizardViewControllerNoPage = -1;
     // Going forward, check pages in between and stops on a page if it is not valid
     if (page > self.currentPage) {
         for (NSInteger i = self.currentPage; i < page; ++i) {
+            // Pages validated and not displayed since cannot have been edited
+            if (i != self.currentPage && [self.validatedPages containsIndex:i]) {
+                continue;
+            }
+            
             self.currentPage = i;
             if (! [self validatePage:i]) {
                 return;
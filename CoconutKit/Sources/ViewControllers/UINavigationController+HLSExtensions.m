@@ -25,8 +25,10 @@ static NSUInteger swizzle_supportedInterfaceOrientations(UINavigationController
 
 + (void)load
 {
+    HLSSwizzleGroup_Begin
     HLSSwizzleSelector(self, @selector(shouldAutorotate), swizzle_shouldAutorotate, &s_shouldAutorotate);
     HLSSwizzleSelector(self, @selector(supportedInterfaceOrientations), swizzle_supportedInterfaceOrientations, &s_supportedInterfaceOrientations);
+    HLSSwizzleGroup_End
 }
 
 #pragma mark Accessors and mutators
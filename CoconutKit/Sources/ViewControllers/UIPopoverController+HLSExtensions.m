@@ -32,10 +32,12 @@ static void swizzle_setContentViewController_animated(UIPopoverController *self,
 
 + (void)load
 {
+    HLSSwizzleGroup_Begin
     // initWithContentViewController: sadly does not rely on setContentViewController:animated: to set its content view controller. Must
     // swizzle it as well
     HLSSwizzleSelector(self, @selector(initWithContentViewController:), swizzle_initWithContentViewController, &s_initWithContentViewController);
     HLSSwizzleSelector(self, @selector(setContentViewController:animated:), swizzle_setContentViewController_animated, &s_setContentViewController_animated);
+    HLSSwizzleGroup_End
 }
 
 @end
@@ -25,9 +25,11 @@ static NSUInteger swizzle_supportedInterfaceOrientations(UISplitViewController *
 
 + (void)load
 {
+    HLSSwizzleGroup_Begin
     // No swizzling occurs on iOS < 6 since those two methods do not exist
     HLSSwizzleSelector(self, @selector(shouldAutorotate), swizzle_shouldAutorotate, &s_shouldAutorotate);
     HLSSwizzleSelector(self, @selector(supportedInterfaceOrientations), swizzle_supportedInterfaceOrientations, &s_supportedInterfaceOrientations);
+    HLSSwizzleGroup_End
 }
 
 #pragma mark Accessors and mutators
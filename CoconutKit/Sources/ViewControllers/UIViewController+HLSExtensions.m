@@ -6,9 +6,11 @@
 
 #import "UIViewController+HLSExtensions.h"
 
-#import <objc/runtime.h>
+#import <QuartzCore/QuartzCore.h>
 #import "HLSLogger.h"
 #import "HLSRuntime.h"
+#import "HLSViewControllerLifeCycleProfiler+Friend.h"
+#import "UIViewController+HLSExtensionsFriend.h"
 #import "UITextField+HLSExtensions.h"
 #import "UITextView+HLSExtensions.h"
 #import "UIView+HLSExtensions.h"
@@ -16,12 +18,12 @@
 // TODO: When CoconutKit requires iOS >= 8, completely update rotation code. Yeah, this is going to be a lot of work...
 
 // Associated object keys
-static void *s_lifeCyclePhaseKey = &s_lifeCyclePhaseKey;
-static void *s_createdViewSizeKey = &s_createdViewSizeKey;
+static void *s_lifeCycleRecordKey = &s_lifeCycleRecordKey;
 
 // Original implementation of the methods we swizzle
 static id (*s_initWithNibName_bundle)(id, SEL, id, id) = NULL;
 static id (*s_initWithCoder)(id, SEL, id) = NULL;
+static id (*s_view)(id, SEL) = NULL;
 static void (*s_viewDidLoad)(id, SEL) = NULL;
 static void (*s_viewWillAppear)(id, SEL, BOOL) = NULL;
 static void (*s_viewDidAppear)(id, SEL, BOOL) = NULL;
@@ -31,19 +33,52 @@ static void (*s_viewDidDisappear)(id, SEL, BOOL) = NULL;
 // Swizzled method implementations
 static id swizzle_initWithNibName_bundle(UIViewController *self, SEL _cmd, NSString *nibName, NSBundle *bundle);
 static id swizzle_initWithCoder(UIViewController *self, SEL _cmd, NSCoder *aDecoder);
+static UIView *swizzle_view(UIViewController *self, SEL _cmd);
 static void swizzle_viewDidLoad(UIViewController *self, SEL _cmd);
 static void swizzle_viewWillAppear(UIViewController *self, SEL _cmd, BOOL animated);
 static void swizzle_viewDidAppear(UIViewController *self, SEL _cmd, BOOL animated);
 static void swizzle_viewWillDisappear(UIViewController *self, SEL _cmd, BOOL animated);
 static void swizzle_viewDidDisappear(UIViewController *self, SEL _cmd, BOOL animated);
 
+#pragma mark -
+#pragma mark HLSViewControllerLifeCycleRecord class
+
+/**
+ * Lifecycle information attached to a view controller as a single associated object, updated in place. Timestamps
+ * are only set when profiling is enabled, and are 0 when no measurement is in progress
+ */
+@interface HLSViewControllerLifeCycleRecord : NSObject {
+@public
+    HLSViewControllerLifeCyclePhase _lifeCyclePhase;
+    CGSize _createdViewSize;
+    BOOL _createdViewSizeAvailable;
+    CFTimeInterval _appearanceStartTime;
+    CFTimeInterval _disappearanceStartTime;
+    CFTimeInterval _pushTime;
+}
+
+@end
+
+@implementation HLSViewControllerLifeCycleRecord
+
+@end
+
+#pragma mark -
+#pragma mark UIViewController (HLSExtensions) category implementation
+
+@interface UIViewController (HLSExtensionsPrivate)
+
+- (HLSViewControllerLifeCycleRecord *)lifeCycleRecord;
+
+@end
+
 @implementation UIViewController (HLSExtensions)
 
 #pragma mark Accessors and mutators
 
 - (HLSViewControllerLifeCyclePhase)lifeCyclePhase
 {
-    return [hls_getAssociatedObject(self, s_lifeCyclePhaseKey) intValue];
+    return [self lifeCycleRecord]->_lifeCyclePhase;
 }
 
 - (UIView *)viewIfLoaded
@@ -65,9 +100,9 @@ static void swizzle_viewDidDisappear(UIViewController *self, SEL _cmd, BOOL anim
 
 - (CGSize)createdViewSize
 {
-    NSValue *createdViewSizeValue = hls_getAssociatedObject(self, s_createdViewSizeKey);
-    if (createdViewSizeValue) {
-        return [createdViewSizeValue CGSizeValue];
+    HLSViewControllerLifeCycleRecord *lifeCycleRecord = [self lifeCycleRecord];
+    if (lifeCycleRecord->_createdViewSizeAvailable) {
+        return lifeCycleRecord->_createdViewSize;
     }
     else {
         // Return zero to avoid triggering lazy view creation
@@ -181,6 +216,7 @@ static void swizzle_viewDidDisappear(UIViewController *self, SEL _cmd, BOOL anim
 
 + (void)load
 {
+    HLSSwizzleGroup_Begin
     HLSSwizzleSelector(self, @selector(initWithNibName:bundle:), swizzle_initWithNibName_bundle, &s_initWithNibName_bundle);
     HLSSwizzleSelector(self, @selector(initWithCoder:), swizzle_initWithCoder, &s_initWithCoder);
     HLSSwizzleSelector(self, @selector(viewDidLoad), swizzle_viewDidLoad, &s_viewDidLoad);
@@ -188,6 +224,7 @@ static void swizzle_viewDidDisappear(UIViewController *self, SEL _cmd, BOOL anim
     HLSSwizzleSelector(self, @selector(viewDidAppear:), swizzle_viewDidAppear, &s_viewDidAppear);
     HLSSwizzleSelector(self, @selector(viewWillDisappear:), swizzle_viewWillDisappear, &s_viewWillDisappear);
     HLSSwizzleSelector(self, @selector(viewDidDisappear:), swizzle_viewDidDisappear, &s_viewDidDisappear);
+    HLSSwizzleGroup_End
 }
 
 #pragma mark Object creation and destruction
@@ -199,9 +236,43 @@ static void swizzle_viewDidDisappear(UIViewController *self, SEL _cmd, BOOL anim
 
 #pragma mark Accessors and mutators
 
+- (HLSViewControllerLifeCycleRecord *)lifeCycleRecord
+{
+    // Created lazily for view controllers which might have been initialized before the hooks were installed
+    HLSViewControllerLifeCycleRecord *lifeCycleRecord = hls_getAssociatedObject(self, s_lifeCycleRecordKey);
+    if (! lifeCycleRecord) {
+        lifeCycleRecord = [[HLSViewControllerLifeCycleRecord alloc] init];
+        hls_setAssociatedObject(self, s_lifeCycleRecordKey, lifeCycleRecord, HLS_ASSOCIATION_STRONG_NONATOMIC);
+    }
+    return lifeCycleRecord;
+}
+
 - (void)setLifeCyclePhase:(HLSViewControllerLifeCyclePhase)lifeCyclePhase
 {
-    hls_setAssociatedObject(self, s_lifeCyclePhaseKey, [NSNumber numberWithInt:lifeCyclePhase], OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    [self lifeCycleRecord]->_lifeCyclePhase = lifeCyclePhase;
+}
+
+@end
+
+@implementation UIViewController (HLSExtensionsFriend)
+
++ (void)installViewLoadingProfilingHook
+{
+    // Swizzling -view globally is only worth it when profiling is actually used. The hook is never removed
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        if (! hls_isSwizzleGroupEnabled(__FILE__)) {
+            return;
+        }
+        HLSSwizzleSelector([UIViewController class], @selector(view), swizzle_view, &s_view);
+    });
+}
+
+- (void)recordPushForLifeCycleProfiling
+{
+    if ([HLSViewControllerLifeCycleProfiler sharedProfiler].enabled) {
+        [self lifeCycleRecord]->_pushTime = CACurrentMediaTime();
+    }
 }
 
 @end
@@ -223,20 +294,48 @@ static void swizzle_viewDidDisappear(UIViewController *self, SEL _cmd, BOOL anim
 
 static id swizzle_initWithNibName_bundle(UIViewController *self, SEL _cmd, NSString *nibName, NSBundle *bundle)
 {
+    HLSViewControllerLifeCycleProfiler *profiler = [HLSViewControllerLifeCycleProfiler sharedProfiler];
+    CFTimeInterval startTime = profiler.enabled ? CACurrentMediaTime() : 0.;
+    
     if ((self = s_initWithNibName_bundle(self, _cmd, nibName, bundle))) {
         [self uiViewControllerHLSExtensionsInit];
+        
+        if (startTime > 0.) {
+            [profiler recordDuration:CACurrentMediaTime() - startTime forMetric:HLSViewControllerLifeCycleMetricInit viewControllerClass:[self class]];
+        }
     }
     return self;
 }
 
 static id swizzle_initWithCoder(UIViewController *self, SEL _cmd, NSCoder *aDecoder)
 {
+    HLSViewControllerLifeCycleProfiler *profiler = [HLSViewControllerLifeCycleProfiler sharedProfiler];
+    CFTimeInterval startTime = profiler.enabled ? CACurrentMediaTime() : 0.;
+    
     if ((self = s_initWithCoder(self, _cmd, aDecoder))) {
         [self uiViewControllerHLSExtensionsInit];
+        
+        if (startTime > 0.) {
+            [profiler recordDuration:CACurrentMediaTime() - startTime forMetric:HLSViewControllerLifeCycleMetricInit viewControllerClass:[self class]];
+        }
     }
     return self;
 }
 
+static UIView *swizzle_view(UIViewController *self, SEL _cmd)
+{
+    // Only measure view creation, which includes -loadView and -viewDidLoad implemented by subclasses
+    HLSViewControllerLifeCycleProfiler *profiler = [HLSViewControllerLifeCycleProfiler sharedProfiler];
+    if ([self isViewLoaded] || ! profiler.enabled) {
+        return s_view(self, _cmd);
+    }
+    
+    CFTimeInterval startTime = CACurrentMediaTime();
+    UIView *view = s_view(self, _cmd);
+    [profiler recordDuration:CACurrentMediaTime() - startTime forMetric:HLSViewControllerLifeCycleMetricViewLoading viewControllerClass:[self class]];
+    return view;
+}
+
 static void swizzle_viewDidLoad(UIViewController *self, SEL _cmd)
 {
     if (! [self isViewLoaded]) {
@@ -245,7 +344,9 @@ static void swizzle_viewDidLoad(UIViewController *self, SEL _cmd)
                                      userInfo:nil];
     }
     
-    hls_setAssociatedObject(self, s_createdViewSizeKey, [NSValue valueWithCGSize:self.view.bounds.size], OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    HLSViewControllerLifeCycleRecord *lifeCycleRecord = [self lifeCycleRecord];
+    lifeCycleRecord->_createdViewSize = self.view.bounds.size;
+    lifeCycleRecord->_createdViewSizeAvailable = YES;
     
     s_viewDidLoad(self, _cmd);
     
@@ -260,6 +361,10 @@ static void swizzle_viewDidLoad(UIViewController *self, SEL _cmd)
 
 static void swizzle_viewWillAppear(UIViewController *self, SEL _cmd, BOOL animated)
 {
+    if ([HLSViewControllerLifeCycleProfiler sharedProfiler].enabled) {
+        [self lifeCycleRecord]->_appearanceStartTime = CACurrentMediaTime();
+    }
+    
     s_viewWillAppear(self, _cmd, animated);
     
     if (! [self isReadyForLifeCyclePhase:HLSViewControllerLifeCyclePhaseViewWillAppear]) {
@@ -281,11 +386,27 @@ static void swizzle_viewDidAppear(UIViewController *self, SEL _cmd, BOOL animate
                       "or maybe [super viewDidAppear:] has not been called by class %@ or one of its parents", self, [self class]);
     }
     
-    [self setLifeCyclePhase:HLSViewControllerLifeCyclePhaseViewDidAppear];    
+    [self setLifeCyclePhase:HLSViewControllerLifeCyclePhaseViewDidAppear];
+    
+    HLSViewControllerLifeCycleRecord *lifeCycleRecord = [self lifeCycleRecord];
+    CFTimeInterval endTime = CACurrentMediaTime();
+    HLSViewControllerLifeCycleProfiler *profiler = [HLSViewControllerLifeCycleProfiler sharedProfiler];
+    if (lifeCycleRecord->_appearanceStartTime > 0.) {
+        [profiler recordDuration:endTime - lifeCycleRecord->_appearanceStartTime forMetric:HLSViewControllerLifeCycleMetricAppearance viewControllerClass:[self class]];
+        lifeCycleRecord->_appearanceStartTime = 0.;
+    }
+    if (lifeCycleRecord->_pushTime > 0.) {
+        [profiler recordDuration:endTime - lifeCycleRecord->_pushTime forMetric:HLSViewControllerLifeCycleMetricPushToAppearance viewControllerClass:[self class]];
+        lifeCycleRecord->_pushTime = 0.;
+    }
 }
 
 static void swizzle_viewWillDisappear(UIViewController *self, SEL _cmd, BOOL animated)
 {
+    if ([HLSViewControllerLifeCycleProfiler sharedProfiler].enabled) {
+        [self lifeCycleRecord]->_disappearanceStartTime = CACurrentMediaTime();
+    }
+    
     s_viewWillDisappear(self, _cmd, animated);
     
     if (! [self isReadyForLifeCyclePhase:HLSViewControllerLifeCyclePhaseViewWillDisappear]) {
@@ -315,4 +436,12 @@ static void swizzle_viewDidDisappear(UIViewController *self, SEL _cmd, BOOL anim
     }
     
     [self setLifeCyclePhase:HLSViewControllerLifeCyclePhaseViewDidDisappear];
+    
+    HLSViewControllerLifeCycleRecord *lifeCycleRecord = [self lifeCycleRecord];
+    if (lifeCycleRecord->_disappearanceStartTime > 0.) {
+        [[HLSViewControllerLifeCycleProfiler sharedProfiler] recordDuration:CACurrentMediaTime() - lifeCycleRecord->_disappearanceStartTime
+                                                                  forMetric:HLSViewControllerLifeCycleMetricDisappearance
+                                                        viewControllerClass:[self class]];
+        lifeCycleRecord->_disappearanceStartTime = 0.;
+    }
 }
@@ -0,0 +1,27 @@
+//
+//  Copyright (c) Samuel Défago. All rights reserved.
+//
+//  Licence information is available from the LICENCE file.
+//
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+
+/**
+ * Interface meant to be used by friend classes of UIViewController (HLSExtensions) (= classes which must have access
+ * to private implementation details)
+ */
+@interface UIViewController (HLSExtensionsFriend)
+
+/**
+ * Install the hook measuring view loading durations (installed once, when lifecycle profiling is first enabled)
+ */
++ (void)installViewLoadingProfilingHook;
+
+/**
+ * Record that the view controller is being pushed into a container. If lifecycle profiling is enabled, the time
+ * elapsed until the view controller appears is measured
+ */
+- (void)recordPushForLifeCycleProfiling;
+
+@end
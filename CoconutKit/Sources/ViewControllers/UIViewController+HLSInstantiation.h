@@ -6,6 +6,10 @@
 
 #import <UIKit/UIKit.h>
 
+/**
+ * Resources used to instantiate a view controller class are resolved once per bundle, and then cached. Storyboards
+ * are cached as well
+ */
 @interface UIViewController (HLSInstantiation)
 
 /**
@@ -28,3 +32,20 @@
 - (instancetype)instanceInBundle:(NSBundle *)bundle;
 
 @end
+
+@interface UIStoryboard (HLSInstantiation)
+
+/**
+ * Return the storyboard with the specified name in the given bundle (main bundle if nil), or nil if none. Unlike
+ * +storyboardWithName:bundle:, no exception is raised if the storyboard does not exist, and storyboards are cached
+ */
++ (UIStoryboard *)sharedStoryboardWithName:(NSString *)name bundle:(NSBundle *)bundle;
+
+/**
+ * Return YES iff the storyboard with the specified name in the given bundle (main bundle if nil) contains a view 
+ * controller with the specified identifier. Unlike -instantiateViewControllerWithIdentifier:, no exception is raised
+ * if this is not the case
+ */
++ (BOOL)storyboardWithName:(NSString *)name bundle:(NSBundle *)bundle containsViewControllerWithIdentifier:(NSString *)identifier;
+
+@end
@@ -8,6 +8,46 @@
 
 #import <objc/runtime.h>
 
+// Resource a view controller class is instantiated from
+typedef NS_ENUM(NSInteger, HLSInstantiationSource) {
+    HLSInstantiationSourceNone = 0,                         // No matching resource
+    HLSInstantiationSourceStoryboardIdentifier,             // View controller with a given identifier in a storyboard
+    HLSInstantiationSourceStoryboardInitial,                // Initial view controller of a storyboard
+    HLSInstantiationSourceNib                               // Nib
+};
+
+// Map between (class, bundle, lookup) keys and resolutions. Also used as lock for the other static variables
+static NSMutableDictionary *s_keyToResolutionMap = nil;
+
+// Map between (bundle, storyboard name) keys and storyboard information (Info.plist contents, NSNull if the storyboard
+// does not exist)
+static NSMutableDictionary *s_keyToStoryboardInfoMap = nil;
+
+// Storyboards, keyed by (bundle, storyboard name)
+static NSCache *s_storyboardCache = nil;
+
+// Function declarations
+static void setupCaches(void);
+
+#pragma mark -
+#pragma mark HLSInstantiationResolution class interface
+
+/**
+ * Resolved instantiation information for a view controller class
+ */
+@interface HLSInstantiationResolution : NSObject
+
+- (instancetype)initWithSource:(HLSInstantiationSource)source resourceName:(NSString *)resourceName identifier:(NSString *)identifier NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, readonly, assign) HLSInstantiationSource source;
+@property (nonatomic, readonly, strong) NSString *resourceName;             // Storyboard or nib name
+@property (nonatomic, readonly, strong) NSString *identifier;               // View controller identifier in the storyboard
+
+@end
+
+#pragma mark -
+#pragma mark UIViewController (HLSInstantiation) category implementation
+
 @implementation UIViewController (HLSInstantiation)
 
 #pragma mark Instantiation
@@ -32,25 +72,62 @@
         return viewController;
     }
     
-    NSString *nibName = [self nibNameInBundle:bundle];
-    return [self initWithNibName:nibName bundle:bundle];
+    HLSInstantiationResolution *resolution = [UIViewController nibResolutionForClass:[self class] inBundle:bundle];
+    return [self initWithNibName:resolution.resourceName bundle:bundle];
 }
 
 #pragma mark Resource lookup
 
-- (NSString *)nibNameInBundle:(NSBundle *)bundle
++ (NSString *)resolutionKeyForClass:(Class)class inBundle:(NSBundle *)bundle storyboardName:(NSString *)storyboardName nib:(BOOL)nib
+{
+    return [NSString stringWithFormat:@"%@|%@|%@|%@", NSStringFromClass(class), [bundle bundlePath], storyboardName ?: @"", nib ? @"nib" : @"storyboard"];
+}
+
++ (HLSInstantiationResolution *)cachedResolutionForKey:(NSString *)key
 {
+    setupCaches();
+    
+    @synchronized(s_keyToResolutionMap) {
+        return [s_keyToResolutionMap objectForKey:key];
+    }
+}
+
++ (void)setCachedResolution:(HLSInstantiationResolution *)resolution forKey:(NSString *)key
+{
+    setupCaches();
+    
+    @synchronized(s_keyToResolutionMap) {
+        [s_keyToResolutionMap setObject:resolution forKey:key];
+    }
+}
+
++ (HLSInstantiationResolution *)nibResolutionForClass:(Class)class inBundle:(NSBundle *)bundle
+{
+    NSParameterAssert(class);
     NSParameterAssert(bundle);
     
-    Class class = [self class];
-    while (class != Nil) {
-        NSString *className = NSStringFromClass(class);
+    NSString *key = [self resolutionKeyForClass:class inBundle:bundle storyboardName:nil nib:YES];
+    HLSInstantiationResolution *resolution = [self cachedResolutionForKey:key];
+    if (resolution) {
+        return resolution;
+    }
+    
+    Class currentClass = class;
+    while (currentClass != Nil) {
+        NSString *className = NSStringFromClass(currentClass);
         if ([bundle pathForResource:className ofType:@"nib"]) {
-            return className;
+            resolution = [[HLSInstantiationResolution alloc] initWithSource:HLSInstantiationSourceNib resourceName:className identifier:nil];
+            break;
         }
-        class = class_getSuperclass(class);
+        currentClass = class_getSuperclass(currentClass);
+    }
+    
+    if (! resolution) {
+        resolution = [[HLSInstantiationResolution alloc] initWithSource:HLSInstantiationSourceNone resourceName:nil identifier:nil];
     }
-    return nil;
+    
+    [self setCachedResolution:resolution forKey:key];
+    return resolution;
 }
 
 - (UIViewController *)viewControllerFromStoryboardWithName:(NSString *)storyboardName inBundle:(NSBundle *)bundle
@@ -58,47 +135,242 @@
     NSParameterAssert(bundle);
     
     Class class = [self class];
-    while (class != Nil) {
-        NSString *storyboardLookupName = storyboardName ?: NSStringFromClass(class);
-        UIViewController *viewController = [UIViewController viewControllerFromStoryboardWithName:storyboardLookupName class:class inBundle:bundle];
-        if (viewController) {
-            return viewController;
+    NSString *key = [UIViewController resolutionKeyForClass:class inBundle:bundle storyboardName:storyboardName nib:NO];
+    HLSInstantiationResolution *resolution = [UIViewController cachedResolutionForKey:key];
+    if (resolution) {
+        return [UIViewController viewControllerWithResolution:resolution inBundle:bundle];
+    }
+    
+    // Checking whether the initial view controller matches requires instantiating it. Use it as result if this is the case
+    UIViewController *viewController = nil;
+    
+    Class currentClass = class;
+    while (currentClass != Nil) {
+        NSString *storyboardLookupName = storyboardName ?: NSStringFromClass(currentClass);
+        resolution = [UIViewController resolutionForStoryboardWithName:storyboardLookupName class:currentClass inBundle:bundle viewController:&viewController];
+        if (resolution) {
+            break;
         }
-        class = class_getSuperclass(class);
+        currentClass = class_getSuperclass(currentClass);
+    }
+    
+    if (! resolution) {
+        resolution = [[HLSInstantiationResolution alloc] initWithSource:HLSInstantiationSourceNone resourceName:nil identifier:nil];
     }
-    return nil;
+    
+    [UIViewController setCachedResolution:resolution forKey:key];
+    return viewController ?: [UIViewController viewControllerWithResolution:resolution inBundle:bundle];
 }
 
-+ (UIViewController *)viewControllerFromStoryboardWithName:(NSString *)storyboardName class:(Class)class inBundle:(NSBundle *)bundle
+/**
+ * Return the resolution if a view controller of the given class can be instantiated from the specified storyboard, 
+ * nil otherwise. If the initial view controller had to be instantiated to find a match, it is returned by reference
+ */
++ (HLSInstantiationResolution *)resolutionForStoryboardWithName:(NSString *)storyboardName
+                                                          class:(Class)class
+                                                       inBundle:(NSBundle *)bundle
+                                                 viewController:(UIViewController **)pViewController
 {
     NSParameterAssert(storyboardName);
     NSParameterAssert(class);
     NSParameterAssert(bundle);
     
+    UIStoryboard *storyboard = [UIStoryboard sharedStoryboardWithName:storyboardName bundle:bundle];
+    if (! storyboard) {
+        return nil;
+    }
+    
     NSString *identifier = NSStringFromClass(class);
-    if (! [bundle pathForResource:identifier ofType:@"storyboardc"]) {
+    if ([UIStoryboard storyboardWithName:storyboardName bundle:bundle containsViewControllerWithIdentifier:identifier]) {
+        return [[HLSInstantiationResolution alloc] initWithSource:HLSInstantiationSourceStoryboardIdentifier resourceName:storyboardName identifier:identifier];
+    }
+    
+    UIViewController *viewController = [storyboard instantiateInitialViewController];
+    if (! [viewController isKindOfClass:class]) {
+        return nil;
+    }
+    
+    if (pViewController) {
+        *pViewController = viewController;
+    }
+    return [[HLSInstantiationResolution alloc] initWithSource:HLSInstantiationSourceStoryboardInitial resourceName:storyboardName identifier:nil];
+}
+
++ (UIViewController *)viewControllerWithResolution:(HLSInstantiationResolution *)resolution inBundle:(NSBundle *)bundle
+{
+    switch (resolution.source) {
+        case HLSInstantiationSourceStoryboardIdentifier: {
+            UIStoryboard *storyboard = [UIStoryboard sharedStoryboardWithName:resolution.resourceName bundle:bundle];
+            return [storyboard instantiateViewControllerWithIdentifier:resolution.identifier];
+            break;
+        }
+            
+        case HLSInstantiationSourceStoryboardInitial: {
+            UIStoryboard *storyboard = [UIStoryboard sharedStoryboardWithName:resolution.resourceName bundle:bundle];
+            return [storyboard instantiateInitialViewController];
+            break;
+        }
+            
+        default: {
+            return nil;
+            break;
+        }
+    }
+}
+
+@end
+
+#pragma mark -
+#pragma mark UIStoryboard (HLSInstantiation) category implementation
+
+@implementation UIStoryboard (HLSInstantiation)
+
+#pragma mark Class methods
+
++ (NSString *)storyboardKeyForName:(NSString *)name bundle:(NSBundle *)bundle
+{
+    return [NSString stringWithFormat:@"%@|%@", [bundle bundlePath], name];
+}
+
+/**
+ * Return the contents of the Info.plist file of the compiled storyboard (an empty dictionary if not available), nil if
+ * the storyboard does not exist
+ */
++ (NSDictionary *)infoForStoryboardWithName:(NSString *)name bundle:(NSBundle *)bundle
+{
+    setupCaches();
+    
+    NSString *key = [self storyboardKeyForName:name bundle:bundle];
+    
+    @synchronized(s_keyToResolutionMap) {
+        id info = [s_keyToStoryboardInfoMap objectForKey:key];
+        if (! info) {
+            NSString *storyboardPath = [bundle pathForResource:name ofType:@"storyboardc"];
+            if (storyboardPath) {
+                NSString *infoPath = [storyboardPath stringByAppendingPathComponent:@"Info.plist"];
+                info = [NSDictionary dictionaryWithContentsOfFile:infoPath] ?: @{};
+            }
+            else {
+                info = [NSNull null];
+            }
+            [s_keyToStoryboardInfoMap setObject:info forKey:key];
+        }
+        return (info != [NSNull null]) ? info : nil;
+    }
+}
+
+/**
+ * Return the map between view controller identifiers and nib names found in the Info.plist of a compiled storyboard,
+ * nil if not available. This information is private and might change in the future. It is only used if it has the
+ * expected format and is consistent with the rest of the Info.plist, so that public API can be used otherwise
+ */
++ (NSDictionary *)identifiersToNibNamesInStoryboardInfo:(NSDictionary *)info
+{
+    NSDictionary *identifiersToNibNames = [info objectForKey:@"UIViewControllerIdentifiersToNibNames"];
+    if (! [identifiersToNibNames isKindOfClass:[NSDictionary class]]) {
         return nil;
     }
     
-    UIStoryboard *storyboard = [UIStoryboard storyboardWithName:identifier bundle:bundle];
+    for (id identifier in identifiersToNibNames) {
+        if (! [identifier isKindOfClass:[NSString class]] || ! [[identifiersToNibNames objectForKey:identifier] isKindOfClass:[NSString class]]) {
+            return nil;
+        }
+    }
     
-    // Throws an exception if no view controller is found for the specified identifier
-    UIViewController *viewController = nil;
-    @try {
-        viewController = [storyboard instantiateViewControllerWithIdentifier:identifier];
+    // The initial view controller, if any, must be listed as well
+    NSString *entryPointIdentifier = [info objectForKey:@"UIStoryboardDesignatedEntryPointIdentifier"];
+    if (entryPointIdentifier && ! [identifiersToNibNames objectForKey:entryPointIdentifier]) {
+        return nil;
     }
-    @catch (NSException *exception) {}
     
-    if (viewController) {
-        return viewController;
+    return identifiersToNibNames;
+}
+
++ (UIStoryboard *)sharedStoryboardWithName:(NSString *)name bundle:(NSBundle *)bundle
+{
+    NSParameterAssert(name);
+    
+    if (! bundle) {
+        bundle = [NSBundle mainBundle];
     }
     
-    viewController = [storyboard instantiateInitialViewController];
-    if (! [viewController isKindOfClass:class]) {
+    if (! [self infoForStoryboardWithName:name bundle:bundle]) {
         return nil;
     }
     
-    return viewController;
+    NSString *key = [self storyboardKeyForName:name bundle:bundle];
+    UIStoryboard *storyboard = [s_storyboardCache objectForKey:key];
+    if (! storyboard) {
+        storyboard = [UIStoryboard storyboardWithName:name bundle:bundle];
+        [s_storyboardCache setObject:storyboard forKey:key];
+    }
+    return storyboard;
+}
+
++ (BOOL)storyboardWithName:(NSString *)name bundle:(NSBundle *)bundle containsViewControllerWithIdentifier:(NSString *)identifier
+{
+    NSParameterAssert(name);
+    NSParameterAssert(identifier);
+    
+    if (! bundle) {
+        bundle = [NSBundle mainBundle];
+    }
+    
+    NSDictionary *info = [self infoForStoryboardWithName:name bundle:bundle];
+    if (! info) {
+        return NO;
+    }
+    
+    // Compiled storyboards list the identifiers of the view controllers they contain
+    NSDictionary *identifiersToNibNames = [self identifiersToNibNamesInStoryboardInfo:info];
+    if (identifiersToNibNames) {
+        return [identifiersToNibNames objectForKey:identifier] != nil;
+    }
+    
+    // Fallback if this information is not available
+    UIStoryboard *storyboard = [self sharedStoryboardWithName:name bundle:bundle];
+    @try {
+        return [storyboard instantiateViewControllerWithIdentifier:identifier] != nil;
+    }
+    @catch (NSException *exception) {
+        return NO;
+    }
+}
+
+@end
+
+#pragma mark -
+#pragma mark HLSInstantiationResolution class implementation
+
+@implementation HLSInstantiationResolution
+
+#pragma mark Object creation and destruction
+
+- (instancetype)initWithSource:(HLSInstantiationSource)source resourceName:(NSString *)resourceName identifier:(NSString *)identifier
+{
+    if (self = [super init]) {
+        _source = source;
+        _resourceName = resourceName;
+        _identifier = identifier;
+    }
+    return self;
+}
+
+- (instancetype)init
+{
+    return [self initWithSource:HLSInstantiationSourceNone resourceName:nil identifier:nil];
 }
 
 @end
+
+#pragma mark Static functions
+
+static void setupCaches(void)
+{
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        s_keyToResolutionMap = [NSMutableDictionary dictionary];
+        s_keyToStoryboardInfoMap = [NSMutableDictionary dictionary];
+        s_storyboardCache = [[NSCache alloc] init];
+    });
+}